@@ -0,0 +1,73 @@
+// Copyright 2025 Xenon Emulator Project. All rights reserved.
+
+// Reservation breaking on stores, including stores of a different size than the reservation.
+
+#include "Base/Logging/Log.h"
+#include "Base/Types.h"
+#include "Core/XCPU/Context/Reservations/XenonReservations.h"
+
+static u32 failures = 0;
+
+#define CHECK(x)                                                                          \
+  do {                                                                                    \
+    if (!(x)) {                                                                           \
+      LOG_ERROR(Test, "{}:{}: Check failed: {}", __FILE__, __LINE__, #x);                 \
+      failures++;                                                                         \
+    }                                                                                     \
+  } while (false)
+
+// Reserves RA on one thread, stores from another, returns whether the conditional store would still succeed.
+static bool SurvivesStore(u64 reservedRA, u64 storeRA, bool wordStore) {
+  XenonReservations reservations{};
+  PPU_RES owner{}, other{};
+  reservations.Register(&owner);
+  reservations.Register(&other);
+  reservations.Reserve(&owner, reservedRA);
+  reservations.Check(storeRA, wordStore);
+  return reservations.Release(&owner, reservedRA);
+}
+
+static void TestStores() {
+  constexpr u64 base = 0x1000;
+  // Same size, same address
+  CHECK(!SurvivesStore(base, base, true));
+  CHECK(!SurvivesStore(base, base, false));
+  // Doubleword store over a word reservation in its upper half
+  CHECK(!SurvivesStore(base + 4, base, false));
+  // Word store to the upper half of a doubleword reservation
+  CHECK(!SurvivesStore(base, base + 4, true));
+  // Stores next to the reservation leave it alone
+  CHECK(SurvivesStore(base + 4, base, true));
+  CHECK(SurvivesStore(base, base + 8, false));
+  CHECK(SurvivesStore(base + 8, base, false));
+  // Nothing stored
+  CHECK(SurvivesStore(base, base + 0x100, true));
+}
+
+static void TestRanges() {
+  XenonReservations reservations{};
+  PPU_RES owner{};
+  reservations.Register(&owner);
+  // A block write over the reservation
+  reservations.Reserve(&owner, 0x2040);
+  reservations.CheckRange(0x2000, 0x80);
+  CHECK(!reservations.Release(&owner, 0x2040));
+  // One that ends right before it
+  reservations.Reserve(&owner, 0x2040);
+  reservations.CheckRange(0x2000, 0x40);
+  CHECK(reservations.Release(&owner, 0x2040));
+  // Released on another address fails
+  reservations.Reserve(&owner, 0x2040);
+  CHECK(!reservations.Release(&owner, 0x2048));
+}
+
+s32 main(s32 argc, char *argv[]) {
+  TestStores();
+  TestRanges();
+  if (failures) {
+    LOG_ERROR(Test, "{} check(s) failed.", failures);
+    return 1;
+  }
+  LOG_INFO(Test, "All reservation checks passed.");
+  return 0;
+}
@@ -0,0 +1,203 @@
+// Copyright 2025 Xenon Emulator Project. All rights reserved.
+
+// Save state round trips on objects built in place, no firmware needed.
+// Covers the state streams, the RAM page records (full and incremental, fed by the dirty tracker) and a PCI device's
+// SaveState/LoadState and power-on reset.
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Base/Hash.h"
+#include "Base/Logging/Log.h"
+#include "Base/StateStream.h"
+#include "Base/Types.h"
+#include "Core/PCI/Devices/AUDIOCTRLLR/AudioController.h"
+#include "Core/RAM/DirtyTracker.h"
+#include "Core/SaveState/RAMPages.h"
+
+static u32 failures = 0;
+
+#define CHECK(x)                                                                          \
+  do {                                                                                    \
+    if (!(x)) {                                                                           \
+      LOG_ERROR(Test, "{}:{}: Check failed: {}", __FILE__, __LINE__, #x);                 \
+      failures++;                                                                         \
+    }                                                                                     \
+  } while (false)
+
+struct sTestRegs {
+  u32 control = 0;
+  u64 address = 0;
+  u8 flags[3] = {};
+};
+
+static void TestStreams() {
+  const std::string name = "Xenon";
+  const std::vector<u32> words = { 1, 2, 0xDEADBEEF, 4 };
+  const sTestRegs regs = { 0x12345678, 0xEC8000000000ULL, { 1, 2, 3 } };
+  // Big and repetitive, so it goes through the compressed chunk path when there is one
+  std::vector<u8> block(3 * 1024 * 1024 + 17);
+  for (u64 i = 0; i != block.size(); ++i)
+    block[i] = static_cast<u8>((i / 64) & 0xFF);
+
+  Base::StateWriter writer{};
+  writer.BeginSection("First"_j);
+  writer.Write<u32>(0xCAFEBABE);
+  writer.WriteString(name);
+  writer.WriteVector(words);
+  writer.Write(regs);
+  writer.BeginSection("Nested"_j);
+  writer.Write<u64>(42);
+  writer.EndSection();
+  writer.EndSection();
+  writer.BeginSection("Unknown"_j);
+  writer.Write<u64>(0xFFFFFFFFFFFFFFFFULL);
+  writer.EndSection();
+  writer.BeginSection("Block"_j);
+  writer.WriteCompressed(block.data(), block.size());
+  writer.EndSection();
+
+  const std::vector<u8> &data = writer.GetData();
+  Base::StateReader reader(data.data(), data.size());
+  Base::StateReader section{};
+  // Looked up out of order, and skipping the one nobody reads
+  CHECK(reader.GetSection("Block"_j, section));
+  std::vector<u8> blockOut(block.size());
+  section.ReadCompressed(blockOut.data(), blockOut.size());
+  CHECK(section.Good() && section.Remaining() == 0);
+  CHECK(blockOut == block);
+
+  CHECK(reader.GetSection("First"_j, section));
+  CHECK(section.Read<u32>() == 0xCAFEBABE);
+  std::string nameOut{};
+  section.ReadString(nameOut);
+  CHECK(nameOut == name);
+  std::vector<u32> wordsOut{};
+  section.ReadVector(wordsOut);
+  CHECK(wordsOut == words);
+  const sTestRegs regsOut = section.Read<sTestRegs>();
+  CHECK(!std::memcmp(&regsOut, &regs, sizeof(regs)));
+  Base::StateReader nested{};
+  CHECK(section.GetSection("Nested"_j, nested));
+  CHECK(nested.Read<u64>() == 42);
+  CHECK(section.Good() && nested.Good());
+
+  CHECK(!reader.GetSection("Missing"_j, section));
+
+  // Running past the end fails for good, and zero fills
+  Base::StateReader truncated(data.data(), 6);
+  truncated.Read<u32>();
+  CHECK(truncated.Read<u64>() == 0);
+  CHECK(!truncated.Good());
+  CHECK(truncated.Read<u8>() == 0 && !truncated.Good());
+}
+
+static void TestRAMPages() {
+  constexpr u64 pageCount = 64;
+  constexpr u64 ramSize = pageCount * DIRTY_PAGE_SIZE;
+  std::vector<u8> ram(ramSize, 0);
+  RAMDirtyTracker tracker{};
+  tracker.Initialize(ram.data(), ramSize, ramSize, eDirtyTrackingMode::Software);
+  const s32 consumer = tracker.RegisterConsumer("Test");
+  CHECK(consumer != -1);
+
+  // Some compressible pages, some random ones and the rest left zero
+  u32 seed = 0x1234567;
+  for (u64 page = 0; page < pageCount; page += 3) {
+    u8 *data = ram.data() + page * DIRTY_PAGE_SIZE;
+    for (u64 i = 0; i != DIRTY_PAGE_SIZE; ++i) {
+      seed = seed * 1664525 + 1013904223;
+      data[i] = page % 2 ? static_cast<u8>(seed >> 24) : static_cast<u8>(i / 16 + page);
+    }
+  }
+
+  // Full state, everything is dirty on the first collection
+  std::vector<u64> pages = tracker.CollectDirtyPages(consumer);
+  CHECK(pages.size() == pageCount);
+  Base::StateWriter full{};
+  const u64 fullRecords = Xe::SaveState::SaveRAMPages(full, ram.data(), pages, true);
+  CHECK(fullRecords == (pageCount + 2) / 3);
+  const std::vector<u8> base = ram;
+
+  // Changes since then: new data, a page cleared, a page written with what it already held
+  std::memset(ram.data() + 1 * DIRTY_PAGE_SIZE, 0x5A, 100);
+  tracker.MarkDirty(1 * DIRTY_PAGE_SIZE, 100);
+  std::memset(ram.data() + 3 * DIRTY_PAGE_SIZE, 0, DIRTY_PAGE_SIZE);
+  tracker.MarkDirty(3 * DIRTY_PAGE_SIZE, DIRTY_PAGE_SIZE);
+  std::memset(ram.data() + 62 * DIRTY_PAGE_SIZE + DIRTY_PAGE_SIZE - 8, 0xA5, 16);
+  tracker.MarkDirty(62 * DIRTY_PAGE_SIZE + DIRTY_PAGE_SIZE - 8, 16);
+  tracker.MarkDirty(6 * DIRTY_PAGE_SIZE, 4);
+  pages = tracker.CollectDirtyPages(consumer);
+  CHECK(pages == std::vector<u64>({ 1 * DIRTY_PAGE_SIZE, 3 * DIRTY_PAGE_SIZE, 6 * DIRTY_PAGE_SIZE,
+    62 * DIRTY_PAGE_SIZE, 63 * DIRTY_PAGE_SIZE }));
+  Base::StateWriter incremental{};
+  // Zero pages must be kept, they clear what the base had
+  CHECK(Xe::SaveState::SaveRAMPages(incremental, ram.data(), pages, false) == pages.size());
+  CHECK(tracker.CollectDirtyPages(consumer).empty());
+
+  // Full state alone gives the base back
+  std::vector<u8> loaded(ramSize, 0);
+  Base::StateReader fullReader(full.GetData().data(), full.Size());
+  CHECK(Xe::SaveState::LoadRAMPages(fullReader, loaded.data(), ramSize));
+  CHECK(loaded == base);
+  // And the increment on top of it the current RAM
+  Base::StateReader incrementalReader(incremental.GetData().data(), incremental.Size());
+  CHECK(Xe::SaveState::LoadRAMPages(incrementalReader, loaded.data(), ramSize));
+  CHECK(loaded == ram);
+
+  // Cut short, or loaded into a smaller RAM
+  Base::StateReader cut(incremental.GetData().data(), incremental.Size() - 1);
+  CHECK(!Xe::SaveState::LoadRAMPages(cut, loaded.data(), ramSize));
+  Base::StateReader smaller(incremental.GetData().data(), incremental.Size());
+  CHECK(!Xe::SaveState::LoadRAMPages(smaller, loaded.data(), 32 * DIRTY_PAGE_SIZE));
+  tracker.UnregisterConsumer(consumer);
+}
+
+static void TestDevice() {
+  Xe::PCIDev::AUDIOCTRLR device("AUDIOCTRLR", AUDIO_CTRLR_DEV_SIZE);
+  device.CapturePowerOnState();
+  const GENRAL_PCI_DEVICE_CONFIG_SPACE powerOn = device.pciConfigSpace;
+
+  // What the kernel does to map it: size discovery, then the BAR
+  const u32 allOnes = 0xFFFFFFFF;
+  device.ConfigWrite(0x10, reinterpret_cast<const u8*>(&allOnes), sizeof(allOnes));
+  u32 barSize = 0;
+  device.ConfigRead(0x10, reinterpret_cast<u8*>(&barSize), sizeof(barSize));
+  CHECK(barSize != allOnes);
+  const u32 bar = 0xEA001600;
+  device.ConfigWrite(0x10, reinterpret_cast<const u8*>(&bar), sizeof(bar));
+  CHECK(device.GetBAR(0) == bar);
+
+  Base::StateWriter writer{};
+  device.SaveState(writer);
+  Xe::PCIDev::AUDIOCTRLR restored("AUDIOCTRLR", AUDIO_CTRLR_DEV_SIZE);
+  Base::StateReader reader(writer.GetData().data(), writer.Size());
+  restored.LoadState(reader);
+  CHECK(reader.Good() && reader.Remaining() == 0);
+  CHECK(!std::memcmp(&restored.pciConfigSpace, &device.pciConfigSpace, sizeof(device.pciConfigSpace)));
+  CHECK(!std::memcmp(restored.pciDevSizes, device.pciDevSizes, sizeof(device.pciDevSizes)));
+  CHECK(restored.GetBAR(0) == bar);
+
+  // Saving what was loaded gives the same bytes
+  Base::StateWriter again{};
+  restored.SaveState(again);
+  CHECK(again.GetData() == writer.GetData());
+
+  // A reset goes back to how it was built
+  device.Reset();
+  CHECK(!std::memcmp(&device.pciConfigSpace, &powerOn, sizeof(powerOn)));
+  CHECK(device.GetBAR(0) == 0);
+}
+
+s32 main(s32 argc, char *argv[]) {
+  TestStreams();
+  TestRAMPages();
+  TestDevice();
+  if (failures) {
+    LOG_ERROR(Test, "{} check(s) failed.", failures);
+    return 1;
+  }
+  LOG_INFO(Test, "All save state round trips passed.");
+  return 0;
+}
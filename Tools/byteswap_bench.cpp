@@ -0,0 +1,109 @@
+// Copyright 2025 Xenon Emulator Project. All rights reserved.
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include "Base/ByteSwap.h"
+#include "Base/Logging/Log.h"
+#include "Base/Param.h"
+#include "Base/Types.h"
+
+PARAM(size, "Size of the buffer to swap, in bytes (hex, default 0x100000)");
+PARAM(iterations, "How many times each routine runs over the buffer (hex, default 0x200)");
+PARAM(isa, "Only runs the given implementation next to the scalar one (SSSE3, AVX2, AVX-512, NEON)");
+
+namespace {
+
+using namespace Base::ByteSwap;
+
+struct sRoutine {
+  const char *name;
+  void (*sSwapRoutines::*func)(void *dst, const void *src, size_t count);
+  u64 elementSize;
+};
+
+constexpr sRoutine routines[] = {
+  { "CopySwap16", &sSwapRoutines::copySwap16, 2 },
+  { "CopySwap32", &sSwapRoutines::copySwap32, 4 },
+  { "CopySwap64", &sSwapRoutines::copySwap64, 8 },
+  { "CopySwap128", &sSwapRoutines::copySwap128, 16 },
+  { "CopySwap16In32", &sSwapRoutines::copySwap16In32, 4 },
+};
+
+constexpr eSwapISA isas[] = { eSwapISA::Scalar, eSwapISA::SSSE3, eSwapISA::AVX2, eSwapISA::AVX512, eSwapISA::NEON };
+
+// Runs one routine over the buffer, returns the throughput in GB/s
+f64 Measure(const sRoutine &routine, u8 *dst, const u8 *src, u64 size, u64 iterations) {
+  const u64 count = size / routine.elementSize;
+  // Warm up the caches and the branch predictors first
+  (currentRoutines.*routine.func)(dst, src, count);
+  const auto start = std::chrono::steady_clock::now();
+  for (u64 i = 0; i != iterations; ++i)
+    (currentRoutines.*routine.func)(dst, src, count);
+  const f64 seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+  return seconds > 0.0 ? static_cast<f64>(count * routine.elementSize * iterations) / seconds / 1e9 : 0.0;
+}
+
+} // namespace
+
+s32 ToolMain() {
+  const u64 size = PARAM_size.Present() ? PARAM_size.Get<u64>() : 0x100000;
+  const u64 iterations = PARAM_iterations.Present() ? PARAM_iterations.Get<u64>() : 0x200;
+  const std::string onlyISA = PARAM_isa.Get();
+  if (size < 16 || iterations == 0) {
+    LOG_ERROR(Main, "Size must be at least 16 bytes, and iterations at least 1.");
+    return 1;
+  }
+
+  // Odd offsets on both sides, the guest hands us unaligned spans too
+  std::vector<u8> source(size + 1), reference(size + 1), result(size + 1);
+  for (u64 i = 0; i != source.size(); ++i)
+    source[i] = static_cast<u8>(i * 131 + 7);
+  const u8 *src = source.data() + 1;
+
+  LOG_INFO(Main, "Swapping 0x{:X} bytes, 0x{:X} iterations per routine.", size, iterations);
+  f64 scalarRate[std::size(routines)] = {};
+  bool failed = false;
+  for (const eSwapISA isa : isas) {
+    const char *isaName = GetISAName(isa);
+    if (!onlyISA.empty() && isa != eSwapISA::Scalar && onlyISA != isaName)
+      continue;
+    if (!SetISA(isa)) {
+      LOG_INFO(Main, "{}: Not supported on this host.", isaName);
+      continue;
+    }
+    for (u64 r = 0; r != std::size(routines); ++r) {
+      const sRoutine &routine = routines[r];
+      const u64 count = size / routine.elementSize;
+      const f64 rate = Measure(routine, result.data() + 1, src, size, iterations);
+      if (isa == eSwapISA::Scalar) {
+        scalarRate[r] = rate;
+        LOG_INFO(Main, "{} {}: {:.2f} GB/s", isaName, routine.name, rate);
+        continue;
+      }
+      // Every implementation must match the scalar one, reference is rebuilt since the buffer is shared
+      SetISA(eSwapISA::Scalar);
+      (currentRoutines.*routine.func)(reference.data() + 1, src, count);
+      SetISA(isa);
+      const bool match = !std::memcmp(reference.data() + 1, result.data() + 1, count * routine.elementSize);
+      failed |= !match;
+      LOG_INFO(Main, "{} {}: {:.2f} GB/s ({:.2f}x scalar){}", isaName, routine.name, rate,
+        scalarRate[r] > 0.0 ? rate / scalarRate[r] : 0.0, match ? "" : " MISMATCH");
+    }
+  }
+  return failed ? 1 : 0;
+}
+
+extern s32 ToolMain();
+PARAM(help, "Prints this message", false);
+s32 main(s32 argc, char *argv[]) {
+  // Init params
+  Base::Param::Init(argc, argv);
+  // Handle help param
+  if (PARAM_help.Present()) {
+    ::Base::Param::Help();
+    return 0;
+  }
+  return ToolMain();
+}
@@ -0,0 +1,337 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "ByteSwap.h"
+#include "Logging/Log.h"
+
+#if defined(_MSC_VER) && (defined(ARCH_X86) || defined(ARCH_X86_64))
+#include <intrin.h>
+#endif
+
+#ifdef __GNUC__
+#define SWAP_TARGET(x) __attribute__((target(x)))
+#else
+#define SWAP_TARGET(x)
+#endif
+
+namespace Base::ByteSwap {
+
+namespace {
+
+//
+// Scalar
+//
+
+template <typename T>
+void ScalarCopySwap(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  for (size_t i = 0; i != count; ++i) {
+    T value = 0;
+    std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+    value = std::byteswap<T>(value);
+    std::memcpy(out + i * sizeof(T), &value, sizeof(T));
+  }
+}
+
+void ScalarCopySwap128(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  for (size_t i = 0; i != count; ++i) {
+    u64 halves[2] = {};
+    std::memcpy(halves, in + i * 16, sizeof(halves));
+    const u64 swapped[2] = { std::byteswap<u64>(halves[1]), std::byteswap<u64>(halves[0]) };
+    std::memcpy(out + i * 16, swapped, sizeof(swapped));
+  }
+}
+
+void ScalarCopySwap16In32(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  for (size_t i = 0; i != count; ++i) {
+    u32 value = 0;
+    std::memcpy(&value, in + i * sizeof(u32), sizeof(u32));
+    value = std::rotl<u32>(value, 16);
+    std::memcpy(out + i * sizeof(u32), &value, sizeof(u32));
+  }
+}
+
+constexpr sSwapRoutines scalarRoutines = {
+  ScalarCopySwap<u16>,
+  ScalarCopySwap<u32>,
+  ScalarCopySwap<u64>,
+  ScalarCopySwap128,
+  ScalarCopySwap16In32
+};
+
+//
+// x86 (SSSE3, AVX2, AVX-512BW)
+// All the swaps stay inside a 16 byte lane, so the same byte shuffle is used at every width.
+//
+
+#if defined(ARCH_X86) || defined(ARCH_X86_64)
+alignas(16) constexpr u8 shuffle16[16] = { 1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14 };
+alignas(16) constexpr u8 shuffle32[16] = { 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12 };
+alignas(16) constexpr u8 shuffle64[16] = { 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8 };
+alignas(16) constexpr u8 shuffle128[16] = { 15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
+alignas(16) constexpr u8 shuffle16In32[16] = { 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13 };
+
+using SwapFunc = void (*)(void *dst, const void *src, size_t count);
+
+template <const u8 *Shuffle, size_t ElementSize, SwapFunc Tail>
+SWAP_TARGET("ssse3")
+void SSSE3CopySwap(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  const size_t bytes = count * ElementSize;
+  const __m128i shuffle = _mm_load_si128(reinterpret_cast<const __m128i*>(Shuffle));
+  size_t offset = 0;
+  for (; offset + 64 <= bytes; offset += 64) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset));
+    const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset + 16));
+    const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset + 32));
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset + 48));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset), _mm_shuffle_epi8(a, shuffle));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset + 16), _mm_shuffle_epi8(b, shuffle));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset + 32), _mm_shuffle_epi8(c, shuffle));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset + 48), _mm_shuffle_epi8(d, shuffle));
+  }
+  for (; offset + 16 <= bytes; offset += 16) {
+    const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + offset));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + offset), _mm_shuffle_epi8(a, shuffle));
+  }
+  if (offset != bytes)
+    Tail(out + offset, in + offset, (bytes - offset) / ElementSize);
+}
+
+template <const u8 *Shuffle, size_t ElementSize, SwapFunc Tail>
+SWAP_TARGET("avx2")
+void AVX2CopySwap(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  const size_t bytes = count * ElementSize;
+  const __m256i shuffle = _mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(Shuffle)));
+  size_t offset = 0;
+  for (; offset + 128 <= bytes; offset += 128) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset));
+    const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset + 32));
+    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset + 64));
+    const __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset + 96));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset), _mm256_shuffle_epi8(a, shuffle));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset + 32), _mm256_shuffle_epi8(b, shuffle));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset + 64), _mm256_shuffle_epi8(c, shuffle));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset + 96), _mm256_shuffle_epi8(d, shuffle));
+  }
+  for (; offset + 32 <= bytes; offset += 32) {
+    const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + offset));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + offset), _mm256_shuffle_epi8(a, shuffle));
+  }
+  if (offset != bytes)
+    Tail(out + offset, in + offset, (bytes - offset) / ElementSize);
+}
+
+template <const u8 *Shuffle, size_t ElementSize, SwapFunc Tail>
+SWAP_TARGET("avx512f,avx512bw")
+void AVX512CopySwap(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  const size_t bytes = count * ElementSize;
+  const __m512i shuffle = _mm512_broadcast_i32x4(_mm_load_si128(reinterpret_cast<const __m128i*>(Shuffle)));
+  size_t offset = 0;
+  for (; offset + 256 <= bytes; offset += 256) {
+    const __m512i a = _mm512_loadu_si512(in + offset);
+    const __m512i b = _mm512_loadu_si512(in + offset + 64);
+    const __m512i c = _mm512_loadu_si512(in + offset + 128);
+    const __m512i d = _mm512_loadu_si512(in + offset + 192);
+    _mm512_storeu_si512(out + offset, _mm512_shuffle_epi8(a, shuffle));
+    _mm512_storeu_si512(out + offset + 64, _mm512_shuffle_epi8(b, shuffle));
+    _mm512_storeu_si512(out + offset + 128, _mm512_shuffle_epi8(c, shuffle));
+    _mm512_storeu_si512(out + offset + 192, _mm512_shuffle_epi8(d, shuffle));
+  }
+  for (; offset + 64 <= bytes; offset += 64) {
+    const __m512i a = _mm512_loadu_si512(in + offset);
+    _mm512_storeu_si512(out + offset, _mm512_shuffle_epi8(a, shuffle));
+  }
+  if (offset != bytes)
+    Tail(out + offset, in + offset, (bytes - offset) / ElementSize);
+}
+
+// Each width hands its remainder down to the next narrower one.
+#define SWAP_X86_ROUTINES(name, shuffle, size, scalar)                                                          \
+  constexpr SwapFunc ssse3##name = SSSE3CopySwap<shuffle, size, scalar>;                                       \
+  constexpr SwapFunc avx2##name = AVX2CopySwap<shuffle, size, ssse3##name>;                                     \
+  constexpr SwapFunc avx512##name = AVX512CopySwap<shuffle, size, avx2##name>;
+
+SWAP_X86_ROUTINES(16, shuffle16, 2, ScalarCopySwap<u16>)
+SWAP_X86_ROUTINES(32, shuffle32, 4, ScalarCopySwap<u32>)
+SWAP_X86_ROUTINES(64, shuffle64, 8, ScalarCopySwap<u64>)
+SWAP_X86_ROUTINES(128, shuffle128, 16, ScalarCopySwap128)
+SWAP_X86_ROUTINES(16In32, shuffle16In32, 4, ScalarCopySwap16In32)
+#undef SWAP_X86_ROUTINES
+
+constexpr sSwapRoutines ssse3Routines = { ssse316, ssse332, ssse364, ssse3128, ssse316In32 };
+constexpr sSwapRoutines avx2Routines = { avx216, avx232, avx264, avx2128, avx216In32 };
+constexpr sSwapRoutines avx512Routines = { avx51216, avx51232, avx51264, avx512128, avx51216In32 };
+
+struct sX86Features {
+  bool ssse3 = false;
+  bool avx2 = false;
+  bool avx512bw = false;
+};
+
+sX86Features DetectX86Features() {
+  sX86Features features = {};
+#ifdef _MSC_VER
+  s32 regs[4] = {};
+  __cpuid(regs, 0);
+  const s32 maxLeaf = regs[0];
+  __cpuid(regs, 1);
+  features.ssse3 = (regs[2] >> 9) & 1;
+  const bool osxsave = (regs[2] >> 27) & 1;
+  if (!osxsave || maxLeaf < 7)
+    return features;
+  // The OS must be saving the YMM (and ZMM) state
+  const u64 xcr0 = _xgetbv(0);
+  const bool ymmState = (xcr0 & 0x6) == 0x6;
+  const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+  __cpuidex(regs, 7, 0);
+  features.avx2 = ymmState && ((regs[1] >> 5) & 1);
+  features.avx512bw = zmmState && ((regs[1] >> 16) & 1) && ((regs[1] >> 30) & 1);
+#else
+  __builtin_cpu_init();
+  features.ssse3 = __builtin_cpu_supports("ssse3");
+  features.avx2 = __builtin_cpu_supports("avx2");
+  features.avx512bw = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+  return features;
+}
+#endif
+
+//
+// AArch64 (NEON)
+//
+
+#if defined(ARCH_AARCH64)
+template <uint8x16_t (*Swap)(uint8x16_t), size_t ElementSize, void (*Tail)(void*, const void*, size_t)>
+void NEONCopySwap(void *dst, const void *src, size_t count) {
+  const u8 *in = static_cast<const u8*>(src);
+  u8 *out = static_cast<u8*>(dst);
+  const size_t bytes = count * ElementSize;
+  size_t offset = 0;
+  for (; offset + 64 <= bytes; offset += 64) {
+    const uint8x16x4_t data = vld1q_u8_x4(in + offset);
+    const uint8x16x4_t swapped = { Swap(data.val[0]), Swap(data.val[1]), Swap(data.val[2]), Swap(data.val[3]) };
+    vst1q_u8_x4(out + offset, swapped);
+  }
+  for (; offset + 16 <= bytes; offset += 16)
+    vst1q_u8(out + offset, Swap(vld1q_u8(in + offset)));
+  if (offset != bytes)
+    Tail(out + offset, in + offset, (bytes - offset) / ElementSize);
+}
+
+inline uint8x16_t NEONSwap16(uint8x16_t value) { return vrev16q_u8(value); }
+inline uint8x16_t NEONSwap32(uint8x16_t value) { return vrev32q_u8(value); }
+inline uint8x16_t NEONSwap64(uint8x16_t value) { return vrev64q_u8(value); }
+inline uint8x16_t NEONSwap128(uint8x16_t value) {
+  const uint8x16_t swapped = vrev64q_u8(value);
+  return vextq_u8(swapped, swapped, 8);
+}
+inline uint8x16_t NEONSwap16In32(uint8x16_t value) {
+  return vreinterpretq_u8_u16(vrev32q_u16(vreinterpretq_u16_u8(value)));
+}
+
+constexpr sSwapRoutines neonRoutines = {
+  NEONCopySwap<NEONSwap16, 2, ScalarCopySwap<u16>>,
+  NEONCopySwap<NEONSwap32, 4, ScalarCopySwap<u32>>,
+  NEONCopySwap<NEONSwap64, 8, ScalarCopySwap<u64>>,
+  NEONCopySwap<NEONSwap128, 16, ScalarCopySwap128>,
+  NEONCopySwap<NEONSwap16In32, 4, ScalarCopySwap16In32>
+};
+#endif
+
+bool IsSupported(eSwapISA isa) {
+  switch (isa) {
+  case eSwapISA::Scalar:
+    return true;
+#if defined(ARCH_X86) || defined(ARCH_X86_64)
+  case eSwapISA::SSSE3:
+    return DetectX86Features().ssse3;
+  case eSwapISA::AVX2:
+    return DetectX86Features().avx2;
+  case eSwapISA::AVX512:
+    return DetectX86Features().avx512bw;
+#elif defined(ARCH_AARCH64)
+  case eSwapISA::NEON:
+    return true;
+#endif
+  default:
+    return false;
+  }
+}
+
+const sSwapRoutines &GetRoutines(eSwapISA isa) {
+  switch (isa) {
+#if defined(ARCH_X86) || defined(ARCH_X86_64)
+  case eSwapISA::SSSE3:
+    return ssse3Routines;
+  case eSwapISA::AVX2:
+    return avx2Routines;
+  case eSwapISA::AVX512:
+    return avx512Routines;
+#elif defined(ARCH_AARCH64)
+  case eSwapISA::NEON:
+    return neonRoutines;
+#endif
+  default:
+    return scalarRoutines;
+  }
+}
+
+eSwapISA currentISA = eSwapISA::Scalar;
+
+} // namespace
+
+sSwapRoutines currentRoutines = scalarRoutines;
+
+void Initialize() {
+  eSwapISA isa = eSwapISA::Scalar;
+#if defined(ARCH_X86) || defined(ARCH_X86_64)
+  const sX86Features features = DetectX86Features();
+  if (features.avx512bw)
+    isa = eSwapISA::AVX512;
+  else if (features.avx2)
+    isa = eSwapISA::AVX2;
+  else if (features.ssse3)
+    isa = eSwapISA::SSSE3;
+#elif defined(ARCH_AARCH64)
+  isa = eSwapISA::NEON;
+#endif
+  SetISA(isa);
+  LOG_INFO(Base, "ByteSwap: Using {} routines.", GetISAName(isa));
+}
+
+eSwapISA GetISA() {
+  return currentISA;
+}
+
+const char *GetISAName(eSwapISA isa) {
+  switch (isa) {
+  case eSwapISA::Scalar: return "Scalar";
+  case eSwapISA::SSSE3: return "SSSE3";
+  case eSwapISA::AVX2: return "AVX2";
+  case eSwapISA::AVX512: return "AVX-512";
+  case eSwapISA::NEON: return "NEON";
+  }
+  return "Unknown";
+}
+
+bool SetISA(eSwapISA isa) {
+  if (!IsSupported(isa))
+    return false;
+  currentRoutines = GetRoutines(isa);
+  currentISA = isa;
+  return true;
+}
+
+} // namespace Base::ByteSwap
@@ -0,0 +1,123 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+#include "Arch.h"
+#include "Types.h"
+
+#if defined(ARCH_X86) || defined(ARCH_X86_64)
+#include <immintrin.h>
+#elif defined(ARCH_AARCH64)
+#include <arm_neon.h>
+#endif
+
+// Bulk byteswap routines.
+// Everything the guest sees is big endian, so any span of guest data handed to the host (DMA buffers, GPU
+// buffers, shader microcode, vectors) has to be swapped. These swap whole spans at once using the widest vector
+// unit available on the host, selected once at startup.
+// Copy variants allow dst == src, but the spans must not otherwise overlap. Spans need not be aligned.
+namespace Base::ByteSwap {
+
+// Implementation in use.
+enum class eSwapISA : u8 {
+  Scalar,
+  SSSE3,
+  AVX2,
+  AVX512,
+  NEON
+};
+
+// Detects the host features and selects the fastest implementation. Until this is called the scalar
+// routines are used.
+void Initialize();
+
+// Returns the implementation currently in use.
+eSwapISA GetISA();
+const char *GetISAName(eSwapISA isa);
+
+// Forces a given implementation, returns false (and keeps the current one) if the host doesn't support it.
+bool SetISA(eSwapISA isa);
+
+// Table of routines for one implementation, counts are in elements.
+struct sSwapRoutines {
+  void (*copySwap16)(void *dst, const void *src, size_t count);
+  void (*copySwap32)(void *dst, const void *src, size_t count);
+  void (*copySwap64)(void *dst, const void *src, size_t count);
+  // Reverses all 16 bytes of each 128-bit lane.
+  void (*copySwap128)(void *dst, const void *src, size_t count);
+  // Swaps the half words of each word (Xenos 16in32 mode).
+  void (*copySwap16In32)(void *dst, const void *src, size_t count);
+};
+
+// Active routines.
+extern sSwapRoutines currentRoutines;
+
+// Copy and swap.
+inline void CopySwap16(void *dst, const void *src, size_t count) { currentRoutines.copySwap16(dst, src, count); }
+inline void CopySwap32(void *dst, const void *src, size_t count) { currentRoutines.copySwap32(dst, src, count); }
+inline void CopySwap64(void *dst, const void *src, size_t count) { currentRoutines.copySwap64(dst, src, count); }
+inline void CopySwap128(void *dst, const void *src, size_t count) { currentRoutines.copySwap128(dst, src, count); }
+inline void CopySwap16In32(void *dst, const void *src, size_t count) { currentRoutines.copySwap16In32(dst, src, count); }
+
+// In place.
+inline void Swap16(void *data, size_t count) { currentRoutines.copySwap16(data, data, count); }
+inline void Swap32(void *data, size_t count) { currentRoutines.copySwap32(data, data, count); }
+inline void Swap64(void *data, size_t count) { currentRoutines.copySwap64(data, data, count); }
+inline void Swap128(void *data, size_t count) { currentRoutines.copySwap128(data, data, count); }
+inline void Swap16In32(void *data, size_t count) { currentRoutines.copySwap16In32(data, data, count); }
+
+// Swaps a span of big endian guest data to host order, picking the routine from the element size.
+template <typename T>
+  requires std::is_integral_v<T>
+inline void SwapBE(T *data, size_t count) {
+  if constexpr (std::endian::native == std::endian::little) {
+    if constexpr (sizeof(T) == 2)
+      Swap16(data, count);
+    else if constexpr (sizeof(T) == 4)
+      Swap32(data, count);
+    else if constexpr (sizeof(T) == 8)
+      Swap64(data, count);
+  }
+}
+
+template <typename T>
+  requires std::is_integral_v<T>
+inline void CopySwapBE(T *dst, const T *src, size_t count) {
+  if constexpr (std::endian::native == std::endian::little && sizeof(T) > 1) {
+    if constexpr (sizeof(T) == 2)
+      CopySwap16(dst, src, count);
+    else if constexpr (sizeof(T) == 4)
+      CopySwap32(dst, src, count);
+    else if constexpr (sizeof(T) == 8)
+      CopySwap64(dst, src, count);
+  } else if (dst != src) {
+    std::memcpy(dst, src, count * sizeof(T));
+  }
+}
+
+// Swaps the four words of a single 16 byte lane in place. This is the VMX load/store case, which is too small to
+// be worth an indirect call, so it's always inlined.
+inline void SwapLane32(void *lane) {
+#if (defined(ARCH_X86) || defined(ARCH_X86_64)) && (defined(__SSSE3__) || defined(_MSC_VER))
+  const __m128i shuffle = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  __m128i *vec = reinterpret_cast<__m128i*>(lane);
+  _mm_storeu_si128(vec, _mm_shuffle_epi8(_mm_loadu_si128(vec), shuffle));
+#elif defined(ARCH_AARCH64)
+  u8 *bytes = reinterpret_cast<u8*>(lane);
+  vst1q_u8(bytes, vrev32q_u8(vld1q_u8(bytes)));
+#else
+  u32 words[4];
+  std::memcpy(words, lane, sizeof(words));
+  for (auto &word : words)
+    word = byteswap_be<u32>(word);
+  std::memcpy(lane, words, sizeof(words));
+#endif
+}
+
+} // namespace Base::ByteSwap
@@ -0,0 +1,78 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "Compression.h"
+
+#ifdef XE_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace Base::Compression {
+
+bool Available() {
+#ifdef XE_HAS_ZSTD
+  return true;
+#else
+  return false;
+#endif
+}
+
+size_t Bound(size_t size) {
+#ifdef XE_HAS_ZSTD
+  return ZSTD_compressBound(size);
+#else
+  return size;
+#endif
+}
+
+Compressor::Compressor(s32 compressionLevel) :
+  level(compressionLevel) {
+#ifdef XE_HAS_ZSTD
+  context = ZSTD_createCCtx();
+#endif
+}
+
+Compressor::~Compressor() {
+#ifdef XE_HAS_ZSTD
+  ZSTD_freeCCtx(static_cast<ZSTD_CCtx*>(context));
+#endif
+}
+
+size_t Compressor::Compress(const void *source, size_t size, void *destination, size_t capacity) {
+#ifdef XE_HAS_ZSTD
+  if (!context)
+    return 0;
+  const size_t result = ZSTD_compressCCtx(static_cast<ZSTD_CCtx*>(context), destination, capacity, source, size, level);
+  if (ZSTD_isError(result) || result >= size)
+    return 0;
+  return result;
+#else
+  return 0;
+#endif
+}
+
+Decompressor::Decompressor() {
+#ifdef XE_HAS_ZSTD
+  context = ZSTD_createDCtx();
+#endif
+}
+
+Decompressor::~Decompressor() {
+#ifdef XE_HAS_ZSTD
+  ZSTD_freeDCtx(static_cast<ZSTD_DCtx*>(context));
+#endif
+}
+
+bool Decompressor::Decompress(const void *source, size_t sourceSize, void *destination, size_t size) {
+#ifdef XE_HAS_ZSTD
+  if (!context)
+    return false;
+  const size_t result = ZSTD_decompressDCtx(static_cast<ZSTD_DCtx*>(context), destination, size, source, sourceSize);
+  return !ZSTD_isError(result) && result == size;
+#else
+  return false;
+#endif
+}
+
+} // namespace Base::Compression
@@ -0,0 +1,50 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include "Types.h"
+
+// Block compression, used by save states.
+// Backed by zstd when the build has it (XE_HAS_ZSTD). Without it nothing compresses and callers store their blocks
+// as is, which is still correct, just bigger.
+namespace Base::Compression {
+
+// Returns true if blocks can be compressed/decompressed.
+bool Available();
+
+// Worst case compressed size of a block.
+size_t Bound(size_t size);
+
+// Compresses blocks, keeps its context around so it can be reused. Not thread safe, use one per thread.
+class Compressor {
+public:
+  explicit Compressor(s32 level = 1);
+  ~Compressor();
+  Compressor(const Compressor&) = delete;
+  Compressor &operator=(const Compressor&) = delete;
+
+  // Compresses source into destination (at least Bound(size) bytes). Returns the compressed size, 0 if the block
+  // doesn't get any smaller or compression is unavailable.
+  size_t Compress(const void *source, size_t size, void *destination, size_t capacity);
+private:
+  void *context = nullptr;
+  s32 level = 1;
+};
+
+// Decompresses blocks. Not thread safe, use one per thread.
+class Decompressor {
+public:
+  Decompressor();
+  ~Decompressor();
+  Decompressor(const Decompressor&) = delete;
+  Decompressor &operator=(const Decompressor&) = delete;
+
+  // Decompresses source, which must expand to exactly size bytes. Returns false on corrupt data.
+  bool Decompress(const void *source, size_t sourceSize, void *destination, size_t size);
+private:
+  void *context = nullptr;
+};
+
+} // namespace Base::Compression
@@ -120,6 +120,7 @@ void _debug::from_toml(const toml::value &value) {
   startHalted = toml::find_or<bool>(value, "StartHalted", startHalted);
   softHaltOnAssertions = toml::find_or<bool>(value, "SoftHaltOnAssertions", softHaltOnAssertions);
   autoContinueOnGuestAssertion = toml::find_or<bool>(value, "AutoContinueOnGuestAssertion", autoContinueOnGuestAssertion);
+  hleVerify = toml::find_or<bool>(value, "HLEVerify", hleVerify);
 #ifdef DEBUG_BUILD
   createTraceFile = toml::find_or<bool>(value, "CreateTraceFile", createTraceFile);
 #endif
@@ -147,6 +148,10 @@ void _debug::to_toml(toml::value &value) {
   value["AutoContinueOnGuestAssertion"].comments().clear();
   value["AutoContinueOnGuestAssertion"] = autoContinueOnGuestAssertion;
   value["AutoContinueOnGuestAssertion"].comments().push_back("# Automatically continues on guest assertion");
+  value["HLEVerify"].comments().clear();
+  value["HLEVerify"] = hleVerify;
+  value["HLEVerify"].comments().push_back("# Interprets HLE'd memory routines and compares the results against the native implementation");
+  value["HLEVerify"].comments().push_back("# Mismatches are logged. Only used with HLEMemRoutines");
 #ifdef DEBUG_BUILD
   value["CreateTraceFile"].comments().clear();
   value["CreateTraceFile"] = createTraceFile;
@@ -162,6 +167,7 @@ bool _debug::verify_toml(toml::value &value) {
   cache_value(startHalted);
   cache_value(softHaltOnAssertions);
   cache_value(autoContinueOnGuestAssertion);
+  cache_value(hleVerify);
 #ifdef DEBUG_BUILD
   cache_value(createTraceFile);
 #endif
@@ -172,6 +178,7 @@ bool _debug::verify_toml(toml::value &value) {
   verify_value(startHalted);
   verify_value(softHaltOnAssertions);
   verify_value(autoContinueOnGuestAssertion);
+  verify_value(hleVerify);
 #ifdef DEBUG_BUILD
   verify_value(createTraceFile);
 #endif
@@ -248,6 +255,9 @@ bool _smc::verify_toml(toml::value &value) {
 
 void _xcpu::from_toml(const toml::value &value) {
   ramSize = toml::find_or<std::string>(value, "RAMSize", ramSize);
+  ramHugePages = toml::find_or<u8&>(value, "RAMHugePages", ramHugePages);
+  ramPoison = toml::find_or<bool>(value, "RAMPoison", ramPoison);
+  ramDirtyTracking = toml::find_or<u8&>(value, "RAMDirtyTracking", ramDirtyTracking);
   elfLoader = toml::find_or<bool>(value, "ElfLoader", elfLoader);
   overrideInitSkip = toml::find_or<bool>(value, "OverrideHWInit", overrideInitSkip);
   HW_INIT_SKIP_1 = toml::find_or<u64&>(value, "HW_INIT_SKIP1", HW_INIT_SKIP_1);
@@ -255,6 +265,12 @@ void _xcpu::from_toml(const toml::value &value) {
   simulate1BL = toml::find_or<bool>(value, "Simulate1BL", simulate1BL);
   runInstrTests = toml::find_or<bool>(value, "RunInstrTests", runInstrTests);
   instrTestsMode = toml::find_or<u8&>(value, "InstrTestsMode", instrTestsMode);
+  timeBaseMode = toml::find_or<std::string>(value, "TimeBaseMode", timeBaseMode);
+  instrsPerTick = toml::find_or<u32&>(value, "InstrsPerTick", instrsPerTick);
+  deterministic = toml::find_or<bool>(value, "Deterministic", deterministic);
+  replayMode = toml::find_or<std::string>(value, "ReplayMode", replayMode);
+  parallelSMT = toml::find_or<bool>(value, "ParallelSMT", parallelSMT);
+  smtHints = toml::find_or<bool>(value, "SMTHints", smtHints);
 }
 void _xcpu::to_toml(toml::value &value) {
   value["RAMSize"].comments().clear();
@@ -264,6 +280,21 @@ void _xcpu::to_toml(toml::value &value) {
   value["RAMSize"].comments().push_back("# 512MiB = 536.870912MB");
   value["RAMSize"].comments().push_back("# 1GiB = 1024MiB");
 
+  value["RAMHugePages"].comments().clear();
+  value["RAMHugePages"] = ramHugePages;
+  value["RAMHugePages"].comments().push_back("# Backs RAM with huge pages where supported (Linux only)");
+  value["RAMHugePages"].comments().push_back("# 0 = Disabled, 1 = Transparent huge pages, 2 = hugetlbfs (falls back to 1 if unavailable)");
+
+  value["RAMPoison"].comments().clear();
+  value["RAMPoison"] = ramPoison;
+  value["RAMPoison"].comments().push_back("# Fills RAM with 0xCD on startup and reset, useful to catch reads of uninitialized memory");
+  value["RAMPoison"].comments().push_back("# Makes all of RAM resident, leave disabled for faster startup and lower memory usage");
+
+  value["RAMDirtyTracking"].comments().clear();
+  value["RAMDirtyTracking"] = ramDirtyTracking;
+  value["RAMDirtyTracking"].comments().push_back("# How written RAM pages are tracked (save states, caches invalidation)");
+  value["RAMDirtyTracking"].comments().push_back("# 0 = Software, 1 = Host soft-dirty bits (Linux only, no overhead on writes, not used with hugetlbfs)");
+
   value["ElfLoader"].comments().clear();
   value["ElfLoader"] = elfLoader;
   value["ElfLoader"].comments().push_back("# Disables normal codeflow and loads an elf from ElfBinary");
@@ -299,10 +330,43 @@ void _xcpu::to_toml(toml::value &value) {
   value["InstrTestsMode"] = instrTestsMode;
   value["RunInstrTests"].comments().push_back("# Specifies the backend to test.");
   value["RunInstrTests"].comments().push_back("# 0 = Interpreter, 1 = JITx86.");
+
+  value["TimeBaseMode"].comments().clear();
+  value["TimeBaseMode"] = timeBaseMode;
+  value["TimeBaseMode"].comments().push_back("# What drives the guest timebase (and so the decrementers and device timers)");
+  value["TimeBaseMode"].comments().push_back("# host = Host clock, instructions = Instructions retired by the PPUs, guest time then scales with emulation speed");
+
+  value["InstrsPerTick"].comments().clear();
+  value["InstrsPerTick"] = instrsPerTick;
+  value["InstrsPerTick"].comments().push_back("# Instructions retired per timebase tick, used by TimeBaseMode = instructions and Deterministic");
+  value["InstrsPerTick"].comments().push_back("# 64 = 3.2GHz / 50MHz, as if every instruction took a cycle. Lower makes guest time go faster");
+
+  value["Deterministic"].comments().clear();
+  value["Deterministic"] = deterministic;
+  value["Deterministic"].comments().push_back("# Runs the PPUs in turns of a fixed instruction count and derives guest time from retired instructions");
+  value["Deterministic"].comments().push_back("# Device events are only delivered between turns. Slower, meant for benchmarking and trace diffing");
+
+  value["ReplayMode"].comments().clear();
+  value["ReplayMode"] = replayMode;
+  value["ReplayMode"].comments().push_back("# Records/replays asynchronous device events (SMC, UART input, NAND, HDD, ODD) to/from ReplayFile");
+  value["ReplayMode"].comments().push_back("# off | record | replay. Requires Deterministic, replaying a recording reproduces the run exactly");
+
+  value["ParallelSMT"].comments().clear();
+  value["ParallelSMT"] = parallelSMT;
+  value["ParallelSMT"].comments().push_back("# Runs both hardware threads of every PPU at once on two host threads (six in total) instead of interleaving them");
+  value["ParallelSMT"].comments().push_back("# Interpreter only, ignored with the JIT and with Deterministic. Best with 6+ host cores");
+
+  value["SMTHints"].comments().clear();
+  value["SMTHints"] = smtHints;
+  value["SMTHints"].comments().push_back("# Honours thread priorities (or 1,1,1 / or 2,2,2 / or 3,3,3) when slicing between the threads of a PPU");
+  value["SMTHints"].comments().push_back("# Spin-waiting threads yield to their sibling and, if they keep spinning, give their host core away. Interpreter only");
 }
 bool _xcpu::verify_toml(toml::value &value) {
   to_toml(value);
   cache_value(ramSize);
+  cache_value(ramHugePages);
+  cache_value(ramPoison);
+  cache_value(ramDirtyTracking);
   cache_value(elfLoader);
   cache_value(overrideInitSkip);
   cache_value(HW_INIT_SKIP_1);
@@ -310,8 +374,17 @@ bool _xcpu::verify_toml(toml::value &value) {
   cache_value(simulate1BL);
   cache_value(runInstrTests);
   cache_value(instrTestsMode);
+  cache_value(timeBaseMode);
+  cache_value(instrsPerTick);
+  cache_value(deterministic);
+  cache_value(replayMode);
+  cache_value(parallelSMT);
+  cache_value(smtHints);
   from_toml(value);
   verify_value(ramSize);
+  verify_value(ramHugePages);
+  verify_value(ramPoison);
+  verify_value(ramDirtyTracking);
   verify_value(elfLoader);
   verify_value(overrideInitSkip);
   verify_value(HW_INIT_SKIP_1);
@@ -319,6 +392,12 @@ bool _xcpu::verify_toml(toml::value &value) {
   verify_value(simulate1BL);
   verify_value(runInstrTests);
   verify_value(instrTestsMode);
+  verify_value(timeBaseMode);
+  verify_value(instrsPerTick);
+  verify_value(deterministic);
+  verify_value(replayMode);
+  verify_value(parallelSMT);
+  verify_value(smtHints);
   return true;
 }
 
@@ -339,6 +418,103 @@ bool _xgpu::verify_toml(toml::value &value) {
   return true;
 }
 
+void _threading::from_toml(const toml::value &value) {
+  placement = toml::find_or<std::string>(value, "Placement", placement);
+  ppu0 = toml::find_or<std::string>(value, "PPU0", ppu0);
+  ppu1 = toml::find_or<std::string>(value, "PPU1", ppu1);
+  ppu2 = toml::find_or<std::string>(value, "PPU2", ppu2);
+  gpu = toml::find_or<std::string>(value, "GPU", gpu);
+  devices = toml::find_or<std::string>(value, "Devices", devices);
+  ioWorkers = toml::find_or<u32&>(value, "IOWorkers", ioWorkers);
+  raisePriority = toml::find_or<bool>(value, "RaisePriority", raisePriority);
+}
+void _threading::to_toml(toml::value &value) {
+  value.comments().clear();
+  value.comments().push_back("# Host CPUs are numbered like the OS does (Windows: group * 64 + index)");
+  value["Placement"].comments().clear();
+  value["Placement"] = placement;
+  value["Placement"].comments().push_back("# How emulator threads are placed on the host CPUs");
+  value["Placement"].comments().push_back("# auto - Each PPU gets a host core (and its SMT siblings), GPU threads another, devices share the rest");
+  value["Placement"].comments().push_back("# off - Leaves it to the OS");
+  value["PPU0"].comments().clear();
+  value["PPU0"] = ppu0;
+  value["PPU0"].comments().push_back("# Host CPU lists (ex, \"0-1,8\") overriding the automatic placement. Empty means automatic");
+  value["PPU1"] = ppu1;
+  value["PPU2"] = ppu2;
+  value["GPU"].comments().clear();
+  value["GPU"] = gpu;
+  value["GPU"].comments().push_back("# Renderer and command processor");
+  value["Devices"].comments().clear();
+  value["Devices"] = devices;
+  value["Devices"].comments().push_back("# Device workers (SMC, UART, I/O workers)");
+  value["IOWorkers"].comments().clear();
+  value["IOWorkers"] = ioWorkers;
+  value["IOWorkers"].comments().push_back("# Host threads running the HDD, ODD and SFCX transfers, concurrent transfers overlap up to this (1-16)");
+  value["RaisePriority"].comments().clear();
+  value["RaisePriority"] = raisePriority;
+  value["RaisePriority"].comments().push_back("# Raises the host priority of the PPU and GPU threads");
+}
+bool _threading::verify_toml(toml::value &value) {
+  to_toml(value);
+  cache_value(placement);
+  cache_value(ppu0);
+  cache_value(ppu1);
+  cache_value(ppu2);
+  cache_value(gpu);
+  cache_value(devices);
+  cache_value(ioWorkers);
+  cache_value(raisePriority);
+  from_toml(value);
+  verify_value(placement);
+  verify_value(ppu0);
+  verify_value(ppu1);
+  verify_value(ppu2);
+  verify_value(gpu);
+  verify_value(devices);
+  verify_value(ioWorkers);
+  verify_value(raisePriority);
+  return true;
+}
+
+void _fastBoot::from_toml(const toml::value &value) {
+  enable = toml::find_or<bool>(value, "Enable", enable);
+  postCode = toml::find_or<u32&>(value, "PostCode", postCode);
+  address = toml::find_or<u64&>(value, "Address", address);
+  directory = toml::find_or<std::string>(value, "Directory", directory);
+}
+void _fastBoot::to_toml(toml::value &value) {
+  value.comments().clear();
+  value.comments().push_back("# Checkpoints are tied to the NAND, fuses, 1BL and boot related settings, changing any of them boots normally again");
+  value.comments().push_back("# The HDD and ODD images aren't part of a checkpoint");
+  value["Enable"].comments().clear();
+  value["Enable"] = enable;
+  value["Enable"].comments().push_back("# Saves a checkpoint once boot reaches PostCode or Address, later launches resume from it");
+  value["PostCode"].comments().clear();
+  value["PostCode"] = postCode;
+  value["PostCode"].as_integer_fmt().fmt = toml::integer_format::hex;
+  value["PostCode"].comments().push_back("# POST code that triggers the checkpoint, 0 = Disabled. 0x79 = LOAD_XAM, the last kernel init step");
+  value["Address"].comments().clear();
+  value["Address"] = address;
+  value["Address"].as_integer_fmt().fmt = toml::integer_format::hex;
+  value["Address"].comments().push_back("# Guest address that triggers the checkpoint when executed, 0 = Disabled");
+  value["Directory"].comments().clear();
+  value["Directory"] = directory;
+  value["Directory"].comments().push_back("# Where checkpoints are kept, relative to the root directory");
+}
+bool _fastBoot::verify_toml(toml::value &value) {
+  to_toml(value);
+  cache_value(enable);
+  cache_value(postCode);
+  cache_value(address);
+  cache_value(directory);
+  from_toml(value);
+  verify_value(enable);
+  verify_value(postCode);
+  verify_value(address);
+  verify_value(directory);
+  return true;
+}
+
 void _filepaths::from_toml(const toml::value &value) {
   fuses = toml::find_or<std::string>(value, "Fuses", fuses);
   oneBl = toml::find_or<std::string>(value, "OneBL", oneBl);
@@ -349,6 +525,8 @@ void _filepaths::from_toml(const toml::value &value) {
   elfBinary = toml::find_or<std::string>(value, "ElfBinary", elfBinary);
   instrTestsPath = toml::find_or<std::string>(value, "InstrTestsPath", instrTestsPath);
   instrTestsBinPath = toml::find_or<std::string>(value, "InstrTestsBinPath", instrTestsBinPath);
+  hleSignatures = toml::find_or<std::string>(value, "HLESignatures", hleSignatures);
+  replayFile = toml::find_or<std::string>(value, "ReplayFile", replayFile);
 }
 void _filepaths::to_toml(toml::value &value) {
   value.comments().clear();
@@ -359,6 +537,8 @@ void _filepaths::to_toml(toml::value &value) {
   value.comments().push_back("# HDDImage is the Hard Drive Disc Image, takes an Xbox360 Formatted (FATX) HDD image for the Xbox System/Linux storage purposes");
   value.comments().push_back("# InstrTestsPath is the base path for instruction test files (.s) for use in the test runner");
   value.comments().push_back("# InstrTestsBinPath is the path for the generated binary instruction test files (.bin)");
+  value.comments().push_back("# HLESignatures is the signature list for HLEMemRoutines, see XenonHLE.h for the format");
+  value.comments().push_back("# ReplayFile is where device events are recorded to/replayed from, see XCPU ReplayMode");
   value["Fuses"] = fuses;
   value["OneBL"] = oneBl;
   value["Nand"] = nand;
@@ -368,6 +548,8 @@ void _filepaths::to_toml(toml::value &value) {
   value["ElfBinary"] = elfBinary;
   value["InstrTestsPath"] = instrTestsPath;
   value["InstrTestsBinPath"] = instrTestsBinPath;
+  value["HLESignatures"] = hleSignatures;
+  value["ReplayFile"] = replayFile;
 }
 bool _filepaths::verify_toml(toml::value &value) {
   to_toml(value);
@@ -380,6 +562,8 @@ bool _filepaths::verify_toml(toml::value &value) {
   cache_value(elfBinary);
   cache_value(instrTestsPath);
   cache_value(instrTestsBinPath);
+  cache_value(hleSignatures);
+  cache_value(replayFile);
   from_toml(value);
   verify_value(fuses);
   verify_value(oneBl);
@@ -390,6 +574,8 @@ bool _filepaths::verify_toml(toml::value &value) {
   verify_value(elfBinary);
   verify_value(instrTestsPath);
   verify_value(instrTestsBinPath);
+  verify_value(hleSignatures);
+  verify_value(replayFile);
   return true;
 }
 
@@ -448,6 +634,7 @@ void _highlyExperimental::from_toml(const toml::value &value) {
   tmpConsoleRevison = toml::find_or<s32&>(value, "ConsoleRevison", tmpConsoleRevison);
   consoleRevison = static_cast<eConsoleRevision>(tmpConsoleRevison);
   cpuExecutor = toml::find_or<std::string>(value, "CPUExecutor", cpuExecutor);
+  hleMemRoutines = toml::find_or<bool>(value, "HLEMemRoutines", hleMemRoutines);
 }
 void _highlyExperimental::to_toml(toml::value &value) {
   value.comments().clear();
@@ -464,14 +651,19 @@ void _highlyExperimental::to_toml(toml::value &value) {
   value["CPUExecutor"].comments().push_back("# JIT - Just In Time compilation, runs opcodes in 'blocks'");
   value["CPUExecutor"].comments().push_back("# Hybrid - JIT with Cached Interpreter fallback, uses faster block system with Interpreter opcodes");
   value["CPUExecutor"].comments().push_back("# [WARN] This is unfinished, you *will* break the emulator changing this");
+  value["HLEMemRoutines"].comments().clear();
+  value["HLEMemRoutines"] = hleMemRoutines;
+  value["HLEMemRoutines"].comments().push_back("# Runs guest memcpy/memmove/memset routines natively. They're found using the signatures in HLESignatures");
 }
 bool _highlyExperimental::verify_toml(toml::value &value) {
   to_toml(value);
   cache_value(consoleRevison);
   cache_value(cpuExecutor);
+  cache_value(hleMemRoutines);
   from_toml(value);
   verify_value(consoleRevison);
   verify_value(cpuExecutor);
+  verify_value(hleMemRoutines);
   return true;
 }
 
@@ -490,6 +682,8 @@ bool verifyConfig(const fs::path &path, toml::value &data) {
   verify_section(smc, SMC);
   verify_section(xcpu, XCPU);
   verify_section(xgpu, XGPU);
+  verify_section(threading, Threading);
+  verify_section(fastBoot, FastBoot);
   verify_section(filepaths, Paths);
   verify_section(debug, Debug);
   verify_section(log, Log);
@@ -519,6 +713,8 @@ void loadConfig(const fs::path &path) {
   read_section(smc, SMC);
   read_section(xcpu, XCPU);
   read_section(xgpu, XGPU);
+  read_section(threading, Threading);
+  read_section(fastBoot, FastBoot);
   read_section(filepaths, Paths);
   read_section(debug, Debug);
   read_section(log, Log);
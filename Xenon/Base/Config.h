@@ -104,6 +104,8 @@ inline struct _debug {
   bool softHaltOnAssertions = true;
   // Automatically continue on guest assertion
   bool autoContinueOnGuestAssertion = false;
+  // Runs HLE'd memory routines through the interpreter and checks the results against the native implementation
+  bool hleVerify = false;
 #ifdef DEBUG_BUILD
   // Create a trace file | NOTE: This can create up to a 20GB file
   bool createTraceFile = false;
@@ -158,6 +160,12 @@ inline struct _smc {
 inline struct _xcpu {
   // CPU RAM Size
   std::string ramSize = "512MiB";
+  // RAM huge pages mode. 0 = Disabled, 1 = Transparent huge pages (madvise), 2 = hugetlbfs
+  u8 ramHugePages = 1;
+  // Fills RAM with a 0xCD poison pattern on startup/reset. Touches every page, so the whole RAM becomes resident
+  bool ramPoison = false;
+  // RAM dirty page tracking backend. 0 = Software (MMU/DMA write paths), 1 = Host soft-dirty bits (Linux only)
+  u8 ramDirtyTracking = 0;
   // Loads an elf from the ElfBinary path
   bool elfLoader = false;
   // CB/SB HW_INIT_SKIP
@@ -170,6 +178,18 @@ inline struct _xcpu {
   bool runInstrTests = false;
   // Instruction tests mode
   u8 instrTestsMode = 0; // See ePPUTestingMode
+  // Guest timebase source. "host" follows the host clock, "instructions" follows the instructions retired by the PPUs
+  std::string timeBaseMode = "host";
+  // Instructions retired per timebase tick when the timebase follows instructions
+  u32 instrsPerTick = 64;
+  // Deterministic execution. PPUs run in turns, guest time follows retired instructions
+  bool deterministic = false;
+  // Asynchronous device events record/replay, needs deterministic execution. "off", "record" or "replay"
+  std::string replayMode = "off";
+  // Runs both SMT threads of every PPU at once, each on a host thread of its own. Interpreter only
+  bool parallelSMT = false;
+  // Thread priority nops and spin-wait hints shorten slices, yield to the sibling thread and back off the host thread
+  bool smtHints = true;
   // TOML Conversion
   void to_toml(toml::value &value);
   void from_toml(const toml::value &value);
@@ -189,6 +209,48 @@ inline struct _xgpu {
   bool verify_toml(toml::value &value);
 } xgpu;
 
+//
+// Threading
+//
+inline struct _threading {
+  // Host thread placement. "auto" places the threads using the host topology, "off" leaves it to the OS
+  std::string placement = "auto";
+  // Host CPU lists ("0-1,8") overriding the automatic placement of each kind of thread. Empty means automatic
+  std::string ppu0 = "";
+  std::string ppu1 = "";
+  std::string ppu2 = "";
+  std::string gpu = "";
+  std::string devices = "";
+  // Host threads running the storage devices (HDD, ODD, SFCX) transfers
+  u32 ioWorkers = 2;
+  // Raises the priority of the PPU and GPU threads
+  bool raisePriority = true;
+
+  // TOML Conversion
+  void to_toml(toml::value &value);
+  void from_toml(const toml::value &value);
+  bool verify_toml(toml::value &value);
+} threading;
+
+//
+// Fast boot
+//
+inline struct _fastBoot {
+  // Saves a checkpoint once boot reaches the trigger below, later launches resume from it
+  bool enable = false;
+  // POST code that triggers the checkpoint. 0 = Disabled
+  u32 postCode = 0x79; // LOAD_XAM, the last kernel init step
+  // Guest effective address that triggers the checkpoint once executed. 0 = Disabled
+  u64 address = 0;
+  // Where checkpoints are kept, relative to the root directory
+  std::string directory = "fastboot";
+
+  // TOML Conversion
+  void to_toml(toml::value &value);
+  void from_toml(const toml::value &value);
+  bool verify_toml(toml::value &value);
+} fastBoot;
+
 //
 // Filepaths
 //
@@ -211,6 +273,10 @@ inline struct _filepaths {
   std::string instrTestsPath = "tests";
   // Instruction tests bin path.
   std::string instrTestsBinPath = "bin";
+  // HLE routine signatures path.
+  std::string hleSignatures = "hle_signatures.txt";
+  // Device events replay file path.
+  std::string replayFile = "replay.xrp";
 
   // Corrects the paths on first time creation
   void correct(const fs::path &basePath) {
@@ -232,6 +298,10 @@ inline struct _filepaths {
     instrTestsPath = instrTestsBasePath.string();
     auto instrTestsBinaryPath = basePath / instrTestsBinPath;
     instrTestsBinPath = instrTestsBinaryPath.string();
+    auto hleSignaturesPath = basePath / hleSignatures;
+    hleSignatures = hleSignaturesPath.string();
+    auto replayFilePath = basePath / replayFile;
+    replayFile = replayFilePath.string();
   }
 
   // TOML Conversion
@@ -285,6 +355,8 @@ inline struct _highlyExperimental {
   // Hybrid - JIT with Cached Interpreter fallback
   // JIT - Just In Time
   std::string cpuExecutor = "Interpreted";
+  // Replaces guest memcpy/memmove/memset routines found by signature with native implementations
+  bool hleMemRoutines = false;
 
   // TOML Conversion
   void to_toml(toml::value &value);
@@ -6,6 +6,7 @@
 
 #include "Types.h"
 
+#include <cstring>
 #include <string_view>
 
 namespace Base {
@@ -46,6 +47,22 @@ inline constexpr u32 JoaatDataHash(const char *data, size_t size, const u32 init
   return key;
 }
 
+// 64-bit hash of a block, a word at a time. Not cryptographic, meant to fingerprint and compare data quickly.
+inline u64 DataHash64(const void *data, size_t size, u64 seed = 0) {
+  const u8 *bytes = static_cast<const u8*>(data);
+  u64 hash = (seed ^ size) * 0x100000001B3ULL ^ 0xCBF29CE484222325ULL;
+  size_t i = 0;
+  for (; i + sizeof(u64) <= size; i += sizeof(u64)) {
+    u64 word = 0;
+    std::memcpy(&word, bytes + i, sizeof(word));
+    hash = (hash ^ word) * 0x100000001B3ULL;
+    hash ^= hash >> 29;
+  }
+  for (; i != size; ++i)
+    hash = (hash ^ bytes[i]) * 0x100000001B3ULL;
+  return hash ^ (hash >> 32);
+}
+
 } // namespace Base
 
 inline consteval u32 operator ""_j(const char *data, size_t size) {
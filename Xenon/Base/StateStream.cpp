@@ -0,0 +1,148 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "StateStream.h"
+
+#include <algorithm>
+
+#include "Compression.h"
+
+namespace Base {
+
+// Compressed blocks are split in chunks of this size.
+static constexpr size_t compressedChunkSize = 1024 * 1024;
+
+// Chunk encodings.
+enum eChunkEncoding : u8 {
+  chunkRaw,
+  chunkCompressed
+};
+
+void StateWriter::WriteBytes(const void *source, size_t size) {
+  if (!size)
+    return;
+  const size_t offset = data.size();
+  data.resize(offset + size);
+  std::memcpy(data.data() + offset, source, size);
+}
+
+void StateWriter::WriteString(const std::string &value) {
+  Write<u32>(static_cast<u32>(value.size()));
+  WriteBytes(value.data(), value.size());
+}
+
+void StateWriter::WriteCompressed(const void *source, size_t size) {
+  Write<u64>(size);
+  const u8 *bytes = static_cast<const u8*>(source);
+  Compression::Compressor compressor{};
+  std::vector<u8> chunk(Compression::Bound(compressedChunkSize));
+  for (size_t offset = 0; offset < size; offset += compressedChunkSize) {
+    const size_t chunkSize = std::min(compressedChunkSize, size - offset);
+    const size_t compressedSize = compressor.Compress(bytes + offset, chunkSize, chunk.data(), chunk.size());
+    if (compressedSize) {
+      Write<u8>(chunkCompressed);
+      Write<u32>(static_cast<u32>(compressedSize));
+      WriteBytes(chunk.data(), compressedSize);
+    } else {
+      Write<u8>(chunkRaw);
+      Write<u32>(static_cast<u32>(chunkSize));
+      WriteBytes(bytes + offset, chunkSize);
+    }
+  }
+}
+
+void StateWriter::BeginSection(u32 tag) {
+  Write<u32>(tag);
+  openSections.push_back(data.size());
+  // Patched in EndSection
+  Write<u64>(0);
+}
+
+void StateWriter::EndSection() {
+  if (openSections.empty())
+    return;
+  const size_t sizeOffset = openSections.back();
+  openSections.pop_back();
+  const u64 sectionSize = data.size() - sizeOffset - sizeof(u64);
+  std::memcpy(data.data() + sizeOffset, &sectionSize, sizeof(sectionSize));
+}
+
+void StateReader::ReadBytes(void *destination, size_t readSize) {
+  if (!readSize)
+    return;
+  if (failed || readSize > Remaining()) {
+    failed = true;
+    std::memset(destination, 0, readSize);
+    return;
+  }
+  std::memcpy(destination, data + position, readSize);
+  position += readSize;
+}
+
+void StateReader::ReadString(std::string &value) {
+  const u32 length = Read<u32>();
+  if (length > Remaining()) {
+    failed = true;
+    value.clear();
+    return;
+  }
+  value.assign(reinterpret_cast<const char*>(data + position), length);
+  position += length;
+}
+
+void StateReader::ReadCompressed(void *destination, size_t readSize) {
+  u8 *bytes = static_cast<u8*>(destination);
+  if (Read<u64>() != readSize) {
+    failed = true;
+    std::memset(destination, 0, readSize);
+    return;
+  }
+  Compression::Decompressor decompressor{};
+  for (size_t offset = 0; offset < readSize && !failed; offset += compressedChunkSize) {
+    const size_t chunkSize = std::min(compressedChunkSize, readSize - offset);
+    const u8 encoding = Read<u8>();
+    const u32 storedSize = Read<u32>();
+    const u8 *stored = Skip(storedSize);
+    if (!stored)
+      break;
+    if (encoding == chunkRaw && storedSize == chunkSize)
+      std::memcpy(bytes + offset, stored, chunkSize);
+    else if (encoding != chunkCompressed || !decompressor.Decompress(stored, storedSize, bytes + offset, chunkSize))
+      failed = true;
+  }
+  if (failed)
+    std::memset(destination, 0, readSize);
+}
+
+const u8 *StateReader::Skip(size_t skipSize) {
+  if (failed || skipSize > Remaining()) {
+    failed = true;
+    return nullptr;
+  }
+  const u8 *skipped = data + position;
+  position += skipSize;
+  return skipped;
+}
+
+bool StateReader::GetSection(u32 tag, StateReader &section) const {
+  size_t offset = position;
+  constexpr size_t headerSize = sizeof(u32) + sizeof(u64);
+  while (size - offset >= headerSize) {
+    u32 sectionTag = 0;
+    u64 sectionSize = 0;
+    std::memcpy(&sectionTag, data + offset, sizeof(sectionTag));
+    std::memcpy(&sectionSize, data + offset + sizeof(u32), sizeof(sectionSize));
+    offset += headerSize;
+    if (sectionSize > size - offset)
+      return false;
+    if (sectionTag == tag) {
+      section = StateReader(data + offset, sectionSize);
+      return true;
+    }
+    offset += sectionSize;
+  }
+  return false;
+}
+
+} // namespace Base
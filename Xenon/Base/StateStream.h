@@ -0,0 +1,131 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Types.h"
+
+// Save state streams.
+// Components serialize themselves field by field into a StateWriter and read the fields back, in the same order,
+// from a StateReader. Data is stored in host byte order, save states aren't meant to move between hosts of different
+// endianness. Sections are tagged blocks ([u32 tag][u64 size][payload]) that can be looked up by tag, so a missing or
+// unknown section doesn't throw off the rest.
+namespace Base {
+
+class StateWriter {
+public:
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void Write(const T &value) {
+    WriteBytes(&value, sizeof(T));
+  }
+  void WriteBytes(const void *source, size_t size);
+  void WriteString(const std::string &value);
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void WriteVector(const std::vector<T> &values) {
+    Write<u64>(values.size());
+    WriteBytes(values.data(), values.size() * sizeof(T));
+  }
+  // Writes a big block, compressed in chunks when possible.
+  void WriteCompressed(const void *source, size_t size);
+
+  // Opens a section, everything written until the matching EndSection goes in it. Sections can be nested.
+  void BeginSection(u32 tag);
+  void EndSection();
+
+  std::vector<u8> &GetData() { return data; }
+  size_t Size() const { return data.size(); }
+private:
+  std::vector<u8> data = {};
+  // Offsets of the size fields of the open sections.
+  std::vector<size_t> openSections = {};
+};
+
+// Reads are bounds checked. Running past the end (or any other error) sets a sticky failure flag and zero fills
+// whatever was being read, so loaders can read everything and check Good() once at the end.
+class StateReader {
+public:
+  StateReader() = default;
+  StateReader(const u8 *buffer, size_t bufferSize) :
+    data(buffer), size(bufferSize) {}
+
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void Read(T &value) {
+    ReadBytes(&value, sizeof(T));
+  }
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  T Read() {
+    T value{};
+    Read(value);
+    return value;
+  }
+  void ReadBytes(void *destination, size_t readSize);
+  void ReadString(std::string &value);
+  template <typename T>
+    requires std::is_trivially_copyable_v<T>
+  void ReadVector(std::vector<T> &values) {
+    const u64 count = Read<u64>();
+    if (count > Remaining() / sizeof(T)) {
+      Fail();
+      values.clear();
+      return;
+    }
+    values.resize(count);
+    ReadBytes(values.data(), count * sizeof(T));
+  }
+  // Reads a block written by WriteCompressed, which must have been exactly readSize bytes.
+  void ReadCompressed(void *destination, size_t readSize);
+  // Returns a pointer to the next size bytes and skips them, nullptr if there aren't that many.
+  const u8 *Skip(size_t skipSize);
+
+  // Looks up a section among the ones starting at the current position, without moving. Returns false if it isn't
+  // there.
+  bool GetSection(u32 tag, StateReader &section) const;
+
+  size_t Remaining() const { return size - position; }
+  bool Good() const { return !failed; }
+  void Fail() { failed = true; }
+private:
+  const u8 *data = nullptr;
+  size_t size = 0;
+  size_t position = 0;
+  bool failed = false;
+};
+
+// A copy of an object's state, taken through its SaveState and put back through its LoadState. Soft resets use it to
+// return components to their power-on state in place.
+class StateSnapshot {
+public:
+  template <typename T>
+  void Capture(T &object) {
+    StateWriter writer{};
+    object.SaveState(writer);
+    data = std::move(writer.GetData());
+  }
+  // Returns false if nothing was captured, or it didn't load back.
+  template <typename T>
+  bool Restore(T &object) const {
+    if (data.empty())
+      return false;
+    StateReader reader(data.data(), data.size());
+    object.LoadState(reader);
+    return reader.Good();
+  }
+  // Reads the snapshot back by hand, for loads that differ from LoadState.
+  StateReader Reader() const { return StateReader(data.data(), data.size()); }
+  bool Empty() const { return data.empty(); }
+private:
+  std::vector<u8> data = {};
+};
+
+} // namespace Base
@@ -0,0 +1,112 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Global.h"
+#include "Logging/Log.h"
+#include "Thread.h"
+
+namespace Base {
+
+TaskGraph::TaskGraph(const std::string &graphName) :
+  name(graphName)
+{}
+
+TaskGraph::TaskId TaskGraph::Add(const std::string &taskName, std::function<void()> function,
+  const std::vector<TaskId> &dependencies, bool pinnedToCaller) {
+  const TaskId id = static_cast<TaskId>(tasks.size());
+  sTask &task = tasks.emplace_back();
+  task.name = taskName;
+  task.function = std::move(function);
+  task.pinned = pinnedToCaller;
+  for (const TaskId dependency : dependencies) {
+    if (dependency < id)
+      task.dependencies.push_back(dependency);
+    else
+      LOG_ERROR(Base, "{}: Task '{}' depends on a task added after it, ignoring it.", name, taskName);
+  }
+  return id;
+}
+
+void TaskGraph::Run() {
+  if (tasks.empty())
+    return;
+  const auto startTime = std::chrono::steady_clock::now();
+
+  // Dependencies left for every task, and who waits on it
+  std::vector<u32> pending(tasks.size());
+  std::vector<std::vector<TaskId>> dependents(tasks.size());
+  // Ready tasks, pinned ones go to the caller only
+  std::deque<TaskId> ready{};
+  std::deque<TaskId> readyPinned{};
+  for (TaskId id = 0; id != tasks.size(); id++) {
+    pending[id] = static_cast<u32>(tasks[id].dependencies.size());
+    for (const TaskId dependency : tasks[id].dependencies)
+      dependents[dependency].push_back(id);
+    if (!pending[id])
+      (tasks[id].pinned ? readyPinned : ready).push_back(id);
+  }
+
+  std::mutex mutex;
+  std::condition_variable condition;
+  size_t finished = 0;
+  auto worker = [&](bool caller) {
+    std::unique_lock lock(mutex);
+    for (;;) {
+      condition.wait(lock, [&] {
+        return finished == tasks.size() || !ready.empty() || (caller && !readyPinned.empty());
+      });
+      if (finished == tasks.size())
+        return;
+      std::deque<TaskId> &queue = caller && !readyPinned.empty() ? readyPinned : ready;
+      const TaskId id = queue.front();
+      queue.pop_front();
+      lock.unlock();
+
+      sTask &task = tasks[id];
+      const auto taskStart = std::chrono::steady_clock::now();
+      task.function();
+      const auto taskEnd = std::chrono::steady_clock::now();
+      task.start = taskStart - startTime;
+      task.duration = taskEnd - taskStart;
+
+      lock.lock();
+      finished++;
+      for (const TaskId dependent : dependents[id]) {
+        if (!--pending[dependent])
+          (tasks[dependent].pinned ? readyPinned : ready).push_back(dependent);
+      }
+      condition.notify_all();
+    }
+  };
+
+  // The caller works too, so one thread less
+  const size_t workerCount = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 2u), tasks.size()) - 1;
+  std::vector<std::thread> workers{};
+  for (size_t i = 0; i != workerCount; i++) {
+    workers.emplace_back([&, i] {
+      SetCurrentThreadName(FMT("[Xe] {} {}", name, i));
+      worker(false);
+    });
+  }
+  worker(true);
+  for (std::thread &thread : workers)
+    thread.join();
+
+  using Milliseconds = std::chrono::duration<f64, std::milli>;
+  for (const sTask &task : tasks) {
+    LOG_INFO(Base, "{}: {} took {:.2f} ms (started at +{:.2f} ms).", name, task.name,
+      Milliseconds(task.duration).count(), Milliseconds(task.start).count());
+  }
+  LOG_INFO(Base, "{}: Done in {:.2f} ms.", name, Milliseconds(std::chrono::steady_clock::now() - startTime).count());
+}
+
+} // namespace Base
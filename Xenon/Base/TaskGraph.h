@@ -0,0 +1,48 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Types.h"
+
+// Task graph.
+// Runs a set of tasks that depend on each other: every task starts as soon as the ones it depends on are done, so
+// the independent ones run in parallel. Tasks can only depend on tasks added before them, so there are no cycles.
+// Used to bring the emulator up, it reports when every task started and how long it took.
+namespace Base {
+
+class TaskGraph {
+public:
+  using TaskId = u32;
+
+  TaskGraph(const std::string &graphName);
+
+  // Adds a task. Tasks pinned to the calling thread run on the thread calling Run, for things that must stay on
+  // it (window creation, for one).
+  TaskId Add(const std::string &taskName, std::function<void()> function,
+    const std::vector<TaskId> &dependencies = {}, bool pinnedToCaller = false);
+
+  // Runs every task and waits for all of them, then logs the timings.
+  void Run();
+private:
+  struct sTask {
+    std::string name;
+    std::function<void()> function;
+    std::vector<TaskId> dependencies;
+    bool pinned = false;
+    // Since Run was called
+    std::chrono::steady_clock::duration start{};
+    std::chrono::steady_clock::duration duration{};
+  };
+  // Name used in the log
+  std::string name;
+  std::vector<sTask> tasks;
+};
+
+} // namespace Base
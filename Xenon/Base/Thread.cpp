@@ -195,6 +195,49 @@ void SetThreadName(void *thread, const std::string_view &name) {
 
 #endif
 
+#if defined(_WIN32)
+
+bool SetCurrentThreadAffinity(const std::vector<u32> &cpus) {
+  if (cpus.empty())
+    return false;
+  // A thread lives in a single processor group, CPUs are numbered group * 64 + index
+  GROUP_AFFINITY affinity = {};
+  affinity.Group = static_cast<WORD>(cpus.front() / 64);
+  for (const u32 cpu : cpus) {
+    if (cpu / 64 == affinity.Group)
+      affinity.Mask |= KAFFINITY{ 1 } << (cpu % 64);
+  }
+  return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr);
+}
+
+#elif defined(__APPLE__)
+
+bool SetCurrentThreadAffinity(const std::vector<u32> &cpus) {
+  // Only affinity tags exist, and they're merely a hint
+  return false;
+}
+
+#else
+
+bool SetCurrentThreadAffinity(const std::vector<u32> &cpus) {
+  if (cpus.empty())
+    return false;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const u32 cpu : cpus) {
+    if (cpu < CPU_SETSIZE)
+      CPU_SET(cpu, &set);
+  }
+  if (int e = pthread_setaffinity_np(pthread_self(), sizeof(set), &set)) {
+    errno = e;
+    LOG_ERROR(Base, "Failed to set thread affinity: {}", GetLastErrorMsg());
+    return false;
+  }
+  return true;
+}
+
+#endif
+
 AccurateTimer::AccurateTimer(std::chrono::nanoseconds target_interval) :
   target_interval(target_interval)
 {}
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <chrono>
+#include <vector>
 
 namespace Base {
 
@@ -22,6 +23,10 @@ void SetCurrentThreadPriority(ThreadPriority new_priority);
 
 void SetCurrentThreadName(const std::string_view &name);
 
+// Restricts the current thread to the given host logical CPUs (see Base::Topology for the numbering).
+// Returns false if the host refused it or doesn't support it (macOS).
+bool SetCurrentThreadAffinity(const std::vector<u32> &cpus);
+
 void SetThreadName(void *thread, const std::string_view &name);
 
 class AccurateTimer {
@@ -0,0 +1,425 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "Topology.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <map>
+#include <set>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#elif defined(__linux__)
+#include <filesystem>
+#include <fstream>
+#include <sched.h>
+#endif
+
+#include "Config.h"
+#include "StringUtil.h"
+#include "Thread.h"
+#include "Logging/Log.h"
+
+namespace Base::Topology {
+
+// Detected host layout.
+static sHostTopology topology = {};
+// CPUs of each role, empty if the OS decides.
+static std::array<std::vector<u32>, static_cast<size_t>(eThreadRole::Count)> placements = {};
+static bool initialized = false;
+#ifdef __APPLE__
+// Only affinity tags exist, and they're merely a hint
+static constexpr bool hostSupportsAffinity = false;
+#else
+static constexpr bool hostSupportsAffinity = true;
+#endif
+
+// A logical CPU as reported by the host, before grouping it into cores.
+struct sDetectedCPU {
+  sLogicalCPU cpu = {};
+  // Unique per physical core.
+  u64 coreKey = 0;
+};
+
+#if defined(_WIN32)
+
+// Calls func for every CPU set in a group affinity.
+template <typename T>
+static void ForEachCPU(const GROUP_AFFINITY &affinity, T func) {
+  for (u32 bit = 0; bit < 64; bit++) {
+    if (affinity.Mask & (KAFFINITY{ 1 } << bit))
+      func(static_cast<u32>(affinity.Group) * 64 + bit);
+  }
+}
+
+static std::vector<sDetectedCPU> DetectCPUs() {
+  DWORD length = 0;
+  GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+  std::vector<u8> buffer(length);
+  if (!length || !GetLogicalProcessorInformationEx(RelationAll,
+    reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length))
+    return {};
+
+  std::map<u32, sDetectedCPU> cpus = {};
+  u32 coreIndex = 0, packageIndex = 0, llcLevel = 0;
+  for (DWORD offset = 0; offset < length;) {
+    const auto *info = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(buffer.data() + offset);
+    switch (info->Relationship) {
+    case RelationProcessorCore:
+      for (WORD group = 0; group < info->Processor.GroupCount; group++) {
+        ForEachCPU(info->Processor.GroupMask[group], [&](u32 id) {
+          sDetectedCPU &cpu = cpus[id];
+          cpu.cpu.id = id;
+          cpu.coreKey = coreIndex;
+          cpu.cpu.perfClass = info->Processor.EfficiencyClass;
+        });
+      }
+      coreIndex++;
+      break;
+    case RelationProcessorPackage:
+      for (WORD group = 0; group < info->Processor.GroupCount; group++)
+        ForEachCPU(info->Processor.GroupMask[group], [&](u32 id) { cpus[id].cpu.package = packageIndex; });
+      packageIndex++;
+      break;
+    case RelationNumaNode:
+      ForEachCPU(info->NumaNode.GroupMask, [&](u32 id) { cpus[id].cpu.node = info->NumaNode.NodeNumber; });
+      break;
+    case RelationCache: {
+      const CACHE_RELATIONSHIP &cache = info->Cache;
+      if (cache.Type == CacheInstruction || cache.Level < llcLevel)
+        break;
+      llcLevel = cache.Level;
+      u32 first = UINT32_MAX;
+      ForEachCPU(cache.GroupMask, [&](u32 id) { first = std::min(first, id); });
+      ForEachCPU(cache.GroupMask, [&](u32 id) { cpus[id].cpu.llc = first; });
+      topology.llcSizeKiB = std::max<u32>(topology.llcSizeKiB, cache.CacheSize / 1024);
+    } break;
+    default:
+      break;
+    }
+    offset += info->Size;
+  }
+
+  std::vector<sDetectedCPU> detected = {};
+  for (auto &[id, cpu] : cpus) {
+    cpu.cpu.id = id;
+    detected.push_back(cpu);
+  }
+  return detected;
+}
+
+#elif defined(__linux__)
+
+static std::string ReadSysFile(const std::string &path) {
+  std::ifstream file(path);
+  std::string line = {};
+  std::getline(file, line);
+  return line;
+}
+
+static u32 ReadSysU32(const std::string &path, u32 fallback) {
+  const std::string value = ReadSysFile(path);
+  // Some fields are -1 when unknown
+  if (value.empty() || value.front() == '-')
+    return fallback;
+  return static_cast<u32>(std::strtoul(value.c_str(), nullptr, 10));
+}
+
+static std::vector<sDetectedCPU> DetectCPUs() {
+  namespace fs = std::filesystem;
+  // Only what we're allowed to run on (taskset, cgroups)
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+    return {};
+
+  // NUMA nodes list their CPUs
+  std::map<u32, u32> cpuNodes = {};
+  std::error_code error;
+  for (const auto &entry : fs::directory_iterator("/sys/devices/system/node", error)) {
+    const std::string name = entry.path().filename().string();
+    if (name.size() <= 4 || name.compare(0, 4, "node") != 0 || !std::isdigit(static_cast<u8>(name[4])))
+      continue;
+    std::vector<u32> nodeCPUs = {};
+    if (ParseCPUList(ReadSysFile((entry.path() / "cpulist").string()), nodeCPUs)) {
+      for (const u32 cpu : nodeCPUs)
+        cpuNodes[cpu] = static_cast<u32>(std::strtoul(name.c_str() + 4, nullptr, 10));
+    }
+  }
+
+  // Intel hybrid parts split their cores in two PMUs
+  std::vector<u32> atomCPUs = {};
+  const bool intelHybrid = ParseCPUList(ReadSysFile("/sys/devices/cpu_atom/cpus"), atomCPUs) && !atomCPUs.empty();
+
+  std::vector<sDetectedCPU> detected = {};
+  for (u32 id = 0; id < CPU_SETSIZE; id++) {
+    if (!CPU_ISSET(id, &allowed))
+      continue;
+    const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(id) + "/";
+    sDetectedCPU cpu = {};
+    cpu.cpu.id = id;
+    cpu.cpu.package = ReadSysU32(base + "topology/physical_package_id", 0);
+    cpu.coreKey = (static_cast<u64>(cpu.cpu.package) << 32) | ReadSysU32(base + "topology/core_id", id);
+    cpu.cpu.node = cpuNodes.contains(id) ? cpuNodes[id] : 0;
+    cpu.cpu.llc = id;
+
+    // Last level cache, the highest level data/unified one
+    u32 llcLevel = 0;
+    for (u32 index = 0;; index++) {
+      const std::string cache = base + "cache/index" + std::to_string(index) + "/";
+      if (!fs::exists(cache, error))
+        break;
+      const u32 level = ReadSysU32(cache + "level", 0);
+      if (ReadSysFile(cache + "type") == "Instruction" || level < llcLevel)
+        continue;
+      llcLevel = level;
+      std::vector<u32> shared = {};
+      if (ParseCPUList(ReadSysFile(cache + "shared_cpu_list"), shared) && !shared.empty())
+        cpu.cpu.llc = *std::min_element(shared.begin(), shared.end());
+      // Given as "32768K"
+      topology.llcSizeKiB = std::max(topology.llcSizeKiB, ReadSysU32(cache + "size", 0));
+    }
+
+    if (intelHybrid)
+      cpu.cpu.perfClass = std::find(atomCPUs.begin(), atomCPUs.end(), id) != atomCPUs.end() ? 0 : 1;
+    else
+      cpu.cpu.perfClass = ReadSysU32(base + "cpu_capacity", 0);
+    detected.push_back(cpu);
+  }
+  return detected;
+}
+
+#else
+
+static std::vector<sDetectedCPU> DetectCPUs() {
+  return {};
+}
+
+#endif
+
+// Groups the detected CPUs into cores and fills in the totals.
+static void BuildTopology(std::vector<sDetectedCPU> detected) {
+  // Nothing usable, assume one core per CPU
+  if (detected.empty()) {
+    const u32 count = std::max(std::thread::hardware_concurrency(), 1u);
+    for (u32 id = 0; id < count; id++) {
+      sDetectedCPU cpu = {};
+      cpu.cpu.id = id;
+      cpu.coreKey = id;
+      detected.push_back(cpu);
+    }
+  }
+
+  std::map<u64, u32> coreIndices = {};
+  std::set<u32> packages = {}, nodes = {}, llcs = {}, perfClasses = {};
+  for (sDetectedCPU &cpu : detected) {
+    auto [it, inserted] = coreIndices.try_emplace(cpu.coreKey, static_cast<u32>(topology.cores.size()));
+    if (inserted) {
+      sCore core = {};
+      core.package = cpu.cpu.package;
+      core.node = cpu.cpu.node;
+      core.llc = cpu.cpu.llc;
+      core.perfClass = cpu.cpu.perfClass;
+      topology.cores.push_back(core);
+    }
+    cpu.cpu.core = it->second;
+    topology.cores[it->second].cpus.push_back(cpu.cpu.id);
+    topology.cpus.push_back(cpu.cpu);
+    packages.insert(cpu.cpu.package);
+    nodes.insert(cpu.cpu.node);
+    llcs.insert(cpu.cpu.llc);
+    perfClasses.insert(cpu.cpu.perfClass);
+  }
+  for (sCore &core : topology.cores)
+    std::sort(core.cpus.begin(), core.cpus.end());
+  topology.packages = static_cast<u32>(packages.size());
+  topology.nodes = static_cast<u32>(nodes.size());
+  topology.llcs = static_cast<u32>(llcs.size());
+  topology.hybrid = perfClasses.size() > 1;
+}
+
+// Automatic placement. Needs a core per PPU plus one for the GPU, otherwise everything is left to the OS.
+static void PlaceAuto() {
+  if (topology.cores.size() < 4) {
+    LOG_INFO(Base, "Topology: Only {} host cores, leaving thread placement to the OS.", topology.cores.size());
+    return;
+  }
+
+  // Stay on the NUMA node with the most fast cores, so RAM accesses stay local
+  const u32 bestPerf = std::max_element(topology.cores.begin(), topology.cores.end(),
+    [](const sCore &a, const sCore &b) { return a.perfClass < b.perfClass; })->perfClass;
+  std::map<u32, u32> nodeScores = {};
+  for (const sCore &core : topology.cores)
+    nodeScores[core.node] += core.perfClass == bestPerf;
+  const u32 node = std::max_element(nodeScores.begin(), nodeScores.end(),
+    [](const auto &a, const auto &b) { return a.second < b.second; })->first;
+
+  // Fastest cores first, keeping cores sharing a last level cache together
+  std::vector<const sCore *> order = {};
+  for (const sCore &core : topology.cores)
+    order.push_back(&core);
+  std::sort(order.begin(), order.end(), [node](const sCore *a, const sCore *b) {
+    if ((a->node == node) != (b->node == node))
+      return a->node == node;
+    if (a->perfClass != b->perfClass)
+      return a->perfClass > b->perfClass;
+    if (a->llc != b->llc)
+      return a->llc < b->llc;
+    return a->cpus.front() < b->cpus.front();
+  });
+
+  // With parallel SMT both threads of a PPU run at once, without host SMT siblings they need two cores
+  const size_t coresPerPPU = Config::xcpu.parallelSMT && order[0]->cpus.size() < 2 && order.size() >= 7 ? 2 : 1;
+  size_t next = 0;
+  for (u8 ppuID = 0; ppuID < 3; ppuID++) {
+    std::vector<u32> &cpus = placements[static_cast<size_t>(eThreadRole::PPU0) + ppuID];
+    for (size_t i = 0; i < coresPerPPU; i++, next++)
+      cpus.insert(cpus.end(), order[next]->cpus.begin(), order[next]->cpus.end());
+    std::sort(cpus.begin(), cpus.end());
+  }
+  const size_t gpuCore = next++;
+  placements[static_cast<size_t>(eThreadRole::GPU)] = order[gpuCore]->cpus;
+  // Devices mostly wait on I/O, they share whatever is left, or the GPU core
+  std::vector<u32> &devices = placements[static_cast<size_t>(eThreadRole::Device)];
+  for (size_t i = next; i < order.size(); i++)
+    devices.insert(devices.end(), order[i]->cpus.begin(), order[i]->cpus.end());
+  if (devices.empty())
+    devices = order[gpuCore]->cpus;
+  std::sort(devices.begin(), devices.end());
+}
+
+// Applies the CPU lists set in the config.
+static void PlaceOverrides() {
+  const std::array<const std::string *, static_cast<size_t>(eThreadRole::Count)> overrides = {
+    &Config::threading.ppu0, &Config::threading.ppu1, &Config::threading.ppu2,
+    &Config::threading.gpu, &Config::threading.devices
+  };
+  for (size_t role = 0; role < overrides.size(); role++) {
+    if (overrides[role]->empty())
+      continue;
+    const char *roleName = GetRoleName(static_cast<eThreadRole>(role));
+    std::vector<u32> cpus = {};
+    if (!ParseCPUList(*overrides[role], cpus) || cpus.empty()) {
+      LOG_WARNING(Base, "Topology: Invalid CPU list '{}' for {}, ignoring it.", *overrides[role], roleName);
+      continue;
+    }
+    const bool valid = std::all_of(cpus.begin(), cpus.end(), [](u32 id) {
+      return std::any_of(topology.cpus.begin(), topology.cpus.end(), [id](const sLogicalCPU &cpu) { return cpu.id == id; });
+    });
+    if (!valid) {
+      LOG_WARNING(Base, "Topology: CPU list '{}' for {} names unavailable CPUs, ignoring it.", *overrides[role], roleName);
+      continue;
+    }
+    placements[role] = cpus;
+  }
+}
+
+void Initialize() {
+  topology = {};
+  placements = {};
+  BuildTopology(DetectCPUs());
+  LOG_INFO(Base, "Topology: {} CPUs, {} cores, {} packages, {} NUMA nodes, {} last level caches ({} KiB){}.",
+    topology.cpus.size(), topology.cores.size(), topology.packages, topology.nodes, topology.llcs,
+    topology.llcSizeKiB, topology.hybrid ? ", hybrid" : "");
+
+  const std::string mode = Base::ToLower(Config::threading.placement);
+  if (mode == "off") {
+    LOG_INFO(Base, "Topology: Thread placement disabled.");
+  } else if (!hostSupportsAffinity) {
+    LOG_INFO(Base, "Topology: The host doesn't support thread placement.");
+  } else {
+    if (mode != "auto")
+      LOG_WARNING(Base, "Topology: Invalid placement mode '{}'! Defaulting to auto", Config::threading.placement);
+    PlaceAuto();
+    PlaceOverrides();
+  }
+  initialized = true;
+
+  for (size_t role = 0; role < placements.size(); role++) {
+    LOG_INFO(Base, "Topology: {} -> {}", GetRoleName(static_cast<eThreadRole>(role)),
+      placements[role].empty() ? "Any CPU" : "CPUs " + FormatCPUList(placements[role]));
+  }
+}
+
+const sHostTopology &GetTopology() {
+  return topology;
+}
+
+const std::vector<u32> &GetPlacement(eThreadRole role) {
+  return placements[static_cast<size_t>(role)];
+}
+
+const char *GetRoleName(eThreadRole role) {
+  switch (role) {
+  case eThreadRole::PPU0: return "PPU0";
+  case eThreadRole::PPU1: return "PPU1";
+  case eThreadRole::PPU2: return "PPU2";
+  case eThreadRole::GPU: return "GPU";
+  case eThreadRole::Device: return "Devices";
+  default: break;
+  }
+  return "Unknown";
+}
+
+void ApplyPlacement(eThreadRole role) {
+  if (!initialized)
+    return;
+  const std::vector<u32> &cpus = GetPlacement(role);
+  if (!cpus.empty() && !SetCurrentThreadAffinity(cpus))
+    LOG_WARNING(Base, "Topology: Couldn't move a {} thread to CPUs {}.", GetRoleName(role), FormatCPUList(cpus));
+  if (Config::threading.raisePriority && role != eThreadRole::Device)
+    SetCurrentThreadPriority(ThreadPriority::High);
+}
+
+bool ParseCPUList(const std::string &list, std::vector<u32> &cpus) {
+  cpus.clear();
+  size_t pos = 0;
+  while (pos < list.size()) {
+    size_t end = list.find(',', pos);
+    if (end == std::string::npos)
+      end = list.size();
+    const std::string item = list.substr(pos, end - pos);
+    pos = end + 1;
+    if (item.empty())
+      continue;
+    const size_t dash = item.find('-');
+    char *parseEnd = nullptr;
+    const u32 first = static_cast<u32>(std::strtoul(item.c_str(), &parseEnd, 10));
+    if (parseEnd == item.c_str())
+      return false;
+    u32 last = first;
+    if (dash != std::string::npos) {
+      const char *lastStr = item.c_str() + dash + 1;
+      last = static_cast<u32>(std::strtoul(lastStr, &parseEnd, 10));
+      if (parseEnd == lastStr || last < first)
+        return false;
+    }
+    for (u32 cpu = first; cpu <= last; cpu++)
+      cpus.push_back(cpu);
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return true;
+}
+
+std::string FormatCPUList(const std::vector<u32> &cpus) {
+  std::string list = {};
+  for (size_t i = 0; i < cpus.size();) {
+    size_t end = i;
+    while (end + 1 < cpus.size() && cpus[end + 1] == cpus[end] + 1)
+      end++;
+    if (!list.empty())
+      list += ',';
+    list += std::to_string(cpus[i]);
+    if (end != i)
+      list += '-' + std::to_string(cpus[end]);
+    i = end + 1;
+  }
+  return list;
+}
+
+} // namespace Base::Topology
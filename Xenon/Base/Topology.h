@@ -0,0 +1,85 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Types.h"
+
+// Host thread placement.
+// Detects how the host logical CPUs are laid out (cores and their SMT siblings, last level caches, packages, NUMA
+// nodes, performance/efficiency cores) and decides where every emulator thread should run: each PPU gets a host
+// core of its own with its siblings, so its two SMT threads share a core like on hardware (two cores with parallel
+// SMT on hosts without SMT), the GPU threads get another one, and device threads share whatever is left.
+// Everything is kept within one NUMA node and on the fastest cores when possible. The placement can be overridden
+// or turned off from the Threading config section.
+// Host logical CPUs are numbered like the OS does (group * 64 + index on Windows).
+namespace Base::Topology {
+
+// Kinds of emulator threads.
+enum class eThreadRole : u8 {
+  PPU0,
+  PPU1,
+  PPU2,
+  GPU,    // Renderer and command processor
+  Device, // Device workers (SMC, UART, device I/O pool)
+  Count
+};
+
+// A host logical CPU.
+struct sLogicalCPU {
+  u32 id = 0;
+  // Index in sHostTopology::cores.
+  u32 core = 0;
+  u32 package = 0;
+  u32 node = 0;
+  // Lowest CPU sharing our last level cache, identifies it.
+  u32 llc = 0;
+  // Relative performance, higher is faster. Only comparable within a host.
+  u32 perfClass = 0;
+};
+
+// A host physical core.
+struct sCore {
+  // Logical CPUs of the core (its SMT siblings), sorted.
+  std::vector<u32> cpus = {};
+  u32 package = 0;
+  u32 node = 0;
+  u32 llc = 0;
+  u32 perfClass = 0;
+};
+
+struct sHostTopology {
+  std::vector<sLogicalCPU> cpus = {};
+  std::vector<sCore> cores = {};
+  u32 packages = 1;
+  u32 nodes = 1;
+  u32 llcs = 1;
+  // Size of the biggest last level cache, in KiB. 0 if unknown.
+  u32 llcSizeKiB = 0;
+  // Cores don't all perform the same (P/E cores, big.LITTLE).
+  bool hybrid = false;
+};
+
+// Detects the host topology, computes the placement from the config and reports it. Until this is called
+// threads are left where the OS puts them.
+void Initialize();
+
+const sHostTopology &GetTopology();
+
+// Host CPUs a role is placed on, empty if the OS decides.
+const std::vector<u32> &GetPlacement(eThreadRole role);
+const char *GetRoleName(eThreadRole role);
+
+// Moves the calling thread to the CPUs of its role and sets its priority. Call it from the thread itself.
+void ApplyPlacement(eThreadRole role);
+
+// Parses a CPU list ("0-3,8,10"). Returns false on a malformed list.
+bool ParseCPUList(const std::string &list, std::vector<u32> &cpus);
+// Formats a CPU list, collapsing ranges.
+std::string FormatCPUList(const std::vector<u32> &cpus);
+
+} // namespace Base::Topology
@@ -414,6 +414,66 @@ bool HostBridge::ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {
   return pciBridge->ConfigWrite(writeAddress, data, size);
 }
 
+void HostBridge::DeviceRead(PCIDevice *device, u64 readAddress, u8 *data, u64 size) {
+  MICROPROFILE_SCOPEI("[Xe::PCI]", "HostBridge::DeviceRead", MP_AUTO);
+  std::lock_guard lck(mutex);
+  device->Read(readAddress, data, size);
+}
+
+void HostBridge::DeviceWrite(PCIDevice *device, u64 writeAddress, const u8 *data, u64 size) {
+  MICROPROFILE_SCOPEI("[Xe::PCI]", "HostBridge::DeviceWrite", MP_AUTO);
+  std::lock_guard lck(mutex);
+  device->Write(writeAddress, data, size);
+}
+
+void HostBridge::DeviceMemSet(PCIDevice *device, u64 writeAddress, s32 data, u64 size) {
+  MICROPROFILE_SCOPEI("[Xe::PCI]", "HostBridge::DeviceMemSet", MP_AUTO);
+  std::lock_guard lck(mutex);
+  device->MemSet(writeAddress, data, size);
+}
+
+void HostBridge::GetPhysRanges(std::vector<sPhysRange> &ranges) {
+  std::lock_guard lck(mutex);
+
+  // PCI Bridge window and the devices behind it
+  if (pciBridge)
+    pciBridge->GetPhysRanges(ranges);
+
+  // XGPU, decoded by us
+  if (xGPU) {
+    for (u8 i = 0; i != 6; ++i) {
+      const u32 bar = xGPU->GetBAR(i);
+      if (bar)
+        ranges.push_back({ bar, static_cast<u64>(bar) + XGPU_DEVICE_SIZE, physHandlerHostBridge, nullptr, 0 });
+    }
+  }
+
+  // Our own registers, highest priority
+  const u32 bars[6] = {
+    hostBridgeConfigSpace.configSpaceHeader.BAR0, hostBridgeConfigSpace.configSpaceHeader.BAR1,
+    hostBridgeConfigSpace.configSpaceHeader.BAR2, hostBridgeConfigSpace.configSpaceHeader.BAR3,
+    hostBridgeConfigSpace.configSpaceHeader.BAR4, hostBridgeConfigSpace.configSpaceHeader.BAR5
+  };
+  for (const u32 bar : bars) {
+    if (bar)
+      ranges.push_back({ bar, static_cast<u64>(bar) + XGPU_DEVICE_SIZE, physHandlerHostBridge, nullptr, 0 });
+  }
+}
+
+void HostBridge::SaveState(Base::StateWriter &writer) {
+  std::lock_guard lck(mutex);
+  writer.Write(hostBridgeConfigSpace);
+  writer.Write(hostBridgeRegs);
+  writer.Write(biuRegs);
+}
+
+void HostBridge::LoadState(Base::StateReader &reader) {
+  std::lock_guard lck(mutex);
+  reader.Read(hostBridgeConfigSpace);
+  reader.Read(hostBridgeRegs);
+  reader.Read(biuRegs);
+}
+
 bool HostBridge::isAddressMappedinBAR(u32 address) {
   #define ADDRESS_BOUNDS_CHECK(a, b) (address >= a && address <= (a + b))
 
@@ -7,6 +7,7 @@
 #include "Core/PCI/PCIe.h"
 
 #include "Core/PCI/Bridge/PCIBridge.h"
+#include "Core/RootBus/PhysPageTable.h"
 
 #include "Core/XGPU/XGPU.h"
 
@@ -73,6 +74,22 @@ public:
   // Configuration Write
   bool ConfigWrite(u64 writeAddress, const u8 *data, u64 size);
 
+  // Direct PCI device R/W, used once the physical page table resolved the target device
+  void DeviceRead(PCIDevice *device, u64 readAddress, u8 *data, u64 size);
+  void DeviceWrite(PCIDevice *device, u64 writeAddress, const u8 *data, u64 size);
+  void DeviceMemSet(PCIDevice *device, u64 writeAddress, s32 data, u64 size);
+
+  // Appends the physical address ranges decoded by this bridge, in ascending priority
+  void GetPhysRanges(std::vector<sPhysRange> &ranges);
+
+  // Save state, our own registers. The PCI bridge and the XGPU are saved on their own.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
+
+  // Power-on state of our registers. The PCI bridge and the XGPU are reset on their own.
+  void CapturePowerOnState() { powerOnState.Capture(*this); }
+  void Reset() { powerOnState.Restore(*this); }
+
 private:
   std::mutex mutex{};
 
@@ -89,4 +106,7 @@ private:
 
   HOSTBRIDGE_REGS hostBridgeRegs{};
   BIU_REGS biuRegs{};
+
+  // Registers at power-on, see Reset
+  Base::StateSnapshot powerOnState{};
 };
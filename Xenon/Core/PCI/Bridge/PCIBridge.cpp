@@ -2,8 +2,11 @@
 /* Copyright 2025 Xenon Emulator Project. All rights reserved. */
 /***************************************************************/
 
+#include <algorithm>
+
 #include "Base/Logging/Log.h"
 #include "Base/Global.h"
+#include "Base/Hash.h"
 
 #include "PCIBridge.h"
 #include "PCIBridgeConfig.h"
@@ -294,6 +297,39 @@ bool PCIBridge::IsAddressMappedinBAR(u32 address) {
   return false;
 }
 
+void PCIBridge::GetPhysRanges(std::vector<sPhysRange> &ranges) {
+  const u32 windows[2] = { pciBridgeConfig.configSpaceHeader.BAR0, pciBridgeConfig.configSpaceHeader.BAR1 };
+  for (const u32 window : windows) {
+    if (!window)
+      continue;
+    const u64 windowStart = window;
+    const u64 windowEnd = windowStart + PCI_BRIDGE_SIZE;
+    // The whole window goes through the Host Bridge decoding (our own registers, unmapped reads)
+    ranges.push_back({ windowStart, windowEnd, physHandlerHostBridge, nullptr, 0 });
+
+    // Attached devices, only reachable through the window. On overlap, the first device found used to win,
+    // so add them in reverse.
+    std::vector<sPhysRange> deviceRanges{};
+    for (auto &[name, dev] : connectedPCIDevices) {
+      for (u8 i = 0; i != 6; ++i) {
+        const u64 barStart = dev->GetBAR(i);
+        const u64 barEnd = barStart + dev->GetDeviceSize();
+        if (!barStart || barStart >= windowEnd || barEnd <= windowStart)
+          continue;
+        deviceRanges.push_back({ std::max(barStart, windowStart), std::min(barEnd, windowEnd),
+          physHandlerPCIDevice, dev.get(), 0 });
+      }
+    }
+    ranges.insert(ranges.end(), deviceRanges.rbegin(), deviceRanges.rend());
+
+    // Our own registers
+    const u64 regsStart = std::max<u64>(PCI_BRIDGE_BASE_ADDRESS, windowStart);
+    const u64 regsEnd = std::min<u64>(static_cast<u64>(PCI_BRIDGE_BASE_END_ADDRESS) + 1, windowEnd);
+    if (regsStart < regsEnd)
+      ranges.push_back({ regsStart, regsEnd, physHandlerHostBridge, nullptr, 0 });
+  }
+}
+
 void PCIBridge::AddPCIDevice(std::shared_ptr<PCIDevice> device) {
   if (!device.get()) {
     LOG_CRITICAL(PCIBridge, "Failed to attach a device!");
@@ -322,6 +358,54 @@ void PCIBridge::ResetPCIDevice(std::shared_ptr<PCIDevice> device) {
   }
 }
 
+void PCIBridge::SaveState(Base::StateWriter &writer) {
+  writer.Write(pciBridgeConfig);
+  writer.Write(pciBridgeState);
+  writer.Write(pciBridgeConfigSpace);
+  // Sorted, so the same state always serializes the same way
+  std::vector<std::string> names = {};
+  for (const auto &[name, device] : connectedPCIDevices)
+    names.push_back(name);
+  std::sort(names.begin(), names.end());
+  for (const std::string &name : names) {
+    writer.BeginSection(Base::JoaatStringHash(name));
+    connectedPCIDevices[name]->SaveState(writer);
+    writer.EndSection();
+  }
+}
+
+void PCIBridge::LoadState(Base::StateReader &reader) {
+  reader.Read(pciBridgeConfig);
+  reader.Read(pciBridgeState);
+  reader.Read(pciBridgeConfigSpace);
+  for (const auto &[name, device] : connectedPCIDevices) {
+    Base::StateReader section = {};
+    if (!reader.GetSection(Base::JoaatStringHash(name), section)) {
+      LOG_WARNING(PCIBridge, "No saved state for {}, leaving it as is.", name);
+      continue;
+    }
+    device->LoadState(section);
+    if (!section.Good())
+      LOG_ERROR(PCIBridge, "Saved state for {} is truncated.", name);
+  }
+}
+
+void PCIBridge::CapturePowerOnState() {
+  powerOnConfig = pciBridgeConfig;
+  powerOnState = pciBridgeState;
+  memcpy(powerOnConfigSpace, pciBridgeConfigSpace, sizeof(powerOnConfigSpace));
+  for (const auto &[name, device] : connectedPCIDevices)
+    device->CapturePowerOnState();
+}
+
+void PCIBridge::Reset() {
+  pciBridgeConfig = powerOnConfig;
+  pciBridgeState = powerOnState;
+  memcpy(pciBridgeConfigSpace, powerOnConfigSpace, sizeof(pciBridgeConfigSpace));
+  for (const auto &[name, device] : connectedPCIDevices)
+    device->Reset();
+}
+
 bool PCIBridge::Read(u64 readAddress, u8 *data, u64 size) {
   // Reading to our own space?
   if (readAddress >= PCI_BRIDGE_BASE_ADDRESS &&
@@ -10,6 +10,7 @@
 #include "Core/PCI/PCIDevice.h"
 
 #include "Core/PCI/PCIe.h"
+#include "Core/RootBus/PhysPageTable.h"
 #include "Core/XCPU/Context/XenonIIC/XenonIIC.h"
 
 /*  Dev type          Config Address    BAR
@@ -101,11 +102,22 @@ public:
   bool ConfigRead(u64 readAddress, u8 *data, u64 size);
   bool ConfigWrite(u64 writeAddress, const u8 *data, u64 size);
 
+  // Appends the physical address ranges decoded by the bridge, in ascending priority
+  void GetPhysRanges(std::vector<sPhysRange> &ranges);
+
   void RegisterIIC(Xe::XCPU::XenonIIC *xenonIICPtr);
 
   bool RouteInterrupt(u8 prio, u8 targetCPU = 0xFF);
   void CancelInterrupt(u8 prio);
 
+  // Save state, the bridge registers and every connected device, each in a section of its own.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
+
+  // Power-on state of the bridge registers and every connected device, see PCIDevice::Reset.
+  void CapturePowerOnState();
+  void Reset();
+
 private:
   // IIC Pointer used for interrupts
   Xe::XCPU::XenonIIC *xenonIIC;
@@ -117,4 +129,8 @@ private:
   PCI_PCI_BRIDGE_CONFIG_SPACE pciBridgeConfig = {};
   PCI_BRIDGE_STATE pciBridgeState = {};
   u8 pciBridgeConfigSpace[256];
+  // Registers at power-on
+  PCI_PCI_BRIDGE_CONFIG_SPACE powerOnConfig = {};
+  PCI_BRIDGE_STATE powerOnState = {};
+  u8 powerOnConfigSpace[256];
 };
@@ -179,3 +179,29 @@ void Xe::PCIDev::EHCI::ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {
 
   memcpy(&pciConfigSpace.data[static_cast<u8>(writeAddress)], &tmp, size);
 }
+
+void Xe::PCIDev::EHCI::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  writer.Write(usbCmd);
+  writer.Write(usbSts);
+  writer.Write(usbIntr);
+  writer.Write(frameIndex);
+  writer.Write(ctrlDsSegment);
+  writer.Write(periodicListBase);
+  writer.Write(asyncListAddr);
+  writer.Write(configFlag);
+  writer.Write(portSC);
+}
+
+void Xe::PCIDev::EHCI::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  reader.Read(usbCmd);
+  reader.Read(usbSts);
+  reader.Read(usbIntr);
+  reader.Read(frameIndex);
+  reader.Read(ctrlDsSegment);
+  reader.Read(periodicListBase);
+  reader.Read(asyncListAddr);
+  reader.Read(configFlag);
+  reader.Read(portSC);
+}
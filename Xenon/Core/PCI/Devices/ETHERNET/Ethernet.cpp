@@ -352,3 +352,19 @@ void Xe::PCIDev::ETHERNET::ConfigWrite(u64 writeAddress, const u8 *data, u64 siz
 
   memcpy(&pciConfigSpace.data[static_cast<u8>(writeAddress)], &tmp, size);
 }
+
+void Xe::PCIDev::ETHERNET::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  writer.Write(mdioRegisters);
+  writer.Write(ethPciState);
+  writer.Write(rxEnabled);
+  writer.Write(txEnabled);
+}
+
+void Xe::PCIDev::ETHERNET::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  reader.Read(mdioRegisters);
+  reader.Read(ethPciState);
+  reader.Read(rxEnabled);
+  reader.Read(txEnabled);
+}
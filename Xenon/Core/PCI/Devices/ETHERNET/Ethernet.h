@@ -94,6 +94,8 @@ public:
   void MemSet(u64 writeAddress, s32 data, u64 size) override;
   void ConfigRead(u64 readAddress, u8* data, u64 size) override;
   void ConfigWrite(u64 writeAddress, const u8* data, u64 size) override;
+  void SaveState(Base::StateWriter &writer) override;
+  void LoadState(Base::StateReader &reader) override;
 
 private:
   // MDIO Read
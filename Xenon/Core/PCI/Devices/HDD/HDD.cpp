@@ -8,6 +8,13 @@
 
 //#define HDD_DEBUG
 
+// Kinds of command completion, see hddCompletion.
+#define HDD_COMPLETION_DMA 0
+#define HDD_COMPLETION_FLUSH 1
+
+// Entries in a PRDT, which can't be bigger than 64KiB.
+#define HDD_MAX_PRDT_ENTRIES (0x10000 / 8)
+
 // Data was pulled off of an Hitachi 250Gb retail HDD.
 const u8 identifyDataBytes[] = {
   0x5a, 0x04, 0xff, 0x3f,
@@ -75,7 +82,8 @@ enum class ATA_TRANSFER_MODE {
   ULTRA_DMA_MODE6 = 0x46,
 };
 
-Xe::PCIDev::HDD::HDD(const std::string &deviceName, u64 size, PCIBridge *parentPCIBridge, RAM* ram) :
+Xe::PCIDev::HDD::HDD(const std::string &deviceName, u64 size, PCIBridge *parentPCIBridge, RAM* ram,
+  Xe::XCPU::XenonScheduler *schedulerPtr, IOPool *ioPoolPtr) :
   PCIDevice(deviceName, size) {
 
   // Note:
@@ -96,6 +104,12 @@ Xe::PCIDev::HDD::HDD(const std::string &deviceName, u64 size, PCIBridge *parentP
   // Assign our RAM pointer
   ramPtr = ram;
 
+  // Assign our scheduler pointer
+  scheduler = schedulerPtr;
+
+  // Assign our I/O pool pointer
+  ioPool = ioPoolPtr;
+
   u32 data = 0;
   // Capabilities at offset 0x58:
   data = 0x80020001;
@@ -150,8 +164,6 @@ Xe::PCIDev::HDD::HDD(const std::string &deviceName, u64 size, PCIBridge *parentP
     LOG_INFO(HDD, "No HDD image found - disabling device.");
   }
 
-  hddThreadRunning = ataState.imageAttached;
-
   // Set the SCR's at offset 0xC0 (SiS-like).
   // SStatus
   data = ataState.imageAttached ? 0x00000113 : 0;
@@ -175,15 +187,16 @@ Xe::PCIDev::HDD::HDD(const std::string &deviceName, u64 size, PCIBridge *parentP
   // Device ready to receive commands.
   ataState.regs.status = ATA_STATUS_DRDY;
 
-  // Enter HDD Worker Thread
-  hddWorkerThread = std::thread(&Xe::PCIDev::HDD::hddThreadLoop, this);
+  // DMA and flushes complete on an I/O pool worker, they go through the scheduler so they can be replayed
+  scheduler->RegisterAsyncSource(Xe::XCPU::eAsyncSource::HDDCompletion, this, [this](const std::vector<u8> &data) {
+    hddCompletion(data);
+  });
 }
 
 Xe::PCIDev::HDD::~HDD() {
-  // Terminate thread.
-  hddThreadRunning = false;
-  if (hddWorkerThread.joinable())
-    hddWorkerThread.join();
+  // Wait for our in flight transfers.
+  ioPool->Drain(this);
+  scheduler->UnregisterAsyncSource(Xe::XCPU::eAsyncSource::HDDCompletion, this);
 }
 
 // PCI Read
@@ -394,6 +407,9 @@ void Xe::PCIDev::HDD::Write(u64 writeAddress, const u8 *data, u64 size) {
       case ATA_COMMAND_WRITE_DMA:
         ataWriteDMACommand();
         break;
+      case ATA_COMMAND_FLUSH_CACHE:
+        ataFlushCacheCommand();
+        break;
       case ATA_COMMAND_IDENTIFY_DEVICE:
         ataIdentifyDeviceCommand();
         // Request interrupt
@@ -508,6 +524,7 @@ void Xe::PCIDev::HDD::Write(u64 writeAddress, const u8 *data, u64 size) {
       memcpy(&ataState.regs.dmaCommand, data, size);
       if (ataState.regs.dmaCommand & XE_ATAPI_DMA_ACTIVE) {
         ataState.regs.dmaStatus = XE_ATA_DMA_ACTIVE; // Signal DMA active status.
+        ataStartDMA();
       }
       break;
     case ATA_REG_DMA_STATUS:
@@ -597,9 +614,11 @@ void Xe::PCIDev::HDD::ataReadDMACommand() {
   // Read count in bytes.
   sectorCount = sectorCount * ATA_SECTOR_SIZE;
 
-  ataState.dataOutBuffer.init(sectorCount, false);
-  ataState.dataOutBuffer.reset();
-  ataState.mountedHDDImage->Read(offset, ataState.dataOutBuffer.get(), sectorCount);
+  ataState.dmaTransfer.offset = offset;
+  ataState.dmaTransfer.byteCount = sectorCount;
+  ataState.dmaTransfer.write = false;
+  ataState.dmaTransfer.pending = true;
+  ataStartDMA();
 }
 
 // ATA READ NATIVE MAX ADDRESS EXT (LBA 48 Bit)
@@ -638,9 +657,11 @@ void Xe::PCIDev::HDD::ataReadDMAExtCommand() {
   // Read count in bytes.
   sectorCount = sectorCount * ATA_SECTOR_SIZE;
 
-  ataState.dataOutBuffer.init(sectorCount, false);
-  ataState.dataOutBuffer.reset();
-  ataState.mountedHDDImage->Read(offset, ataState.dataOutBuffer.get(), sectorCount);
+  ataState.dmaTransfer.offset = offset;
+  ataState.dmaTransfer.byteCount = sectorCount;
+  ataState.dmaTransfer.write = false;
+  ataState.dmaTransfer.pending = true;
+  ataStartDMA();
 }
 
 // ATA WRITE DMA (LBA 28 Bit)
@@ -660,7 +681,36 @@ void Xe::PCIDev::HDD::ataWriteDMACommand() {
   // Read count in bytes.
   sectorCount = sectorCount * ATA_SECTOR_SIZE;
 
-  ataState.mountedHDDImage->Write(offset, ataState.dataInBuffer.get(), sectorCount);
+  ataState.dmaTransfer.offset = offset;
+  ataState.dmaTransfer.byteCount = sectorCount;
+  ataState.dmaTransfer.write = true;
+  ataState.dmaTransfer.pending = true;
+  ataStartDMA();
+}
+
+// ATA FLUSH CACHE
+void Xe::PCIDev::HDD::ataFlushCacheCommand() {
+  // Nothing to write back without an image
+  if (!ataState.imageAttached) {
+    ataIssueInterrupt();
+    return;
+  }
+  // Busy until the image is on disk, completed writes are only in the host's cache until then
+  ataState.regs.status = ATA_STATUS_BSY;
+
+  sIORequest request = {};
+  request.type = eIORequestType::Flush;
+  request.owner = this;
+  request.storage = ataState.mountedHDDImage.get();
+  request.completion = [this](bool success) {
+    if (!success) {
+      LOG_ERROR(HDD, "Flushing the image failed.");
+    }
+    // Signal completion, see hddCompletion
+    scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::HDDCompletion,
+      { HDD_COMPLETION_FLUSH, static_cast<u8>(success) });
+  };
+  ioPool->Submit(std::move(request));
 }
 
 //
@@ -705,81 +755,102 @@ const std::string Xe::PCIDev::HDD::getATACommandName(u32 commandID) {
   }
 }
 
-// Worker thread for DMA.
-void Xe::PCIDev::HDD::hddThreadLoop() {
-  // Check if we should be running
-  if (!hddThreadRunning)
+// Hands the pending transfer over to the I/O pool, once the command is issued and the DMA engine started (in
+// either order).
+void Xe::PCIDev::HDD::ataStartDMA() {
+  if (!ataState.imageAttached || !ataState.dmaTransfer.pending || !(ataState.regs.dmaCommand & XE_ATA_DMA_ACTIVE))
     return;
-  LOG_INFO(HDD, "Entered HDD worker thread.");
-  while (hddThreadRunning) {
-    // Check if we should exit early
-    hddThreadRunning = XeRunning;
-    if (!hddThreadRunning)
-      break;
-    // Check for the DMA active command.
-    if (ataState.regs.dmaCommand & XE_ATA_DMA_ACTIVE) {
-      // Start our DMA operation
-      doDMA();
-      // Change our DMA status after completion.
-      ataState.regs.dmaCommand &= ~1; // Clear active status.
-      ataState.regs.dmaStatus = XE_ATA_DMA_INTR; // Signal Interrupt.
-    }
-  }
+  // Only one transfer at a time
+  if (dmaCompletionPending.exchange(true))
+    return;
+  ataState.dmaTransfer.pending = false;
 
-  LOG_INFO(HDD, "Exiting HDD worker thread.");
-}
+  // If this bit in the Command register is set the device writes to memory, a read operation
+  const bool readOperation = ataState.regs.dmaCommand & XE_ATAPI_DMA_WR;
+  if (readOperation == ataState.dmaTransfer.write) {
+    LOG_WARNING(HDD, "DMA direction doesn't match the issued command.");
+  }
 
-// Performs the DMA operation until it reaches the end of the PRDT.
-void Xe::PCIDev::HDD::doDMA() {
-  for (;;) {
-    // Read the first entry of the table in memory
-    u8 *DMAPointer = ramPtr->GetPointerToAddress(ataState.regs.dmaTableOffset + ataState.dmaState.currentTableOffset);
+  sIORequest request = {};
+  request.type = ataState.dmaTransfer.write ? eIORequestType::Write : eIORequestType::Read;
+  request.owner = this;
+  request.storage = ataState.mountedHDDImage.get();
+  request.offset = ataState.dmaTransfer.offset;
+
+  // Walk the PRDT, the transfer is scattered over its entries.
+  u32 remaining = ataState.dmaTransfer.byteCount;
+  bool tableValid = true;
+  ataState.dmaState.currentTableOffset = 0;
+  for (u32 entry = 0; remaining != 0; ++entry) {
+    // The table is at most 64KiB, a malformed one must not send us walking through RAM
+    if (entry == HDD_MAX_PRDT_ENTRIES) {
+      LOG_ERROR(HDD, "PRDT at {:#x} has no end of table entry.", ataState.regs.dmaTableOffset);
+      tableValid = false;
+      break;
+    }
     // Each entry is 64 bit long
+    u8 *DMAPointer = ramPtr->GetPointerToAddress(ataState.regs.dmaTableOffset + ataState.dmaState.currentTableOffset);
+    if (!DMAPointer) {
+      LOG_ERROR(HDD, "PRDT at {:#x} is outside of RAM.", ataState.regs.dmaTableOffset);
+      tableValid = false;
+      break;
+    }
     memcpy(&ataState.dmaState, DMAPointer, 8);
+    ataState.dmaState.currentTableOffset = (entry + 1) * 8;
 
-    // Store current position in the table
-    ataState.dmaState.currentTableOffset += 8;
+    // A zero byte count stands for 64KiB
+    const u32 entrySize = ataState.dmaState.currentPRD.sizeInBytes ? ataState.dmaState.currentPRD.sizeInBytes : 0x10000;
+    const u32 size = std::min<u32>(entrySize, remaining);
+    request.segments.push_back({ ataState.dmaState.currentPRD.physAddress, size });
+    remaining -= size;
 
-    // If this bit in the Command register is set we're facing a read operation
-    bool readOperation = ataState.regs.dmaCommand & XE_ATAPI_DMA_WR;
     // This bit specifies that we're facing the last entry in the PRD Table
-    bool lastEntry = ataState.dmaState.currentPRD.control & 0x8000;
-    // The byte count to read/write
-    u16 size = ataState.dmaState.currentPRD.sizeInBytes;
-    // The address in memory to be written to/read from
-    u32 bufferAddress = ataState.dmaState.currentPRD.physAddress;
-    // Buffer Pointer in main memory
-    u8 *bufferInMemory = ramPtr->GetPointerToAddress(bufferAddress);
-
-    if (readOperation) {
-      // Reading from us
-      size = std::fmin(static_cast<u32>(size), ataState.dataOutBuffer.count());
-
-      // Buffer overrun? Apparently there can be entries in the PRDT which have a zero byte count.
-      if (size == 0) {
-        LOG_WARNING(HDD, "[DMA Worker Read] Entry read size is zero.");
-      }
+    if (ataState.dmaState.currentPRD.control & 0x8000)
+      break;
+  }
+  // Reset the current position
+  ataState.dmaState.currentTableOffset = 0;
 
-      memcpy(bufferInMemory, ataState.dataOutBuffer.get(), size);
-      ataState.dataOutBuffer.resize(size);
-    } else {
-      // Writing to us
-      size = std::fmin(static_cast<u32>(size), ataState.dataInBuffer.count());
-      // Buffer overrun? Apparently there can be entries in the PRDT which have a zero byte count.
-      if (size == 0) {
-        LOG_WARNING(HDD, "[DMA Worker Write] Entry write size is zero.");
-      }
-      memcpy(ataState.dataInBuffer.get(), bufferInMemory, size);
-      ataState.dataInBuffer.resize(size);
-    }
-    if (lastEntry) {
-      // Reset the current position
-      ataState.dmaState.currentTableOffset = 0;
-      // After completion we must raise an interrupt
-      ataIssueInterrupt();
-      return;
+  // Fail the command, nothing was transferred
+  if (!tableValid) {
+    scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::HDDCompletion, { HDD_COMPLETION_DMA, 0 });
+    return;
+  }
+
+  request.completion = [this](bool success) {
+    if (!success) {
+      LOG_ERROR(HDD, "DMA transfer to/from the image failed.");
     }
+    // Signal completion, see hddCompletion
+    scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::HDDCompletion,
+      { HDD_COMPLETION_DMA, static_cast<u8>(success) });
+  };
+  ioPool->Submit(std::move(request));
+}
+
+// Dispatches a command completion, data is its kind and whether it succeeded.
+void Xe::PCIDev::HDD::hddCompletion(const std::vector<u8> &data) {
+  // Events recorded before completions carried anything are successful DMA completions
+  const bool success = data.size() < 2 || data[1];
+  ataState.regs.error = success ? 0 : ATA_ERROR_ABRT;
+  ataState.regs.status = success ? ATA_STATUS_DRDY : ATA_STATUS_DRDY | ATA_STATUS_ERR_CHK;
+  if (!data.empty() && data[0] == HDD_COMPLETION_FLUSH) {
+    ataIssueInterrupt();
+    return;
   }
+  dmaCompletion(success);
+}
+
+// Finishes a DMA operation.
+void Xe::PCIDev::HDD::dmaCompletion(bool success) {
+  // Change our DMA status after completion.
+  ataState.regs.dmaCommand &= ~1; // Clear active status.
+  ataState.regs.dmaStatus = XE_ATA_DMA_INTR; // Signal Interrupt.
+  if (!success)
+    ataState.regs.dmaStatus |= XE_ATA_DMA_ERR;
+  dmaCompletionPending = false;
+  // After completion we must raise an interrupt
+  ataIssueInterrupt();
 }
 
 // Issues an interrupt to the XCPU.
@@ -791,3 +862,26 @@ void Xe::PCIDev::HDD::ataIssueInterrupt() {
     parentBus->RouteInterrupt(PRIO_SATA_HDD);
   }
 }
+
+// Save state. The image itself isn't part of it, it's the drive's backing storage
+void Xe::PCIDev::HDD::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  writer.Write(ataState.regs);
+  writer.Write(ataState.ataIdentifyData);
+  ataState.dataInBuffer.SaveState(writer);
+  ataState.dataOutBuffer.SaveState(writer);
+  writer.Write(ataState.dmaState);
+  writer.Write(ataState.dmaTransfer);
+  writer.Write<bool>(dmaCompletionPending);
+}
+
+void Xe::PCIDev::HDD::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  reader.Read(ataState.regs);
+  reader.Read(ataState.ataIdentifyData);
+  ataState.dataInBuffer.LoadState(reader);
+  ataState.dataOutBuffer.LoadState(reader);
+  reader.Read(ataState.dmaState);
+  reader.Read(ataState.dmaTransfer);
+  dmaCompletionPending = reader.Read<bool>();
+}
@@ -12,15 +12,18 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #endif
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <string>
 #include <thread>
 
 #include "Core/RAM/RAM.h"
+#include "Core/PCI/IOPool.h"
 #include "Core/XCPU/PPU/PPCInternal.h"
 #include "Core/PCI/SATA.h"
 #include "Core/PCI/Bridge/PCIBridge.h"
+#include "Core/XCPU/Context/Scheduler/XenonScheduler.h"
 
 #define HDD_DEV_SIZE 0x30
 
@@ -31,7 +34,7 @@ namespace PCIDev {
 // Read/Write Storage.
 //
 #ifdef _WIN32
-class ReadWriteStorage {
+class ReadWriteStorage : public IOStorage {
 public:
   ReadWriteStorage(const std::string Filename) {
     hFile = CreateFileA(Filename.data(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
@@ -50,7 +53,7 @@ public:
     return (cb == INVALID_FILE_SIZE) ? 0 : cb;
   }
 
-  bool Read(u64 Offset, u8* Destination, u32 cu8s) {
+  bool Read(u64 Offset, u8* Destination, u32 cu8s) override {
     DWORD cbRead;
     OVERLAPPED Over;
 
@@ -61,7 +64,7 @@ public:
       (cbRead == cu8s));
   }
 
-  bool Write(u64 Offset, u8* Source, u32 cu8s) {
+  bool Write(u64 Offset, const u8* Source, u32 cu8s) override {
     DWORD cbWritten;
     OVERLAPPED Over;
 
@@ -72,6 +75,10 @@ public:
       (cbWritten == cu8s));
   }
 
+  bool Flush() override {
+    return FlushFileBuffers(hFile);
+  }
+
     bool isHandleValid() {
       return (hFile != INVALID_HANDLE_VALUE);
     }
@@ -80,7 +87,7 @@ public:
     HANDLE hFile;
   };
 #else
-class ReadWriteStorage {
+class ReadWriteStorage : public IOStorage {
 public:
   ReadWriteStorage(const std::string Filename) {
     fd = open(Filename.c_str(), O_RDWR);
@@ -98,20 +105,21 @@ public:
     return static_cast<u32>(st.st_size);
   }
 
-  bool Read(u64 Offset, u8* Destination, u32 cu8s) {
-    if (lseek(fd, Offset, SEEK_SET) == (off_t)-1)
-      return false;
-    ssize_t bytesRead = read(fd, Destination, cu8s);
+  // Positional, requests to the image can run concurrently.
+  bool Read(u64 Offset, u8* Destination, u32 cu8s) override {
+    ssize_t bytesRead = pread(fd, Destination, cu8s, static_cast<off_t>(Offset));
     return bytesRead == static_cast<ssize_t>(cu8s);
   }
 
-  bool Write(u64 Offset, u8* Source, u32 cu8s) {
-    if (lseek(fd, Offset, SEEK_SET) == (off_t)-1)
-      return false;
-    ssize_t bytesWritten = write(fd, Source, cu8s);
+  bool Write(u64 Offset, const u8* Source, u32 cu8s) override {
+    ssize_t bytesWritten = pwrite(fd, Source, cu8s, static_cast<off_t>(Offset));
     return bytesWritten == static_cast<ssize_t>(cu8s);
   }
 
+  bool Flush() override {
+    return fsync(fd) == 0;
+  }
+
   bool isHandleValid() {
     return (fd != -1);
   }
@@ -151,6 +159,27 @@ private:
       }
       return false;
     }
+    void SaveState(Base::StateWriter &writer) {
+      writer.Write<u32>(_data ? _size : 0);
+      writer.Write<u32>(_pointer);
+      if (_data)
+        writer.WriteBytes(_data.get(), _size);
+    }
+    void LoadState(Base::StateReader &reader) {
+      const u32 size = reader.Read<u32>();
+      const u32 pointer = reader.Read<u32>();
+      if (size > reader.Remaining()) {
+        reader.Fail();
+        return;
+      }
+      // Drop the current buffer so it ends up exactly the saved size
+      _data.reset();
+      _size = 0;
+      if (size)
+        init(size, false);
+      reader.ReadBytes(_data.get(), size);
+      _pointer = pointer;
+    }
   private:
     std::unique_ptr<u8[]> _data;
     u32 _size;
@@ -386,6 +415,13 @@ struct ATA_DEV_STATE {
   HDDDataBuffer dataOutBuffer;
   // DMA State
   XE_ATA_DMA_STATE dmaState = {0};
+  // Transfer set up by the last DMA command, started once the DMA engine is active.
+  struct {
+    u64 offset = 0;
+    u32 byteCount = 0;
+    bool write = false;
+    bool pending = false;
+  } dmaTransfer;
   // Do we have an image?
   bool imageAttached = false;
 };
@@ -393,13 +429,15 @@ struct ATA_DEV_STATE {
 class HDD : public PCIDevice {
 public:
   HDD(const std::string &deviceName, u64 size,
-    PCIBridge *parentPCIBridge, RAM* ram);
+    PCIBridge *parentPCIBridge, RAM* ram, Xe::XCPU::XenonScheduler *schedulerPtr, IOPool *ioPoolPtr);
   ~HDD();
   void Read(u64 readAddress, u8 *data, u64 size) override;
   void Write(u64 writeAddress, const u8 *data, u64 size) override;
   void MemSet(u64 writeAddress, s32 data, u64 size) override;
   void ConfigRead(u64 readAddress, u8* data, u64 size) override;
   void ConfigWrite(u64 writeAddress, const u8* data, u64 size) override;
+  void SaveState(Base::StateWriter &writer) override;
+  void LoadState(Base::StateReader &reader) override;
 
 private:
   // PCI Bridge pointer. Used for Interrupts.
@@ -408,31 +446,37 @@ private:
   // RAM Pointer for DMA ops.
   RAM* ramPtr;
 
+  // Event scheduler, delivers DMA completions.
+  Xe::XCPU::XenonScheduler *scheduler = nullptr;
+
   // Device State
   ATA_DEV_STATE ataState = {};
 
-  // Worker Thread for DMA requests.
-  std::thread hddWorkerThread;
-
-  // Thread running
-  volatile bool hddThreadRunning = false;
+  // Device I/O pool, runs the DMA transfers.
+  IOPool *ioPool = nullptr;
 
-  // Thread loop for processing DMA requests, etc...
-  void hddThreadLoop();
+  // A DMA transfer is in flight, don't start another one.
+  std::atomic<bool> dmaCompletionPending = false;
 
   // ATA Commands.
   void ataReadDMACommand();
   void ataReadNativeMaxAddressExtCommand();
   void ataReadDMAExtCommand();
   void ataWriteDMACommand();
+  void ataFlushCacheCommand();
   void ataIdentifyDeviceCommand();
 
   // Utilities
 
   // Returns the name of a given command.
   static const std::string getATACommandName(u32 commandID);
-  // DMA Worker.
-  void doDMA();
+  // Starts the pending transfer once the DMA engine is active, the I/O pool moves the data straight between
+  // the image and the PRDT buffers.
+  void ataStartDMA();
+  // Command completion, delivered through the scheduler. Data is the kind of completion.
+  void hddCompletion(const std::vector<u8> &data);
+  // Finishes a DMA transfer, flagging an error if it failed.
+  void dmaCompletion(bool success);
   // Issues an interrupt if allowed.
   void ataIssueInterrupt();
 };
@@ -12,6 +12,10 @@
 // Enables ODD Debug output
 //#define ODD_DEBUG
 
+// Kinds of command completion, see oddCompletion.
+#define ODD_COMPLETION_DMA 0
+#define ODD_COMPLETION_SCSI 1
+
 // Describes the ATA transfer modes available to the SET_TRNASFER_MODE subcommand.
 enum class ATA_TRANSFER_MODE {
   PIO = 0x00,
@@ -72,7 +76,8 @@ const u8 atapiInquiryDataBytes[] = { 0x05, 0x80, 0x00, 0x32, 0x5B, 0x00, 0x00, 0
 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x31, 0x35, 0x33, 0x32
 };
 
-Xe::PCIDev::ODD::ODD(const char* deviceName, u64 size, PCIBridge *parentPCIBridge, RAM *ram) 
+Xe::PCIDev::ODD::ODD(const char* deviceName, u64 size, PCIBridge *parentPCIBridge, RAM *ram,
+  Xe::XCPU::XenonScheduler *schedulerPtr, IOPool *ioPoolPtr)
   : PCIDevice(deviceName, size) {
   // Note:
   // The ATA/ATAPI Controller in the Xenon Southbridge contain two BAR's:
@@ -110,6 +115,8 @@ Xe::PCIDev::ODD::ODD(const char* deviceName, u64 size, PCIBridge *parentPCIBridg
   // Assign our PCI bridge and RAM pointers
   parentBus = parentPCIBridge;
   ramPtr = ram;
+  scheduler = schedulerPtr;
+  ioPool = ioPoolPtr;
 
   // Initialize our input and output buffers
   atapiState.dataInBuffer.init(ATAPI_CDROM_SECTOR_SIZE, true);
@@ -152,8 +159,6 @@ Xe::PCIDev::ODD::ODD(const char* deviceName, u64 size, PCIBridge *parentPCIBridg
     LOG_INFO(ODD, "No ODD image found - disabling device.");
   }
 
-  oddThreadRunning = atapiState.imageAttached;
-
   // Set the SCR's at offset 0xC0 (SiS-like)
   // SStatus
   data = atapiState.imageAttached ? 0x00000113 : 0;
@@ -199,8 +204,16 @@ Xe::PCIDev::ODD::ODD(const char* deviceName, u64 size, PCIBridge *parentPCIBridg
       }
   }
 
-  // Enter ODD Worker Thread
-  oddWorkerThread = std::thread(&Xe::PCIDev::ODD::oddThreadLoop, this);
+  // Commands complete on an I/O pool worker, that goes through the scheduler so it can be replayed
+  scheduler->RegisterAsyncSource(Xe::XCPU::eAsyncSource::ODDCompletion, this, [this](const std::vector<u8> &data) {
+    oddCompletion(data);
+  });
+}
+
+Xe::PCIDev::ODD::~ODD() {
+  // Wait for our in flight commands.
+  ioPool->Drain(this);
+  scheduler->UnregisterAsyncSource(Xe::XCPU::eAsyncSource::ODDCompletion, this);
 }
 
 // PCI Read
@@ -343,6 +356,7 @@ void Xe::PCIDev::ODD::Write(u64 writeAddress, const u8 *data, u64 size) {
         atapiState.scsiCommandPending = true;
         // Reset our buffer ptr.
         atapiState.dataInBuffer.reset();
+        oddSubmitWork();
       }
       return;
     } break;
@@ -494,6 +508,7 @@ void Xe::PCIDev::ODD::Write(u64 writeAddress, const u8 *data, u64 size) {
       memcpy(&atapiState.regs.dmaCommand, data, size);
       if (atapiState.regs.dmaCommand & XE_ATAPI_DMA_ACTIVE) {
         atapiState.regs.dmaStatus = XE_ATA_DMA_ACTIVE; // Signal DMA active status.
+        oddSubmitWork();
       }
       break;
     case ATAPI_DMA_REG_STATUS:
@@ -1048,57 +1063,41 @@ std::string Xe::PCIDev::ODD::getATAPIRegisterName(u32 regID) {
   }
 }
 
-// Worker thread for DMA.
-void Xe::PCIDev::ODD::oddThreadLoop() {
-  // Check if we should be running
-  if (!oddThreadRunning)
+// Hands the next piece of work over to the I/O pool. Called whenever some gets posted and after every completion.
+void Xe::PCIDev::ODD::oddSubmitWork() {
+  std::lock_guard lock(workMutex);
+  if (!atapiState.imageAttached || completionPending)
     return;
-  LOG_INFO(ODD, "Entered ODD worker thread.");
-  while (oddThreadRunning) {
-    // Check if we should exit early
-    oddThreadRunning = XeRunning;
-    if (!oddThreadRunning)
-      break;
-    // Check for the DMA active command, and only start the DMA engine if there's not any 
-    // pending SCSI command for processing. (Avoids race conditions)
-    if (atapiState.regs.dmaCommand & XE_ATA_DMA_ACTIVE
-      && atapiState.scsiCommandPending == false) {
+
+  u8 kind = ODD_COMPLETION_SCSI;
+  // Pending SCSI commands go first, the DMA engine only starts once there's none left. (Avoids race conditions)
+  if (!atapiState.scsiCommandPending) {
+    if (!(atapiState.regs.dmaCommand & XE_ATA_DMA_ACTIVE))
+      return;
 #ifdef ODD_DEBUG
-      LOG_INFO(ODD, "Started DMA Operation. Direction : {}",(atapiState.regs.dmaCommand & XE_ATAPI_DMA_WR ? "Out" : "In"));
+    LOG_INFO(ODD, "Started DMA Operation. Direction : {}",(atapiState.regs.dmaCommand & XE_ATAPI_DMA_WR ? "Out" : "In"));
 #endif // ODD_DEBUG
+    kind = ODD_COMPLETION_DMA;
+  }
+  completionPending = true;
+
+  sIORequest request = {};
+  request.type = eIORequestType::Job;
+  request.owner = this;
+  request.job = [this, kind]() {
+    if (kind == ODD_COMPLETION_DMA) {
       // Start our DMA operation
       doDMA();
-      // Change our DMA status after completion.
-      atapiState.regs.dmaCommand &= ~1; // Clear active status.
-      atapiState.regs.dmaStatus = XE_ATA_DMA_INTR; // Signal Interrupt.
-      atapiState.regs.SActive = 0x40;
-      atapiState.regs.status = ATA_STATUS_DRDY;
-      // Reset I/O data buffers
-      atapiState.dataInBuffer.reset();
-      atapiState.dataOutBuffer.reset();
-      // After completion we must raise an interrupt.
-      atapiIssueInterrupt();
-
-      // Check if we should copy the input buffer onto our page data.
-      if (copyDataIntoPageData) {
-        memcpy(pageData, atapiState.dataInBuffer.get(), sizeof(pageData));
-        copyDataIntoPageData = false;
-      }
-    }
-    
-    // Check for pending SCSI commands.
-    if (atapiState.scsiCommandPending) {
+    } else {
       processSCSICommand();
-      atapiState.scsiCommandPending = false;
-      // Request an Interrupt.
-      atapiIssueInterrupt();
     }
-
-    // Sleep for some time.
-    std::this_thread::sleep_for(50ns);
-  }
-
-  LOG_INFO(ODD, "Exiting ODD worker thread.");
+    return true;
+  };
+  request.completion = [this, kind](bool) {
+    // Signal completion, see oddCompletion
+    scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::ODDCompletion, { kind });
+  };
+  ioPool->Submit(std::move(request));
 }
 
 // Performs the DMA operation until it reaches the end of the PRDT.
@@ -1134,6 +1133,7 @@ void Xe::PCIDev::ODD::doDMA() {
       }
 
       memcpy(bufferInMemory, atapiState.dataOutBuffer.get(), size);
+      ramPtr->MarkDirty(bufferAddress, size);
       atapiState.dataOutBuffer.resize(size);
     }
     else {
@@ -1154,6 +1154,53 @@ void Xe::PCIDev::ODD::doDMA() {
   }
 }
 
+// Finishes a DMA operation or SCSI command.
+void Xe::PCIDev::ODD::oddCompletion(const std::vector<u8> &data) {
+  if (data.empty()) {
+    LOG_ERROR(ODD, "Malformed command completion, dropping it.");
+    {
+      std::lock_guard lock(workMutex);
+      completionPending = false;
+    }
+    oddSubmitWork();
+    return;
+  }
+  switch (data[0]) {
+  case ODD_COMPLETION_DMA:
+    // Change our DMA status after completion.
+    atapiState.regs.dmaCommand &= ~1; // Clear active status.
+    atapiState.regs.dmaStatus = XE_ATA_DMA_INTR; // Signal Interrupt.
+    atapiState.regs.SActive = 0x40;
+    atapiState.regs.status = ATA_STATUS_DRDY;
+    // Reset I/O data buffers
+    atapiState.dataInBuffer.reset();
+    atapiState.dataOutBuffer.reset();
+    // After completion we must raise an interrupt.
+    atapiIssueInterrupt();
+
+    // Check if we should copy the input buffer onto our page data.
+    if (copyDataIntoPageData) {
+      memcpy(pageData, atapiState.dataInBuffer.get(), sizeof(pageData));
+      copyDataIntoPageData = false;
+    }
+    break;
+  case ODD_COMPLETION_SCSI:
+    atapiState.scsiCommandPending = false;
+    // Request an Interrupt.
+    atapiIssueInterrupt();
+    break;
+  default:
+    LOG_ERROR(ODD, "Unknown command completion kind {}.", data[0]);
+    break;
+  }
+  {
+    std::lock_guard lock(workMutex);
+    completionPending = false;
+  }
+  // Pick up whatever got posted in the meantime
+  oddSubmitWork();
+}
+
 // Issues an interrupt to the XCPU.
 void Xe::PCIDev::ODD::atapiIssueInterrupt() {
   if ((atapiState.regs.deviceControl & ATA_DEVICE_CONTROL_NIEN) == 0) {
@@ -1278,4 +1325,38 @@ void Xe::PCIDev::ODD::perform3BAuth() {
   atapiState.regs.interruptReason |= ATA_INTERRUPT_REASON_IO;
   atapiState.regs.interruptReason &= ~ATA_INTERRUPT_REASON_CD;
   atapiState.regs.status = ATA_STATUS_DRDY | ATA_STATUS_DF | ATA_STATUS_DRQ;
-}
\ No newline at end of file
+}
+// Save state. The disc image isn't part of it
+void Xe::PCIDev::ODD::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  writer.Write(atapiState.regs);
+  writer.Write(atapiState.atapiIdentifyData);
+  writer.Write(atapiState.atapiInquiryData);
+  atapiState.dataInBuffer.SaveState(writer);
+  atapiState.dataOutBuffer.SaveState(writer);
+  writer.Write(atapiState.scsiCBD);
+  writer.Write(atapiState.dmaState);
+  writer.Write(atapiState.scsiCommandPending);
+  writer.Write(dvdKey);
+  writer.Write(pageData);
+  writer.Write(copyDataIntoPageData);
+  std::lock_guard lock(workMutex);
+  writer.Write(completionPending);
+}
+
+void Xe::PCIDev::ODD::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  reader.Read(atapiState.regs);
+  reader.Read(atapiState.atapiIdentifyData);
+  reader.Read(atapiState.atapiInquiryData);
+  atapiState.dataInBuffer.LoadState(reader);
+  atapiState.dataOutBuffer.LoadState(reader);
+  reader.Read(atapiState.scsiCBD);
+  reader.Read(atapiState.dmaState);
+  reader.Read(atapiState.scsiCommandPending);
+  reader.Read(dvdKey);
+  reader.Read(pageData);
+  reader.Read(copyDataIntoPageData);
+  std::lock_guard lock(workMutex);
+  reader.Read(completionPending);
+}
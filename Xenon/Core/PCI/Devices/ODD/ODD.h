@@ -14,14 +14,17 @@
 #endif
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <thread>
 
 #include "Core/RAM/RAM.h"
+#include "Core/PCI/IOPool.h"
 #include "Core/PCI/SATA.h"
 #include "Core/PCI/Bridge/PCIBridge.h"
 #include "Core/PCI/PCIDevice.h"
 #include "Core/XCPU/PPU/PPCInternal.h"
+#include "Core/XCPU/Context/Scheduler/XenonScheduler.h"
 
 #define ODD_DEV_SIZE 0x30
 
@@ -64,6 +67,27 @@ public:
     }
     return false;
   }
+  void SaveState(Base::StateWriter &writer) {
+    writer.Write<u32>(_data ? _size : 0);
+    writer.Write<u32>(_pointer);
+    if (_data)
+      writer.WriteBytes(_data.get(), _size);
+  }
+  void LoadState(Base::StateReader &reader) {
+    const u32 size = reader.Read<u32>();
+    const u32 pointer = reader.Read<u32>();
+    if (size > reader.Remaining()) {
+      reader.Fail();
+      return;
+    }
+    // Drop the current buffer so it ends up exactly the saved size
+    _data.reset();
+    _size = 0;
+    if (size)
+      init(size, false);
+    reader.ReadBytes(_data.get(), size);
+    _pointer = pointer;
+  }
 private:
   std::unique_ptr<u8[]> _data;
   u32 _size;
@@ -74,7 +98,7 @@ private:
 // Read Only Storage.
 //
 #ifdef _WIN32
-class ReadOnlyStorage {
+class ReadOnlyStorage : public IOStorage {
 public:
   ReadOnlyStorage(const std::string Filename) {
     hFile = CreateFileA(Filename.data(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
@@ -93,7 +117,7 @@ public:
     return (cb == INVALID_FILE_SIZE) ? 0 : cb;
   }
 
-  bool Read(u64 Offset, u8 *Destination, u32 cu8s) {
+  bool Read(u64 Offset, u8 *Destination, u32 cu8s) override {
     DWORD cbRead;
     OVERLAPPED Over;
 
@@ -104,6 +128,10 @@ public:
       (cbRead == cu8s));
   }
 
+  bool Write(u64 Offset, const u8 *Source, u32 cu8s) override {
+    return false;
+  }
+
   bool isHandleValid() {
     return (hFile != INVALID_HANDLE_VALUE);
   }
@@ -112,7 +140,7 @@ private:
   HANDLE hFile;
 };
 #else
-class ReadOnlyStorage {
+class ReadOnlyStorage : public IOStorage {
 public:
   ReadOnlyStorage(const std::string Filename) {
     fd = open(Filename.c_str(), O_RDWR);
@@ -130,13 +158,16 @@ public:
     return static_cast<u32>(st.st_size);
   }
 
-  bool Read(u64 Offset, u8 *Destination, u32 cu8s) {
-    if (lseek(fd, Offset, SEEK_SET) == (off_t)-1)
-      return false;
-    ssize_t bytesRead = read(fd, Destination, cu8s);
+  // Positional, requests to the image can run concurrently.
+  bool Read(u64 Offset, u8 *Destination, u32 cu8s) override {
+    ssize_t bytesRead = pread(fd, Destination, cu8s, static_cast<off_t>(Offset));
     return bytesRead == static_cast<ssize_t>(cu8s);
   }
 
+  bool Write(u64 Offset, const u8 *Source, u32 cu8s) override {
+    return false;
+  }
+
   bool isHandleValid() {
     return (fd != -1);
   }
@@ -638,13 +669,16 @@ struct ATAPI_DEV_STATE {
 class ODD : public PCIDevice {
 public:
   ODD(const char* deviceName, u64 size,
-    PCIBridge *parentPCIBridge, RAM *ram);
+    PCIBridge *parentPCIBridge, RAM *ram, Xe::XCPU::XenonScheduler *schedulerPtr, IOPool *ioPoolPtr);
+  ~ODD();
 
   void Read(u64 readAddress, u8 *data, u64 size) override;
   void Write(u64 writeAddress, const u8 *data, u64 size) override;
   void MemSet(u64 writeAddress, s32 data, u64 size) override;
   void ConfigRead(u64 readAddress, u8* data, u64 size) override;
   void ConfigWrite(u64 writeAddress, const u8* data, u64 size) override;
+  void SaveState(Base::StateWriter &writer) override;
+  void LoadState(Base::StateReader &reader) override;
 
 private:
   // PCI Bridge pointer. Used for Interrupts.
@@ -653,17 +687,23 @@ private:
   // RAM Pointer for DMA ops.
   RAM *ramPtr;
 
+  // Event scheduler, delivers DMA and SCSI command completions.
+  Xe::XCPU::XenonScheduler *scheduler = nullptr;
+
   // ATAPI Device State.
   ATAPI_DEV_STATE atapiState = {};
 
-  // Worker Thread for DMA requests.
-  std::thread oddWorkerThread;
+  // Device I/O pool, runs the DMA transfers and SCSI commands.
+  IOPool *ioPool = nullptr;
+
+  // Guards completionPending.
+  std::mutex workMutex;
 
-  // Thread running
-  volatile bool oddThreadRunning = false;
+  // A DMA/SCSI command is in flight, don't pick up more work.
+  bool completionPending = false;
 
-  // Thread loop for processing DMA requests, etc...
-  void oddThreadLoop();
+  // Submits the pending SCSI command or DMA transfer to the I/O pool, if we're not busy.
+  void oddSubmitWork();
 
   // ATA Commands
   void atapiIdentifyPacketDeviceCommand();
@@ -685,6 +725,8 @@ private:
   std::string getATAPIRegisterName(u32 regID);
   // DMA Worker.
   void doDMA();
+  // DMA/SCSI command completion, delivered through the scheduler. Data is the kind of completion.
+  void oddCompletion(const std::vector<u8> &data);
   // Issues an interrupt if allowed.
   void atapiIssueInterrupt();
   // Processes a SCSI Command.
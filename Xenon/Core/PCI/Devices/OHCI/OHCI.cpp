@@ -184,3 +184,41 @@ void Xe::PCIDev::OHCI::ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {
 
   memcpy(&pciConfigSpace.data[static_cast<u8>(writeAddress)], &tmp, size);
 }
+
+void Xe::PCIDev::OHCI::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  writer.Write(HcRevision);
+  writer.Write(HcControl);
+  writer.Write(HcCommandStatus);
+  writer.Write(HcInterruptStatus);
+  writer.Write(HcInterruptEnable);
+  writer.Write(HcHCCA);
+  writer.Write(HcPeriodCurrentED);
+  writer.Write(HcControlHeadED);
+  writer.Write(HcBulkHeadED);
+  writer.Write(HcFmInterval);
+  writer.Write(HcPeriodicStart);
+  writer.Write(HcRhDescriptorA);
+  writer.Write(HcRhDescriptorB);
+  writer.Write(HcRhStatus);
+  writer.Write(HcRhPortStatus);
+}
+
+void Xe::PCIDev::OHCI::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  reader.Read(HcRevision);
+  reader.Read(HcControl);
+  reader.Read(HcCommandStatus);
+  reader.Read(HcInterruptStatus);
+  reader.Read(HcInterruptEnable);
+  reader.Read(HcHCCA);
+  reader.Read(HcPeriodCurrentED);
+  reader.Read(HcControlHeadED);
+  reader.Read(HcBulkHeadED);
+  reader.Read(HcFmInterval);
+  reader.Read(HcPeriodicStart);
+  reader.Read(HcRhDescriptorA);
+  reader.Read(HcRhDescriptorB);
+  reader.Read(HcRhStatus);
+  reader.Read(HcRhPortStatus);
+}
@@ -6,6 +6,7 @@
 #include "Base/Global.h"
 #include "Base/Config.h"
 #include "Base/Thread.h"
+#include "Base/Topology.h"
 #include "Core/XCPU/XenonCPU.h"
 
 #include "SFCX.h"
@@ -13,9 +14,10 @@
 //#define SFCX_DEBUG
 
 // There are two SFCX Versions, pre-Jasper and post-Jasper
-Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::string &nandLoadPath, PCIBridge *parentPCIBridge, RAM *ram) :
+Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::string &nandLoadPath, PCIBridge *parentPCIBridge, RAM *ram,
+  Xe::XCPU::XenonScheduler *schedulerPtr, IOPool *ioPoolPtr) :
   PCIDevice(deviceName, size),
-  parentBus(parentPCIBridge), mainMemory(ram)
+  parentBus(parentPCIBridge), mainMemory(ram), scheduler(schedulerPtr), ioPool(ioPoolPtr)
 {
   // Set PCI Properties
   pciConfigSpace.configSpaceHeader.reg0.hexData = 0x580B1414;
@@ -87,14 +89,11 @@ Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::strin
     return;
   }
 
-  // Read NAND Image data
-  nandFile.seekg(0, std::ios::beg);
-  rawImageData.resize(imageSize);
-  for (s32 b = 0; b < imageSize;  b += sfcxState.blockSize) {
-    nandFile.read(reinterpret_cast<char*>(rawImageData.data() + b), sfcxState.blockSize);
-  }
-  // Close the file
-  nandFile.close();
+  // The image is read on demand, a chunk at a time, and the rest in the background. The file stays open until then
+  rawImageData = std::make_unique_for_overwrite<u8[]>(imageSize);
+  rawImageSize = imageSize;
+  chunksLeft = (imageSize + nandLoadChunkSize - 1) / nandLoadChunkSize;
+  loadedChunks = std::vector<std::atomic<u64>>((chunksLeft + 63) / 64);
 
   // Get the block size based on the blockSize / pageSize * pageSizePhys
   sfcxState.blockSizePhys = (sfcxState.blockSize / sfcxState.pageSize) * sfcxState.pageSizePhys;
@@ -103,7 +102,8 @@ Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::strin
   pciDevSizes[1] = imageSize; // BAR1
 
   // Read NAND header.
-  memcpy(&sfcxState.nandHeader, reinterpret_cast<char*>(rawImageData.data()),
+  EnsureLoaded(0, sizeof(sfcxState.nandHeader));
+  memcpy(&sfcxState.nandHeader, reinterpret_cast<char*>(rawImageData.get()),
     sizeof(sfcxState.nandHeader));
 
   // Display info about the loaded image header
@@ -161,7 +161,8 @@ Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::strin
   // Get CB_A header data from image data.
   u32 cbaOffset = sfcxState.nandHeader.entry;
   cbaOffset = 1 ? ((cbaOffset / 0x200) * 0x210) + cbaOffset % 0x200 : cbaOffset;
-  memcpy(&cbaHeader, reinterpret_cast<char*>(rawImageData.data() + cbaOffset),
+  EnsureLoaded(cbaOffset, sizeof(cbaHeader));
+  memcpy(&cbaHeader, reinterpret_cast<char*>(rawImageData.get() + cbaOffset),
     sizeof(cbaHeader));
 
   // Byteswap CB_A info from header
@@ -172,7 +173,8 @@ Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::strin
   // Get CB_B header data from image data
   u32 cbbOffset = sfcxState.nandHeader.entry + cbaHeader.length;
   cbbOffset = 1 ? ((cbbOffset / 0x200) * 0x210) + cbbOffset % 0x200 : cbbOffset;
-  memcpy(&cbbHeader, reinterpret_cast<char*>(rawImageData.data() + cbbOffset),
+  EnsureLoaded(cbbOffset, sizeof(cbbHeader));
+  memcpy(&cbbHeader, reinterpret_cast<char*>(rawImageData.get() + cbbOffset),
     sizeof(cbbHeader));
 
   // Byteswap CB_B info from header
@@ -242,20 +244,33 @@ Xe::PCIDev::SFCX::SFCX(const std::string &deviceName, u64 size, const std::strin
       break;
     }
   }
+
+  // Whatever the guest didn't touch yet
+  if (chunksLeft)
+    loaderThread = std::thread(&SFCX::BackgroundLoad, this);
 }
 
 Xe::PCIDev::SFCX::~SFCX() {
+  // Stop loading the image
+  stopLoading = true;
+  if (loaderThread.joinable())
+    loaderThread.join();
+  // Wait for our in flight command
+  ioPool->Drain(this);
   // Clear NAND image data
-  rawImageData.clear();
-  // Terminate thread
-  sfcxThreadRunning = false;
-  if (sfcxThread.joinable())
-    sfcxThread.join();
+  rawImageData.reset();
+  scheduler->UnregisterAsyncSource(Xe::XCPU::eAsyncSource::NANDCompletion, this);
 }
 
 void Xe::PCIDev::SFCX::Start() {
-  // Enter SFCX Thread
-  sfcxThread = std::thread(&Xe::PCIDev::SFCX::sfcxMainLoop, this);
+  // Commands complete on an I/O pool worker, that goes through the scheduler so it can be replayed
+  scheduler->RegisterAsyncSource(Xe::XCPU::eAsyncSource::NANDCompletion, this, [this](const std::vector<u8>&) {
+    sfcxCommandCompletion();
+  });
+  std::lock_guard lck(mutex);
+  started = true;
+  // Pick up anything issued before
+  sfcxSubmitCommand();
 }
 
 void Xe::PCIDev::SFCX::Read(u64 readAddress, u8 *data, u64 size) {
@@ -351,6 +366,7 @@ void Xe::PCIDev::SFCX::Write(u64 writeAddress, const u8 *data, u64 size) {
 
     // Set command register
     sfcxState.commandReg = command;
+    sfcxSubmitCommand();
     break;
   case SFCX_ADDRESS_REG:
     memcpy(&sfcxState.addressReg, data, size);
@@ -393,6 +409,7 @@ void Xe::PCIDev::SFCX::MemSet(u64 writeAddress, s32 data, u64 size) {
     break;
   case SFCX_COMMAND_REG:
     memset(&sfcxState.commandReg, data, size);
+    sfcxSubmitCommand();
     break;
   case SFCX_ADDRESS_REG:
     memset(&sfcxState.addressReg, data, size);
@@ -427,7 +444,8 @@ void Xe::PCIDev::SFCX::ReadRaw(u64 readAddress, u8 *data, u64 size) {
 #ifdef NAND_DEBUG
   LOG_DEBUG(SFCX, "Reading RAW data at 0x{:X} (offset 0x{:X}) for 0x{:X} bytes", readAddress, offset, size);
 #endif // NAND_DEBUG
-  memcpy(data, rawImageData.data() + offset, size);
+  EnsureLoaded(offset, size);
+  memcpy(data, rawImageData.get() + offset, size);
 }
 
 void Xe::PCIDev::SFCX::WriteRaw(u64 writeAddress, const u8 *data, u64 size) {
@@ -436,7 +454,9 @@ void Xe::PCIDev::SFCX::WriteRaw(u64 writeAddress, const u8 *data, u64 size) {
 #ifdef NAND_DEBUG
   LOG_DEBUG(SFCX, "Writing RAW data at 0x{:X} (offset 0x{:X}) for 0x{:X} bytes", writeAddress, offset, size);
 #endif // NAND_DEBUG
-  memcpy(rawImageData.data() + offset, data, size);
+  EnsureLoaded(offset, size);
+  memcpy(rawImageData.get() + offset, data, size);
+  imageGeneration++;
 }
 
 void Xe::PCIDev::SFCX::MemSetRaw(u64 writeAddress, s32 data, u64 size) {
@@ -445,7 +465,9 @@ void Xe::PCIDev::SFCX::MemSetRaw(u64 writeAddress, s32 data, u64 size) {
 #ifdef NAND_DEBUG
   LOG_DEBUG(SFCX, "Setting RAW data at 0x{:X} to 0x{:X} (offset 0x{:X}) for 0x{:X} bytes", writeAddress, data, offset, size);
 #endif // NAND_DEBUG
-  memset(rawImageData.data() + offset, data, size);
+  EnsureLoaded(offset, size);
+  memset(rawImageData.get() + offset, data, size);
+  imageGeneration++;
 }
 
 void Xe::PCIDev::SFCX::ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {
@@ -477,60 +499,72 @@ void Xe::PCIDev::SFCX::ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {
   memcpy(&pciConfigSpace.data[offset], &tmp, size);
 }
 
-void Xe::PCIDev::SFCX::sfcxMainLoop() {
-  Base::SetCurrentThreadName("[Xe] SFCX");
-  sfcxThreadRunning = XeRunning;
-  // Config register should be initialized by now
-  while (sfcxThreadRunning) {
-    // Ensure we haven't shutdown elsewhere.
-    sfcxThreadRunning = XeRunning;
-    if (!sfcxThreadRunning)
-      break;
+void Xe::PCIDev::SFCX::sfcxSubmitCommand() {
+  // Did we got a command?
+  if (!started || sfcxState.commandReg == NO_CMD || completionPending)
+    return;
+  completionPending = true;
 
-    // Did we got a command?
-    if (sfcxState.commandReg != NO_CMD) {
-      // Check the command reg to see what command was issued
-      std::lock_guard lck(mutex);
-      switch (sfcxState.commandReg) {
-      case PHY_PAGE_TO_BUF:
-        sfcxReadPageFromNAND(true);
-        break;
-      case LOG_PAGE_TO_BUF:
-        sfcxReadPageFromNAND(false);
-        break;
-      case DMA_LOG_TO_RAM:
-        sfcxDoDMAfromNAND(false);
-        break;
-      case DMA_PHY_TO_RAM:
-        sfcxDoDMAfromNAND(true);
-        break;
-      case DMA_RAM_TO_PHY:
-        sfcxDoDMAtoNAND();
-        break;
-      case BLOCK_ERASE:
-        sfcxEraseBlock();
-        break;
-      case UNLOCK_CMD_0:
-        LOG_DEBUG(SFCX, "Performing unlock sequence for NAND write.");
-        break;
-      case UNLOCK_CMD_1:
-        break;
-      default:
-        LOG_ERROR(SFCX, "Unrecognized command was issued. 0x{:X}. Issuing interrupt if enabled.", sfcxState.commandReg);
-        break;
-      }
-      if (sfcxState.configReg & CONFIG_INT_EN) {
-        parentBus->RouteInterrupt(PRIO_SFCX);
-        sfcxState.statusReg |= STATUS_INT_CP;
-      }
+  sIORequest request = {};
+  request.type = eIORequestType::Job;
+  request.owner = this;
+  request.job = [this]() {
+    sfcxExecuteCommand();
+    return true;
+  };
+  request.completion = [this](bool) {
+    // Signal completion, see sfcxCommandCompletion
+    scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::NANDCompletion);
+  };
+  ioPool->Submit(std::move(request));
+}
 
-      // Clear Command Register
-      sfcxState.commandReg = NO_CMD;
+void Xe::PCIDev::SFCX::sfcxExecuteCommand() {
+  // Check the command reg to see what command was issued
+  std::lock_guard lck(mutex);
+  switch (sfcxState.commandReg) {
+  case PHY_PAGE_TO_BUF:
+    sfcxReadPageFromNAND(true);
+    break;
+  case LOG_PAGE_TO_BUF:
+    sfcxReadPageFromNAND(false);
+    break;
+  case DMA_LOG_TO_RAM:
+    sfcxDoDMAfromNAND(false);
+    break;
+  case DMA_PHY_TO_RAM:
+    sfcxDoDMAfromNAND(true);
+    break;
+  case DMA_RAM_TO_PHY:
+    sfcxDoDMAtoNAND();
+    break;
+  case BLOCK_ERASE:
+    sfcxEraseBlock();
+    break;
+  case UNLOCK_CMD_0:
+    LOG_DEBUG(SFCX, "Performing unlock sequence for NAND write.");
+    break;
+  case UNLOCK_CMD_1:
+    break;
+  default:
+    LOG_ERROR(SFCX, "Unrecognized command was issued. 0x{:X}. Issuing interrupt if enabled.", sfcxState.commandReg);
+    break;
+  }
+}
 
-      // Set Status to Ready again
-      sfcxState.statusReg &= ~STATUS_BUSY;
-    }
+void Xe::PCIDev::SFCX::sfcxCommandCompletion() {
+  std::lock_guard lck(mutex);
+  if (sfcxState.configReg & CONFIG_INT_EN) {
+    parentBus->RouteInterrupt(PRIO_SFCX);
+    sfcxState.statusReg |= STATUS_INT_CP;
   }
+
+  // Clear Command Register
+  sfcxState.commandReg = NO_CMD;
+
+  // Set Status to Ready again
+  sfcxState.statusReg &= ~STATUS_BUSY;
+  completionPending = false;
 }
 
 bool Xe::PCIDev::SFCX::checkMagic() {
@@ -571,6 +605,7 @@ void Xe::PCIDev::SFCX::sfcxReadPageFromNAND(bool physical) {
   memset(sfcxState.pageBuffer, 0, sizeof(sfcxState.pageBuffer));
 
   // Perform the read
+  EnsureLoaded(nandOffset, sfcxState.pageSizePhys);
   memcpy(sfcxState.pageBuffer, &rawImageData[nandOffset], physical ? sfcxState.pageSizePhys : sfcxState.pageSize);
 }
 
@@ -587,8 +622,10 @@ void Xe::PCIDev::SFCX::sfcxEraseBlock() {
   // Clear the page buffer
   memset(sfcxState.pageBuffer, 0, sizeof(sfcxState.pageBuffer));
 
-  // Perform the erase
+  // Perform the erase. Still loads the block, so the background loader doesn't write it back
+  EnsureLoaded(nandOffset, sfcxState.blockSizePhys);
   memset(&rawImageData[nandOffset], 0, sfcxState.blockSizePhys);
+  imageGeneration++;
 }
 
 void Xe::PCIDev::SFCX::sfcxDoDMAfromNAND(bool physical) {
@@ -622,13 +659,16 @@ void Xe::PCIDev::SFCX::sfcxDoDMAfromNAND(bool physical) {
     memset(sfcxState.pageBuffer, 0, sizeof(sfcxState.pageBuffer));
 
     // Get page data
+    EnsureLoaded(physAddr, sfcxState.pageSizePhys);
     memcpy(sfcxState.pageBuffer, &rawImageData[physAddr], sfcxState.pageSizePhys);
 
     // Write page and spare to RAM
     // On DMA, physical pages are split into Page data and Spare Data, and stored at different locations in memory
     memcpy(dataPhysAddrPtr, &sfcxState.pageBuffer, sfcxState.pageSize);
+    mainMemory->MarkDirtyHost(dataPhysAddrPtr, sfcxState.pageSize);
     if (physical) {
       memcpy(sparePhysAddrPtr, &sfcxState.pageBuffer[sfcxState.pageSize], sfcxState.spareSize);
+      mainMemory->MarkDirtyHost(sparePhysAddrPtr, sfcxState.spareSize);
     }
 
     // Increase buffer pointers
@@ -671,8 +711,10 @@ void Xe::PCIDev::SFCX::sfcxDoDMAtoNAND() {
 
     // Write page and spare to NAND
     // On DMA, physical pages are split into Page data and Spare Data, and stored at different locations in memory
+    EnsureLoaded(physAddr, sfcxState.pageSizePhys);
     memcpy(&rawImageData[physAddr], dataPhysAddrPtr, sfcxState.pageSize);
     memcpy(&rawImageData[physAddr + sfcxState.pageSize], sparePhysAddrPtr, sfcxState.spareSize);
+    imageGeneration++;
 
     // Increase buffer pointers
     dataPhysAddrPtr += sfcxState.pageSize;   // Logical page size
@@ -682,3 +724,85 @@ void Xe::PCIDev::SFCX::sfcxDoDMAtoNAND() {
     physAddr += sfcxState.pageSizePhys;
   }
 }
+
+void Xe::PCIDev::SFCX::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  std::lock_guard lock(mutex);
+  writer.Write(sfcxState);
+  writer.Write(started);
+  writer.Write(completionPending);
+}
+
+void Xe::PCIDev::SFCX::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  std::lock_guard lock(mutex);
+  reader.Read(sfcxState);
+  reader.Read(started);
+  reader.Read(completionPending);
+}
+
+void Xe::PCIDev::SFCX::SaveImage(Base::StateWriter &writer) {
+  std::lock_guard lock(mutex);
+  EnsureAllLoaded();
+  writer.Write<u64>(rawImageSize);
+  writer.WriteCompressed(rawImageData.get(), rawImageSize);
+}
+
+void Xe::PCIDev::SFCX::LoadImage(Base::StateReader &reader) {
+  std::lock_guard lock(mutex);
+  const u64 imageSize = reader.Read<u64>();
+  if (imageSize != rawImageSize) {
+    LOG_ERROR(SFCX, "Save state NAND image is 0x{:X} bytes, the loaded one is 0x{:X}. Not restoring it.",
+      imageSize, rawImageSize);
+    reader.Fail();
+    return;
+  }
+  // Overwrites all of it, nothing may be loaded over it later
+  EnsureAllLoaded();
+  reader.ReadCompressed(rawImageData.get(), rawImageSize);
+  imageGeneration++;
+}
+
+void Xe::PCIDev::SFCX::EnsureLoaded(u64 offset, u64 size) {
+  if (imageLoaded.load(std::memory_order_acquire) || !size || offset >= rawImageSize)
+    return;
+  const u64 lastChunk = (std::min(offset + size, rawImageSize) - 1) / nandLoadChunkSize;
+  for (u64 chunk = offset / nandLoadChunkSize; chunk <= lastChunk; chunk++) {
+    if (!(loadedChunks[chunk >> 6].load(std::memory_order_acquire) & (1ULL << (chunk & 63))))
+      LoadChunk(chunk);
+  }
+}
+
+void Xe::PCIDev::SFCX::LoadChunk(u64 chunk) {
+  std::lock_guard lock(loadMutex);
+  const u64 chunkBit = 1ULL << (chunk & 63);
+  // Someone else may have gotten to it first
+  if (loadedChunks[chunk >> 6].load(std::memory_order_relaxed) & chunkBit)
+    return;
+  const u64 offset = chunk * nandLoadChunkSize;
+  const u64 size = std::min(nandLoadChunkSize, rawImageSize - offset);
+  u8 *chunkData = rawImageData.get() + offset;
+  nandFile.seekg(offset, std::ios::beg);
+  nandFile.read(reinterpret_cast<char*>(chunkData), size);
+  const u64 bytesRead = nandFile ? size : static_cast<u64>(nandFile.gcount());
+  if (bytesRead != size) {
+    LOG_ERROR(SFCX, "Failed to read the NAND image at 0x{:X}, the file may have changed.", offset + bytesRead);
+    memset(chunkData + bytesRead, 0, size - bytesRead);
+    nandFile.clear();
+  }
+  loadedChunks[chunk >> 6].fetch_or(chunkBit, std::memory_order_release);
+  if (--chunksLeft == 0) {
+    nandFile.close();
+    imageLoaded.store(true, std::memory_order_release);
+  }
+}
+
+void Xe::PCIDev::SFCX::BackgroundLoad() {
+  Base::SetCurrentThreadName("[Xe] NAND Loader");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::Device);
+  const u64 chunkCount = (rawImageSize + nandLoadChunkSize - 1) / nandLoadChunkSize;
+  for (u64 chunk = 0; chunk < chunkCount && !stopLoading; chunk++)
+    EnsureLoaded(chunk * nandLoadChunkSize, 1);
+  if (!stopLoading)
+    LOG_INFO(SFCX, "NAND image fully loaded.");
+}
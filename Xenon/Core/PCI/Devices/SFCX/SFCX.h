@@ -5,12 +5,18 @@
 #pragma once
 
 #include <thread>
+#include <atomic>
 #include <fstream>
 #include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "Core/RAM/RAM.h"
 #include "Core/PCI/Bridge/PCIBridge.h"
+#include "Core/PCI/IOPool.h"
 #include "Core/PCI/PCIDevice.h"
+#include "Core/XCPU/Context/Scheduler/XenonScheduler.h"
 
 // Device Size (at address 0xEA00C000)
 #define SFCX_DEV_SIZE 0x400
@@ -176,10 +182,10 @@ struct SFCX_STATE {
 class SFCX : public PCIDevice {
 public:
   SFCX(const std::string &deviceName, u64 size, const std::string &nandLoadPath,
-    PCIBridge *parentPCIBridge, RAM *ram);
+    PCIBridge *parentPCIBridge, RAM *ram, Xe::XCPU::XenonScheduler *schedulerPtr, IOPool *ioPoolPtr);
   ~SFCX();
 
-  // Starts the thread
+  // Starts accepting commands
   void Start();
 
   // PCI Read/Write methods to the SFCX device.
@@ -196,21 +202,37 @@ public:
   void ConfigRead(u64 readAddress, u8* data, u64 size) override;
   void ConfigWrite(u64 writeAddress, const u8* data, u64 size) override;
 
+  // Save state. Registers go in the device state, the image is saved separately since it only has to be stored
+  // again once it changed (see GetImageGeneration).
+  void SaveState(Base::StateWriter &writer) override;
+  void LoadState(Base::StateReader &reader) override;
+  void SaveImage(Base::StateWriter &writer);
+  void LoadImage(Base::StateReader &reader);
+  // Bumped on every write to the image.
+  u64 GetImageGeneration() const { return imageGeneration; }
+
   bool hasInitialised = false;
   // Init skips
   u64 initSkip1 = 0, initSkip2 = 0;
 private:
-  // Secure Flash Controller for Xbox main loop.
-  void sfcxMainLoop();
+  // Submits the issued command to the I/O pool, if we're not busy.
+  void sfcxSubmitCommand();
+  // Runs the issued command, on an I/O pool worker.
+  void sfcxExecuteCommand();
   // Magic check
   bool checkMagic();
-  // Thread object
-  std::thread sfcxThread;
-  // Thread running
-  volatile bool sfcxThreadRunning = false;
+  // Makes sure the given range of the image was read from the file.
+  void EnsureLoaded(u64 offset, u64 size);
+  void EnsureAllLoaded() { EnsureLoaded(0, rawImageSize); }
+  // Reads a chunk of the image, if no one did yet.
+  void LoadChunk(u64 chunk);
+  // Reads whatever is left of the image, on a thread of its own.
+  void BackgroundLoad();
+  // Accepting commands
+  bool started = false;
   // SFCX State
   SFCX_STATE sfcxState{};
-  // I/O File stream.
+  // I/O File stream. Open until the whole image was read.
   std::ifstream nandFile;
   // PCI Bridge pointer. Used for Interrupts.
   PCIBridge *parentBus = nullptr;
@@ -218,6 +240,14 @@ private:
   std::recursive_mutex mutex;
   // RAM pointer. Used for DMA.
   RAM *mainMemory = nullptr;
+  // Event scheduler, delivers command completions.
+  Xe::XCPU::XenonScheduler *scheduler = nullptr;
+  // Device I/O pool, runs the commands.
+  IOPool *ioPool = nullptr;
+  // A command is in flight, don't run it again.
+  bool completionPending = false;
+  // Command completion, delivered through the scheduler.
+  void sfcxCommandCompletion();
   // Read a page from memory to page buffer.
   void sfcxReadPageFromNAND(bool physical);
   // Erase NAND Block
@@ -227,7 +257,20 @@ private:
   // Does a DMA operation from physical memory to NAND.
   void sfcxDoDMAtoNAND();
   // RAW NAND Data from loaded image.
-  std::vector<u8> rawImageData{};
+  std::unique_ptr<u8[]> rawImageData{};
+  u64 rawImageSize = 0;
+  // Image chunks read so far, one bit each. Once all of them are, imageLoaded skips the checks
+  static constexpr u64 nandLoadChunkSize = 0x10000;
+  std::vector<std::atomic<u64>> loadedChunks{};
+  std::atomic<bool> imageLoaded = false;
+  // Chunks not read yet, guarded by loadMutex along with the file
+  u64 chunksLeft = 0;
+  std::mutex loadMutex;
+  // Background image loader
+  std::thread loaderThread;
+  std::atomic<bool> stopLoading = false;
+  // Image write counter.
+  std::atomic<u64> imageGeneration = 0;
 };
 
 } // namespace PCIDev
@@ -9,6 +9,7 @@
 #include "Base/Error.h"
 #include "Base/Hash.h"
 #include "Base/Thread.h"
+#include "Base/Topology.h"
 
 #include "HANA_State.h"
 #include "SMC_Config.h"
@@ -58,14 +59,24 @@
 #define CLCK_INT_READY 0x1
 #define CLCK_INT_TAKEN 0x3
 
+// Clock interrupt period.
+// According to sources online, this timer runs at a 1ms frequency.
+// TODO: Verify on hardware.
+// Leaving this on 10ms for now, we're not fast enough for a 1ms timer, and crashes the emulator.
+#define SMC_CLOCK_INT_PERIOD 10ms
+
 // Class Constructor.
-Xe::PCIDev::SMC::SMC(const std::string &deviceName, u64 size, PCIBridge *parentPCIBridge) :
+Xe::PCIDev::SMC::SMC(const std::string &deviceName, u64 size, PCIBridge *parentPCIBridge,
+  Xe::XCPU::XenonScheduler *schedulerPtr) :
   PCIDevice(deviceName, size) {
   LOG_INFO(SMC, "Core: Initializing...");
 
   // Assign our parent PCI Bus pointer
   pciBridge = parentPCIBridge;
 
+  // Assign our scheduler pointer
+  scheduler = schedulerPtr;
+
   // Assign our core sate, this is already filled with config data regarding
   // AVPACK, PWRON Reason and TrayState
   smcCoreState.currentUARTSystem = Base::JoaatStringHash(Config::smc.uartSystem);
@@ -117,6 +128,20 @@ Xe::PCIDev::SMC::SMC(const std::string &deviceName, u64 size, PCIBridge *parentP
   }
   smcCoreState.uartHandle->uartPresent = true;
 
+  // Start ticking the clock interrupt
+  clockEvent = scheduler->RegisterEvent("SMC Clock", [this](u64 dueTick, u64 currentTick) {
+    smcClockEvent(dueTick, currentTick);
+  });
+  scheduler->ScheduleEvent(clockEvent, Xe::XCPU::XenonScheduler::ToTicks(SMC_CLOCK_INT_PERIOD));
+
+  // FIFO responses and UART input happen asynchronously, they go through the scheduler so they can be replayed
+  scheduler->RegisterAsyncSource(Xe::XCPU::eAsyncSource::SMCFifo, this, [this](const std::vector<u8> &data) {
+    smcFifoResponse(data);
+  });
+  scheduler->RegisterAsyncSource(Xe::XCPU::eAsyncSource::UARTInput, this, [this](const std::vector<u8> &data) {
+    smcUARTInput(data);
+  });
+
   // Enter main execution thread.
   smcThread = std::thread(&SMC::smcMainThread, this);
 }
@@ -124,9 +149,12 @@ Xe::PCIDev::SMC::SMC(const std::string &deviceName, u64 size, PCIBridge *parentP
 // Class Destructor.
 Xe::PCIDev::SMC::~SMC() {
   LOG_INFO(SMC, "Shutting SMC down...");
+  scheduler->UnregisterEvent(clockEvent);
   smcThreadRunning = false;
   if (smcThread.joinable())
     smcThread.join();
+  scheduler->UnregisterAsyncSource(Xe::XCPU::eAsyncSource::SMCFifo, this);
+  scheduler->UnregisterAsyncSource(Xe::XCPU::eAsyncSource::UARTInput, this);
   smcCoreState.uartHandle->Shutdown();
   smcCoreState.uartHandle.reset();
   LOG_INFO(SMC, "Done!");
@@ -139,6 +167,15 @@ void Xe::PCIDev::SMC::Read(u64 readAddress, u8 *data, u64 size) {
   mutex.lock();
   switch (regOffset) {
   case UART_BYTE_OUT_REG: // UART Data Out Register
+    if (scheduler->IsDeterministic()) {
+      // Input was already received by our thread
+      if (!uartRxQueue.empty()) {
+        smcPCIState.uartOutReg = uartRxQueue.front();
+        uartRxQueue.pop();
+        memcpy(data, &smcPCIState.uartOutReg, size);
+      }
+      break;
+    }
     smcPCIState.uartOutReg = smcCoreState.uartHandle->Read();
     if (smcCoreState.uartHandle->retVal) {
       memcpy(data, &smcPCIState.uartOutReg, size);
@@ -147,7 +184,9 @@ void Xe::PCIDev::SMC::Read(u64 readAddress, u8 *data, u64 size) {
   case UART_STATUS_REG: // UART Status Register
     // First lets check if the UART has already been setup, if so, proceed to do
     // the TX/RX.
-    smcPCIState.uartStatusReg = smcCoreState.uartHandle->ReadStatus();
+    // In deterministic mode, the TX side is always ready and only delivered input counts.
+    smcPCIState.uartStatusReg = scheduler->IsDeterministic() ?
+      UART_STATUS_EMPTY | (uartRxQueue.empty() ? 0 : UART_STATUS_DATA_PRES) : smcCoreState.uartHandle->ReadStatus();
     // Check if UART is already initialized.
     if (smcCoreState.uartHandle->SetupNeeded()) {
       // XeLL doesn't initialize UART before sending data trough it. Initialize
@@ -388,17 +427,103 @@ void Xe::PCIDev::SMC::setupUART(u32 uartConfig) {
   }
 }
 
+// Save state. The UART setup is host configuration and stays as it is
+void Xe::PCIDev::SMC::SaveState(Base::StateWriter &writer) {
+  PCIDevice::SaveState(writer);
+  mutex.lock();
+  writer.Write(smcPCIState);
+  writer.Write(smcCoreState.currTrayState);
+  writer.Write(smcCoreState.currPowerOnReason);
+  writer.Write(smcCoreState.currAVPackType);
+  writer.Write(smcCoreState.fifoDataBuffer);
+  writer.Write(smcCoreState.fifoBufferPos);
+  writer.Write<bool>(fifoResponsePending);
+  std::vector<u8> rxQueue = {};
+  for (std::queue<u8> queue = uartRxQueue; !queue.empty(); queue.pop())
+    rxQueue.push_back(queue.front());
+  writer.WriteVector(rxQueue);
+  mutex.unlock();
+}
+
+void Xe::PCIDev::SMC::LoadState(Base::StateReader &reader) {
+  PCIDevice::LoadState(reader);
+  mutex.lock();
+  reader.Read(smcPCIState);
+  reader.Read(smcCoreState.currTrayState);
+  reader.Read(smcCoreState.currPowerOnReason);
+  reader.Read(smcCoreState.currAVPackType);
+  reader.Read(smcCoreState.fifoDataBuffer);
+  reader.Read(smcCoreState.fifoBufferPos);
+  fifoResponsePending = reader.Read<bool>();
+  std::vector<u8> rxQueue = {};
+  reader.ReadVector(rxQueue);
+  uartRxQueue = {};
+  for (const u8 byte : rxQueue)
+    uartRxQueue.push(byte);
+  mutex.unlock();
+}
+
+// SMC Clock Interrupt, fired by the scheduler
+void Xe::PCIDev::SMC::smcClockEvent(u64 dueTick, u64 currentTick) {
+  // Check for SMC Clock interrupt register.
+  // 
+  // Clock Int Enabled and not taken.
+  mutex.lock();
+  if (smcPCIState.clockIntEnabledReg == CLCK_INT_ENABLED && smcPCIState.clockIntStatusReg == CLCK_INT_READY) {
+    smcPCIState.clockIntStatusReg = CLCK_INT_TAKEN;
+    pciBridge->RouteInterrupt(PRIO_CLOCK);
+  }
+  mutex.unlock();
+  // Keep a steady cadence, but don't try to catch up on ticks missed while nothing ran
+  const u64 period = Xe::XCPU::XenonScheduler::ToTicks(SMC_CLOCK_INT_PERIOD);
+  scheduler->ScheduleEventAt(clockEvent, std::max(dueTick + period, currentTick + 1));
+}
+
+// SMC FIFO command response, hands the reply over to the system
+void Xe::PCIDev::SMC::smcFifoResponse(const std::vector<u8> &data) {
+  if (data.size() != sizeof(smcCoreState.fifoDataBuffer) + 1) {
+    LOG_ERROR(SMC, "Malformed FIFO response of {} bytes, dropping it.", data.size());
+    fifoResponsePending = false;
+    return;
+  }
+  const bool noResponse = data.back() != 0;
+  mutex.lock();
+  memcpy(smcCoreState.fifoDataBuffer, data.data(), sizeof(smcCoreState.fifoDataBuffer));
+
+  // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY. Outside of deterministic mode this was done as soon as we picked
+  // up the command.
+  if (scheduler->IsDeterministic())
+    smcPCIState.fifoInStatusReg = FIFO_STATUS_READY;
+
+  // Set FIFO_OUT_STATUS_REG to FIFO_STATUS_READY, signaling we're ready to
+  // transmit a response.
+  smcPCIState.fifoOutStatusReg = FIFO_STATUS_READY;
+
+  // If interrupts are active set Int status and issue one.
+  if (smcPCIState.smiIntEnabledReg & SMI_INT_ENABLED && noResponse == false) {
+    smcPCIState.smiIntPendingReg = SMI_INT_PENDING;
+    pciBridge->RouteInterrupt(PRIO_SMM);
+  }
+  fifoResponsePending = false;
+  mutex.unlock();
+}
+
+// UART input, received by our thread in deterministic mode
+void Xe::PCIDev::SMC::smcUARTInput(const std::vector<u8> &data) {
+  mutex.lock();
+  for (const u8 byte : data)
+    uartRxQueue.push(byte);
+  mutex.unlock();
+}
+
 // SMC Main Thread
 void Xe::PCIDev::SMC::smcMainThread() {
   Base::SetCurrentThreadName("[Xe] SMC");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::Device);
   // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY to indicate we are ready to
   // receive a message.
   smcPCIState.fifoInStatusReg = FIFO_STATUS_READY;
 
-  // Timer for measuring elapsed time since last Clock Interrupt.
-  std::chrono::steady_clock::time_point timerStart =
-      std::chrono::steady_clock::now();
-  
   // Fat consoles vs Slims have different initial values for the HANA/ANA
   u32 *hanaState = HANA_State;
   switch (Config::highlyExperimental.consoleRevison) {
@@ -439,6 +564,7 @@ void Xe::PCIDev::SMC::smcMainThread() {
     reinterpret_cast<u8*>(hanaState)[0xFE] = 0x23;
     break;
   }
+  const bool deterministic = scheduler->IsDeterministic();
   while (smcThreadRunning) {
     MICROPROFILE_SCOPEI("[Xe::PCI]", "SMC::Loop", MP_AUTO);
     // The System Management Controller (SMC) does the following:
@@ -447,7 +573,7 @@ void Xe::PCIDev::SMC::smcMainThread() {
     // * Does the UART/Serial communication between the console and remote
     // Serial Device/PC.
     // * Ticks the clock and sends an interrupt (PRIO_CLOCK) every x
-    // milliseconds.
+    // milliseconds. This one is driven by the scheduler, see smcClockEvent.
 
     // Core State (PowerOn Cause, SMC Ver, FAN Speed, Temps, etc...) should be
     // already set.
@@ -503,16 +629,23 @@ void Xe::PCIDev::SMC::smcMainThread() {
     // Check wheter we've received a command. If so, process it.
     // Software sets FIFO_IN_STATUS_REG to FIFO_STATUS_BUSY after it has
     // finished sending a command.
-    if (smcPCIState.fifoInStatusReg == FIFO_STATUS_BUSY) {
-      // This is set first as software waits for this register to become Ready
-      // in order to read a reply. Set FIFO_OUT_STATUS_REG to FIFO_STATUS_BUSY
-      smcPCIState.fifoOutStatusReg = FIFO_STATUS_BUSY;
-
-      // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY
-      smcPCIState.fifoInStatusReg = FIFO_STATUS_READY;
+    if (smcPCIState.fifoInStatusReg == FIFO_STATUS_BUSY && !fifoResponsePending) {
+      fifoResponsePending = true;
+      // In deterministic mode the system must not see any of this before the response is delivered, the
+      // registers already read busy until then
+      if (!deterministic) {
+        // This is set first as software waits for this register to become Ready
+        // in order to read a reply. Set FIFO_OUT_STATUS_REG to FIFO_STATUS_BUSY
+        smcPCIState.fifoOutStatusReg = FIFO_STATUS_BUSY;
+
+        // Set FIFO_IN_STATUS_REG to FIFO_STATUS_READY
+        smcPCIState.fifoInStatusReg = FIFO_STATUS_READY;
+      }
 
       // Some commands does'nt have responses/interrupts.
       bool noResponse = false;
+      // A reboot resets us, the command goes with everything else
+      bool rebooted = false;
 
       // Note that the first byte in the response is always Command ID.
       //
@@ -687,6 +820,7 @@ void Xe::PCIDev::SMC::smcMainThread() {
           mutex.unlock();
           XeMain::Reboot(static_cast<Xe::PCIDev::SMC_PWR_REASON>(smcCoreState.fifoDataBuffer[2]));
           mutex.lock();
+          rebooted = true;
         } else {
           LOG_WARNING(SMC, "Unimplemented SMC_FIFO_CMD Subtype in SMC_SET_STANDBY: 0x{:02X}",
             static_cast<u16>(smcCoreState.fifoDataBuffer[1]));
@@ -746,46 +880,37 @@ void Xe::PCIDev::SMC::smcMainThread() {
             static_cast<u16>(smcCoreState.fifoDataBuffer[0]));
         break;
       }
-      mutex.unlock();
-
-      // Set FIFO_OUT_STATUS_REG to FIFO_STATUS_READY, signaling we're ready to
-      // transmit a response.
-      smcPCIState.fifoOutStatusReg = FIFO_STATUS_READY;
-
-      // If interrupts are active set Int status and issue one.
-      if (smcPCIState.smiIntEnabledReg & SMI_INT_ENABLED && noResponse == false) {
-        // Wait a small delay to mimic hardware. This allows code in xboxkrnl.exe such as
-        // KeWaitForSingleObject to correctly setup waiting code.
-        // This is no longer needed due to mutexes
-        mutex.lock();
-        smcPCIState.smiIntPendingReg = SMI_INT_PENDING;
-        pciBridge->RouteInterrupt(PRIO_SMM);
+      if (rebooted) {
+        mutex.unlock();
+      } else {
+        // Hand the response over, see smcFifoResponse
+        std::vector<u8> response(std::begin(smcCoreState.fifoDataBuffer), std::end(smcCoreState.fifoDataBuffer));
+        response.push_back(noResponse);
         mutex.unlock();
+        scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::SMCFifo, std::move(response));
       }
     }
 
-    // Measure elapsed time.
-    std::chrono::steady_clock::time_point timerNow =
-      std::chrono::steady_clock::now();
-
-    // Check for SMC Clock interrupt register.
-    // 
-    // Clock Int Enabled.
-    if (smcPCIState.clockIntEnabledReg == CLCK_INT_ENABLED) {
-      // Clock Interrupt Not Taken.
-      if (smcPCIState.clockIntStatusReg == CLCK_INT_READY) {
-        // According to sources online, this timer runs at a 1ms frequency.
-        // TODO: Verify on hardware.
-        // Leaving this on 10ms for now, we're not fast enough for a 1ms timer, and crashes the emulator.
-        if (timerNow >= timerStart + 10ms) {
-          // Update internal timer.
-          timerStart = std::chrono::steady_clock::now();
-          mutex.lock();
-          smcPCIState.clockIntStatusReg = CLCK_INT_TAKEN;
-          pciBridge->RouteInterrupt(PRIO_CLOCK);
-          mutex.unlock();
+    /*
+            2. UART input (deterministic mode).
+    */
+
+    // Received data is picked up here and delivered through the scheduler, so the system sees it at the same point
+    // in execution when replaying.
+    if (deterministic) {
+      std::vector<u8> input = {};
+      mutex.lock();
+      if (!smcCoreState.uartHandle->SetupNeeded()) {
+        while (smcCoreState.uartHandle->ReadStatus() & UART_STATUS_DATA_PRES) {
+          const u8 byte = smcCoreState.uartHandle->Read();
+          if (!smcCoreState.uartHandle->retVal)
+            break;
+          input.push_back(byte);
         }
       }
+      mutex.unlock();
+      if (!input.empty())
+        scheduler->PostAsyncEvent(Xe::XCPU::eAsyncSource::UARTInput, std::move(input));
     }
   }
 }
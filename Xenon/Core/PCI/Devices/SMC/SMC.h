@@ -14,6 +14,7 @@
 
 #include "Core/PCI/Bridge/PCIBridge.h"
 #include "Core/PCI/PCIDevice.h"
+#include "Core/XCPU/Context/Scheduler/XenonScheduler.h"
 
 #include "Core/PCI/Devices/SMC/UART/UART.h"
 
@@ -239,7 +240,7 @@ struct SMC_CORE_STATE {
 class SMC : public PCIDevice {
 public:
   SMC(const std::string &deviceName, u64 size,
-    PCIBridge *parentPCIBridge);
+    PCIBridge *parentPCIBridge, Xe::XCPU::XenonScheduler *schedulerPtr);
   ~SMC();
 
   // Read/Write functions
@@ -248,6 +249,8 @@ public:
   void MemSet(u64 writeAddress, s32 data, u64 size) override;
   void ConfigRead(u64 readAddress, u8* data, u64 size) override;
   void ConfigWrite(u64 writeAddress, const u8* data, u64 size) override;
+  void SaveState(Base::StateWriter &writer) override;
+  void LoadState(Base::StateReader &reader) override;
 
   void SetPowerOnReason(const SMC_PWR_REASON &reason) {
     smcCoreState.currPowerOnReason = reason;
@@ -283,6 +286,27 @@ private:
   // SMC Main Thread
   void smcMainThread();
 
+  // Event scheduler, drives the clock interrupt
+  Xe::XCPU::XenonScheduler *scheduler = nullptr;
+
+  // Clock interrupt event
+  Xe::XCPU::SchedulerEventID clockEvent = Xe::XCPU::schedulerInvalidEvent;
+
+  // Clock interrupt event callback
+  void smcClockEvent(u64 dueTick, u64 currentTick);
+
+  // A FIFO command response is on its way, don't pick up the next command yet
+  volatile bool fifoResponsePending = false;
+
+  // FIFO command response, delivered through the scheduler. Data is the response followed by the no response flag
+  void smcFifoResponse(const std::vector<u8> &data);
+
+  // Deterministic mode: UART input delivered through the scheduler, waiting to be read by the system
+  std::queue<u8> uartRxQueue = {};
+
+  // UART input callback
+  void smcUARTInput(const std::vector<u8> &data);
+
   // UART/COM Port Setup
   void setupUART(u32 uartConfig);
 };
@@ -7,6 +7,7 @@
 #include "Base/Error.h"
 #include "Base/Global.h"
 #include "Base/Thread.h"
+#include "Base/Topology.h"
 #ifndef _WIN32
 #include <signal.h>
 #endif //ifndef _WIN32
@@ -16,6 +17,7 @@
 // UART Thread
 void HW_UART_SOCK::uartMainThread() {
   Base::SetCurrentThreadName("[Xe::SMC::UART] Transfer");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::Device);
   if (uartInitialized) {
     LOG_INFO(SMC, "UART Initialized Successfully!");
   }
@@ -46,6 +48,7 @@ void HW_UART_SOCK::uartMainThread() {
 // UART Receive Thread
 void HW_UART_SOCK::uartReceiveThread() {
   Base::SetCurrentThreadName("[Xe::SMC::UART] Receive");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::Device);
   while (uartThreadRunning) {
     std::unique_lock<std::mutex> lock(uartMutex);
     char c = -1;
@@ -0,0 +1,123 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "IOPool.h"
+
+#include <algorithm>
+#include <string>
+
+#include "Base/Logging/Log.h"
+#include "Base/Thread.h"
+#include "Base/Topology.h"
+#include "Core/RAM/RAM.h"
+
+Xe::PCIDev::IOPool::IOPool(RAM *ramPtr, u32 workerCount) :
+  ram(ramPtr) {
+  workerCount = std::clamp<u32>(workerCount, 1, 16);
+  running.resize(workerCount, nullptr);
+  for (u32 i = 0; i != workerCount; ++i) {
+    workers.emplace_back(&IOPool::workerLoop, this, i);
+  }
+  LOG_INFO(PCIBridge, "Device I/O pool started with {} workers.", workerCount);
+}
+
+Xe::PCIDev::IOPool::~IOPool() {
+  {
+    std::lock_guard lock(queueMutex);
+    stopping = true;
+    // Nothing is left to complete them
+    queue.clear();
+  }
+  queueCondition.notify_all();
+  for (std::thread &worker : workers) {
+    if (worker.joinable())
+      worker.join();
+  }
+}
+
+void Xe::PCIDev::IOPool::Submit(sIORequest &&request) {
+  {
+    std::lock_guard lock(queueMutex);
+    if (stopping)
+      return;
+    queue.push_back(std::move(request));
+  }
+  queueCondition.notify_one();
+}
+
+void Xe::PCIDev::IOPool::Drain(const void *owner) {
+  std::unique_lock lock(queueMutex);
+  std::erase_if(queue, [owner](const sIORequest &request) { return request.owner == owner; });
+  doneCondition.wait(lock, [&] { return std::find(running.begin(), running.end(), owner) == running.end(); });
+}
+
+void Xe::PCIDev::IOPool::WaitIdle() {
+  std::unique_lock lock(queueMutex);
+  doneCondition.wait(lock, [this] {
+    return queue.empty() && std::all_of(running.begin(), running.end(), [](const void *owner) { return !owner; });
+  });
+}
+
+void Xe::PCIDev::IOPool::workerLoop(u32 workerId) {
+  Base::SetCurrentThreadName("[Xe] I/O " + std::to_string(workerId));
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::Device);
+  for (;;) {
+    sIORequest request = {};
+    {
+      std::unique_lock lock(queueMutex);
+      // Sleep until there's work, idle devices must not cost anything
+      queueCondition.wait(lock, [this] { return stopping || !queue.empty(); });
+      if (stopping)
+        break;
+      request = std::move(queue.front());
+      queue.pop_front();
+      running[workerId] = request.owner;
+    }
+
+    const bool success = execute(request);
+    if (request.completion)
+      request.completion(success);
+
+    {
+      std::lock_guard lock(queueMutex);
+      running[workerId] = nullptr;
+    }
+    doneCondition.notify_all();
+  }
+}
+
+bool Xe::PCIDev::IOPool::execute(sIORequest &request) {
+  switch (request.type) {
+  case eIORequestType::Read:
+  case eIORequestType::Write: {
+    const bool read = request.type == eIORequestType::Read;
+    u64 offset = request.offset;
+    for (const sIOSegment &segment : request.segments) {
+      if (segment.size == 0)
+        continue;
+      // Segments come from guest tables, the whole of it must be in RAM
+      u8 *hostPtr = ram->GetPointerToAddress(segment.physAddress);
+      if (!hostPtr || segment.physAddress - RAM_START_ADDR + static_cast<u64>(segment.size) > ram->GetSize()) {
+        LOG_ERROR(PCIBridge, "I/O request segment at {:#x} ({:#x} bytes) is outside of RAM.", segment.physAddress,
+          segment.size);
+        return false;
+      }
+      if (read) {
+        if (!request.storage->Read(offset, hostPtr, segment.size))
+          return false;
+        ram->MarkDirty(segment.physAddress, segment.size);
+      } else if (!request.storage->Write(offset, hostPtr, segment.size)) {
+        return false;
+      }
+      offset += segment.size;
+    }
+    return true;
+  }
+  case eIORequestType::Flush:
+    return request.storage->Flush();
+  case eIORequestType::Job:
+    return request.job ? request.job() : true;
+  }
+  return false;
+}
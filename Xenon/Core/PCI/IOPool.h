@@ -0,0 +1,99 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Base/Types.h"
+
+class RAM;
+
+namespace Xe {
+namespace PCIDev {
+
+// Backing storage of a device (disk images), read and written by the I/O pool. Requests may run concurrently on
+// different workers, so implementations must use positional I/O.
+class IOStorage {
+public:
+  virtual ~IOStorage() = default;
+  virtual bool Read(u64 offset, u8 *destination, u32 size) = 0;
+  virtual bool Write(u64 offset, const u8 *source, u32 size) = 0;
+  virtual bool Flush() { return true; }
+};
+
+enum class eIORequestType : u8 {
+  Read,  // Storage to guest memory
+  Write, // Guest memory to storage
+  Flush, // Flushes the storage
+  Job    // Runs a device provided function
+};
+
+// A contiguous range of guest physical memory.
+struct sIOSegment {
+  u32 physAddress = 0;
+  u32 size = 0;
+};
+
+// Called on the worker once a request is done. Devices post their scheduler async event from here, so the
+// completion (and its interrupt) is delivered on the guest side and stays replayable.
+using IOCompletion = std::function<void(bool success)>;
+
+struct sIORequest {
+  eIORequestType type = eIORequestType::Job;
+  // Device that submitted it, see Drain.
+  const void *owner = nullptr;
+  // Read/Write/Flush target, the storage range starts at offset and is spread over the segments in order.
+  IOStorage *storage = nullptr;
+  u64 offset = 0;
+  std::vector<sIOSegment> segments = {};
+  // Job body, returns whether it succeeded.
+  std::function<bool()> job = {};
+  IOCompletion completion = {};
+};
+
+// Device I/O pool
+// Small set of host threads shared by the storage devices (HDD, ODD, SFCX). Devices submit requests from their
+// register write handlers instead of polling their registers on a thread of their own, so idle devices cost nothing
+// and requests from different devices overlap.
+class IOPool {
+public:
+  IOPool(RAM *ramPtr, u32 workerCount);
+  ~IOPool();
+
+  // Queues a request, returns right away.
+  void Submit(sIORequest &&request);
+  // Drops the queued requests of owner and waits for its running ones. Devices call it before going away.
+  void Drain(const void *owner);
+  // Waits until there's nothing queued or running. Completions may queue more work, that is waited for too.
+  // Used to get the devices to a stable state (save states), nothing else must be submitting meanwhile.
+  void WaitIdle();
+
+private:
+  // Worker thread loop.
+  void workerLoop(u32 workerId);
+  // Runs a request, returns whether it succeeded.
+  bool execute(sIORequest &request);
+
+  RAM *ram = nullptr;
+  std::vector<std::thread> workers = {};
+  // Guards the queue and the running set.
+  std::mutex queueMutex;
+  // Signaled on new requests and on shutdown.
+  std::condition_variable queueCondition;
+  // Signaled when a request is done.
+  std::condition_variable doneCondition;
+  std::deque<sIORequest> queue = {};
+  // Owners of the requests being run, one per worker.
+  std::vector<const void*> running = {};
+  bool stopping = false;
+};
+
+} // namespace PCIDev
+} // namespace Xe
@@ -7,6 +7,7 @@
 #include <cstring>
 #include <string>
 
+#include "Base/StateStream.h"
 #include "Core/PCI/PCIe.h"
 
 struct PCIDeviceInfo {
@@ -27,7 +28,36 @@ public:
   virtual void ConfigRead(u64 readAddress, u8 *data, u64 size) {}
   virtual void ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {}
 
+  // Save state. Devices with registers of their own extend these, calling ours first.
+  virtual void SaveState(Base::StateWriter &writer) {
+    writer.Write(pciConfigSpace);
+    writer.Write(pciDevSizes);
+  }
+  virtual void LoadState(Base::StateReader &reader) {
+    reader.Read(pciConfigSpace);
+    reader.Read(pciDevSizes);
+  }
+
+  // Power-on state. Captured once the device is set up, Reset puts every register back to it in place, keeping
+  // whatever the device allocated and opened (images, worker threads).
+  void CapturePowerOnState() { powerOnState.Capture(*this); }
+  virtual void Reset() { powerOnState.Restore(*this); }
+
   std::string GetDeviceName() { return deviceInfo.deviceName; }
+  u64 GetDeviceSize() { return deviceInfo.size; }
+
+  // Returns the base address of the given BAR
+  u32 GetBAR(u8 index) {
+    switch (index) {
+    case 0: return pciConfigSpace.configSpaceHeader.BAR0;
+    case 1: return pciConfigSpace.configSpaceHeader.BAR1;
+    case 2: return pciConfigSpace.configSpaceHeader.BAR2;
+    case 3: return pciConfigSpace.configSpaceHeader.BAR3;
+    case 4: return pciConfigSpace.configSpaceHeader.BAR4;
+    case 5: return pciConfigSpace.configSpaceHeader.BAR5;
+    }
+    return 0;
+  }
 
   // Checks wether a given address is mapped in the device's BAR's
   bool IsAddressMappedInBAR(u32 address) {
@@ -66,4 +96,5 @@ public:
   u32 pciDevSizes[6] = {};
 private:
   PCIDeviceInfo deviceInfo = { "" };
+  Base::StateSnapshot powerOnState = {};
 };
@@ -0,0 +1,205 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <bit>
+#include <iterator>
+
+#include "Base/Error.h"
+#include "Base/Logging/Log.h"
+
+#include "DirtyTracker.h"
+
+RAMDirtyTracker::~RAMDirtyTracker() {
+#ifdef __linux__
+  if (pagemapFd != -1)
+    close(pagemapFd);
+#endif
+}
+
+void RAMDirtyTracker::Initialize(u8 *base, u64 size, u64 mappedSize, eDirtyTrackingMode trackingMode) {
+  std::lock_guard lock(trackerMutex);
+  hostBase = base;
+  hostMappedSize = mappedSize;
+  ramSize = size;
+  pageCount = (size + DIRTY_PAGE_SIZE - 1) >> DIRTY_PAGE_SHIFT;
+  wordCount = (pageCount + 63) / 64;
+  sharedBitmap = std::make_unique<std::atomic<u64>[]>(wordCount);
+  for (u64 i = 0; i != wordCount; ++i) {
+    sharedBitmap[i].store(0, std::memory_order_relaxed);
+  }
+
+  mode = trackingMode;
+  if (mode == eDirtyTrackingMode::HostSoftDirty) {
+#ifdef __linux__
+    if (pagemapFd == -1)
+      pagemapFd = open("/proc/self/pagemap", O_RDONLY);
+    const s32 clearRefsFd = open("/proc/self/clear_refs", O_WRONLY);
+    if (pagemapFd == -1 || clearRefsFd == -1) {
+      LOG_WARNING(System, "RAM: Soft-dirty tracking is unavailable ({}), using software tracking",
+        Base::GetLastErrorMsg());
+      mode = eDirtyTrackingMode::Software;
+    }
+    if (clearRefsFd != -1)
+      close(clearRefsFd);
+#else
+    LOG_WARNING(System, "RAM: Soft-dirty tracking is only available on Linux, using software tracking");
+    mode = eDirtyTrackingMode::Software;
+#endif
+  }
+
+  // Contents are new to everyone
+  for (auto &consumer : consumers) {
+    if (consumer.active)
+      consumer.bitmap.assign(wordCount, ~0ULL);
+  }
+  UpdateTracking();
+}
+
+s32 RAMDirtyTracker::RegisterConsumer(const std::string &name) {
+  std::lock_guard lock(trackerMutex);
+  for (s32 consumerId = 0; consumerId != DIRTY_MAX_CONSUMERS; ++consumerId) {
+    sConsumer &consumer = consumers[consumerId];
+    if (consumer.active)
+      continue;
+    consumer.active = true;
+    consumer.name = name;
+    consumer.bitmap.assign(wordCount, ~0ULL);
+    UpdateTracking();
+    LOG_DEBUG(System, "RAM: Dirty tracking consumer '{}' registered ({})", name, consumerId);
+    return consumerId;
+  }
+  LOG_ERROR(System, "RAM: No free dirty tracking slots for '{}'", name);
+  return -1;
+}
+
+void RAMDirtyTracker::UnregisterConsumer(s32 consumerId) {
+  std::lock_guard lock(trackerMutex);
+  if (consumerId < 0 || consumerId >= DIRTY_MAX_CONSUMERS)
+    return;
+  sConsumer &consumer = consumers[consumerId];
+  consumer.active = false;
+  consumer.name.clear();
+  consumer.bitmap.clear();
+  UpdateTracking();
+}
+
+void RAMDirtyTracker::MarkAllDirty() {
+  std::lock_guard lock(trackerMutex);
+  for (auto &consumer : consumers) {
+    if (consumer.active)
+      consumer.bitmap.assign(wordCount, ~0ULL);
+  }
+}
+
+std::vector<u64> RAMDirtyTracker::CollectDirtyPages(s32 consumerId) {
+  std::vector<u64> dirtyPages{};
+  std::lock_guard lock(trackerMutex);
+  if (consumerId < 0 || consumerId >= DIRTY_MAX_CONSUMERS || !consumers[consumerId].active)
+    return dirtyPages;
+  Harvest();
+  std::vector<u64> &bitmap = consumers[consumerId].bitmap;
+  for (u64 wordIdx = 0; wordIdx != wordCount; ++wordIdx) {
+    u64 bits = bitmap[wordIdx];
+    bitmap[wordIdx] = 0;
+    while (bits) {
+      const u64 page = (wordIdx << 6) + std::countr_zero(bits);
+      bits &= bits - 1;
+      if (page < pageCount)
+        dirtyPages.push_back(page << DIRTY_PAGE_SHIFT);
+    }
+  }
+  return dirtyPages;
+}
+
+bool RAMDirtyTracker::TestAndClear(s32 consumerId, u64 offset, u64 size) {
+  std::lock_guard lock(trackerMutex);
+  if (consumerId < 0 || consumerId >= DIRTY_MAX_CONSUMERS || !consumers[consumerId].active)
+    return false;
+  if (size == 0 || offset >= ramSize)
+    return false;
+  Harvest();
+  std::vector<u64> &bitmap = consumers[consumerId].bitmap;
+  bool dirty = false;
+  const u64 lastPage = (std::min(offset + size, ramSize) - 1) >> DIRTY_PAGE_SHIFT;
+  for (u64 page = offset >> DIRTY_PAGE_SHIFT; page <= lastPage; ++page) {
+    const u64 bit = 1ULL << (page & 63);
+    if (bitmap[page >> 6] & bit) {
+      bitmap[page >> 6] &= ~bit;
+      dirty = true;
+    }
+  }
+  return dirty;
+}
+
+void RAMDirtyTracker::Harvest() {
+  if (mode == eDirtyTrackingMode::HostSoftDirty && !HarvestSoftDirty()) {
+    LOG_WARNING(System, "RAM: Failed to read soft-dirty bits, switching to software tracking");
+    // We don't know what was written, so everything is dirty
+    for (auto &consumer : consumers) {
+      if (consumer.active)
+        consumer.bitmap.assign(wordCount, ~0ULL);
+    }
+    mode = eDirtyTrackingMode::Software;
+    UpdateTracking();
+    return;
+  }
+  for (u64 wordIdx = 0; wordIdx != wordCount; ++wordIdx) {
+    if (!sharedBitmap[wordIdx].load(std::memory_order_relaxed))
+      continue;
+    const u64 bits = sharedBitmap[wordIdx].exchange(0, std::memory_order_acq_rel);
+    for (auto &consumer : consumers) {
+      if (consumer.active)
+        consumer.bitmap[wordIdx] |= bits;
+    }
+  }
+}
+
+bool RAMDirtyTracker::HarvestSoftDirty() {
+#ifdef __linux__
+  // See https://www.kernel.org/doc/html/latest/admin-guide/mm/soft-dirty.html
+  constexpr u64 softDirtyBit = 1ULL << 55;
+  if (pagemapFd == -1 || !hostBase)
+    return false;
+  const u64 hostPageSize = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  const u64 hostPageCount = hostMappedSize / hostPageSize;
+  const u64 guestPagesPerHostPage = std::max<u64>(hostPageSize >> DIRTY_PAGE_SHIFT, 1);
+  u64 entries[512];
+  for (u64 hostPage = 0; hostPage < hostPageCount;) {
+    const u64 count = std::min<u64>(hostPageCount - hostPage, std::size(entries));
+    const off_t fileOffset = static_cast<off_t>((reinterpret_cast<u64>(hostBase) / hostPageSize + hostPage) * sizeof(u64));
+    if (pread(pagemapFd, entries, count * sizeof(u64), fileOffset) != static_cast<ssize_t>(count * sizeof(u64)))
+      return false;
+    for (u64 i = 0; i != count; ++i) {
+      if (!(entries[i] & softDirtyBit))
+        continue;
+      const u64 firstPage = (hostPage + i) * guestPagesPerHostPage;
+      for (u64 page = firstPage; page < firstPage + guestPagesPerHostPage && page < pageCount; ++page) {
+        sharedBitmap[page >> 6].fetch_or(1ULL << (page & 63), std::memory_order_relaxed);
+      }
+    }
+    hostPage += count;
+  }
+  // Clear the soft-dirty bits for the next harvest
+  const s32 clearRefsFd = open("/proc/self/clear_refs", O_WRONLY);
+  if (clearRefsFd == -1)
+    return false;
+  const bool cleared = write(clearRefsFd, "4", 1) == 1;
+  close(clearRefsFd);
+  return cleared;
+#else
+  return false;
+#endif
+}
+
+void RAMDirtyTracker::UpdateTracking() {
+  bool anyConsumer = false;
+  for (const auto &consumer : consumers) {
+    anyConsumer |= consumer.active;
+  }
+  softwareTracking.store(anyConsumer && mode == eDirtyTrackingMode::Software, std::memory_order_release);
+}
@@ -0,0 +1,111 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Base/Types.h"
+
+// Dirty tracking granularity, matches the guest page size.
+#define DIRTY_PAGE_SHIFT 12
+#define DIRTY_PAGE_SIZE (1ULL << DIRTY_PAGE_SHIFT)
+// Maximum number of consumers.
+#define DIRTY_MAX_CONSUMERS 8
+
+// Dirty tracking backends.
+enum class eDirtyTrackingMode : u8 {
+  // Writes are recorded by the MMU and device DMA paths.
+  Software = 0,
+  // Writes are recorded by the host kernel (Linux soft-dirty bits), the write paths do nothing.
+  // Harvesting isn't atomic against running writers, so it's meant to be used while the guest is stopped.
+  HostSoftDirty = 1
+};
+
+// Tracks which guest RAM pages were written.
+// Writers set bits in a shared atomic bitmap. Every consumer (save states, framebuffer/texture caches, JIT) has its
+// own bitmap, which is only fed from the shared one when that consumer asks for its dirty pages, so consumers never
+// see each other's clears. Nothing is recorded while there are no consumers.
+class RAMDirtyTracker {
+public:
+  RAMDirtyTracker() = default;
+  ~RAMDirtyTracker();
+
+  // Sets up tracking for a RAM block. Must not race with writers (RAM (re)allocation).
+  void Initialize(u8 *hostBase, u64 size, u64 hostMappedSize, eDirtyTrackingMode trackingMode);
+
+  // Registers a consumer, returns its ID or -1 if there are no free slots.
+  // Everything is reported dirty on the first collection, as the consumer never saw the current contents.
+  s32 RegisterConsumer(const std::string &name);
+  // Unregisters a consumer.
+  void UnregisterConsumer(s32 consumerId);
+
+  // Records a write to [offset, offset + size).
+  void MarkDirty(u64 offset, u64 size) {
+    if (!softwareTracking.load(std::memory_order_relaxed)) [[likely]]
+      return;
+    if (size == 0 || offset >= ramSize)
+      return;
+    const u64 lastPage = (std::min(offset + size, ramSize) - 1) >> DIRTY_PAGE_SHIFT;
+    for (u64 page = offset >> DIRTY_PAGE_SHIFT; page <= lastPage; ++page) {
+      std::atomic<u64> &word = sharedBitmap[page >> 6];
+      const u64 bit = 1ULL << (page & 63);
+      // Avoid bouncing the cache line around when it's already set
+      if (!(word.load(std::memory_order_relaxed) & bit))
+        word.fetch_or(bit, std::memory_order_relaxed);
+    }
+  }
+  // Marks every page dirty for every consumer (RAM was cleared/replaced).
+  void MarkAllDirty();
+
+  // Returns the offsets of every page written since this consumer's last collection and clears them for it.
+  std::vector<u64> CollectDirtyPages(s32 consumerId);
+  // Returns true if any page in [offset, offset + size) was written since this consumer last cleared it, and clears
+  // those pages for it.
+  bool TestAndClear(s32 consumerId, u64 offset, u64 size);
+
+  eDirtyTrackingMode GetMode() const {
+    return mode;
+  }
+
+private:
+  struct sConsumer {
+    bool active = false;
+    std::string name{};
+    std::vector<u64> bitmap{};
+  };
+
+  // Moves the pending dirty bits into every consumer's bitmap. Must hold trackerMutex.
+  void Harvest();
+  // Reads and clears the host soft-dirty bits, returns false if they're unavailable.
+  bool HarvestSoftDirty();
+  // Updates whether the write paths need to record anything. Must hold trackerMutex.
+  void UpdateTracking();
+
+  eDirtyTrackingMode mode = eDirtyTrackingMode::Software;
+  // Write paths record writes
+  std::atomic<bool> softwareTracking = false;
+  // Tracked size
+  u64 ramSize = 0;
+  u64 pageCount = 0;
+  u64 wordCount = 0;
+  // Host mapping, used by the soft-dirty backend
+  u8 *hostBase = nullptr;
+  u64 hostMappedSize = 0;
+  // Pending writes, not yet seen by any consumer
+  std::unique_ptr<std::atomic<u64>[]> sharedBitmap{};
+  // Consumers
+  std::array<sConsumer, DIRTY_MAX_CONSUMERS> consumers{};
+  std::mutex trackerMutex{};
+#ifdef __linux__
+  // /proc/self/pagemap handle
+  s32 pagemapFd = -1;
+#endif
+};
@@ -2,6 +2,16 @@
 /* Copyright 2025 Xenon Emulator Project. All rights reserved. */
 /***************************************************************/
 
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <vector>
+
+#include "Base/Config.h"
+#include "Base/Error.h"
 #include "Base/Logging/Log.h"
 #include "Base/Hash.h"
 
@@ -85,57 +95,178 @@ RAM::RAM(const std::string &deviceName, u64 startAddress, std::string size, bool
     }
   }
   UpdateEndAddress(GetStartAddress() + ramSize);
-  ramData = std::make_unique<STRIP_UNIQUE_ARR(ramData)>(ramSize);
-  if (!ramData.get()) {
+  if (!Allocate()) {
     LOG_CRITICAL(System, "RAM failed to allocate! This is really bad!");
     Base::SystemPause();
-  } else {
-    memset(ramData.get(), 0xCD, ramSize);
+  } else if (Config::xcpu.ramPoison) {
+    memset(ramData, 0xCD, ramSize);
   }
 }
 RAM::~RAM() {
-  ramData.reset();
+  LOG_INFO(System, "RAM: {:#x} of {:#x} bytes resident", GetResidentSize(), ramSize);
+  Free();
 }
 
 void RAM::Reset() {
-  if (!ramData.get()) {
-    ramData = std::make_unique<STRIP_UNIQUE_ARR(ramData)>(ramSize);
-    memset(ramData.get(), 0xCD, ramSize);
+  if (!ramData) {
+    Allocate();
   } else {
-    memset(ramData.get(), 0xCD, ramSize);
+    Discard();
   }
+  if (ramData && Config::xcpu.ramPoison)
+    memset(ramData, 0xCD, ramSize);
+  dirtyTracker.MarkAllDirty();
 }
 
+void RAM::Clear() {
+  if (!ramData)
+    Allocate();
+  else
+    Discard();
+  dirtyTracker.MarkAllDirty();
+}
+
+// Note: Reallocating moves the host memory, any cached host pointers (ERATs) must be flushed by the caller.
 void RAM::Resize(u64 size) {
+  if (ramData && size == ramSize)
+    return;
+  Free();
   ramSize = size;
-  if (!ramData.get()) {
-    ramData = std::make_unique<STRIP_UNIQUE_ARR(ramData)>(ramSize);
+  Allocate();
+}
+
+bool RAM::Allocate() {
+#ifdef _WIN32
+  // Committed memory is demand-zero, physical pages are only assigned on first touch.
+  mappedSize = ramSize;
+  ramData = reinterpret_cast<u8*>(VirtualAlloc(nullptr, mappedSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+  if (!ramData) {
+    LOG_ERROR(System, "RAM: VirtualAlloc failed: {}", Base::GetLastErrorMsg());
+    return false;
+  }
+#else
+  void *mapping = MAP_FAILED;
+  hugeTLB = false;
+#ifdef MAP_HUGETLB
+  if (Config::xcpu.ramHugePages == 2) {
+    // hugetlbfs pages are 2MiB, round the mapping up
+    constexpr u64 hugePageSize = 2_MiB;
+    mappedSize = (ramSize + hugePageSize - 1) & ~(hugePageSize - 1);
+    mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping == MAP_FAILED)
+      LOG_WARNING(System, "RAM: hugetlbfs mapping failed ({}), falling back to regular pages", Base::GetLastErrorMsg());
+    else
+      hugeTLB = true;
+  }
+#endif
+  if (mapping == MAP_FAILED) {
+    const u64 pageSize = static_cast<u64>(sysconf(_SC_PAGESIZE));
+    mappedSize = (ramSize + pageSize - 1) & ~(pageSize - 1);
+    mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  }
+  if (mapping == MAP_FAILED) {
+    LOG_ERROR(System, "RAM: mmap failed: {}", Base::GetLastErrorMsg());
+    mappedSize = 0;
+    return false;
+  }
+  ramData = reinterpret_cast<u8*>(mapping);
+#ifdef MADV_HUGEPAGE
+  if (!hugeTLB && Config::xcpu.ramHugePages != 0)
+    madvise(ramData, mappedSize, MADV_HUGEPAGE);
+#endif
+#endif
+  LOG_INFO(System, "RAM: Reserved {:#x} bytes{}", mappedSize, hugeTLB ? " (hugetlbfs)" : "");
+  // Soft-dirty bits aren't tracked on hugetlbfs mappings
+  const bool softDirty = Config::xcpu.ramDirtyTracking == 1 && !hugeTLB;
+  dirtyTracker.Initialize(ramData, ramSize, mappedSize,
+    softDirty ? eDirtyTrackingMode::HostSoftDirty : eDirtyTrackingMode::Software);
+  return true;
+}
+
+void RAM::Free() {
+  if (!ramData)
+    return;
+#ifdef _WIN32
+  VirtualFree(ramData, 0, MEM_RELEASE);
+#else
+  munmap(ramData, mappedSize);
+#endif
+  ramData = nullptr;
+  mappedSize = 0;
+}
+
+void RAM::Discard() {
+#ifdef _WIN32
+  // Decommitting and committing again gives us demand-zero pages at the same address
+  VirtualFree(ramData, mappedSize, MEM_DECOMMIT);
+  VirtualAlloc(ramData, mappedSize, MEM_COMMIT, PAGE_READWRITE);
+#else
+  // Map fresh anonymous pages over the old ones, keeping the address
+  const s32 flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED | (hugeTLB ? 0 : MAP_NORESERVE);
+#ifdef MAP_HUGETLB
+  void *mapping = mmap(ramData, mappedSize, PROT_READ | PROT_WRITE, flags | (hugeTLB ? MAP_HUGETLB : 0), -1, 0);
+#else
+  void *mapping = mmap(ramData, mappedSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+#endif
+  if (mapping == MAP_FAILED) {
+    LOG_WARNING(System, "RAM: Failed to discard pages ({}), clearing instead", Base::GetLastErrorMsg());
+    memset(ramData, 0, ramSize);
+    return;
+  }
+#ifdef MADV_HUGEPAGE
+  if (!hugeTLB && Config::xcpu.ramHugePages != 0)
+    madvise(ramData, mappedSize, MADV_HUGEPAGE);
+#endif
+#endif
+}
+
+u64 RAM::GetResidentSize() {
+  if (!ramData)
+    return 0;
+#ifdef _WIN32
+  return ramSize;
+#else
+  const u64 pageSize = static_cast<u64>(sysconf(_SC_PAGESIZE));
+  std::vector<u8> residency(mappedSize / pageSize);
+#ifdef __APPLE__
+  if (mincore(ramData, mappedSize, reinterpret_cast<char*>(residency.data())) != 0)
+#else
+  if (mincore(ramData, mappedSize, reinterpret_cast<unsigned char*>(residency.data())) != 0)
+#endif
+    return ramSize;
+  u64 residentPages = 0;
+  for (const u8 page : residency) {
+    residentPages += page & 1;
   }
+  return residentPages * pageSize;
+#endif
 }
 
 void RAM::Read(u64 readAddress, u8 *data, u64 size) {
   const u64 offset = static_cast<u32>(readAddress - RAM_START_ADDR);
-  memcpy(data, ramData.get() + offset, size);
+  memcpy(data, ramData + offset, size);
   if (false)
     LOG_TRACE(Xenon, "Reading {:#08x} bytes from {:#08x}", size, readAddress);
 }
 
 void RAM::Write(u64 writeAddress, const u8 *data, u64 size) {
   const u32 offset = static_cast<u32>(writeAddress - RAM_START_ADDR);
-  memcpy(ramData.get() + offset, data, size);
+  memcpy(ramData + offset, data, size);
+  dirtyTracker.MarkDirty(offset, size);
   if (false)
     LOG_TRACE(Xenon, "Writing {:#08x} bytes to {:#08x}", size, writeAddress);
 }
 
 void RAM::MemSet(u64 writeAddress, s32 data, u64 size) {
   const u32 offset = static_cast<u32>(writeAddress - RAM_START_ADDR);
-  memset(ramData.get() + offset, data, size);
+  memset(ramData + offset, data, size);
+  dirtyTracker.MarkDirty(offset, size);
   if (false)
     LOG_TRACE(Xenon, "Setting {:#08x} to {:#02x} for {:#08x} bytes", writeAddress, data, size);
 }
 
 u8 *RAM::GetPointerToAddress(u32 address) {
   const u64 offset = static_cast<u32>(address - RAM_START_ADDR);
-  if (offset > ramSize) { return nullptr; }
-  return ramData.get() + offset;
+  if (offset >= ramSize) { return nullptr; }
+  return ramData + offset;
 }
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "Base/SystemDevice.h"
+#include "Core/RAM/DirtyTracker.h"
 
 #define RAM_START_ADDR 0
 
@@ -16,6 +17,8 @@ public:
     bool isSOCDevice);
   ~RAM();
   void Reset();
+  // Zeroes every page, whatever the poison setting. Used before restoring a save state
+  void Clear();
   void Resize(u64 size);
   void Read(u64 readAddress, u8 *data, u64 size) override;
   void Write(u64 writeAddress, const u8 *data, u64 size) override;
@@ -25,7 +28,36 @@ public:
   u64 GetSize() {
     return ramSize;
   }
+  // Returns the amount of RAM (in bytes) currently backed by host memory, that is, pages touched since the last
+  // reset. Returns the full size where residency can't be queried.
+  u64 GetResidentSize();
+
+  // Dirty page tracking, see RAMDirtyTracker.
+  RAMDirtyTracker &GetDirtyTracker() {
+    return dirtyTracker;
+  }
+  // Records a write done directly to host memory (DMA, MMU fast paths).
+  void MarkDirty(u64 address, u64 size) {
+    dirtyTracker.MarkDirty(address - RAM_START_ADDR, size);
+  }
+  void MarkDirtyHost(const u8 *hostPtr, u64 size) {
+    dirtyTracker.MarkDirty(static_cast<u64>(hostPtr - ramData), size);
+  }
 private:
+  // Reserves the host backing for RAM. Pages are only committed on first touch
+  bool Allocate();
+  // Releases the host backing
+  void Free();
+  // Drops every page, they read back as zero on next access. The host address stays the same
+  void Discard();
+  // RAM Size
   u64 ramSize = 0;
-  std::unique_ptr<u8[]> ramData{};
+  // Host mapping size, rounded up to the page size in use
+  u64 mappedSize = 0;
+  // Mapping is backed by hugetlbfs
+  bool hugeTLB = false;
+  // Host memory
+  u8 *ramData = nullptr;
+  // Written pages
+  RAMDirtyTracker dirtyTracker{};
 };
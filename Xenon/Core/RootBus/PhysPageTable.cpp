@@ -0,0 +1,182 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include <algorithm>
+
+#include "Base/Global.h"
+
+#include "PhysPageTable.h"
+
+PhysPageTable::PhysPageTable() {
+  for (auto &chunk : chunks) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+PhysPageTable::~PhysPageTable() {
+  for (auto &chunk : chunks) {
+    chunk.store(nullptr, std::memory_order_relaxed);
+  }
+  for (auto &chunk : chunkStorage) {
+    chunk.reset();
+  }
+  retiredChunks.clear();
+}
+
+void PhysPageTable::Rebuild(const std::vector<sPhysRange> &ranges) {
+  MICROPROFILE_SCOPEI("[Xe::PCI]", "PhysPageTable::Rebuild", MP_AUTO);
+  std::lock_guard lock(rebuildMutex);
+
+  u32 rebuiltChunks = 0;
+  std::vector<sPhysRange> chunkRanges{};
+  for (u64 chunkIdx = 0; chunkIdx != PHYS_CHUNK_COUNT; ++chunkIdx) {
+    const u64 chunkStart = chunkIdx << (PHYS_PAGE_SHIFT + PHYS_CHUNK_SHIFT);
+    const u64 chunkEnd = chunkStart + (PHYS_CHUNK_PAGES << PHYS_PAGE_SHIFT);
+
+    // Gather the ranges that touch this chunk
+    chunkRanges.clear();
+    for (const auto &range : ranges) {
+      if (range.start < chunkEnd && range.end > chunkStart && range.handler != physHandlerNone)
+        chunkRanges.push_back(range);
+    }
+
+    sPhysChunk *oldChunk = chunks[chunkIdx].load(std::memory_order_relaxed);
+    if (chunkRanges.empty()) {
+      chunks[chunkIdx].store(nullptr, std::memory_order_release);
+      if (chunkStorage[chunkIdx])
+        retiredChunks.push_back({ chunkIdx, std::move(chunkStorage[chunkIdx]) });
+      continue;
+    }
+    // Nothing changed
+    if (oldChunk && oldChunk->sourceRanges == chunkRanges)
+      continue;
+
+    // Same layout as one we replaced before, it's still good
+    std::unique_ptr<sPhysChunk> newChunk{};
+    const auto retired = std::find_if(retiredChunks.begin(), retiredChunks.end(),
+      [&](const sRetiredChunk &chunk) { return chunk.chunkIdx == chunkIdx && chunk.chunk->sourceRanges == chunkRanges; });
+    if (retired != retiredChunks.end()) {
+      newChunk = std::move(retired->chunk);
+      retiredChunks.erase(retired);
+    } else {
+      newChunk = BuildChunk(chunkStart, chunkRanges);
+    }
+    // Keep the access statistics
+    if (oldChunk) {
+      for (u64 i = 0; i != PHYS_CHUNK_PAGES; ++i) {
+        newChunk->pages[i].accessCount.store(oldChunk->pages[i].accessCount.load(std::memory_order_relaxed),
+          std::memory_order_relaxed);
+      }
+    }
+    chunks[chunkIdx].store(newChunk.get(), std::memory_order_release);
+    if (chunkStorage[chunkIdx])
+      retiredChunks.push_back({ chunkIdx, std::move(chunkStorage[chunkIdx]) });
+    chunkStorage[chunkIdx] = std::move(newChunk);
+    rebuiltChunks++;
+  }
+  LOG_DEBUG(RootBus, "Physical page table rebuilt ({} ranges, {} chunks updated, {} retired)", ranges.size(),
+    rebuiltChunks, retiredChunks.size());
+}
+
+std::unique_ptr<PhysPageTable::sPhysChunk> PhysPageTable::BuildChunk(u64 chunkStart,
+  const std::vector<sPhysRange> &ranges) {
+  std::unique_ptr<sPhysChunk> chunk = std::make_unique<sPhysChunk>();
+  chunk->sourceRanges = ranges;
+
+  // Page segments, painted by each range in priority order
+  struct sSegment {
+    u16 start;
+    u16 end;
+    s32 rangeIdx;
+  };
+  std::vector<sSegment> segments{}, painted{};
+
+  for (u64 pageIdx = 0; pageIdx != PHYS_CHUNK_PAGES; ++pageIdx) {
+    const u64 pageStart = chunkStart + (pageIdx << PHYS_PAGE_SHIFT);
+    const u64 pageEnd = pageStart + PHYS_PAGE_SIZE;
+
+    segments.clear();
+    segments.push_back({ 0, static_cast<u16>(PHYS_PAGE_SIZE), -1 });
+    for (s32 rangeIdx = 0; rangeIdx != static_cast<s32>(ranges.size()); ++rangeIdx) {
+      const sPhysRange &range = ranges[rangeIdx];
+      if (range.start >= pageEnd || range.end <= pageStart)
+        continue;
+      const u16 start = static_cast<u16>(std::max(range.start, pageStart) - pageStart);
+      const u16 end = static_cast<u16>(std::min(range.end, pageEnd) - pageStart);
+      // Covers the whole page, just replace it
+      if (start == 0 && end == PHYS_PAGE_SIZE) {
+        segments.clear();
+        segments.push_back({ start, end, rangeIdx });
+        continue;
+      }
+      painted.clear();
+      for (const auto &segment : segments) {
+        if (segment.end <= start || segment.start >= end) {
+          painted.push_back(segment);
+          continue;
+        }
+        if (segment.start < start)
+          painted.push_back({ segment.start, start, segment.rangeIdx });
+        if (segment.end > end)
+          painted.push_back({ end, segment.end, segment.rangeIdx });
+      }
+      painted.push_back({ start, end, rangeIdx });
+      std::sort(painted.begin(), painted.end(), [](const sSegment &a, const sSegment &b) { return a.start < b.start; });
+      segments.swap(painted);
+    }
+
+    // Merge adjacent segments that belong to the same range
+    painted.clear();
+    for (const auto &segment : segments) {
+      if (!painted.empty() && painted.back().rangeIdx == segment.rangeIdx && painted.back().end == segment.start)
+        painted.back().end = segment.end;
+      else
+        painted.push_back(segment);
+    }
+
+    auto makeMapping = [&](s32 rangeIdx, u64 address) {
+      sPhysMapping mapping = {};
+      if (rangeIdx != -1) {
+        const sPhysRange &range = ranges[rangeIdx];
+        mapping.object = range.object;
+        mapping.baseOffset = address - range.start;
+        mapping.handler = range.handler;
+        mapping.flags = range.flags;
+      }
+      return mapping;
+    };
+
+    sPhysPage &page = chunk->pages[pageIdx];
+    if (painted.size() == 1) {
+      page.mapping = makeMapping(painted.front().rangeIdx, pageStart);
+    } else {
+      page.mapping.flags = physPageSplit;
+      page.splitIndex = static_cast<u32>(chunk->splits.size());
+      page.splitCount = static_cast<u32>(painted.size());
+      for (const auto &segment : painted) {
+        chunk->splits.push_back({ segment.start, segment.end, makeMapping(segment.rangeIdx, pageStart + segment.start) });
+      }
+    }
+  }
+  return chunk;
+}
+
+u64 PhysPageTable::GetAccessCount(u64 physAddress) {
+  if (physAddress >= PHYS_ADDRESS_SPACE_SIZE)
+    return 0;
+  const u64 pageIdx = physAddress >> PHYS_PAGE_SHIFT;
+  sPhysChunk *chunk = chunks[pageIdx >> PHYS_CHUNK_SHIFT].load(std::memory_order_acquire);
+  return chunk ? chunk->pages[pageIdx & (PHYS_CHUNK_PAGES - 1)].accessCount.load(std::memory_order_relaxed) : 0;
+}
+
+void PhysPageTable::ResetAccessCounts() {
+  std::lock_guard lock(rebuildMutex);
+  for (auto &chunk : chunkStorage) {
+    if (!chunk)
+      continue;
+    for (auto &page : chunk->pages) {
+      page.accessCount.store(0, std::memory_order_relaxed);
+    }
+  }
+}
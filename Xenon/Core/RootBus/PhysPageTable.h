@@ -0,0 +1,142 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Base/Types.h"
+
+// Physical address space covered by the table (32 bits).
+#define PHYS_ADDRESS_SPACE_SIZE 0x100000000ULL
+#define PHYS_PAGE_SHIFT 12
+#define PHYS_PAGE_SIZE (1ULL << PHYS_PAGE_SHIFT)
+// Pages per chunk (second level), each chunk spans 4MiB.
+#define PHYS_CHUNK_SHIFT 10
+#define PHYS_CHUNK_PAGES (1ULL << PHYS_CHUNK_SHIFT)
+#define PHYS_CHUNK_COUNT (PHYS_ADDRESS_SPACE_SIZE >> (PHYS_PAGE_SHIFT + PHYS_CHUNK_SHIFT))
+
+// Who handles accesses to a physical page.
+enum ePhysHandler : u8 {
+  physHandlerNone = 0,      // Unmapped.
+  physHandlerConfig,        // PCI Configuration space.
+  physHandlerSystemDevice,  // Device attached to the RootBus (RAM, NAND).
+  physHandlerHostBridge,    // Host Bridge registers, XGPU and PCI Bridge registers. Uses the Host Bridge decoding.
+  physHandlerPCIDevice      // PCI Device behind the PCI Bridge.
+};
+
+enum ePhysPageFlags : u8 {
+  physPageRAM = 1 << 0,   // Backed by RAM, SoC accesses never reach it.
+  physPageSplit = 1 << 1  // Page is shared by multiple handlers (BARs smaller than a page).
+};
+
+// An address range [start, end) mapped to a handler.
+// Ranges are applied in order, later ranges take priority over earlier ones.
+struct sPhysRange {
+  u64 start = 0;
+  u64 end = 0;
+  ePhysHandler handler = physHandlerNone;
+  void *object = nullptr;
+  u8 flags = 0;
+
+  bool operator==(const sPhysRange &other) const = default;
+};
+
+// Resolved handler for a page (or part of a page).
+struct sPhysMapping {
+  // Handler object (SystemDevice/PCIDevice), depends on the handler type.
+  void *object = nullptr;
+  // Offset of this mapping from the start of the handler's range.
+  u64 baseOffset = 0;
+  ePhysHandler handler = physHandlerNone;
+  u8 flags = 0;
+};
+
+// Part of a page shared by multiple handlers.
+struct sPhysSplit {
+  u16 start = 0;
+  u16 end = 0;
+  sPhysMapping mapping = {};
+};
+
+struct sPhysPage {
+  sPhysMapping mapping = {};
+  // Index and count into the owning chunk's splits, only used with physPageSplit.
+  u32 splitIndex = 0;
+  u32 splitCount = 0;
+  // Number of accesses done to this page.
+  std::atomic<u64> accessCount = 0;
+};
+
+// Page-granular physical address dispatch table.
+// Two levels: 1024 chunks of 1024 4KiB pages, chunks with nothing mapped are never allocated.
+// Lookups are lock-free. A rebuild only replaces the chunks whose mappings changed. Other threads may still be reading
+// the replaced chunks, so they're kept until the table is destroyed. A chunk only depends on the ranges it was built
+// from, so rebuilds going back to a previous layout (reboots) reuse the retired chunks instead of adding new ones.
+class PhysPageTable {
+public:
+  PhysPageTable();
+  ~PhysPageTable();
+
+  // Rebuilds the table from a list of ranges, in ascending priority.
+  void Rebuild(const std::vector<sPhysRange> &ranges);
+
+  // Resolves the mapping for a physical address and counts the access. Returns nullptr if unmapped.
+  const sPhysMapping *Resolve(u64 physAddress) {
+    if (physAddress >= PHYS_ADDRESS_SPACE_SIZE)
+      return nullptr;
+    const u64 pageIdx = physAddress >> PHYS_PAGE_SHIFT;
+    sPhysChunk *chunk = chunks[pageIdx >> PHYS_CHUNK_SHIFT].load(std::memory_order_acquire);
+    if (!chunk)
+      return nullptr;
+    sPhysPage &page = chunk->pages[pageIdx & (PHYS_CHUNK_PAGES - 1)];
+    page.accessCount.fetch_add(1, std::memory_order_relaxed);
+    if (page.mapping.flags & physPageSplit) [[unlikely]] {
+      const u16 offset = static_cast<u16>(physAddress & (PHYS_PAGE_SIZE - 1));
+      for (u32 i = 0; i != page.splitCount; ++i) {
+        const sPhysSplit &split = chunk->splits[page.splitIndex + i];
+        if (offset >= split.start && offset < split.end)
+          return &split.mapping;
+      }
+      return nullptr;
+    }
+    return &page.mapping;
+  }
+
+  // Returns the number of accesses done to the page containing the given address.
+  u64 GetAccessCount(u64 physAddress);
+
+  // Resets all access counters.
+  void ResetAccessCounts();
+
+private:
+  struct sPhysChunk {
+    std::array<sPhysPage, PHYS_CHUNK_PAGES> pages{};
+    std::vector<sPhysSplit> splits{};
+    // Ranges this chunk was built from, used to detect changes.
+    std::vector<sPhysRange> sourceRanges{};
+  };
+
+  // Builds a chunk from the ranges intersecting it.
+  std::unique_ptr<sPhysChunk> BuildChunk(u64 chunkStart, const std::vector<sPhysRange> &ranges);
+
+  // A replaced chunk, and where it was.
+  struct sRetiredChunk {
+    u64 chunkIdx = 0;
+    std::unique_ptr<sPhysChunk> chunk{};
+  };
+
+  // First level
+  std::array<std::atomic<sPhysChunk*>, PHYS_CHUNK_COUNT> chunks{};
+  // Chunks in use, owns the memory.
+  std::array<std::unique_ptr<sPhysChunk>, PHYS_CHUNK_COUNT> chunkStorage{};
+  // Replaced chunks.
+  std::vector<sRetiredChunk> retiredChunks{};
+  // Rebuild lock
+  std::mutex rebuildMutex{};
+};
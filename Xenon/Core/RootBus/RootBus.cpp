@@ -25,6 +25,7 @@ RootBus::~RootBus() {
 
 void RootBus::AddHostBridge(std::shared_ptr<HostBridge> newHostBridge) {
   hostBridge = newHostBridge;
+  RebuildPageTable();
 }
 
 void RootBus::AddDevice(std::shared_ptr<SystemDevice> device) {
@@ -37,6 +38,7 @@ void RootBus::AddDevice(std::shared_ptr<SystemDevice> device) {
   deviceCount++;
   LOG_INFO(RootBus, "Device attached: {}", device->GetDeviceName());
   connectedDevices.insert({ device->GetDeviceName(), device });
+  RebuildPageTable();
 }
 
 void RootBus::ResetDevice(std::shared_ptr<SystemDevice> device) {
@@ -55,32 +57,62 @@ void RootBus::ResetDevice(std::shared_ptr<SystemDevice> device) {
   } else {
     LOG_CRITICAL(RootBus, "Failed to reset device! '{}' never existed.", it->first);
   }
+  RebuildPageTable();
 }
 
-bool RootBus::Read(u64 readAddress, u8 *data, u64 size, bool soc) {
-  MICROPROFILE_SCOPEI("[Xe::PCI]", "RootBus::Read", MP_AUTO);
-  // Configuration Read?
-  if (readAddress >= PCI_CONFIG_REGION_ADDRESS &&
-      readAddress <= PCI_CONFIG_REGION_ADDRESS + PCI_CONFIG_REGION_SIZE) {
-    ConfigRead(readAddress, data, size);
-    return true;
-  }
+void RootBus::RebuildPageTable() {
+  std::vector<sPhysRange> ranges{};
+
+  // Host Bridge, XGPU, PCI Bridge and PCI devices. Lowest priority
+  if (hostBridge)
+    hostBridge->GetPhysRanges(ranges);
 
+  // Devices attached to us
   for (auto &[name, dev] : connectedDevices) {
-    if (readAddress >= dev->GetStartAddress() &&
-        readAddress <= dev->GetEndAddress()) {
+    if (!dev)
+      continue;
+    sPhysRange range = {};
+    range.start = dev->GetStartAddress();
+    range.end = dev->GetEndAddress();
+    range.handler = physHandlerSystemDevice;
+    range.object = dev.get();
+    range.flags = name == "RAM" ? physPageRAM : 0;
+    ranges.push_back(range);
+  }
+
+  // Configuration space
+  ranges.push_back({ PCI_CONFIG_REGION_ADDRESS, PCI_CONFIG_REGION_ADDRESS + PCI_CONFIG_REGION_SIZE,
+    physHandlerConfig, nullptr, 0 });
+
+  pageTable.Rebuild(ranges);
+}
+
+bool RootBus::Read(u64 readAddress, u8 *data, u64 size, bool soc) {
+  MICROPROFILE_SCOPEI("[Xe::PCI]", "RootBus::Read", MP_AUTO);
+  if (const sPhysMapping *mapping = pageTable.Resolve(readAddress)) {
+    switch (mapping->handler) {
+    case physHandlerConfig:
+      // Configuration Read
+      ConfigRead(readAddress, data, size);
+      return true;
+    case physHandlerSystemDevice:
       // If the read is to SOC MMIO, we can't read from RAM.
-      if (soc && dev->GetDeviceName() == "RAM") { continue; }
-      dev->Read(readAddress, data, size);
+      if (soc && (mapping->flags & physPageRAM))
+        break;
+      static_cast<SystemDevice*>(mapping->object)->Read(readAddress, data, size);
+      return true;
+    case physHandlerHostBridge:
+      if (hostBridge->Read(readAddress, data, size))
+        return true;
+      break;
+    case physHandlerPCIDevice:
+      hostBridge->DeviceRead(static_cast<PCIDevice*>(mapping->object), readAddress, data, size);
       return true;
+    default:
+      break;
     }
   }
 
-  // Check on the other busses
-  if (hostBridge->Read(readAddress, data, size)) {
-    return true;
-  }
-
   if (!soc) {
     // Device not found
     LOG_ERROR(RootBus, "Read failed at address 0x{:X}", readAddress);
@@ -96,20 +128,23 @@ bool RootBus::Read(u64 readAddress, u8 *data, u64 size, bool soc) {
 
 bool RootBus::MemSet(u64 writeAddress, s32 data, u64 size) {
   MICROPROFILE_SCOPEI("[Xe::PCI]", "RootBus::MemSet", MP_AUTO);
-  for (auto &[name, dev] : connectedDevices) {
-    if (writeAddress >= dev->GetStartAddress() &&
-        writeAddress <= dev->GetEndAddress()) {
-      // Hit
-      dev->MemSet(writeAddress, data, size);
+  if (const sPhysMapping *mapping = pageTable.Resolve(writeAddress)) {
+    switch (mapping->handler) {
+    case physHandlerSystemDevice:
+      static_cast<SystemDevice*>(mapping->object)->MemSet(writeAddress, data, size);
+      return true;
+    case physHandlerHostBridge:
+      if (hostBridge->MemSet(writeAddress, data, size))
+        return true;
+      break;
+    case physHandlerPCIDevice:
+      hostBridge->DeviceMemSet(static_cast<PCIDevice*>(mapping->object), writeAddress, data, size);
       return true;
+    default:
+      break;
     }
   }
 
-  // Check on the other busses
-  if (hostBridge->MemSet(writeAddress, data, size)) {
-    return true;
-  }
-
   // Device or address not found
   if (false) {
     LOG_ERROR(RootBus, "MemSet failed at address: 0x{:X}, data: 0x{:X}", writeAddress, data);
@@ -122,28 +157,30 @@ bool RootBus::MemSet(u64 writeAddress, s32 data, u64 size) {
 
 bool RootBus::Write(u64 writeAddress, const u8 *data, u64 size, bool soc) {
   MICROPROFILE_SCOPEI("[Xe::PCI]", "RootBus::Write", MP_AUTO);
-  // PCI Configuration Write?
-  if (writeAddress >= PCI_CONFIG_REGION_ADDRESS &&
-      writeAddress <= PCI_CONFIG_REGION_ADDRESS + PCI_CONFIG_REGION_SIZE) {
-    ConfigWrite(writeAddress, data, size);
-    return true;
-  }
-
-  for (auto &[name, dev] : connectedDevices) {
-    if (writeAddress >= dev->GetStartAddress() &&
-        writeAddress <= dev->GetEndAddress()) {
-      // If the write is to SOC MMIO, we can't read from RAM.
-      if (soc && dev->GetDeviceName() == "RAM") { continue; }
-      dev->Write(writeAddress, data, size);
+  if (const sPhysMapping *mapping = pageTable.Resolve(writeAddress)) {
+    switch (mapping->handler) {
+    case physHandlerConfig:
+      // PCI Configuration Write
+      ConfigWrite(writeAddress, data, size);
+      return true;
+    case physHandlerSystemDevice:
+      // If the write is to SOC MMIO, we can't write to RAM.
+      if (soc && (mapping->flags & physPageRAM))
+        break;
+      static_cast<SystemDevice*>(mapping->object)->Write(writeAddress, data, size);
       return true;
+    case physHandlerHostBridge:
+      if (hostBridge->Write(writeAddress, data, size))
+        return true;
+      break;
+    case physHandlerPCIDevice:
+      hostBridge->DeviceWrite(static_cast<PCIDevice*>(mapping->object), writeAddress, data, size);
+      return true;
+    default:
+      break;
     }
   }
 
-  // Check on the other busses
-  if (hostBridge->Write(writeAddress, data, size)) {
-    return true;
-  }
-
   // Device or address not found
   if (!soc) {
     LOG_ERROR(RootBus, "Write to {:#x} failed, data {:#x}", writeAddress, *reinterpret_cast<const u64*>(data));
@@ -160,5 +197,11 @@ bool RootBus::ConfigRead(u64 readAddress, u8 *data, u64 size) {
 }
 
 bool RootBus::ConfigWrite(u64 writeAddress, const u8 *data, u64 size) {
-  return hostBridge->ConfigWrite(writeAddress, data, size);
+  const bool result = hostBridge->ConfigWrite(writeAddress, data, size);
+  // BARs may have been moved, rebuild the page table
+  PCIE_CONFIG_ADDR configAddress = {};
+  configAddress.hexData = static_cast<u32>(writeAddress);
+  if (configAddress.regOffset >= 0x10 && configAddress.regOffset < 0x28)
+    RebuildPageTable();
+  return result;
 }
@@ -8,6 +8,7 @@
 
 #include "Base/SystemDevice.h"
 #include "Core/PCI/Bridge/HostBridge.h"
+#include "Core/RootBus/PhysPageTable.h"
 
 // PCI Configuration region
 #define PCI_CONFIG_REGION_ADDRESS 0xD0000000
@@ -32,10 +33,19 @@ public:
   bool ConfigRead(u64 readAddress, u8 *data, u64 size);
   bool ConfigWrite(u64 writeAddress, const u8 *data, u64 size);
 
+  // Rebuilds the physical page table. Must be called whenever devices are attached or their BARs/size change.
+  void RebuildPageTable();
+
+  // Returns the number of accesses done to the physical page containing the given address.
+  u64 GetPageAccessCount(u64 physAddress) { return pageTable.GetAccessCount(physAddress); }
+
 private:
   std::shared_ptr<HostBridge> hostBridge{};
   u32 deviceCount;
   std::unordered_map<std::string, std::shared_ptr<SystemDevice>> connectedDevices;
 
+  // Physical page dispatch table
+  PhysPageTable pageTable{};
+
   std::unique_ptr<u8> biuData{ std::make_unique<STRIP_UNIQUE(biuData)>(0x10000) };
 };
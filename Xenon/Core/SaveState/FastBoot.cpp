@@ -0,0 +1,190 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "FastBoot.h"
+
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "Base/Hash.h"
+#include "Base/Logging/Log.h"
+#include "Base/Thread.h"
+#include "Base/Topology.h"
+#include "Base/Version.h"
+#include "Core/XeMain.h"
+
+namespace Xe::SaveState {
+
+// Hashes a file's contents. Missing files hash their path instead, so pointing somewhere else still changes it.
+static u64 HashFile(const std::string &path, u64 seed) {
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file)
+    return Base::DataHash64(path.data(), path.size(), seed);
+  const std::vector<char> data{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+  return Base::DataHash64(data.data(), data.size(), seed);
+}
+
+// Hashes a file's path, size and modification time, without reading it. Used for the NAND image, which is big and
+// only loaded as it's accessed.
+static u64 HashFileStamp(const std::string &path, u64 seed) {
+  std::error_code sizeError, timeError;
+  const u64 size = fs::file_size(path, sizeError);
+  const auto writeTime = fs::last_write_time(path, timeError);
+  const std::string stamp = FMT("{}|{}|{}", path, sizeError ? 0 : size,
+    timeError ? 0 : writeTime.time_since_epoch().count());
+  return Base::DataHash64(stamp.data(), stamp.size(), seed);
+}
+
+FastBoot::FastBoot(SaveStateManager *saveStateManager) :
+  manager(saveStateManager) {
+  // Everything the boot path depends on. Bumping the save state version (or the emulator) drops old checkpoints too
+  u64 fingerprint = XE_SAVESTATE_VERSION;
+  fingerprint = HashFile(Config::filepaths.oneBl, fingerprint);
+  fingerprint = HashFile(Config::filepaths.fuses, fingerprint);
+  if (Config::xcpu.elfLoader)
+    fingerprint = HashFile(Config::filepaths.elfBinary, fingerprint);
+  if (XeMain::sfcx)
+    fingerprint = HashFileStamp(Config::filepaths.nand, fingerprint);
+  const std::string settings = FMT("{}|{}|{}|{}|{:X}|{:X}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{}|{:X}|{:X}", Base::Version,
+    Config::xcpu.ramSize, Config::xcpu.elfLoader, Config::xcpu.overrideInitSkip, Config::xcpu.HW_INIT_SKIP_1,
+    Config::xcpu.HW_INIT_SKIP_2, Config::xcpu.simulate1BL, Config::xcpu.timeBaseMode, Config::xcpu.instrsPerTick,
+    Config::xcpu.deterministic, static_cast<u32>(Config::highlyExperimental.consoleRevison),
+    Config::highlyExperimental.cpuExecutor, Config::smc.avPackType, Config::smc.powerOnReason,
+    Config::filepaths.hddImage, Config::filepaths.oddImage, Config::fastBoot.postCode, Config::fastBoot.address);
+  fingerprint = Base::DataHash64(settings.data(), settings.size(), fingerprint);
+  checkpointPath = XeMain::rootDirectory / Config::fastBoot.directory / FMT("{:016X}.xst", fingerprint);
+}
+
+FastBoot::~FastBoot() {
+  Stop();
+  {
+    std::lock_guard lock(captureMutex);
+    exiting = true;
+  }
+  captureCondition.notify_one();
+  if (captureThread.joinable())
+    captureThread.join();
+}
+
+bool FastBoot::Start() {
+  if (!XeMain::CPUStarted)
+    return false;
+  std::error_code ec;
+  if (fs::exists(checkpointPath, ec)) {
+    LOG_INFO(System, "FastBoot: Resuming from checkpoint '{}'.", checkpointPath.filename().string());
+    if (manager->Load(checkpointPath))
+      return true;
+    // The machine may be half restored, start over and capture a new one
+    LOG_WARNING(System, "FastBoot: Checkpoint couldn't be loaded, booting normally.");
+    fs::remove(checkpointPath, ec);
+    XeMain::ShutdownCPU();
+    XeMain::StartCPU();
+    if (!XeMain::CPUStarted)
+      return false;
+  }
+  Arm();
+  return false;
+}
+
+void FastBoot::Stop() {
+  armed = false;
+  // Waits for a capture in progress
+  std::lock_guard busyLock(busyMutex);
+  {
+    std::lock_guard lock(captureMutex);
+    captureRequested = false;
+  }
+  RemoveBreakpoint();
+}
+
+void FastBoot::OnPOST(u64 postCode) {
+  if (armed.load(std::memory_order_relaxed) && Config::fastBoot.postCode && postCode == Config::fastBoot.postCode)
+    RequestCapture();
+}
+
+void FastBoot::Arm() {
+  if (!Config::fastBoot.postCode && !Config::fastBoot.address) {
+    LOG_WARNING(System, "FastBoot: Neither PostCode nor Address are set, no checkpoint will be captured.");
+    return;
+  }
+  {
+    std::lock_guard busyLock(busyMutex);
+    // Checked on every execution of the address, never halts
+    if (Config::fastBoot.address) {
+      breakpointId = XeMain::xenonCPU->GetBreakpoints().Add(Config::fastBoot.address, -1, -1, [this](sPPEState *) {
+        RequestCapture();
+        return false;
+      });
+    }
+    armed = true;
+  }
+  if (!captureThread.joinable())
+    captureThread = std::thread(&FastBoot::CaptureThreadLoop, this);
+  if (Config::fastBoot.address) {
+    LOG_INFO(System, "FastBoot: No checkpoint yet, capturing one at POST 0x{:X} or address 0x{:X}.",
+      Config::fastBoot.postCode, Config::fastBoot.address);
+  } else {
+    LOG_INFO(System, "FastBoot: No checkpoint yet, capturing one at POST 0x{:X}.", Config::fastBoot.postCode);
+  }
+}
+
+void FastBoot::RequestCapture() {
+  // Only the first trigger counts
+  if (!armed.exchange(false))
+    return;
+  {
+    std::lock_guard lock(captureMutex);
+    captureRequested = true;
+  }
+  captureCondition.notify_one();
+}
+
+void FastBoot::CaptureThreadLoop() {
+  Base::SetCurrentThreadName("[Xe] Fast Boot");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::Device);
+  for (;;) {
+    {
+      std::unique_lock lock(captureMutex);
+      captureCondition.wait(lock, [this] { return exiting || captureRequested; });
+      if (exiting)
+        break;
+    }
+    Capture();
+  }
+}
+
+void FastBoot::Capture() {
+  std::lock_guard busyLock(busyMutex);
+  {
+    // Stop may have come first
+    std::lock_guard lock(captureMutex);
+    if (!captureRequested)
+      return;
+    captureRequested = false;
+  }
+  RemoveBreakpoint();
+  if (!manager->Save(checkpointPath, false)) {
+    LOG_ERROR(System, "FastBoot: Unable to save the checkpoint.");
+    return;
+  }
+  // Checkpoints of other fingerprints are stale, only the current one is kept
+  std::error_code ec;
+  for (const fs::directory_entry &entry : fs::directory_iterator(checkpointPath.parent_path(), ec)) {
+    if (entry.path().extension() == ".xst" && entry.path().filename() != checkpointPath.filename())
+      fs::remove(entry.path(), ec);
+  }
+  LOG_INFO(System, "FastBoot: Checkpoint saved, next launches resume from here.");
+}
+
+void FastBoot::RemoveBreakpoint() {
+  if (!breakpointId)
+    return;
+  if (XeMain::xenonCPU)
+    XeMain::xenonCPU->GetBreakpoints().Remove(breakpointId);
+  breakpointId = 0;
+}
+
+} // namespace Xe::SaveState
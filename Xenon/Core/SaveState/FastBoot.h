@@ -0,0 +1,66 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "Base/PathUtil.h"
+#include "Base/Types.h"
+
+// Fast boot.
+// Nearly every run boots the same way, through 1BL, CB/CD, the hypervisor and kernel init. Fast boot saves a
+// checkpoint (a full save state) once boot reaches a POST code or guest address, see the FastBoot config section,
+// and later launches resume from it. Checkpoints are named after a fingerprint of the NAND image, fuses, 1BL and the
+// settings boot depends on, so changing any of them misses the old checkpoint, boots normally and captures a new one.
+namespace Xe::SaveState {
+
+class SaveStateManager;
+
+class FastBoot {
+public:
+  // Fingerprints the machine, so create it before the CPU starts.
+  FastBoot(SaveStateManager *saveStateManager);
+  ~FastBoot();
+
+  // Call once the CPU is started. Resumes from the checkpoint if there's one, otherwise arms the trigger to capture
+  // it. Returns true if it resumed.
+  bool Start();
+  // Disarms the trigger, waiting for a capture in progress. Call it before the CPU is reset.
+  void Stop();
+
+  // POST code written by the guest.
+  void OnPOST(u64 postCode);
+private:
+  // Sets the trigger up and starts the capture thread.
+  void Arm();
+  // Trigger reached, wakes the capture thread. Called from the PPU threads.
+  void RequestCapture();
+  // Saving suspends the PPUs, so it's done on a thread of its own.
+  void CaptureThreadLoop();
+  void Capture();
+  // Removes the address trigger, if set. Must hold busyMutex.
+  void RemoveBreakpoint();
+  // Save states
+  SaveStateManager *manager = nullptr;
+  // Checkpoint for this machine
+  fs::path checkpointPath = {};
+  // Waiting for the trigger
+  std::atomic<bool> armed = false;
+  // Address trigger breakpoint ID, 0 if none
+  u32 breakpointId = 0;
+  // Capture thread
+  std::thread captureThread;
+  std::mutex captureMutex;
+  std::condition_variable captureCondition;
+  bool captureRequested = false;
+  bool exiting = false;
+  // Held while capturing, Stop waits on it
+  std::mutex busyMutex;
+};
+
+} // namespace Xe::SaveState
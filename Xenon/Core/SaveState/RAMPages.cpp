@@ -0,0 +1,112 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "RAMPages.h"
+
+#include <atomic>
+#include <cstring>
+
+#include "Base/Compression.h"
+
+namespace Xe::SaveState {
+
+static bool IsZeroPage(const u8 *page) {
+  const u64 *words = reinterpret_cast<const u64*>(page);
+  for (u64 i = 0; i != DIRTY_PAGE_SIZE / sizeof(u64); ++i) {
+    if (words[i])
+      return false;
+  }
+  return true;
+}
+
+u64 SaveRAMPages(Base::StateWriter &writer, const u8 *ramBase, const std::vector<u64> &pages, bool skipZeroPages) {
+  const u32 workers = GetWorkerCount(pages.size());
+  // Every worker encodes its own range, the ranges are then stitched together in order
+  std::vector<Base::StateWriter> records(workers);
+  std::vector<u64> recordCounts(workers, 0);
+  ParallelFor(pages.size(), workers, [&](u32 worker, u64 begin, u64 end) {
+    Base::Compression::Compressor compressor{};
+    std::vector<u8> compressed(Base::Compression::Bound(DIRTY_PAGE_SIZE));
+    Base::StateWriter &out = records[worker];
+    for (u64 i = begin; i != end; ++i) {
+      const u8 *page = ramBase + pages[i];
+      u8 encoding = pageRaw;
+      const u8 *data = page;
+      size_t size = DIRTY_PAGE_SIZE;
+      if (IsZeroPage(page)) {
+        if (skipZeroPages)
+          continue;
+        encoding = pageZero;
+        size = 0;
+      } else if (const size_t compressedSize = compressor.Compress(page, DIRTY_PAGE_SIZE, compressed.data(),
+        compressed.size())) {
+        encoding = pageCompressed;
+        data = compressed.data();
+        size = compressedSize;
+      }
+      out.Write<u32>(static_cast<u32>(pages[i] >> DIRTY_PAGE_SHIFT));
+      out.Write<u8>(encoding);
+      out.Write<u32>(static_cast<u32>(size));
+      out.WriteBytes(data, size);
+      recordCounts[worker]++;
+    }
+  });
+  u64 totalRecords = 0;
+  for (const u64 count : recordCounts)
+    totalRecords += count;
+  writer.Write<u64>(totalRecords);
+  for (Base::StateWriter &out : records)
+    writer.WriteBytes(out.GetData().data(), out.Size());
+  return totalRecords;
+}
+
+bool LoadRAMPages(Base::StateReader &reader, u8 *ramBase, u64 ramSize) {
+  struct sPageRecord {
+    u64 offset = 0;
+    const u8 *data = nullptr;
+    u32 size = 0;
+    u8 encoding = pageZero;
+  };
+  const u64 pageCount = ramSize >> DIRTY_PAGE_SHIFT;
+  const u64 recordCount = reader.Read<u64>();
+  if (!reader.Good() || recordCount > reader.Remaining() / pageRecordHeaderSize)
+    return false;
+  // Index first, the records have variable sizes
+  std::vector<sPageRecord> pageRecords(recordCount);
+  for (sPageRecord &record : pageRecords) {
+    const u32 page = reader.Read<u32>();
+    record.encoding = reader.Read<u8>();
+    record.size = reader.Read<u32>();
+    record.data = reader.Skip(record.size);
+    if (!reader.Good() || page >= pageCount || record.encoding > pageCompressed)
+      return false;
+    record.offset = static_cast<u64>(page) << DIRTY_PAGE_SHIFT;
+  }
+  std::atomic<bool> corrupt = false;
+  ParallelFor(pageRecords.size(), GetWorkerCount(pageRecords.size()), [&](u32, u64 begin, u64 end) {
+    Base::Compression::Decompressor decompressor{};
+    for (u64 i = begin; i != end; ++i) {
+      const sPageRecord &record = pageRecords[i];
+      u8 *page = ramBase + record.offset;
+      switch (record.encoding) {
+      case pageZero:
+        std::memset(page, 0, DIRTY_PAGE_SIZE);
+        break;
+      case pageRaw:
+        if (record.size == DIRTY_PAGE_SIZE)
+          std::memcpy(page, record.data, DIRTY_PAGE_SIZE);
+        else
+          corrupt = true;
+        break;
+      case pageCompressed:
+        if (!decompressor.Decompress(record.data, record.size, page, DIRTY_PAGE_SIZE))
+          corrupt = true;
+        break;
+      }
+    }
+  });
+  return !corrupt;
+}
+
+} // namespace Xe::SaveState
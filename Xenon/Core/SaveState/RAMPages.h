@@ -0,0 +1,61 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "Base/StateStream.h"
+#include "Base/Types.h"
+#include "Core/RAM/DirtyTracker.h"
+
+// RAM section of a save state.
+// It's [u64 record count] followed by one [u32 page index][u8 encoding][u32 size][data] record per page. Zero pages
+// have no data, the others are stored compressed when that makes them smaller. An incremental state only has records
+// for the pages written since its base, loading it on top of the base gives the RAM it was saved with.
+namespace Xe::SaveState {
+
+enum ePageEncoding : u8 {
+  pageZero,      // No data, page is zero filled
+  pageRaw,       // Stored as is
+  pageCompressed
+};
+
+// Smallest possible page record.
+inline constexpr u64 pageRecordHeaderSize = sizeof(u32) + sizeof(u8) + sizeof(u32);
+
+// Workers used to go over the given amount of pages.
+inline u32 GetWorkerCount(u64 items) {
+  const u32 hostThreads = std::max(1U, std::thread::hardware_concurrency());
+  // Not worth a thread below a few hundred pages
+  return static_cast<u32>(std::clamp<u64>(items / 512, 1, std::min(hostThreads, 16U)));
+}
+
+// Splits [0, count) in one contiguous range per worker and runs them in parallel.
+template <typename Fn>
+void ParallelFor(u64 count, u32 workers, Fn &&fn) {
+  if (workers <= 1) {
+    fn(0, 0, count);
+    return;
+  }
+  std::vector<std::thread> threads{};
+  threads.reserve(workers);
+  for (u32 worker = 0; worker != workers; ++worker) {
+    const u64 begin = count * worker / workers;
+    const u64 end = count * (worker + 1) / workers;
+    threads.emplace_back([&fn, worker, begin, end] { fn(worker, begin, end); });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+}
+
+// Writes the records of the given pages (byte offsets into ramBase), returns how many it wrote. Zero pages are left
+// out when skipZeroPages is set, for full states that are loaded over cleared RAM.
+u64 SaveRAMPages(Base::StateWriter &writer, const u8 *ramBase, const std::vector<u64> &pages, bool skipZeroPages);
+// Reads records back into ramBase. Returns false if they're corrupt or point past ramSize.
+bool LoadRAMPages(Base::StateReader &reader, u8 *ramBase, u64 ramSize);
+
+} // namespace Xe::SaveState
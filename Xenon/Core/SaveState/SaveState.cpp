@@ -0,0 +1,442 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "SaveState.h"
+
+#include <chrono>
+#include <fstream>
+#include <random>
+
+#include "Base/Compression.h"
+#include "Base/Hash.h"
+#include "Base/Logging/Log.h"
+#include "Core/XeMain.h"
+
+#include "RAMPages.h"
+
+// File layout: [sStateHeader][parent path string][sections]. The parent path is relative to the state's directory
+// when possible, so a chain can be moved around as a whole.
+// The RAM section is described in RAMPages.h. Full states skip zero pages, they're all zero after RAM::Clear anyway.
+namespace Xe::SaveState {
+
+// Longest incremental chain followed, guards against loops.
+static constexpr u32 maxChainDepth = 64;
+
+// Machine state, apart from RAM and the NAND image. Loaded in this order.
+struct sComponent {
+  const char *name;
+  u32 tag;
+  void (*save)(Base::StateWriter &writer);
+  void (*load)(Base::StateReader &reader);
+};
+
+static const sComponent components[] = {
+  { "Scheduler", "Scheduler"_j,
+    [](Base::StateWriter &writer) { XeMain::scheduler->SaveState(writer); },
+    [](Base::StateReader &reader) { XeMain::scheduler->LoadState(reader); } },
+  { "HostBridge", "HostBridge"_j,
+    [](Base::StateWriter &writer) { XeMain::hostBridge->SaveState(writer); },
+    [](Base::StateReader &reader) { XeMain::hostBridge->LoadState(reader); } },
+  { "PCIBridge", "PCIBridge"_j,
+    [](Base::StateWriter &writer) { XeMain::pciBridge->SaveState(writer); },
+    [](Base::StateReader &reader) { XeMain::pciBridge->LoadState(reader); } },
+  { "XGPU", "XGPU"_j,
+    [](Base::StateWriter &writer) { XeMain::xenos->SaveState(writer); },
+    [](Base::StateReader &reader) { XeMain::xenos->LoadState(reader); } },
+  { "CPU", "CPU"_j,
+    [](Base::StateWriter &writer) { XeMain::xenonCPU->SaveState(writer); },
+    [](Base::StateReader &reader) { XeMain::xenonCPU->LoadState(reader); } }
+};
+
+// A state read from disk.
+struct sLoadedState {
+  fs::path path = {};
+  std::vector<u8> data = {};
+  sStateHeader header = {};
+  std::string parentPath = {};
+  // Where the sections start
+  size_t bodyOffset = 0;
+
+  Base::StateReader Body() const {
+    return Base::StateReader(data.data() + bodyOffset, data.size() - bodyOffset);
+  }
+};
+
+static u64 NewSnapshotId() {
+  std::random_device device{};
+  const u64 id = ((static_cast<u64>(device()) << 32) | device()) ^
+    static_cast<u64>(std::chrono::steady_clock::now().time_since_epoch().count());
+  // 0 means no parent
+  return id ? id : 1;
+}
+
+static double ElapsedMs(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool ReadFile(const fs::path &path, std::vector<u8> &data) {
+  std::error_code ec;
+  const u64 fileSize = fs::file_size(path, ec);
+  if (ec)
+    return false;
+  std::ifstream file(path, std::ios::in | std::ios::binary);
+  if (!file)
+    return false;
+  data.resize(fileSize);
+  file.read(reinterpret_cast<char*>(data.data()), fileSize);
+  return static_cast<u64>(file.gcount()) == fileSize;
+}
+
+static bool WriteFile(const fs::path &path, const std::vector<u8> &data) {
+  std::error_code ec;
+  if (path.has_parent_path())
+    fs::create_directories(path.parent_path(), ec);
+  // Written next to it and renamed over it, so a failed save doesn't take the previous state with it
+  fs::path tempPath = path;
+  tempPath += ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file)
+      return false;
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    if (!file)
+      return false;
+  }
+  fs::rename(tempPath, path, ec);
+  return !ec;
+}
+
+static bool ReadState(const fs::path &path, sLoadedState &state) {
+  state.path = path;
+  if (!ReadFile(path, state.data)) {
+    LOG_ERROR(System, "SaveState: Unable to read '{}'.", path.string());
+    return false;
+  }
+  Base::StateReader reader(state.data.data(), state.data.size());
+  reader.Read(state.header);
+  reader.ReadString(state.parentPath);
+  if (!reader.Good() || state.header.magic != XE_SAVESTATE_MAGIC) {
+    LOG_ERROR(System, "SaveState: '{}' isn't a save state.", path.string());
+    return false;
+  }
+  if (state.header.version != XE_SAVESTATE_VERSION) {
+    LOG_ERROR(System, "SaveState: '{}' is version {}, only version {} is supported.", path.string(),
+      state.header.version, XE_SAVESTATE_VERSION);
+    return false;
+  }
+  if (state.header.ramSize != XeMain::ram->GetSize() || state.header.pageSize != DIRTY_PAGE_SIZE) {
+    LOG_ERROR(System, "SaveState: '{}' was saved with 0x{:X} bytes of RAM, the console has 0x{:X}.", path.string(),
+      state.header.ramSize, XeMain::ram->GetSize());
+    return false;
+  }
+  state.bodyOffset = state.data.size() - reader.Remaining();
+  return true;
+}
+
+// Machine state at one point, compared across a round trip.
+struct sMachineCapture {
+  std::vector<std::vector<u8>> components = {};
+  std::vector<u8> nand = {};
+  std::vector<u64> pageHashes = {};
+};
+
+static void CaptureMachine(sMachineCapture &capture) {
+  capture.components.clear();
+  for (const sComponent &component : components) {
+    Base::StateWriter writer{};
+    component.save(writer);
+    capture.components.push_back(std::move(writer.GetData()));
+  }
+  capture.nand.clear();
+  if (XeMain::sfcx) {
+    Base::StateWriter writer{};
+    XeMain::sfcx->SaveImage(writer);
+    capture.nand = std::move(writer.GetData());
+  }
+  const u8 *ramBase = XeMain::ram->GetPointerToAddress(RAM_START_ADDR);
+  const u64 pageCount = XeMain::ram->GetSize() >> DIRTY_PAGE_SHIFT;
+  capture.pageHashes.resize(pageCount);
+  ParallelFor(pageCount, GetWorkerCount(pageCount), [&](u32, u64 begin, u64 end) {
+    for (u64 page = begin; page != end; ++page)
+      capture.pageHashes[page] = Base::DataHash64(ramBase + (page << DIRTY_PAGE_SHIFT), DIRTY_PAGE_SIZE);
+  });
+}
+
+SaveStateManager::SaveStateManager() {
+  LOG_INFO(System, "SaveState: RAM pages are {}.", Base::Compression::Available() ? "zstd compressed" :
+    "stored uncompressed (built without zstd)");
+}
+
+SaveStateManager::~SaveStateManager() {
+  if (dirtyConsumer != -1 && XeMain::ram)
+    XeMain::ram->GetDirtyTracker().UnregisterConsumer(dirtyConsumer);
+}
+
+bool SaveStateManager::Save(const fs::path &path, bool incremental) {
+  std::lock_guard lock(mutex);
+  if (!XeMain::CPUStarted || !XeMain::xenonCPU) {
+    LOG_ERROR(System, "SaveState: The console isn't running, nothing to save.");
+    return false;
+  }
+  Freeze();
+  const bool result = SaveFrozen(path, incremental);
+  Thaw();
+  return result;
+}
+
+bool SaveStateManager::Load(const fs::path &path) {
+  std::lock_guard lock(mutex);
+  if (!XeMain::CPUStarted || !XeMain::xenonCPU) {
+    LOG_ERROR(System, "SaveState: The console isn't running, start it before loading a state.");
+    return false;
+  }
+  Freeze();
+  const bool result = LoadFrozen(path);
+  Thaw();
+  return result;
+}
+
+void SaveStateManager::Invalidate() {
+  std::lock_guard lock(mutex);
+  basePath.clear();
+  baseId = 0;
+}
+
+bool SaveStateManager::VerifyRoundTrip(const fs::path &path, bool incremental) {
+  std::lock_guard lock(mutex);
+  if (!XeMain::CPUStarted || !XeMain::xenonCPU) {
+    LOG_ERROR(System, "SaveState: The console isn't running, nothing to verify.");
+    return false;
+  }
+  Freeze();
+  sMachineCapture before{};
+  CaptureMachine(before);
+  const auto saveStart = std::chrono::steady_clock::now();
+  bool result = SaveFrozen(path, incremental);
+  const double saveMs = ElapsedMs(saveStart);
+  const auto loadStart = std::chrono::steady_clock::now();
+  result = result && LoadFrozen(path);
+  const double loadMs = ElapsedMs(loadStart);
+  if (result) {
+    sMachineCapture after{};
+    CaptureMachine(after);
+    for (size_t i = 0; i != before.components.size(); ++i) {
+      if (before.components[i] != after.components[i]) {
+        LOG_ERROR(System, "SaveState: {} state differs after the round trip.", components[i].name);
+        result = false;
+      }
+    }
+    if (before.nand != after.nand) {
+      LOG_ERROR(System, "SaveState: NAND image differs after the round trip.");
+      result = false;
+    }
+    u64 differingPages = 0;
+    for (u64 page = 0; page != before.pageHashes.size(); ++page) {
+      if (before.pageHashes[page] != after.pageHashes[page])
+        differingPages++;
+    }
+    if (differingPages) {
+      LOG_ERROR(System, "SaveState: {} RAM pages differ after the round trip.", differingPages);
+      result = false;
+    }
+  }
+  Thaw();
+  if (result) {
+    LOG_INFO(System, "SaveState: {} round trip passed (save {:.1f} ms, load {:.1f} ms).",
+      incremental ? "Incremental" : "Full", saveMs, loadMs);
+  } else {
+    LOG_ERROR(System, "SaveState: {} round trip failed.", incremental ? "Incremental" : "Full");
+  }
+  return result;
+}
+
+void SaveStateManager::Freeze() {
+  // CPU first so nothing new gets started, then guest time, then let whatever is in flight land
+  XeMain::xenonCPU->Suspend();
+  XeMain::scheduler->Pause();
+  if (XeMain::xenos && !XeMain::xenos->WaitIdle(1000ms))
+    LOG_WARNING(System, "SaveState: Xenos didn't go idle, its ring buffer is saved mid way.");
+  if (XeMain::ioPool)
+    XeMain::ioPool->WaitIdle();
+}
+
+void SaveStateManager::Thaw() {
+  XeMain::scheduler->Resume();
+  XeMain::xenonCPU->Resume();
+}
+
+bool SaveStateManager::SaveFrozen(const fs::path &path, bool incremental) {
+  const auto start = std::chrono::steady_clock::now();
+  RAMDirtyTracker &tracker = XeMain::ram->GetDirtyTracker();
+  if (dirtyConsumer == -1) {
+    dirtyConsumer = tracker.RegisterConsumer("SaveState");
+    if (dirtyConsumer == -1)
+      LOG_WARNING(System, "SaveState: No dirty tracking slot left, every state will be a full one.");
+  }
+  std::error_code ec;
+  if (incremental && (basePath.empty() || dirtyConsumer == -1)) {
+    LOG_WARNING(System, "SaveState: Nothing to base '{}' on, saving a full state.", path.string());
+    incremental = false;
+  } else if (incremental && fs::equivalent(path, basePath, ec)) {
+    LOG_WARNING(System, "SaveState: '{}' is the state it would be based on, saving a full state.", path.string());
+    incremental = false;
+  }
+
+  sStateHeader header{};
+  header.snapshotId = NewSnapshotId();
+  header.ramSize = XeMain::ram->GetSize();
+  header.pageSize = DIRTY_PAGE_SIZE;
+  std::string parentPath{};
+  if (incremental) {
+    header.flags |= stateIncremental;
+    header.parentId = baseId;
+    const fs::path relativePath = fs::relative(fs::absolute(basePath, ec), fs::absolute(path, ec).parent_path(), ec);
+    parentPath = (ec || relativePath.empty() ? fs::absolute(basePath, ec) : relativePath).string();
+  }
+  const u64 nandGeneration = XeMain::sfcx ? XeMain::sfcx->GetImageGeneration() : 0;
+  if (XeMain::sfcx && (!incremental || nandGeneration != baseNANDGeneration))
+    header.flags |= stateHasNAND;
+
+  Base::StateWriter writer{};
+  writer.Write(header);
+  writer.WriteString(parentPath);
+  for (const sComponent &component : components) {
+    writer.BeginSection(component.tag);
+    component.save(writer);
+    writer.EndSection();
+  }
+  if (header.flags & stateHasNAND) {
+    writer.BeginSection("NAND"_j);
+    XeMain::sfcx->SaveImage(writer);
+    writer.EndSection();
+  }
+
+  // Collecting also resets the tracker, past this point the base moves to this state
+  std::vector<u64> pages{};
+  if (incremental) {
+    pages = tracker.CollectDirtyPages(dirtyConsumer);
+  } else {
+    if (dirtyConsumer != -1)
+      tracker.CollectDirtyPages(dirtyConsumer);
+    pages.resize(header.ramSize >> DIRTY_PAGE_SHIFT);
+    for (u64 page = 0; page != pages.size(); ++page)
+      pages[page] = page << DIRTY_PAGE_SHIFT;
+  }
+  writer.BeginSection("RAM"_j);
+  const u64 pageRecords = SaveRAMPages(writer, XeMain::ram->GetPointerToAddress(RAM_START_ADDR), pages, !incremental);
+  writer.EndSection();
+
+  if (!WriteFile(path, writer.GetData())) {
+    LOG_ERROR(System, "SaveState: Unable to write '{}'.", path.string());
+    // The dirty pages are gone, only a full state is safe now
+    basePath.clear();
+    baseId = 0;
+    return false;
+  }
+  basePath = path;
+  baseId = header.snapshotId;
+  baseNANDGeneration = nandGeneration;
+  LOG_INFO(System, "SaveState: Saved {} state '{}', {} RAM pages, {} KiB, in {:.1f} ms.",
+    incremental ? "an incremental" : "a full", path.string(), pageRecords, writer.Size() / 1024, ElapsedMs(start));
+  return true;
+}
+
+bool SaveStateManager::LoadFrozen(const fs::path &path) {
+  const auto start = std::chrono::steady_clock::now();
+  // Newest first
+  std::vector<sLoadedState> chain(1);
+  if (!ReadState(path, chain.back()))
+    return false;
+  while (chain.back().header.flags & stateIncremental) {
+    if (chain.size() == maxChainDepth) {
+      LOG_ERROR(System, "SaveState: '{}' is based on too many states.", path.string());
+      return false;
+    }
+    fs::path parentPath = chain.back().parentPath;
+    if (parentPath.is_relative())
+      parentPath = chain.back().path.parent_path() / parentPath;
+    const u64 parentId = chain.back().header.parentId;
+    chain.emplace_back();
+    if (!ReadState(parentPath, chain.back()))
+      return false;
+    if (chain.back().header.snapshotId != parentId) {
+      LOG_ERROR(System, "SaveState: '{}' was overwritten after a state was based on it.", parentPath.string());
+      return false;
+    }
+  }
+
+  // Check everything is there before touching the machine
+  const sLoadedState &newest = chain.front();
+  Base::StateReader section{};
+  for (const sComponent &component : components) {
+    if (!newest.Body().GetSection(component.tag, section)) {
+      LOG_ERROR(System, "SaveState: '{}' has no {} state.", path.string(), component.name);
+      return false;
+    }
+  }
+  for (const sLoadedState &state : chain) {
+    if (!state.Body().GetSection("RAM"_j, section)) {
+      LOG_ERROR(System, "SaveState: '{}' has no RAM.", state.path.string());
+      return false;
+    }
+  }
+
+  // From here on a failure leaves the machine half restored
+  bool result = true;
+  XeMain::ram->Clear();
+  for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+    it->Body().GetSection("RAM"_j, section);
+    if (!LoadRAMPages(section, XeMain::ram->GetPointerToAddress(RAM_START_ADDR), XeMain::ram->GetSize())) {
+      LOG_ERROR(System, "SaveState: RAM in '{}' is corrupt.", it->path.string());
+      result = false;
+    }
+  }
+  // The NAND image comes from the newest state that has one
+  for (const sLoadedState &state : chain) {
+    if (!(state.header.flags & stateHasNAND))
+      continue;
+    if (XeMain::sfcx && state.Body().GetSection("NAND"_j, section)) {
+      XeMain::sfcx->LoadImage(section);
+      if (!section.Good()) {
+        LOG_ERROR(System, "SaveState: NAND image in '{}' is corrupt.", state.path.string());
+        result = false;
+      }
+    }
+    break;
+  }
+  for (const sComponent &component : components) {
+    newest.Body().GetSection(component.tag, section);
+    component.load(section);
+    if (!section.Good()) {
+      LOG_ERROR(System, "SaveState: {} state in '{}' is corrupt.", component.name, path.string());
+      result = false;
+    }
+  }
+  // BARs may have moved
+  XeMain::rootBus->RebuildPageTable();
+  // Code was replaced, the hooks and scanned pages belong to whatever ran before
+  XeMain::xenonCPU->GetHLE().Reset();
+
+  ResetDirtyBase();
+  if (!result) {
+    basePath.clear();
+    baseId = 0;
+    return false;
+  }
+  basePath = path;
+  baseId = newest.header.snapshotId;
+  LOG_INFO(System, "SaveState: Loaded '{}' ({} file(s)) in {:.1f} ms.", path.string(), chain.size(), ElapsedMs(start));
+  return true;
+}
+
+void SaveStateManager::ResetDirtyBase() {
+  RAMDirtyTracker &tracker = XeMain::ram->GetDirtyTracker();
+  if (dirtyConsumer == -1)
+    dirtyConsumer = tracker.RegisterConsumer("SaveState");
+  if (dirtyConsumer != -1)
+    tracker.CollectDirtyPages(dirtyConsumer);
+  baseNANDGeneration = XeMain::sfcx ? XeMain::sfcx->GetImageGeneration() : 0;
+}
+
+} // namespace Xe::SaveState
@@ -0,0 +1,78 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <mutex>
+
+#include "Base/PathUtil.h"
+#include "Base/StateStream.h"
+#include "Base/Types.h"
+
+// Save states.
+// A state holds everything needed to resume the console where it was: the PPU threads and SoC blocks, the event
+// scheduler, the bridges and PCI devices, Xenos, the NAND image and RAM. RAM is stored per page, zero pages are left
+// out and the others compressed. An incremental state only holds the pages (and the NAND image, if it changed) written
+// since the state it's based on, the last one saved or loaded, and points to that file; loading it walks the chain
+// back to a full state.
+// HDD and ODD images aren't part of a state, the drives keep using whatever images are loaded.
+namespace Xe::SaveState {
+
+#define XE_SAVESTATE_MAGIC 0x54535358 // 'XSST'
+#define XE_SAVESTATE_VERSION 1
+
+enum eStateFlags : u32 {
+  stateIncremental = 1 << 0, // Based on another state, see parent path
+  stateHasNAND = 1 << 1      // Has the NAND image
+};
+
+#pragma pack(push, 1)
+struct sStateHeader {
+  u32 magic = XE_SAVESTATE_MAGIC;
+  u32 version = XE_SAVESTATE_VERSION;
+  // Identifies the state, incremental states reference their parent with it
+  u64 snapshotId = 0;
+  u64 parentId = 0;
+  u64 ramSize = 0;
+  u32 pageSize = 0;
+  u32 flags = 0;
+};
+#pragma pack(pop)
+
+class SaveStateManager {
+public:
+  SaveStateManager();
+  ~SaveStateManager();
+
+  // Saves the running console. Incremental states need a base (falls back to a full state without one), which must
+  // be kept around. Must not be called from an emulator thread.
+  bool Save(const fs::path &path, bool incremental = false);
+  // Loads a state, along with the ones it's based on. Must not be called from an emulator thread.
+  bool Load(const fs::path &path);
+  // Forgets the base, the next state will be a full one. Call it whenever the machine is reset or rebuilt.
+  void Invalidate();
+
+  // Saves a state, loads it back, and checks the machine ended up exactly like it was. Returns true if it did.
+  bool VerifyRoundTrip(const fs::path &path, bool incremental);
+private:
+  // Stops/restarts everything that can touch the machine state.
+  void Freeze();
+  void Thaw();
+  // The same, with the machine already frozen.
+  bool SaveFrozen(const fs::path &path, bool incremental);
+  bool LoadFrozen(const fs::path &path);
+  // Makes whatever RAM holds now the base for the next incremental state.
+  void ResetDirtyBase();
+  // One save or load at a time
+  std::mutex mutex;
+  // RAM dirty tracker consumer, -1 until the first state
+  s32 dirtyConsumer = -1;
+  // Last state saved or loaded, incremental states are based on it
+  fs::path basePath = {};
+  u64 baseId = 0;
+  // NAND image generation when the base was taken
+  u64 baseNANDGeneration = 0;
+};
+
+} // namespace Xe::SaveState
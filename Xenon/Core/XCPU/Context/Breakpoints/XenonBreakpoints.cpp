@@ -0,0 +1,98 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include <algorithm>
+
+#include "Base/Global.h"
+#include "Core/XCPU/PPU/PowerPC.h"
+
+#include "XenonBreakpoints.h"
+
+namespace Xe::XCPU {
+
+u32 XenonBreakpoints::Add(u64 address, s8 ppuID, s8 threadID, BreakpointCondition condition, u64 ignoreCount,
+  bool temporary) {
+  std::lock_guard lock(bpLock);
+  sBreakpoint breakpoint = {};
+  breakpoint.id = nextId++;
+  breakpoint.address = address;
+  breakpoint.ppuID = ppuID;
+  breakpoint.threadID = threadID;
+  breakpoint.ignoreCount = ignoreCount;
+  breakpoint.temporary = temporary;
+  breakpoint.condition = std::move(condition);
+  breakpoints.push_back(std::move(breakpoint));
+  LOG_DEBUG(Xenon, "Breakpoint {} added at {:#x}", nextId - 1, address);
+  Rebuild();
+  return nextId - 1;
+}
+
+bool XenonBreakpoints::Remove(u32 id) {
+  std::lock_guard lock(bpLock);
+  const auto it = std::find_if(breakpoints.begin(), breakpoints.end(),
+    [id](const sBreakpoint &breakpoint) { return breakpoint.id == id; });
+  if (it == breakpoints.end())
+    return false;
+  breakpoints.erase(it);
+  Rebuild();
+  return true;
+}
+
+void XenonBreakpoints::Clear() {
+  std::lock_guard lock(bpLock);
+  breakpoints.clear();
+  Rebuild();
+}
+
+std::vector<sBreakpoint> XenonBreakpoints::GetBreakpoints() {
+  std::lock_guard lock(bpLock);
+  return breakpoints;
+}
+
+bool XenonBreakpoints::IsBreakpointAt(u64 EA) {
+  if (!IsPageArmed(EA))
+    return false;
+  std::lock_guard lock(bpLock);
+  return std::any_of(breakpoints.begin(), breakpoints.end(),
+    [EA](const sBreakpoint &breakpoint) { return breakpoint.address == EA; });
+}
+
+bool XenonBreakpoints::Check(sPPEState *ppeState, u64 EA) {
+  std::lock_guard lock(bpLock);
+  for (auto it = breakpoints.begin(); it != breakpoints.end(); ++it) {
+    sBreakpoint &breakpoint = *it;
+    if (breakpoint.address != EA)
+      continue;
+    if (breakpoint.ppuID != -1 && breakpoint.ppuID != ppeState->ppuID)
+      continue;
+    if (breakpoint.threadID != -1 && breakpoint.threadID != executingThread)
+      continue;
+    if (breakpoint.condition && !breakpoint.condition(ppeState))
+      continue;
+    if (breakpoint.hitCount++ < breakpoint.ignoreCount)
+      continue;
+    LOG_DEBUG(Xenon, "Breakpoint {} hit at {:#x} (PPU{}, thread {})", breakpoint.id, EA, ppeState->ppuID,
+      static_cast<u8>(executingThread));
+    if (breakpoint.temporary) {
+      breakpoints.erase(it);
+      Rebuild();
+    }
+    return true;
+  }
+  return false;
+}
+
+void XenonBreakpoints::Rebuild() {
+  for (auto &word : pageBitmap) {
+    word.store(0, std::memory_order_relaxed);
+  }
+  for (const auto &breakpoint : breakpoints) {
+    const u64 page = (breakpoint.address >> 12) & (bpPageCount - 1);
+    pageBitmap[page >> 6].fetch_or(1ULL << (page & 63), std::memory_order_relaxed);
+  }
+  activeCount.store(static_cast<u32>(breakpoints.size()), std::memory_order_release);
+  generation.fetch_add(1, std::memory_order_release);
+}
+
+}
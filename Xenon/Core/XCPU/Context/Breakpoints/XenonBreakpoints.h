@@ -0,0 +1,89 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include "Base/Types.h"
+
+struct sPPEState;
+
+namespace Xe::XCPU {
+  // Optional breakpoint condition, evaluated on the PPE that reached it (executingThread is the thread).
+  using BreakpointCondition = std::function<bool(sPPEState *ppeState)>;
+
+  struct sBreakpoint {
+    // Breakpoint ID, used for removal.
+    u32 id = 0;
+    // Effective address of the instruction.
+    u64 address = 0;
+    // Only trigger on this PPU/thread, -1 for any.
+    s8 ppuID = -1;
+    s8 threadID = -1;
+    // Number of hits to ignore before triggering.
+    u64 ignoreCount = 0;
+    // Number of times it was reached (matching PPU/thread and condition).
+    u64 hitCount = 0;
+    // Removed once it triggers (run to address).
+    bool temporary = false;
+    // Optional condition.
+    BreakpointCondition condition{};
+  };
+
+  // Execution breakpoints.
+  // Armed instruction pages are tracked in a bitmap, the interpreter only checks the breakpoint list when the
+  // current instruction's page is armed, and the JIT only emits a breakpoint stub for instructions that have one.
+  // When no breakpoints are armed, execution never looks at them.
+  class XenonBreakpoints {
+  public:
+    // Adds a breakpoint. Returns its ID.
+    u32 Add(u64 address, s8 ppuID = -1, s8 threadID = -1, BreakpointCondition condition = {}, u64 ignoreCount = 0,
+      bool temporary = false);
+    // Removes a breakpoint. Returns false if it didn't exist.
+    bool Remove(u32 id);
+    // Removes every breakpoint.
+    void Clear();
+    // Returns a copy of the current breakpoints.
+    std::vector<sBreakpoint> GetBreakpoints();
+
+    // Returns true if any breakpoint is armed.
+    bool Any() const {
+      return activeCount.load(std::memory_order_acquire) != 0;
+    }
+    // Returns true if the page containing the given address has any breakpoint.
+    bool IsPageArmed(u64 EA) const {
+      const u64 page = (EA >> 12) & (bpPageCount - 1);
+      return pageBitmap[page >> 6].load(std::memory_order_relaxed) & (1ULL << (page & 63));
+    }
+    // Returns true if there's a breakpoint on the given address. Used by the JIT when building blocks.
+    bool IsBreakpointAt(u64 EA);
+    // Evaluates the breakpoints on the given address for the current thread. Returns true if execution must halt.
+    bool Check(sPPEState *ppeState, u64 EA);
+
+    // Bumped on every change. The JIT drops its blocks when it changes, so breakpoint stubs are emitted/removed.
+    u32 GetGeneration() const {
+      return generation.load(std::memory_order_acquire);
+    }
+
+  private:
+    // Rebuilds the page bitmap from the current list. Must hold bpLock.
+    void Rebuild();
+
+    // Number of tracked pages (32-bit effective address space). Higher addresses wrap around, which at worst causes
+    // a few extra list checks.
+    static constexpr u64 bpPageCount = 1ULL << 20;
+
+    std::atomic<u32> activeCount = 0;
+    std::atomic<u32> generation = 0;
+    std::array<std::atomic<u64>, bpPageCount / 64> pageBitmap{};
+    std::vector<sBreakpoint> breakpoints{};
+    std::mutex bpLock{};
+    u32 nextId = 1;
+  };
+}
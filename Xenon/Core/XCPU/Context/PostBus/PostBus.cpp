@@ -3,10 +3,14 @@
 /***************************************************************/
 
 #include "Base/Logging/Log.h"
+#include "Core/XeMain.h"
 
 #include "PostBus.h"
 
 void Xe::XCPU::POSTBUS::POST(u64 postCode) {
+  // Fast boot checkpoints can be triggered by a POST code
+  if (XeMain::fastBoot)
+    XeMain::fastBoot->OnPOST(postCode);
   /* 1BL */
   if (postCode >= 0x10 && postCode <= 0x1E) {
     switch (postCode) {
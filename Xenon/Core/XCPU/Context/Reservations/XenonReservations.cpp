@@ -4,30 +4,28 @@
 
 #include "XenonReservations.h"
 
-XenonReservations::XenonReservations() {
-  std::lock_guard lock(reservationLock);
-  numReservations = 0;
-  processors = 0;
-  reservations[0] = nullptr;
-}
-
-bool XenonReservations::Register(PPU_RES *Res) {
-  std::lock_guard lock(reservationLock);
-  reservations[processors] = Res;
+bool XenonReservations::Register(PPU_RES *res) {
+  if (processors == XE_RES_MAX_THREADS)
+    return false;
+  reservations[processors] = res;
   processors++;
   return true;
 }
 
 void XenonReservations::Scan(u64 PhysAddress, bool word) {
-  std::lock_guard lock(reservationLock);
-  // Address must be aligned.
-  PhysAddress &= (word ? ~3 : ~7);
+  // Stores of one size may overlap reservations of the other, so it's an overlap test too.
+  ScanRange(PhysAddress, word ? 4 : 8);
+}
+
+void XenonReservations::ScanRange(u64 PhysAddress, u64 size) {
+  // Reservations are doubleword aligned at most.
+  const u64 start = PhysAddress & ~7;
+  const u64 end = PhysAddress + size;
 
-  for (int i = 0; i < processors; i++) {
-    // NB: order of checks matters!
-    if (reservations[i]->valid && PhysAddress == reservations[i]->reservedAddr) {
-      reservations[i]->valid = false;
-      numReservations--;
-    }
+  for (s32 i = 0; i < processors; i++) {
+    const u64 reservation = reservations[i]->reservation.load(std::memory_order_acquire);
+    const u64 reservedAddr = reservation & ~XE_RES_VALID_BIT;
+    if (reservation && reservedAddr >= start && reservedAddr < end)
+      Break(reservations[i], reservation);
   }
 }
@@ -4,42 +4,71 @@
 
 #pragma once
 
-#include <functional>
-#include <mutex>
-#include <vector>
+#include <atomic>
 
+#include "Base/Types.h"
+
+// Max number of hardware threads (3 PPE's * 2 threads).
+#define XE_RES_MAX_THREADS 6
+// Set on a reservation word when it holds a valid reservation. Reserved addresses are always word aligned, so bit 0
+// is free.
+#define XE_RES_VALID_BIT 1ULL
+
+// Per hardware thread reservation.
 struct PPU_RES {
-  u8 ppuID;
-  volatile bool valid;
-  volatile u64 reservedAddr;
+  u8 ppuID = 0;
+  // Reserved granule, real address of the reserved word/doubleword ORed with XE_RES_VALID_BIT, or 0 when the
+  // thread holds no reservation. Written by the owning thread on lwarx/ldarx, cleared by any thread.
+  std::atomic<u64> reservation = 0;
+  // Raw (big endian) memory contents seen by the last lwarx/ldarx. Only accessed by the owning thread, used by the
+  // host CAS in stwcx./stdcx.
+  u64 reservedData = 0;
 };
 
+// Lock-free reservation tracking.
+// Every thread owns a single atomic reservation word. Stores scan the other threads' reservations to break them,
+// but only when at least one reservation is active, so the common case is a single relaxed load.
 class XenonReservations {
 public:
-  XenonReservations();
-  virtual bool Register(PPU_RES *Res);
-  void Increment(void) {
-    std::lock_guard lock(reservationLock);
-    numReservations++;
+  XenonReservations() = default;
+  // Registers a thread's reservation. Only called during init, before any thread runs.
+  bool Register(PPU_RES *res);
+
+  // Acquires a reservation on the given real address, replacing any previous one held by the thread.
+  void Reserve(PPU_RES *res, u64 RA) {
+    if (res->reservation.exchange(RA | XE_RES_VALID_BIT, std::memory_order_acq_rel) == 0)
+      activeReservations.fetch_add(1, std::memory_order_release);
   }
-  void Decrement(void) {
-    std::lock_guard lock(reservationLock);
-    numReservations--;
+  // Drops the thread's reservation. Returns true if it was still held for the given real address, meaning the
+  // conditional store may be performed.
+  bool Release(PPU_RES *res, u64 RA) {
+    const u64 reservation = res->reservation.exchange(0, std::memory_order_acq_rel);
+    if (reservation == 0)
+      return false;
+    activeReservations.fetch_sub(1, std::memory_order_release);
+    return reservation == (RA | XE_RES_VALID_BIT);
   }
+
+  // Breaks every reservation on the given real address. Called on stores.
   void Check(u64 x, bool word) {
-    if (numReservations)
+    if (activeReservations.load(std::memory_order_acquire))
       Scan(x, word);
   }
-  virtual void Scan(u64 PhysAddress, bool word);
-  void LockGuard(std::function<void()> callback) {
-    std::lock_guard lock(reservationLock);
-    if (callback) {
-      callback();
-    }
+  // Range version of Check, used by block writes (dcbz, memcpy, ...).
+  void CheckRange(u64 x, u64 size) {
+    if (activeReservations.load(std::memory_order_acquire))
+      ScanRange(x, size);
   }
+  void Scan(u64 PhysAddress, bool word);
+  void ScanRange(u64 PhysAddress, u64 size);
 private:
-  s32 numReservations;
-  std::recursive_mutex reservationLock;
-  s32 processors;
-  struct PPU_RES *reservations[6];
+  // Atomically clears a reservation if it still holds the expected value.
+  void Break(PPU_RES *res, u64 expected) {
+    if (res->reservation.compare_exchange_strong(expected, 0, std::memory_order_acq_rel))
+      activeReservations.fetch_sub(1, std::memory_order_release);
+  }
+  // Number of threads currently holding a reservation.
+  std::atomic<s32> activeReservations = 0;
+  s32 processors = 0;
+  PPU_RES *reservations[XE_RES_MAX_THREADS] = {};
 };
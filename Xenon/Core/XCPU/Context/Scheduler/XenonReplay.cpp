@@ -0,0 +1,89 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include "Base/Global.h"
+
+#include "XenonReplay.h"
+
+namespace Xe::XCPU {
+
+XenonReplay::~XenonReplay() {
+  Close();
+}
+
+bool XenonReplay::Open(const std::string &path, eReplayMode openMode, u32 instrsPerTick) {
+  Close();
+  if (openMode == eReplayMode::Off)
+    return true;
+
+  if (openMode == eReplayMode::Record) {
+    file.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      LOG_ERROR(Xenon, "Replay: Unable to create '{}' for recording.", path);
+      return false;
+    }
+    const sReplayHeader header = { replayMagic, replayVersion, instrsPerTick, 0 };
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    LOG_INFO(Xenon, "Replay: Recording device events to '{}'.", path);
+  } else {
+    file.open(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+      LOG_ERROR(Xenon, "Replay: Unable to open '{}' for replaying.", path);
+      return false;
+    }
+    sReplayHeader header = {};
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || header.magic != replayMagic || header.version != replayVersion) {
+      LOG_ERROR(Xenon, "Replay: '{}' is not a valid replay file (or was made by an incompatible version).", path);
+      file.close();
+      return false;
+    }
+    if (header.instrsPerTick != instrsPerTick) {
+      LOG_ERROR(Xenon, "Replay: '{}' was recorded at {} instructions per tick, but we run at {}.", path,
+        header.instrsPerTick, instrsPerTick);
+      file.close();
+      return false;
+    }
+    LOG_INFO(Xenon, "Replay: Replaying device events from '{}'.", path);
+  }
+  mode = openMode;
+  PopEvent();
+  return true;
+}
+
+void XenonReplay::Close() {
+  if (file.is_open()) {
+    file.flush();
+    file.close();
+  }
+  mode = eReplayMode::Off;
+  nextEvent.reset();
+}
+
+void XenonReplay::WriteEvent(const sReplayEvent &event) {
+  if (mode != eReplayMode::Record)
+    return;
+  const sReplayEventHeader header = { event.syncIndex, event.timeBase, static_cast<u32>(event.data.size()), event.source };
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(event.data.data()), event.data.size());
+}
+
+void XenonReplay::PopEvent() {
+  nextEvent.reset();
+  if (mode != eReplayMode::Replay)
+    return;
+  sReplayEventHeader header = {};
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!file)
+    return;
+  sReplayEvent event = { header.syncIndex, header.timeBase, header.source, std::vector<u8>(header.size) };
+  file.read(reinterpret_cast<char*>(event.data.data()), header.size);
+  if (!file) {
+    LOG_ERROR(Xenon, "Replay: Truncated event at sync point {}.", header.syncIndex);
+    return;
+  }
+  nextEvent = std::move(event);
+}
+
+} // namespace Xe::XCPU
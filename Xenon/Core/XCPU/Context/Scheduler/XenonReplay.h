@@ -0,0 +1,81 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <fstream>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Base/Types.h"
+
+namespace Xe::XCPU {
+  // Replay file mode.
+  enum class eReplayMode : u8 {
+    Off,
+    Record,
+    Replay
+  };
+
+  // Xenon Replay File
+  // Log of the asynchronous device events delivered during a deterministic run. Each event is tagged with the sync
+  // point (scheduling round) it was delivered at, which is all that's needed to deliver it again at the exact same
+  // point in guest execution.
+  // Layout: a sReplayHeader, followed by the events, each being a sReplayEventHeader and its data.
+  class XenonReplay {
+  public:
+    // 'XREP'
+    static constexpr u32 replayMagic = 0x50455258;
+    static constexpr u32 replayVersion = 1;
+
+    struct sReplayEvent {
+      // Sync point the event was delivered at.
+      u64 syncIndex = 0;
+      // Guest time at delivery, only used for diagnostics.
+      u64 timeBase = 0;
+      // Event source, see eAsyncSource.
+      u8 source = 0;
+      std::vector<u8> data = {};
+    };
+
+    ~XenonReplay();
+
+    // Opens the replay file for recording or replaying. instrsPerTick is stored in the header, as replaying with a
+    // different guest time ratio would diverge. Returns false on failure.
+    bool Open(const std::string &path, eReplayMode openMode, u32 instrsPerTick);
+    void Close();
+
+    eReplayMode GetMode() const { return mode; }
+
+    // Record: appends an event.
+    void WriteEvent(const sReplayEvent &event);
+
+    // Replay: the next event to deliver, nullptr once the file is exhausted.
+    const sReplayEvent *PeekEvent() const { return nextEvent ? &*nextEvent : nullptr; }
+    // Replay: moves on to the following event.
+    void PopEvent();
+
+  private:
+#pragma pack(push, 1)
+    struct sReplayHeader {
+      u32 magic;
+      u32 version;
+      u32 instrsPerTick;
+      u32 reserved;
+    };
+    struct sReplayEventHeader {
+      u64 syncIndex;
+      u64 timeBase;
+      u32 size;
+      u8 source;
+    };
+#pragma pack(pop)
+
+    eReplayMode mode = eReplayMode::Off;
+    std::fstream file;
+    // Replay: event read ahead.
+    std::optional<sReplayEvent> nextEvent = {};
+  };
+} // namespace Xe::XCPU
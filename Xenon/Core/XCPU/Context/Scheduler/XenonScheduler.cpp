@@ -0,0 +1,624 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include <algorithm>
+
+#include "Base/Config.h"
+#include "Base/Global.h"
+#include "Base/Hash.h"
+
+#include "XenonScheduler.h"
+
+namespace Xe::XCPU {
+
+// Longest the end of an empty round waits for a device event before moving on
+#define SCHEDULER_IDLE_ROUND_WAIT 1ms
+// A replay waiting on a device rechecks for shutdown this often, and reports it at the second interval
+#define SCHEDULER_REPLAY_WAIT 100ms
+#define SCHEDULER_REPLAY_WAIT_WARN 5s
+
+XenonScheduler::XenonScheduler() {
+  wheel.resize(wheelSlotCount);
+  hostStart = std::chrono::steady_clock::now();
+
+  switch (Base::JoaatStringHash(Config::xcpu.timeBaseMode)) {
+  case "host"_jLower:
+    break;
+  case "instructions"_jLower:
+    timeBaseMode = eTimeBaseMode::Instructions;
+    break;
+  default:
+    LOG_WARNING(Xenon, "Invalid timebase mode '{}'! Defaulting to host", Config::xcpu.timeBaseMode);
+    break;
+  }
+  instrsPerTick = std::max<u64>(Config::xcpu.instrsPerTick, 1);
+
+  deterministic = Config::xcpu.deterministic;
+  eReplayMode replayMode = eReplayMode::Off;
+  switch (Base::JoaatStringHash(Config::xcpu.replayMode)) {
+  case "off"_jLower:
+    break;
+  case "record"_jLower:
+    replayMode = eReplayMode::Record;
+    break;
+  case "replay"_jLower:
+    replayMode = eReplayMode::Replay;
+    break;
+  default:
+    LOG_WARNING(Xenon, "Invalid replay mode '{}'! Defaulting to off", Config::xcpu.replayMode);
+    break;
+  }
+  if (replayMode != eReplayMode::Off) {
+    if (!deterministic) {
+      LOG_WARNING(Xenon, "Scheduler: Replays need deterministic execution, enabling it.");
+      deterministic = true;
+    }
+    replay.Open(Config::filepaths.replayFile, replayMode, static_cast<u32>(instrsPerTick));
+  }
+  if (deterministic) {
+    // Guest time can't depend on the host in a reproducible run
+    timeBaseMode = eTimeBaseMode::Instructions;
+    LOG_INFO(Xenon, "Scheduler: Deterministic execution enabled.");
+  }
+  if (timeBaseMode == eTimeBaseMode::Instructions)
+    LOG_INFO(Xenon, "Scheduler: Timebase follows retired instructions, {} instructions per tick.", instrsPerTick);
+}
+
+SchedulerEventID XenonScheduler::RegisterEvent(const std::string &name, SchedulerCallback callback) {
+  std::lock_guard lock(eventMutex);
+  // Reuse a free handle if there is one
+  SchedulerEventID eventId = 0;
+  for (; eventId != events.size(); ++eventId) {
+    if (!events[eventId].registered)
+      break;
+  }
+  if (eventId == events.size())
+    events.emplace_back();
+  sSchedulerEvent &event = events[eventId];
+  event.name = name;
+  event.callback = std::move(callback);
+  event.dueTick = 0;
+  event.registered = true;
+  event.scheduled = false;
+  LOG_DEBUG(Xenon, "Scheduler: Registered event '{}' ({}).", name, eventId);
+  return eventId;
+}
+
+void XenonScheduler::UnregisterEvent(SchedulerEventID eventId) {
+  // Don't pull the callback from under a running service pass
+  std::lock_guard serviceLock(serviceMutex);
+  std::lock_guard lock(eventMutex);
+  if (eventId >= events.size() || !events[eventId].registered)
+    return;
+  WheelRemove(eventId);
+  events[eventId] = {};
+}
+
+void XenonScheduler::ScheduleEvent(SchedulerEventID eventId, u64 delayTicks) {
+  ScheduleEventAt(eventId, GetTimeBase() + delayTicks);
+}
+
+void XenonScheduler::ScheduleEventAt(SchedulerEventID eventId, u64 dueTick) {
+  std::lock_guard lock(eventMutex);
+  if (eventId >= events.size() || !events[eventId].registered) {
+    LOG_ERROR(Xenon, "Scheduler: Tried to schedule an invalid event ({}).", eventId);
+    return;
+  }
+  WheelRemove(eventId);
+  events[eventId].dueTick = dueTick;
+  WheelInsert(eventId);
+  // Lower the early out bound if needed
+  u64 nextTick = nextEventTick.load(std::memory_order_relaxed);
+  const u64 previousTick = nextTick;
+  while (dueTick < nextTick && !nextEventTick.compare_exchange_weak(nextTick, dueTick, std::memory_order_release)) {}
+  // Sleepers computed their deadline from the old bound. Callbacks rescheduling themselves don't need this, the
+  // sleepers wake up for the event being serviced anyway
+  if (dueTick < previousTick && wakeupCallback && serviceThread != std::this_thread::get_id())
+    wakeupCallback();
+}
+
+void XenonScheduler::SetWakeupCallback(std::function<void()> callback) {
+  std::lock_guard lock(eventMutex);
+  wakeupCallback = std::move(callback);
+}
+
+void XenonScheduler::CancelEvent(SchedulerEventID eventId) {
+  std::lock_guard lock(eventMutex);
+  if (eventId >= events.size())
+    return;
+  // nextEventTick is left as is, the next service pass fixes it up
+  WheelRemove(eventId);
+}
+
+bool XenonScheduler::IsScheduled(SchedulerEventID eventId) {
+  std::lock_guard lock(eventMutex);
+  return eventId < events.size() && events[eventId].scheduled;
+}
+
+void XenonScheduler::Service() {
+  if (paused.load(std::memory_order_acquire))
+    return;
+  const u64 now = AdvanceTimeBase();
+  // Nothing due yet
+  if (now < nextEventTick.load(std::memory_order_acquire))
+    return;
+  // Another PPU thread is already on it
+  if (!serviceMutex.try_lock())
+    return;
+  std::lock_guard serviceLock(serviceMutex, std::adopt_lock);
+  MICROPROFILE_SCOPEI("[Xe::Scheduler]", "Service", MP_AUTO);
+
+  firedEvents.clear();
+  {
+    std::lock_guard lock(eventMutex);
+    // Walk every slot that elapsed since the last pass, at most one full turn
+    const u64 firstSlot = wheelTick >> wheelSlotShift;
+    const u64 lastSlot = std::min(now >> wheelSlotShift, firstSlot + wheelSlotCount - 1);
+    for (u64 slot = firstSlot; slot <= lastSlot; ++slot) {
+      std::vector<SchedulerEventID> &bucket = wheel[slot & (wheelSlotCount - 1)];
+      for (size_t idx = 0; idx < bucket.size();) {
+        sSchedulerEvent &event = events[bucket[idx]];
+        if (event.dueTick > now) {
+          // Due on a later turn of the wheel
+          idx++;
+          continue;
+        }
+        firedEvents.push_back({ event.dueTick, event.callback });
+        event.scheduled = false;
+        bucket[idx] = bucket.back();
+        bucket.pop_back();
+      }
+    }
+    wheelTick = std::max(wheelTick, now + 1);
+
+    // Recompute the early out bound
+    u64 nextTick = UINT64_MAX;
+    for (const sSchedulerEvent &event : events) {
+      if (event.scheduled)
+        nextTick = std::min(nextTick, event.dueTick);
+    }
+    nextEventTick.store(nextTick, std::memory_order_release);
+    serviceThread = std::this_thread::get_id();
+  }
+
+  // Fire in deadline order
+  std::stable_sort(firedEvents.begin(), firedEvents.end(),
+    [](const sFiredEvent &a, const sFiredEvent &b) { return a.dueTick < b.dueTick; });
+  for (const sFiredEvent &event : firedEvents) {
+    event.callback(event.dueTick, now);
+  }
+  std::lock_guard lock(eventMutex);
+  serviceThread = {};
+}
+
+void XenonScheduler::WheelInsert(SchedulerEventID eventId) {
+  sSchedulerEvent &event = events[eventId];
+  // Events already in the past go in the next slot to be processed
+  const u64 slot = (std::max(event.dueTick, wheelTick) >> wheelSlotShift) & (wheelSlotCount - 1);
+  wheel[slot].push_back(eventId);
+  event.scheduled = true;
+}
+
+void XenonScheduler::WheelRemove(SchedulerEventID eventId) {
+  sSchedulerEvent &event = events[eventId];
+  if (!event.scheduled)
+    return;
+  const u64 slot = (std::max(event.dueTick, wheelTick) >> wheelSlotShift) & (wheelSlotCount - 1);
+  std::vector<SchedulerEventID> &bucket = wheel[slot];
+  if (auto it = std::find(bucket.begin(), bucket.end(), eventId); it != bucket.end()) {
+    *it = bucket.back();
+    bucket.pop_back();
+  } else {
+    // The wheel moved past its slot, look everywhere
+    for (auto &otherBucket : wheel) {
+      std::erase(otherBucket, eventId);
+    }
+  }
+  event.scheduled = false;
+}
+
+u64 XenonScheduler::AdvanceTimeBase() {
+  // Moved by the PPUs as they retire instructions, or stopped
+  if (timeBaseMode == eTimeBaseMode::Instructions || paused.load(std::memory_order_acquire))
+    return timeBase.load(std::memory_order_acquire);
+  // Guest time follows host time at the timebase frequency
+  const u64 elapsedNs = static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now() - hostStart).count());
+  const u64 target = elapsedNs / timeBasePeriodNs;
+  // Several PPU threads sample concurrently, never go backwards
+  u64 current = timeBase.load(std::memory_order_relaxed);
+  while (target > current && !timeBase.compare_exchange_weak(current, target, std::memory_order_acq_rel)) {}
+  return std::max(target, current);
+}
+
+void XenonScheduler::AddCPU(u8 ppuID) {
+  std::lock_guard lock(cpuMutex);
+  const auto it = std::lower_bound(cpus.begin(), cpus.end(), ppuID);
+  if (it != cpus.end() && *it == ppuID)
+    return;
+  cpus.insert(it, ppuID);
+  if (cpuStates.size() <= ppuID)
+    cpuStates.resize(ppuID + 1);
+  cpuStates[ppuID] = { true, false, UINT64_MAX };
+  if (cpus.size() == 1)
+    currentTurn = ppuID;
+}
+
+void XenonScheduler::RemoveCPU(u8 ppuID) {
+  {
+    std::lock_guard lock(cpuMutex);
+    const auto it = std::find(cpus.begin(), cpus.end(), ppuID);
+    if (it == cpus.end())
+      return;
+    const auto next = cpus.erase(it);
+    if (cpuStates[ppuID].idle)
+      idleCPUs--;
+    cpuStates[ppuID] = {};
+    idleWakeTick = GetIdleWakeTick();
+    if (currentTurn == ppuID) {
+      // Hand the turn over, a round cut short this way isn't accounted for
+      currentTurn = next != cpus.end() ? *next : (cpus.empty() ? 0xFF : cpus.front());
+    }
+  }
+  turnCV.notify_all();
+}
+
+void XenonScheduler::RetireInstructions(u64 retiredInstrs) {
+  // Deterministic mode accounts for whole rounds instead
+  if (timeBaseMode != eTimeBaseMode::Instructions || deterministic || !retiredInstrs)
+    return;
+  bool wakeSleepers = false;
+  {
+    std::lock_guard lock(cpuMutex);
+    // Everyone ran in parallel, each slice only accounts for its share of the elapsed time
+    const u64 instrsPerRunningTick = instrsPerTick * std::max<u64>(cpus.size() - idleCPUs, 1);
+    instrRemainder += retiredInstrs;
+    const u64 ticks = instrRemainder / instrsPerRunningTick;
+    instrRemainder %= instrsPerRunningTick;
+    const u64 current = timeBase.fetch_add(ticks, std::memory_order_acq_rel) + ticks;
+    // A sleeping PPU's decrementer expired
+    if (current >= idleWakeTick) {
+      idleWakeTick = UINT64_MAX;
+      wakeSleepers = true;
+    }
+  }
+  if (wakeSleepers && wakeupCallback)
+    wakeupCallback();
+}
+
+void XenonScheduler::IdleCPU(u8 ppuID, u64 wakeTick) {
+  bool wakeSleepers = false;
+  {
+    std::lock_guard lock(cpuMutex);
+    if (ppuID >= cpuStates.size() || !cpuStates[ppuID].registered)
+      return;
+    sCPUState &state = cpuStates[ppuID];
+    if (!state.idle)
+      idleCPUs++;
+    state.idle = true;
+    state.wakeTick = wakeTick;
+    idleWakeTick = GetIdleWakeTick();
+    // Everyone is asleep and guest time would stand still, skip ahead to whatever wakes someone up first
+    if (!deterministic && idleCPUs == cpus.size()) {
+      const u64 current = timeBase.load(std::memory_order_acquire);
+      const u64 target = std::min(idleWakeTick, nextEventTick.load(std::memory_order_acquire));
+      if (target != UINT64_MAX && target > current) {
+        timeBase.store(target, std::memory_order_release);
+        idleWakeTick = UINT64_MAX;
+        wakeSleepers = true;
+      }
+    }
+  }
+  if (wakeSleepers && wakeupCallback)
+    wakeupCallback();
+}
+
+void XenonScheduler::ResumeCPU(u8 ppuID) {
+  std::lock_guard lock(cpuMutex);
+  if (ppuID >= cpuStates.size() || !cpuStates[ppuID].idle)
+    return;
+  cpuStates[ppuID].idle = false;
+  cpuStates[ppuID].wakeTick = UINT64_MAX;
+  idleCPUs--;
+  idleWakeTick = GetIdleWakeTick();
+}
+
+u64 XenonScheduler::GetIdleWakeTick() const {
+  u64 wakeTick = UINT64_MAX;
+  for (const sCPUState &state : cpuStates) {
+    if (state.idle)
+      wakeTick = std::min(wakeTick, state.wakeTick);
+  }
+  return wakeTick;
+}
+
+bool XenonScheduler::WaitForTurn(u8 ppuID) {
+  std::unique_lock lock(cpuMutex);
+  const auto registered = [&] { return std::binary_search(cpus.begin(), cpus.end(), ppuID); };
+  turnCV.wait(lock, [&] { return currentTurn == ppuID || !registered(); });
+  return registered();
+}
+
+void XenonScheduler::EndTurn(u8 ppuID, u64 retiredInstrs, bool idle, u64 wakeTick) {
+  std::unique_lock lock(cpuMutex);
+  if (currentTurn != ppuID)
+    return;
+  roundInstrs = std::max(roundInstrs, retiredInstrs);
+  roundIdle = roundIdle && idle;
+  if (idle)
+    roundWakeTick = std::min(roundWakeTick, wakeTick);
+
+  auto next = std::upper_bound(cpus.begin(), cpus.end(), ppuID);
+  if (next == cpus.end()) {
+    // Last PPU of the round. Keeps the turn while closing it, so nobody runs meanwhile
+    const u64 instrs = roundInstrs;
+    const bool allIdle = roundIdle;
+    const u64 allWakeTick = roundWakeTick;
+    roundInstrs = 0;
+    roundIdle = true;
+    roundWakeTick = UINT64_MAX;
+    lock.unlock();
+    EndRound(instrs, allIdle, allWakeTick);
+    lock.lock();
+    next = cpus.begin();
+  }
+  currentTurn = next != cpus.end() ? *next : 0xFF;
+  lock.unlock();
+  turnCV.notify_all();
+}
+
+void XenonScheduler::EndRound(u64 retiredInstrs, bool idle, u64 wakeTick) {
+  MICROPROFILE_SCOPEI("[Xe::Scheduler]", "EndRound", MP_AUTO);
+  // PPUs run concurrently on hardware, so the round took as long as the busiest one
+  bool timeMoved = false;
+  if (idle) {
+    // Everyone is asleep, skip ahead to whatever wakes them up
+    const u64 current = timeBase.load(std::memory_order_relaxed);
+    const u64 target = std::min(wakeTick, nextEventTick.load(std::memory_order_acquire));
+    if (target != UINT64_MAX && target > current) {
+      timeBase.store(target, std::memory_order_release);
+      timeMoved = true;
+    }
+  } else if (retiredInstrs) {
+    instrRemainder += retiredInstrs;
+    timeBase.fetch_add(instrRemainder / instrsPerTick, std::memory_order_acq_rel);
+    instrRemainder %= instrsPerTick;
+    timeMoved = true;
+  }
+
+  const bool delivered = DeliverAsyncEvents();
+  syncIndex++;
+
+  // Nothing can happen until a device does something (or the debugger lets us go), don't spin on it
+  if (!timeMoved && !delivered && replay.GetMode() != eReplayMode::Replay) {
+    std::unique_lock lock(asyncMutex);
+    asyncCV.wait_for(lock, SCHEDULER_IDLE_ROUND_WAIT, [&] { return !pendingAsync.empty(); });
+  }
+}
+
+void XenonScheduler::RegisterAsyncSource(eAsyncSource source, const void *owner, AsyncEventHandler handler) {
+  std::lock_guard lock(asyncMutex);
+  asyncSources[static_cast<size_t>(source)] = { owner, std::move(handler) };
+}
+
+void XenonScheduler::UnregisterAsyncSource(eAsyncSource source, const void *owner) {
+  std::lock_guard deliverLock(deliverMutex);
+  std::lock_guard lock(asyncMutex);
+  sAsyncSource &asyncSource = asyncSources[static_cast<size_t>(source)];
+  if (asyncSource.owner != owner)
+    return;
+  asyncSource = {};
+  std::erase_if(pendingAsync, [source](const sAsyncEvent &event) { return event.source == source; });
+}
+
+void XenonScheduler::PostAsyncEvent(eAsyncSource source, std::vector<u8> data) {
+  if (!deterministic) {
+    RunAsyncHandler(source, data);
+    return;
+  }
+  {
+    std::lock_guard lock(asyncMutex);
+    // External input comes from the recording when replaying
+    if (source == eAsyncSource::UARTInput && replay.GetMode() == eReplayMode::Replay)
+      return;
+    pendingAsync.push_back({ source, std::move(data) });
+  }
+  asyncCV.notify_all();
+}
+
+bool XenonScheduler::DeliverAsyncEvents() {
+  std::lock_guard deliverLock(deliverMutex);
+  bool delivered = false;
+
+  if (replay.GetMode() == eReplayMode::Replay) {
+    // Deliver what was recorded at this sync point, with the recorded data. Device side work (DMA, ...) still
+    // happens live, so wait for the device to actually post the event
+    for (const XenonReplay::sReplayEvent *event = replay.PeekEvent(); event && event->syncIndex <= syncIndex;
+      event = replay.PeekEvent()) {
+      const eAsyncSource source = static_cast<eAsyncSource>(event->source);
+      if (source != eAsyncSource::UARTInput) {
+        std::unique_lock lock(asyncMutex);
+        const auto posted = [&] {
+          return std::find_if(pendingAsync.begin(), pendingAsync.end(),
+            [source](const sAsyncEvent &pending) { return pending.source == source; });
+        };
+        auto lastWarning = std::chrono::steady_clock::now();
+        while (posted() == pendingAsync.end() && XeRunning) {
+          asyncCV.wait_for(lock, SCHEDULER_REPLAY_WAIT);
+          const auto now = std::chrono::steady_clock::now();
+          if (now - lastWarning >= SCHEDULER_REPLAY_WAIT_WARN) {
+            LOG_WARNING(Xenon, "Replay: Sync point {} is still waiting on event source {}, did the run diverge?",
+              syncIndex, event->source);
+            lastWarning = now;
+          }
+        }
+        if (!XeRunning)
+          return delivered;
+        pendingAsync.erase(posted());
+      }
+      RunAsyncHandler(source, event->data);
+      replay.PopEvent();
+      delivered = true;
+    }
+    if (!replay.PeekEvent()) {
+      LOG_INFO(Xenon, "Replay: Reached the end of the recording at sync point {}, running live from now on.", syncIndex);
+      replay.Close();
+    }
+    return delivered;
+  }
+
+  std::deque<sAsyncEvent> events = {};
+  {
+    std::lock_guard lock(asyncMutex);
+    events.swap(pendingAsync);
+  }
+  for (const sAsyncEvent &event : events) {
+    replay.WriteEvent({ syncIndex, timeBase.load(std::memory_order_relaxed), static_cast<u8>(event.source), event.data });
+    RunAsyncHandler(event.source, event.data);
+    delivered = true;
+  }
+  return delivered;
+}
+
+void XenonScheduler::RunAsyncHandler(eAsyncSource source, const std::vector<u8> &data) {
+  AsyncEventHandler handler = {};
+  {
+    std::lock_guard lock(asyncMutex);
+    handler = asyncSources[static_cast<size_t>(source)].handler;
+  }
+  if (handler)
+    handler(data);
+  else
+    LOG_WARNING(Xenon, "Scheduler: Dropped an event from source {}, nothing handles it.", static_cast<u8>(source));
+}
+
+void XenonScheduler::DropAsyncEvents() {
+  std::lock_guard lock(asyncMutex);
+  pendingAsync.clear();
+}
+
+void XenonScheduler::Pause() {
+  std::lock_guard serviceLock(serviceMutex);
+  if (paused.load())
+    return;
+  AdvanceTimeBase();
+  paused.store(true, std::memory_order_release);
+}
+
+void XenonScheduler::Resume() {
+  {
+    std::lock_guard serviceLock(serviceMutex);
+    if (!paused.load())
+      return;
+    // Host time picks up where guest time stopped
+    hostStart = std::chrono::steady_clock::now() -
+      std::chrono::nanoseconds(timeBase.load(std::memory_order_acquire) * timeBasePeriodNs);
+    paused.store(false, std::memory_order_release);
+  }
+  if (wakeupCallback)
+    wakeupCallback();
+}
+
+void XenonScheduler::SaveState(Base::StateWriter &writer) {
+  std::lock_guard serviceLock(serviceMutex);
+  {
+    std::lock_guard lock(eventMutex);
+    writer.Write<u64>(timeBase.load(std::memory_order_acquire));
+    u32 scheduledCount = 0;
+    for (const sSchedulerEvent &event : events) {
+      if (event.registered && event.scheduled)
+        scheduledCount++;
+    }
+    writer.Write<u32>(scheduledCount);
+    for (const sSchedulerEvent &event : events) {
+      if (!event.registered || !event.scheduled)
+        continue;
+      writer.WriteString(event.name);
+      writer.Write<u64>(event.dueTick);
+    }
+  }
+  {
+    std::lock_guard lock(cpuMutex);
+    writer.Write<u64>(instrRemainder);
+  }
+  std::lock_guard lock(asyncMutex);
+  writer.Write<u32>(static_cast<u32>(pendingAsync.size()));
+  for (const sAsyncEvent &event : pendingAsync) {
+    writer.Write(event.source);
+    writer.WriteVector(event.data);
+  }
+}
+
+void XenonScheduler::LoadState(Base::StateReader &reader) {
+  struct sSavedEvent {
+    std::string name;
+    u64 dueTick;
+  };
+  // Every entry takes a few bytes at least, a bigger count is corrupt
+  const auto readCount = [&reader] {
+    const u32 count = reader.Read<u32>();
+    if (count > reader.Remaining()) {
+      reader.Fail();
+      return 0U;
+    }
+    return count;
+  };
+  const u64 savedTimeBase = reader.Read<u64>();
+  std::vector<sSavedEvent> savedEvents(readCount());
+  for (sSavedEvent &event : savedEvents) {
+    reader.ReadString(event.name);
+    reader.Read(event.dueTick);
+  }
+  const u64 savedInstrRemainder = reader.Read<u64>();
+  std::deque<sAsyncEvent> savedAsync(readCount());
+  for (sAsyncEvent &event : savedAsync) {
+    reader.Read(event.source);
+    reader.ReadVector(event.data);
+  }
+  if (!reader.Good())
+    return;
+
+  {
+    std::lock_guard serviceLock(serviceMutex);
+    std::lock_guard lock(eventMutex);
+    for (auto &bucket : wheel)
+      bucket.clear();
+    for (sSchedulerEvent &event : events)
+      event.scheduled = false;
+    wheelTick = savedTimeBase;
+    timeBase.store(savedTimeBase, std::memory_order_release);
+    if (!paused.load())
+      hostStart = std::chrono::steady_clock::now() - std::chrono::nanoseconds(savedTimeBase * timeBasePeriodNs);
+    // Events sharing a name are matched in registration order
+    for (const sSavedEvent &savedEvent : savedEvents) {
+      const auto it = std::find_if(events.begin(), events.end(), [&](const sSchedulerEvent &event) {
+        return event.registered && !event.scheduled && event.name == savedEvent.name;
+      });
+      if (it == events.end()) {
+        LOG_WARNING(Xenon, "Scheduler: Saved event '{}' isn't registered, dropping it.", savedEvent.name);
+        continue;
+      }
+      it->dueTick = savedEvent.dueTick;
+      WheelInsert(static_cast<SchedulerEventID>(it - events.begin()));
+    }
+    u64 nextTick = UINT64_MAX;
+    for (const sSchedulerEvent &event : events) {
+      if (event.scheduled)
+        nextTick = std::min(nextTick, event.dueTick);
+    }
+    nextEventTick.store(nextTick, std::memory_order_release);
+  }
+  {
+    std::lock_guard lock(cpuMutex);
+    instrRemainder = savedInstrRemainder;
+  }
+  {
+    std::lock_guard lock(asyncMutex);
+    pendingAsync = std::move(savedAsync);
+  }
+  if (wakeupCallback)
+    wakeupCallback();
+}
+
+} // namespace Xe::XCPU
@@ -0,0 +1,288 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Base/StateStream.h"
+#include "Base/Types.h"
+
+#include "XenonReplay.h"
+
+namespace Xe::XCPU {
+  // Event callback. Receives the timebase tick the event was due at and the current timebase, the difference
+  // being how late it fired (slices aren't cut short for events).
+  using SchedulerCallback = std::function<void(u64 dueTick, u64 currentTick)>;
+
+  // Handle to a registered event.
+  using SchedulerEventID = u32;
+  inline constexpr SchedulerEventID schedulerInvalidEvent = 0xFFFFFFFF;
+
+  // Sources of asynchronous device events, these complete on device threads at host dependent times.
+  // Stored in replay files, only append to this.
+  enum class eAsyncSource : u8 {
+    SMCFifo,        // SMC FIFO command response
+    UARTInput,      // Byte received on the UART (external input)
+    NANDCompletion, // SFCX command completion
+    HDDCompletion,  // HDD DMA completion
+    ODDCompletion,  // ODD DMA/SCSI command completion
+    Count
+  };
+
+  // What drives the guest timebase.
+  enum class eTimeBaseMode : u8 {
+    Host,        // Host clock
+    Instructions // Instructions retired by the PPUs
+  };
+
+  // Applies an asynchronous event to the device state, with the data it was posted with.
+  using AsyncEventHandler = std::function<void(const std::vector<u8> &data)>;
+
+  // Xenon Event Scheduler
+  // Central timer for everything that must happen at a given point in guest time (device timers, VBLANK, ...).
+  // Time is kept in timebase ticks (50MHz), following either the host clock or the instructions retired by the PPUs
+  // (see eTimeBaseMode). Pending events live in a hashed timing wheel, so scheduling and cancelling are O(1) and
+  // servicing only visits the slots that elapsed since the last call.
+  // There is no host thread behind it: the PPU threads service it at the end of every execution slice, so
+  // callbacks run on whichever PPU thread gets there first.
+  class XenonScheduler {
+  public:
+    // Timebase frequency.
+    static constexpr u64 timeBaseFrequency = 50000000;
+    // Nanoseconds per timebase tick.
+    static constexpr u64 timeBasePeriodNs = 1000000000ULL / timeBaseFrequency;
+
+    XenonScheduler();
+
+    // Converts a host duration to timebase ticks.
+    template <typename Rep, typename Period>
+    static constexpr u64 ToTicks(std::chrono::duration<Rep, Period> duration) {
+      return static_cast<u64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()) / timeBasePeriodNs;
+    }
+
+    // Registers an event and returns its handle. Callbacks are invoked without any scheduler lock held, so they may
+    // (re)schedule events, but must not unregister them.
+    SchedulerEventID RegisterEvent(const std::string &name, SchedulerCallback callback);
+    // Cancels and unregisters an event. Waits for any in flight service pass, so the callback is guaranteed not to
+    // run once this returns.
+    void UnregisterEvent(SchedulerEventID eventId);
+
+    // Schedules an event delayTicks from now. Rescheduling a pending event moves it.
+    void ScheduleEvent(SchedulerEventID eventId, u64 delayTicks);
+    // Schedules an event at an absolute timebase tick.
+    void ScheduleEventAt(SchedulerEventID eventId, u64 dueTick);
+    // Cancels a pending event.
+    void CancelEvent(SchedulerEventID eventId);
+    // Returns true if the event is pending.
+    bool IsScheduled(SchedulerEventID eventId);
+
+    eTimeBaseMode GetTimeBaseMode() const { return timeBaseMode; }
+    // Instructions retired per timebase tick, when guest time follows instructions.
+    u64 GetInstrsPerTick() const { return instrsPerTick; }
+
+    // Current guest time in timebase ticks.
+    u64 GetTimeBase() const { return timeBase.load(std::memory_order_acquire); }
+    // Tick of the earliest pending event (may be stale low after a cancel), UINT64_MAX if none.
+    u64 GetNextEventTick() const { return nextEventTick.load(std::memory_order_acquire); }
+
+    // Brings the guest time up to date and fires every due event. Called by the PPU threads at slice boundaries.
+    void Service();
+
+    // Sets the function called when an event gets scheduled ahead of every pending one from outside a service pass,
+    // so threads sleeping until the next event can wake up and recompute their deadline.
+    void SetWakeupCallback(std::function<void()> callback);
+
+    //
+    // Instruction driven timebase
+    //
+    // Guest time advances by the instructions the PPUs retire, reported at slice boundaries. PPUs run in parallel
+    // on hardware, so it moves by the average progress of the running ones. Sleeping PPUs don't count, and once all
+    // of them sleep guest time jumps to whatever wakes one up first.
+
+    // Adds/removes a PPU. Removing it hands its turn over and releases a waiting WaitForTurn.
+    void AddCPU(u8 ppuID);
+    void RemoveCPU(u8 ppuID);
+    // Accounts for the instructions retired by a PPU during its last slice.
+    void RetireInstructions(u64 retiredInstrs);
+    // Marks a PPU as sleeping until wakeTick (its decrementer, UINT64_MAX if none), or as running again. The wakeup
+    // callback gets invoked once guest time reaches wakeTick.
+    void IdleCPU(u8 ppuID, u64 wakeTick);
+    void ResumeCPU(u8 ppuID);
+
+    //
+    // Deterministic execution
+    //
+    // PPUs run one slice at a time, in PPU order, and guest time advances by the instructions retired in each round
+    // of slices. Asynchronous device events are only delivered at the end of a round (a sync point), which can be
+    // recorded and replayed.
+
+    bool IsDeterministic() const { return deterministic; }
+
+    // Blocks until it's our turn. Returns false if the PPU was removed.
+    bool WaitForTurn(u8 ppuID);
+    // Ends our turn, having retired retiredInstrs instructions. idle means the PPU is sleeping until wakeTick, if all
+    // of them are guest time jumps straight to the first wakeup or event.
+    void EndTurn(u8 ppuID, u64 retiredInstrs, bool idle, u64 wakeTick);
+
+    //
+    // Asynchronous device events
+    //
+
+    // Registers the handler for an event source on behalf of owner (the device). Handlers run on whichever thread
+    // delivers the event.
+    void RegisterAsyncSource(eAsyncSource source, const void *owner, AsyncEventHandler handler);
+    // Unregisters a handler if it's still owner's (devices can be recreated before the old one is gone), waits for
+    // any in flight delivery.
+    void UnregisterAsyncSource(eAsyncSource source, const void *owner);
+    // Posts an event from a device thread. The handler runs right away, unless in deterministic mode, where it's
+    // queued until the next sync point.
+    void PostAsyncEvent(eAsyncSource source, std::vector<u8> data = {});
+    // Drops the events still queued for the next sync point, their devices were reset.
+    void DropAsyncEvents();
+
+    //
+    // Save states
+    //
+
+    // Stops guest time while the machine is being saved or loaded, so host time spent on it doesn't count. Nothing
+    // gets serviced until Resume.
+    void Pause();
+    void Resume();
+
+    // Saves the guest time and the pending events. Events are saved by name, loading reschedules the registered
+    // events with the same names and leaves the others unscheduled.
+    void SaveState(Base::StateWriter &writer);
+    void LoadState(Base::StateReader &reader);
+
+  private:
+    // Wheel geometry: 1024 slots of 1024 ticks (~20us), one turn is ~21ms. Events further out than a turn stay in
+    // their slot and are skipped until their turn comes around.
+    static constexpr u32 wheelSlotShift = 10;
+    static constexpr u32 wheelSlotCount = 1024;
+
+    struct sSchedulerEvent {
+      std::string name = {};
+      SchedulerCallback callback = {};
+      u64 dueTick = 0;
+      bool registered = false;
+      bool scheduled = false;
+    };
+
+    struct sFiredEvent {
+      u64 dueTick;
+      SchedulerCallback callback;
+    };
+
+    // Inserts/removes an event from the wheel. eventMutex must be held.
+    void WheelInsert(SchedulerEventID eventId);
+    void WheelRemove(SchedulerEventID eventId);
+
+    // Samples the time source and advances the guest time.
+    u64 AdvanceTimeBase();
+
+    struct sAsyncEvent {
+      eAsyncSource source;
+      std::vector<u8> data;
+    };
+
+    struct sAsyncSource {
+      const void *owner = nullptr;
+      AsyncEventHandler handler = {};
+    };
+
+    struct sCPUState {
+      bool registered = false;
+      bool idle = false;
+      u64 wakeTick = UINT64_MAX;
+    };
+
+    // Earliest wakeup of the sleeping PPUs. cpuMutex must be held.
+    u64 GetIdleWakeTick() const;
+
+    // Closes a round of turns: advances guest time and delivers the queued asynchronous events.
+    void EndRound(u64 retiredInstrs, bool idle, u64 wakeTick);
+    // Delivers the asynchronous events due at this sync point. Returns true if any was.
+    bool DeliverAsyncEvents();
+    // Runs the handler of an event source.
+    void RunAsyncHandler(eAsyncSource source, const std::vector<u8> &data);
+
+    // Guards the events and the wheel.
+    std::mutex eventMutex;
+    // Held by the thread servicing the wheel, only one at a time.
+    std::mutex serviceMutex;
+
+    std::vector<sSchedulerEvent> events = {};
+    std::vector<std::vector<SchedulerEventID>> wheel = {};
+    // The wheel has been processed up to (not including) this tick.
+    u64 wheelTick = 0;
+    // Events popped in the current service pass.
+    std::vector<sFiredEvent> firedEvents = {};
+    // Thread running the current service pass.
+    std::thread::id serviceThread = {};
+    // Wakes up threads sleeping until the next event.
+    std::function<void()> wakeupCallback = {};
+
+    // Host time at timebase 0.
+    std::chrono::steady_clock::time_point hostStart = {};
+    // Current guest time.
+    std::atomic<u64> timeBase{ 0 };
+    // Earliest pending event, lets Service return early without taking any lock.
+    std::atomic<u64> nextEventTick{ UINT64_MAX };
+    // Guest time is stopped, see Pause.
+    std::atomic<bool> paused = false;
+
+    // Guest time source.
+    eTimeBaseMode timeBaseMode = eTimeBaseMode::Host;
+    u64 instrsPerTick = 64;
+    // Guards the PPU states and the turn order.
+    std::mutex cpuMutex;
+    // PPUs, sorted.
+    std::vector<u8> cpus = {};
+    // Indexed by PPU ID.
+    std::vector<sCPUState> cpuStates = {};
+    // Sleeping PPUs.
+    u64 idleCPUs = 0;
+    // Earliest wakeup of the sleeping PPUs.
+    u64 idleWakeTick = UINT64_MAX;
+    // Instructions not yet turned into ticks.
+    u64 instrRemainder = 0;
+
+    // Deterministic execution enabled.
+    bool deterministic = false;
+    std::condition_variable turnCV;
+    // PPU whose turn it is.
+    u8 currentTurn = 0xFF;
+    // Max instructions retired by a PPU in the current round.
+    u64 roundInstrs = 0;
+    // All PPUs idled in the current round.
+    bool roundIdle = true;
+    // Earliest wakeup of the PPUs idling in the current round.
+    u64 roundWakeTick = UINT64_MAX;
+
+    // Guards the queued events and handlers.
+    std::mutex asyncMutex;
+    // Signaled when an event gets posted.
+    std::condition_variable asyncCV;
+    // Held while delivering events.
+    std::mutex deliverMutex;
+    std::array<sAsyncSource, static_cast<size_t>(eAsyncSource::Count)> asyncSources = {};
+    // Events posted since the last sync point.
+    std::deque<sAsyncEvent> pendingAsync = {};
+    // Current sync point.
+    u64 syncIndex = 0;
+    // Event log.
+    XenonReplay replay;
+  };
+} // namespace Xe::XCPU
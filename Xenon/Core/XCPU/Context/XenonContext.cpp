@@ -10,56 +10,132 @@
 
 namespace Xe::XCPU {
 
+void XenonContext::SaveState(Base::StateWriter &writer) {
+  std::lock_guard lock(mutex);
+  writer.WriteBytes(SRAM.get(), XE_SECRAM_BLOCK_SIZE);
+  writer.Write(*socSecOTPBlock);
+  writer.Write(*socSecEngBlock);
+  writer.Write(*socSecRNGBlock);
+  writer.Write(*socCBIBlock);
+  writer.Write(*socPMWBlock);
+  writer.Write(*socPRVBlock);
+  writer.Write(timeBaseActive);
+  iic.SaveState(writer);
+}
+
+void XenonContext::LoadState(Base::StateReader &reader) {
+  std::lock_guard lock(mutex);
+  reader.ReadBytes(SRAM.get(), XE_SECRAM_BLOCK_SIZE);
+  reader.Read(*socSecOTPBlock);
+  reader.Read(*socSecEngBlock);
+  reader.Read(*socSecRNGBlock);
+  reader.Read(*socCBIBlock);
+  reader.Read(*socPMWBlock);
+  reader.Read(*socPRVBlock);
+  reader.Read(timeBaseActive);
+  iic.LoadState(reader);
+  eratGeneration.fetch_add(1);
+}
+
+void XenonContext::BuildSOCPageMap() {
+  auto mapBlock = [&](u64 start, u64 size, eSOCBlock block) {
+    for (u64 page = start >> 12; page < (start + size) >> 12; ++page) {
+      socPageMap[page] = block;
+    }
+  };
+  socPageMap.fill(socBlockNone);
+  // Only the first 32KB of the Secure ROM block are populated (1BL)
+  mapBlock(XE_SECROM_BLOCK_START, 0x8000, socBlockSROM);
+  mapBlock(XE_SECRAM_BLOCK_START, XE_SECRAM_BLOCK_SIZE, socBlockSRAM);
+  mapBlock(XE_SOCSECOTP_BLOCK_START, XE_SOCSECOTP_BLOCK_SIZE, socBlockSecOTP);
+  mapBlock(XE_SOCSECENG_BLOCK_START, XE_SOCSECENG_BLOCK_SIZE, socBlockSecEng);
+  mapBlock(XE_SOCSECRNG_BLOCK_START, XE_SOCSECRNG_BLOCK_SIZE, socBlockSecRNG);
+  mapBlock(XE_SOCCBI_BLOCK_START, XE_SOCCBI_BLOCK_SIZE, socBlockCBI);
+  mapBlock(XE_SOCINTS_BLOCK_START, XE_SOCINTS_BLOCK_SIZE, socBlockINT);
+  mapBlock(XE_SOCPMW_BLOCK_START, XE_SOCPMW_BLOCK_SIZE, socBlockPMW);
+  mapBlock(XE_SOCPRV_BLOCK_START, XE_SOCPRV_BLOCK_SIZE, socBlockPRV);
+}
+
 bool XenonContext::HandleSOCRead(u64 readAddr, u8 *data, size_t byteCount) {
   // Get target block
-  if (readAddr >= XE_SOCSECENG_BLOCK_START && readAddr < XE_SOCSECENG_BLOCK_START + XE_SOCSECENG_BLOCK_SIZE) {
+  const u64 page = readAddr >> 12;
+  if (page >= XE_SOC_PAGE_COUNT)
+    return false;
+  switch (socPageMap[page]) {
+  case socBlockSROM:
+    // Secure ROM
+    memcpy(data, &SROM[readAddr - XE_SECROM_BLOCK_START], byteCount);
+    return true;
+  case socBlockSRAM:
+    // Secure RAM
+    memcpy(data, &SRAM[readAddr - XE_SECRAM_BLOCK_START], byteCount);
+    return true;
+  case socBlockSecEng:
     // Security Engine
     return HandleSecEngRead(readAddr, data, byteCount);
-  } else if (readAddr >= XE_SOCSECOTP_BLOCK_START && readAddr < XE_SOCSECOTP_BLOCK_START + XE_SOCSECOTP_BLOCK_SIZE) {
+  case socBlockSecOTP:
     // Secure OTP
     return HandleSecOTPRead(readAddr, data, byteCount);
-  } else if (readAddr >= XE_SOCSECRNG_BLOCK_START && readAddr < XE_SOCSECRNG_BLOCK_START + XE_SOCSECRNG_BLOCK_SIZE) {
+  case socBlockSecRNG:
     // Secure RNG
     return HandleSecRNGRead(readAddr, data, byteCount);
-  } else if (readAddr >= XE_SOCCBI_BLOCK_START && readAddr < XE_SOCCBI_BLOCK_START + XE_SOCCBI_BLOCK_SIZE) {
+  case socBlockCBI:
     // CBI
     return HandleCBIRead(readAddr, data, byteCount);
-  } else if (readAddr >= XE_SOCINTS_BLOCK_START && readAddr < XE_SOCINTS_BLOCK_START + XE_SOCINTS_BLOCK_SIZE) {
-    // INT
-    return HandleINTRead(readAddr, data, byteCount);
-  } else if (readAddr >= XE_SOCPMW_BLOCK_START && readAddr < XE_SOCPMW_BLOCK_START + XE_SOCPMW_BLOCK_SIZE) {
+  case socBlockINT:
+    // Integrated Interrupt Controller in real mode, used when the HV wants to start a CPUs IC
+    HandleINTRead(readAddr, data, byteCount);
+    return true;
+  case socBlockPMW:
     // PMW
     return HandlePMWRead(readAddr, data, byteCount);
-  } else if (readAddr >= XE_SOCPRV_BLOCK_START && readAddr < XE_SOCPRV_BLOCK_START + XE_SOCPRV_BLOCK_SIZE) {
+  case socBlockPRV:
     // Pervasive Logic
     return HandlePRVRead(readAddr, data, byteCount);
+  default:
+    break;
   }
   return false;
 }
 
 bool XenonContext::HandleSOCWrite(u64 writeAddr, const u8 *data, size_t byteCount) {
   // Get target block
-  if (writeAddr >= XE_SOCSECENG_BLOCK_START && writeAddr < XE_SOCSECENG_BLOCK_START + XE_SOCSECENG_BLOCK_SIZE) {
+  const u64 page = writeAddr >> 12;
+  if (page >= XE_SOC_PAGE_COUNT)
+    return false;
+  switch (socPageMap[page]) {
+  case socBlockSROM:
+    // Secure ROM
+    LOG_ERROR(Xenon_MMU, "Tried to write to XCPU SROM!");
+    return true;
+  case socBlockSRAM:
+    // Secure RAM
+    memcpy(&SRAM[writeAddr - XE_SECRAM_BLOCK_START], data, byteCount);
+    return true;
+  case socBlockSecEng:
     // Security Engine
     return HandleSecEngWrite(writeAddr, data, byteCount);
-  } else if (writeAddr >= XE_SOCSECOTP_BLOCK_START && writeAddr < XE_SOCSECOTP_BLOCK_START + XE_SOCSECOTP_BLOCK_SIZE) {
+  case socBlockSecOTP:
     // Secure OTP
     return HandleSecOTPWrite(writeAddr, data, byteCount);
-  } else if (writeAddr >= XE_SOCSECRNG_BLOCK_START && writeAddr < XE_SOCSECRNG_BLOCK_START + XE_SOCSECRNG_BLOCK_SIZE) {
+  case socBlockSecRNG:
     // Secure RNG
     return HandleSecRNGWrite(writeAddr, data, byteCount);
-  } else if (writeAddr >= XE_SOCCBI_BLOCK_START && writeAddr < XE_SOCCBI_BLOCK_START + XE_SOCCBI_BLOCK_SIZE) {
+  case socBlockCBI:
     // CBI
     return HandleCBIWrite(writeAddr, data, byteCount);
-  } else if (writeAddr >= XE_SOCINTS_BLOCK_START && writeAddr < XE_SOCINTS_BLOCK_START + XE_SOCINTS_BLOCK_SIZE) {
-    // INT
-    return HandleINTWrite(writeAddr, data, byteCount);
-  } else if (writeAddr >= XE_SOCPMW_BLOCK_START && writeAddr < XE_SOCPMW_BLOCK_START + XE_SOCPMW_BLOCK_SIZE) {
+  case socBlockINT:
+    // Integrated Interrupt Controller in real mode, used when the HV wants to start a CPUs IC
+    HandleINTWrite(writeAddr, data, byteCount);
+    return true;
+  case socBlockPMW:
     // PMW
     return HandlePMWWrite(writeAddr, data, byteCount);
-  } else if (writeAddr >= XE_SOCPRV_BLOCK_START && writeAddr < XE_SOCPRV_BLOCK_START + XE_SOCPRV_BLOCK_SIZE) {
+  case socBlockPRV:
     // Pervasive Logic
     return HandlePRVWrite(writeAddr, data, byteCount);
+  default:
+    break;
   }
   return false;
 }
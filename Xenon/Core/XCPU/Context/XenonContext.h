@@ -4,27 +4,50 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
 #include <memory>
 
 #include "XenonSOC.h"
+#include "Base/Config.h"
 #include "Base/Types.h"
 #include "Core/RAM/RAM.h"
 #include "Core/XCPU/eFuse.h"
 #include "Core/RootBus/RootBus.h"
 #include "Core/XCPU/Context/XenonIIC/XenonIIC.h"
 #include "Core/XCPU/Context/Reservations/XenonReservations.h"
+#include "Core/XCPU/Context/Breakpoints/XenonBreakpoints.h"
+#include "Core/XCPU/Context/Scheduler/XenonScheduler.h"
+#include "Core/XCPU/HLE/XenonHLE.h"
+#include "Core/XCPU/MMU/XenonWatchpoints.h"
 
 
 namespace Xe::XCPU {
 
+  // SoC address space size covered by the SoC page map (up to the end of the Pervasive Logic block).
+  #define XE_SOC_PAGE_COUNT ((XE_SOCPRV_BLOCK_START + XE_SOCPRV_BLOCK_SIZE) >> 12)
+
+  // SoC blocks, used in the SoC page map.
+  enum eSOCBlock : u8 {
+    socBlockNone = 0,
+    socBlockSROM,
+    socBlockSRAM,
+    socBlockSecOTP,
+    socBlockSecEng,
+    socBlockSecRNG,
+    socBlockCBI,
+    socBlockINT,
+    socBlockPMW,
+    socBlockPRV
+  };
+
   // Main Xenon CPU 'context'
   // Contains all of the internal CPU components and SOC logic aside from the Power Processing Elements and is shared
   // for all three PPE's an their respecting Power Processing Units (PPU's) threads.
   class XenonContext {
   public:
-    XenonContext(RootBus *rootBusPtr, RAM *ramPtr) :
-      rootBus(rootBusPtr), ram(ramPtr)
+    XenonContext(RootBus *rootBusPtr, RAM *ramPtr, XenonScheduler *schedulerPtr) :
+      scheduler(schedulerPtr), rootBus(rootBusPtr), ram(ramPtr)
     {
       SROM = std::make_unique<STRIP_UNIQUE_ARR(SROM)>(XE_SECROM_BLOCK_SIZE);
       SRAM = std::make_unique<STRIP_UNIQUE_ARR(SROM)>(XE_SECRAM_BLOCK_SIZE);
@@ -34,6 +57,14 @@ namespace Xe::XCPU {
       socCBIBlock = std::make_unique<STRIP_UNIQUE(socCBIBlock)>();
       socPMWBlock = std::make_unique<STRIP_UNIQUE(socPMWBlock)>();
       socPRVBlock = std::make_unique<STRIP_UNIQUE(socPRVBlock)>();
+      BuildSOCPageMap();
+      // Debugger halts from the config
+      if (Config::debug.haltOnAddress)
+        breakpoints.Add(Config::debug.haltOnAddress);
+      if (Config::debug.haltOnReadAddress)
+        watchpoints.Add(Config::debug.haltOnReadAddress, 1, MMU::watchRead);
+      if (Config::debug.haltOnWriteAddress)
+        watchpoints.Add(Config::debug.haltOnWriteAddress, 1, MMU::watchWrite);
     }
     ~XenonContext() {
       SROM.reset();
@@ -51,6 +82,15 @@ namespace Xe::XCPU {
     bool HandleSOCRead(u64 readAddr, u8 *data, size_t byteCount);
     bool HandleSOCWrite(u64 writeAddr, const u8 *data, size_t byteCount);
 
+    // Save state, SRAM, the SoC blocks and the IIC. Bumps the ERAT generation on load so every thread refetches its
+    // translations.
+    void SaveState(Base::StateWriter &writer);
+    void LoadState(Base::StateReader &reader);
+    // Power-on state, captured once the fuses and 1BL are in. Reset puts it back in place, returns false if there's
+    // none. The SROM isn't part of it, nothing writes to it.
+    void CapturePowerOnState() { powerOnState.Capture(*this); }
+    bool Reset() { return powerOnState.Restore(*this); }
+
     // Xenon SecureROM
     // Contains the CPU's main startup code known as 1BL.
     std::unique_ptr<u8[]> SROM{};
@@ -78,9 +118,22 @@ namespace Xe::XCPU {
     // value is set.
     bool timeBaseActive = false;
 
-    // Global timebase tick counter (Increments based on the timeBase frquency)
-    // The timer thread inside XenonCPU will increase this; each PPU reads the counter and applies the delta.
-    std::atomic<u64> timeBaseGlobalCounter{ 0 };
+    // Event scheduler, owns the guest time. Outlives the CPU, devices keep their events across CPU resets.
+    // Each PPU services it at slice boundaries and applies the elapsed ticks to its TB and decrementers.
+    XenonScheduler *scheduler = nullptr;
+
+    // ERAT invalidation generation.
+    // Bumped by broadcast TLB invalidations (tlbie), every PPU thread flushes its ERATs when it sees a new value.
+    std::atomic<u32> eratGeneration{ 0 };
+
+    // Data/Exec watchpoints, on real addresses.
+    MMU::XenonWatchpoints watchpoints{ &eratGeneration };
+
+    // Execution breakpoints, on effective addresses.
+    XenonBreakpoints breakpoints{};
+
+    // Native memory routines.
+    HLE::XenonHLE hle{};
 
     //
     // SOC Blocks
@@ -105,6 +158,12 @@ namespace Xe::XCPU {
     RootBus *rootBus{};
     // RAM pointer
     RAM *ram{};
+    // State at power-on, see Reset
+    Base::StateSnapshot powerOnState{};
+
+    // SoC page map, indexed by 4KB page. Resolves the SoC block an address belongs to.
+    std::array<eSOCBlock, XE_SOC_PAGE_COUNT> socPageMap{};
+    void BuildSOCPageMap();
 
     // SOC Blocks R/W.
 
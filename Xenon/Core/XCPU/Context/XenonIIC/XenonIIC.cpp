@@ -2,6 +2,8 @@
 /* Copyright 2025 Xenon Emulator Project. All rights reserved. */
 /***************************************************************/
 
+#include <bit>
+
 #include "Core/XCPU/Context/XenonIIC/XenonIIC.h"
 
   // Debug output enable.
@@ -17,6 +19,30 @@ Xe::XCPU::XenonIIC::~XenonIIC() {
   socINTBlock.reset();
 }
 
+// Save state
+void Xe::XCPU::XenonIIC::SaveState(Base::StateWriter &writer) {
+  std::lock_guard lock(iicMutex);
+  writer.Write(*socINTBlock);
+  for (const sInterruptState &state : interruptState) {
+    writer.Write<u64>(state.interrupts.load());
+    writer.Write<u8>(state.taskPriority.load());
+    writer.Write<u8>(state.logicalId.load());
+  }
+}
+
+void Xe::XCPU::XenonIIC::LoadState(Base::StateReader &reader) {
+  std::lock_guard lock(iicMutex);
+  reader.Read(*socINTBlock);
+  for (sInterruptState &state : interruptState) {
+    state.interrupts.store(reader.Read<u64>());
+    state.taskPriority.store(reader.Read<u8>());
+    state.logicalId.store(reader.Read<u8>());
+  }
+  // Let sleeping threads recheck for deliverable interrupts
+  for (u8 threadID = 0; threadID < 6; threadID++)
+    notifyThread(threadID);
+}
+
 // Write routine
 void Xe::XCPU::XenonIIC::Write(u64 writeAddress, const u8* data, u64 size) {
   // Set a lock
@@ -49,8 +75,18 @@ void Xe::XCPU::XenonIIC::Write(u64 writeAddress, const u8* data, u64 size) {
     const u32 blockOffset = offset % ProcessorBlockSize;  // 0..0xFFF
 
     switch (blockOffset) {
-    case 0x0000: break; // LogicalIdentification
-    case 0x0008: break; // InterruptTaskPriority
+    case 0x0000: // LogicalIdentification
+      interruptState[threadID].logicalId.store(
+        static_cast<u8>(socINTBlock->ProcessorBlock[threadID].LogicalIdentification.AsBITS.LogicalId),
+        std::memory_order_relaxed);
+      break;
+    case 0x0008: // InterruptTaskPriority
+      // Lowering the priority may unmask a pending interrupt.
+      interruptState[threadID].taskPriority.store(
+        static_cast<u8>(socINTBlock->ProcessorBlock[threadID].InterruptTaskPriority.AsULONGLONG & 0xFF),
+        std::memory_order_relaxed);
+      notifyThread(threadID);
+      break;
     case 0x0010: // IpiGeneration
       // Interrupt packet received, generate appropriate interrupt to target threads.
       {
@@ -77,6 +113,8 @@ void Xe::XCPU::XenonIIC::Write(u64 writeAddress, const u8* data, u64 size) {
         removeFirstACKdInterrupt(threadID);
         // Update task priority.
         socINTBlock->ProcessorBlock[threadID].InterruptTaskPriority.AsULONGLONG = dataIn & 0xFF;
+        interruptState[threadID].taskPriority.store(static_cast<u8>(dataIn & 0xFF), std::memory_order_relaxed);
+        notifyThread(threadID);
       }
       break; 
     case 0x0070: break; // SpuriousVector
@@ -190,213 +228,120 @@ void Xe::XCPU::XenonIIC::Read(u64 readAddress, u8* data, u64 size) {
 // Generates an interrupt of the specified type to the specified CPUs.
 void Xe::XCPU::XenonIIC::generateInterrupt(u8 interruptType, u8 cpusToInterrupt) {
   MICROPROFILE_SCOPEI("[Xe::IIC]", "GenInterrupt", MP_AUTO);
-  
-  // Set a lock
-  std::lock_guard lock(iicMutex);
 
 #ifdef IIC_DEBUG
   LOG_DEBUG(Xenon_IIC, "[IIC]: Generating interrupt {} for threads with mask {:#x}", 
     getIntName(static_cast<eXeIntVectors>(interruptType)).c_str(), cpusToInterrupt);
 #endif // IIC_DEBUG
 
-  // Create our interrupt packet
-  sInterruptPacket intPacket = { interruptType, false};
-
+  const u32 bit = interruptBit(interruptType);
   for (u8 threadID = 0; threadID < 6; threadID++) {
-    u8 cpuMask = socINTBlock->ProcessorBlock[threadID].LogicalIdentification.AsBITS.LogicalId;
+    const u8 cpuMask = interruptState[threadID].logicalId.load(std::memory_order_relaxed);
     if ((cpusToInterrupt & cpuMask)) {
-      // Store the interrupt in the interrupt queue
-      interruptState[threadID].pendingInterrupts.push(intPacket);
+      // Latch the interrupt as pending
+      interruptState[threadID].interrupts.fetch_or(bit, std::memory_order_release);
+      notifyThread(threadID);
     }
   }
 }
 
 // Cancels a pending interrupt that has not being ACK'd yet.
 void Xe::XCPU::XenonIIC::cancelInterrupt(u8 interruptType, u8 cpusToInterrupt) {
-  return;
+  const u32 bit = interruptBit(interruptType);
+  for (u8 threadID = 0; threadID < 6; threadID++) {
+    const u8 cpuMask = interruptState[threadID].logicalId.load(std::memory_order_relaxed);
+    if ((cpusToInterrupt & cpuMask)) {
+      interruptState[threadID].interrupts.fetch_and(~static_cast<u64>(bit), std::memory_order_release);
+    }
+  }
 }
 
-// Returns true if there are pending interrupts for the given thread that match the specified priority.
-bool Xe::XCPU::XenonIIC::hasPendingInterrupts(u8 threadID, bool ignorePendingACKd) {
-  // Check for valid thread ID
+// Blocks a sleeping thread until it's woken up, an interrupt can be delivered to it or the timeout expires.
+bool Xe::XCPU::XenonIIC::sleepThread(u8 threadID, bool wakeOnInterrupt, std::chrono::nanoseconds timeout) {
   if (threadID >= 6) {
     return false;
   }
 
-  // Set a lock
-  std::lock_guard lock(iicMutex);
-
-  auto& pq = interruptState[threadID].pendingInterrupts;
+  sThreadWaiter &waiter = threadWaiter[threadID];
+  std::unique_lock lock(waiter.mutex);
+  waiter.sleeping.store(true, std::memory_order_relaxed);
+  // Pairs with the fence in notifyThread, either we see the wake condition or the waker sees us sleeping.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const bool woken = waiter.cv.wait_for(lock, timeout, [&] {
+    return waiter.wakeRequested.load(std::memory_order_relaxed) ||
+      (wakeOnInterrupt && hasPendingInterrupts(threadID, true));
+  });
+  waiter.sleeping.store(false, std::memory_order_relaxed);
+  waiter.wakeRequested.store(false, std::memory_order_relaxed);
+  return woken;
+}
 
-  if (pq.empty()) {
-    // No pending interrupts
-    return false;
+// Wakes up a thread blocked in sleepThread.
+void Xe::XCPU::XenonIIC::wakeThread(u8 threadID) {
+  if (threadID >= 6) {
+    return;
   }
+  threadWaiter[threadID].wakeRequested.store(true, std::memory_order_relaxed);
+  notifyThread(threadID);
+}
 
-  // Check for priority
-  const u8 priority = static_cast<u8>(socINTBlock->ProcessorBlock[threadID].InterruptTaskPriority.AsULONGLONG & 0xFF);
-
-  // Ignore ACK packages if any and lower priority interrupts
-  bool foundAcked = false;
-  bool foundMatch = false;
-  u8 type = 0;
-  std::vector<sInterruptPacket> buffer;
-  buffer.reserve(pq.size());
-
-  while (!pq.empty()) {
-    const auto pkt = pq.top();
-    pq.pop();
-    buffer.emplace_back(pkt);
-
-    if (pkt.acknowledged) { foundAcked = true; } 
-    else if (pkt.interruptType > priority) { foundMatch = true; type = pkt.interruptType; }
+// Notifies a thread blocked in sleepThread, if any.
+void Xe::XCPU::XenonIIC::notifyThread(u8 threadID) {
+  sThreadWaiter &waiter = threadWaiter[threadID];
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!waiter.sleeping.load(std::memory_order_relaxed)) {
+    return;
   }
-
-  for (const auto& pkt : buffer) { pq.push(pkt); }
-
-  // There are ACK'd packets, cant signal an interupt.
-  if (foundAcked && !ignorePendingACKd) {
-    return false;
+  // Taking the lock makes sure a sleeper that just checked its wake condition is blocked before we notify it.
+  {
+    std::lock_guard lock(waiter.mutex);
   }
-
-  return foundMatch;
+  waiter.cv.notify_one();
 }
 
-// Removes the first ACK'd interrupt from the pending queue for a given thread.
+// Removes the first ACK'd interrupt (highest priority one in service) for a given thread.
 void Xe::XCPU::XenonIIC::removeFirstACKdInterrupt(u8 threadID) {
-  // Set a lock
-  std::lock_guard lock(iicMutex);
-
-  auto& pq = interruptState[threadID].pendingInterrupts;
-  if (pq.empty()) {
-#ifdef IIC_DEBUG
-      LOG_DEBUG(Xenon_IIC, "[IIC]: EOI on thread {} with empty queue", threadID);
-#endif // IIC_DEBUG
-    return;
-  }
-
-  // Rebuild the priority queue excluding the first acknowledged packet encountered in order.
-  bool removed = false;
-  std::vector<sInterruptPacket> buffer;
-  buffer.reserve(pq.size());
-
-  // Pop all elements; the top is highest priority due to operator < inversion.
-  while (!pq.empty()) {
-    const auto pkt = pq.top();
-    pq.pop();
-    if (!removed && pkt.acknowledged) {
-      removed = true;
+  std::atomic<u64> &interrupts = interruptState[threadID].interrupts;
+  u64 current = interrupts.load(std::memory_order_acquire);
+  u64 bit = 0;
+  do {
+    const u32 inService = static_cast<u32>(current >> 32);
+    if (inService == 0) {
 #ifdef IIC_DEBUG
-        LOG_DEBUG(Xenon_IIC, "[IIC]: Removed ACK'd interrupt {} from thread {}",
-          getIntName(static_cast<eXeIntVectors>(pkt.interruptType)).c_str(), threadID);
+      LOG_DEBUG(Xenon_IIC, "[IIC]: EOI on thread {} found no ACK'd interrupts to remove", threadID);
 #endif // IIC_DEBUG
-      continue; // skip this packet
+      return;
     }
-    buffer.emplace_back(pkt);
-  }
-
-  // Restore the remaining packets back into the priority queue.
-  for (const auto& pkt : buffer) {
-    pq.push(pkt);
-  }
+    bit = static_cast<u64>(1U << (31 - std::countl_zero(inService))) << 32;
+  } while (!interrupts.compare_exchange_weak(current, current & ~bit, std::memory_order_acq_rel,
+    std::memory_order_acquire));
 
 #ifdef IIC_DEBUG
-  if (!removed) {
-    LOG_DEBUG(Xenon_IIC, "[IIC]: EOI on thread {} found no ACK'd interrupts to remove", threadID);
-  }
+  LOG_DEBUG(Xenon_IIC, "[IIC]: Removed ACK'd interrupt {} from thread {}",
+    getIntName(static_cast<eXeIntVectors>(std::countr_zero(bit >> 32) << 2)).c_str(), threadID);
 #endif // IIC_DEBUG
 }
 
 // Acknowledges and returns the highest priority pending interrupt for a given thread.
-// NOTE: If the highest priority interrupt is the same priority as the current task priority, we return and ACK the next
-// higher priority interrupt instead.
+// NOTE: Only interrupts strictly higher than the current task priority are eligible.
 u8 Xe::XCPU::XenonIIC::acknowledgeInterrupt(u8 threadID) {
-  // Set a lock
-  std::lock_guard lock(iicMutex);
-
-  u8 outInterrupt = prioNONE;
-
-  auto& pq = interruptState[threadID].pendingInterrupts;
-
-  if (!pq.empty()) {
-    // Current task priority for this thread
-    const u8 currentPriority = static_cast<u8>(socINTBlock->ProcessorBlock[threadID].InterruptTaskPriority.AsULONGLONG & 0xFF);
-
-    // Get the highest priority interrupt
-    const auto topPacket = pq.top();
-    u8 targetInterrupt = prioNONE;
-
-    if (!topPacket.acknowledged) {
-      if (topPacket.interruptType > currentPriority) {
-        // Top is higher than current priority -> acknowledge it
-        targetInterrupt = topPacket.interruptType;
-      } else if (topPacket.interruptType == currentPriority) {
-        // Special case, top equals current priority -> find next strictly higher than currentPriority
-        // We scan the queue and pick the first matching.
-        std::vector<sInterruptPacket> buffer;
-        buffer.reserve(pq.size());
-
-        u8 nextHigher = prioNONE;
-        while (!pq.empty()) {
-          const auto pkt = pq.top();
-          pq.pop();
-          buffer.emplace_back(pkt);
-          if (!pkt.acknowledged && pkt.interruptType > currentPriority) {
-            nextHigher = pkt.interruptType;
-            break;
-          }
-        }
-        // Restore queue contents (including any not yet popped)
-        for (const auto& pkt : buffer) { pq.push(pkt); }
-
-        targetInterrupt = nextHigher; // may remain prioNONE if none found
-      } else {
-        // Top is lower than currentPriority -> no eligible interrupt
-        targetInterrupt = prioNONE;
-      }
-    } else {
-      // Top already acknowledged; try to find a non-acknowledged packet strictly higher than currentPriority
-      std::vector<sInterruptPacket> buffer;
-      buffer.reserve(pq.size());
-
-      u8 nextHigher = prioNONE;
-      while (!pq.empty()) {
-        const auto pkt = pq.top();
-        pq.pop();
-        buffer.emplace_back(pkt);
-        if (!pkt.acknowledged && pkt.interruptType > currentPriority) {
-          nextHigher = pkt.interruptType;
-          break; // first higher-than-currentPriority encountered
-        }
-      }
-      for (const auto& pkt : buffer) { pq.push(pkt); }
-
-      targetInterrupt = nextHigher;
+  sInterruptState &state = interruptState[threadID];
+  const u32 deliverable = deliverableMask(state.taskPriority.load(std::memory_order_relaxed));
+
+  // Move the interrupt from pending to in service
+  u64 current = state.interrupts.load(std::memory_order_acquire);
+  u32 bit = 0;
+  do {
+    const u32 candidates = static_cast<u32>(current) & deliverable;
+    if (candidates == 0) {
+      return prioNONE;
     }
+    bit = 1U << (31 - std::countl_zero(candidates));
+  } while (!state.interrupts.compare_exchange_weak(current,
+    (current & ~static_cast<u64>(bit)) | (static_cast<u64>(bit) << 32), std::memory_order_acq_rel,
+    std::memory_order_acquire));
 
-    // If we found an interrupt to acknowledge, mark exactly one matching packet as acknowledged.
-    if (targetInterrupt != prioNONE) {
-      outInterrupt = targetInterrupt;
-
-      bool marked = false;
-      std::vector<sInterruptPacket> buffer;
-      buffer.reserve(pq.size());
-      // Pop all elements; the top is highest priority due to operator < inversion.
-      while (!pq.empty()) {
-        auto pkt = pq.top();
-        pq.pop();
-        if (!marked && !pkt.acknowledged && pkt.interruptType == targetInterrupt) {
-          pkt.acknowledged = true;
-          marked = true;
-        }
-        buffer.emplace_back(pkt);
-      }
-      // Restore the packets back into the priority queue.
-      for (const auto& pkt : buffer) { pq.push(pkt); }
-    }
-  }
-
-  return outInterrupt;
+  return static_cast<u8>(std::countr_zero(bit) << 2);
 }
 
 // Returns the name of the register being accessed based on the offset and what block it belongs to.
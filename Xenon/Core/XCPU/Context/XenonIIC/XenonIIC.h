@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
-#include <queue>
+
+#include "Base/StateStream.h"
 
 namespace Xe::XCPU {
 
@@ -220,20 +224,16 @@ namespace Xe::XCPU {
     u64 Reserved12[495]; // 28808
   } SOCINTS_BLOCK, * PSOCINTS_BLOCK;
 
-  // Structure represnting an Interrupt Packet
-    struct sInterruptPacket {
-    u8 interruptType = prioNONE;
-    bool acknowledged = false;
-
-    // Highest priority comes first
-    friend constexpr bool operator<(const sInterruptPacket& lhs, const sInterruptPacket& rhs) noexcept {
-      return lhs.interruptType > rhs.interruptType;
-    }
-  };
-
   // Structure tracking the state of interrupts for each PPU Thread.
+  // Interrupts are kept as bitmasks indexed by priority (vector >> 2), so checking for a deliverable interrupt
+  // is a single relaxed load. The low word holds the interrupts pending acknowledgement, the high word the ones
+  // that have been acknowledged and are waiting for an EOI. Like on hardware, an interrupt that is generated while
+  // already pending is latched only once.
   struct sInterruptState {
-    std::priority_queue<sInterruptPacket> pendingInterrupts;
+    std::atomic<u64> interrupts = 0;
+    // Copies of the InterruptTaskPriority and LogicalIdentification registers, readable without the lock.
+    std::atomic<u8> taskPriority = 0;
+    std::atomic<u8> logicalId = 0;
   };
 
   class XenonIIC {
@@ -250,7 +250,29 @@ namespace Xe::XCPU {
     // Cancels a previously generated pending interrupt.
     void cancelInterrupt(u8 interruptType, u8 cpusToInterrupt);
     // Returns true if there are pending interrupts for the given thread.
-    bool hasPendingInterrupts(u8 threadID, bool ignorePendingACKd = false);
+    bool hasPendingInterrupts(u8 threadID, bool ignorePendingACKd = false) {
+      if (threadID >= 6)
+        return false;
+      const sInterruptState &state = interruptState[threadID];
+      const u64 interrupts = state.interrupts.load(std::memory_order_relaxed);
+      // Nothing pending
+      if (static_cast<u32>(interrupts) == 0)
+        return false;
+      // There are ACK'd interrupts waiting for an EOI, cant signal an interrupt.
+      if ((interrupts >> 32) != 0 && !ignorePendingACKd)
+        return false;
+      // Only interrupts above the current task priority are delivered.
+      return (static_cast<u32>(interrupts) & deliverableMask(state.taskPriority.load(std::memory_order_relaxed))) != 0;
+    }
+    // Blocks a sleeping thread until it's woken up with wakeThread, the timeout expires or, if wakeOnInterrupt is
+    // set, an interrupt can be delivered to it. Returns false on timeout.
+    bool sleepThread(u8 threadID, bool wakeOnInterrupt, std::chrono::nanoseconds timeout);
+    // Wakes up a thread blocked in sleepThread. If it isn't sleeping yet, its next sleep returns right away.
+    void wakeThread(u8 threadID);
+
+    // Save state, the register block and the interrupt states of every thread.
+    void SaveState(Base::StateWriter &writer);
+    void LoadState(Base::StateReader &reader);
 
   private:
     // Our Interrupt Block
@@ -259,8 +281,31 @@ namespace Xe::XCPU {
     // Interrupt States for each PPU Thread
     sInterruptState interruptState[6] = {};
 
-    // Mutex for thread safety
-    std::recursive_mutex iicMutex;
+    // Mutex for the register block
+    std::mutex iicMutex;
+
+    // Wait slot for each PPU Thread
+    struct sThreadWaiter {
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::atomic<bool> sleeping = false;
+      std::atomic<bool> wakeRequested = false;
+    };
+    sThreadWaiter threadWaiter[6] = {};
+
+    // Bit for an interrupt vector in the interrupt masks.
+    static constexpr u32 interruptBit(u8 interruptType) {
+      return 1U << ((interruptType >> 2) & 31);
+    }
+
+    // Mask of interrupt vectors strictly above the given task priority.
+    static constexpr u32 deliverableMask(u8 priority) {
+      const u32 index = priority >> 2;
+      return index >= 31 ? 0 : ~((2U << index) - 1);
+    }
+
+    // Notifies a thread blocked in sleepThread so it rechecks its wake conditions.
+    void notifyThread(u8 threadID);
 
     // Erases the first element in the queue that has been ack'd.
     void removeFirstACKdInterrupt(u8 threadID);
@@ -0,0 +1,454 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+
+#include "Base/ByteSwap.h"
+#include "Base/Config.h"
+#include "Base/Global.h"
+#include "Base/Hash.h"
+#include "Core/XCPU/Interpreter/PPCInterpreter.h"
+
+#include "XenonHLE.h"
+
+namespace Xe::XCPU::HLE {
+
+// Largest operation we run natively, bigger ones are left to the guest.
+static constexpr u64 hleMaxSize = 64_MiB;
+
+// A translated part of a guest range.
+struct sHLESpan {
+  u8 *hostPtr = nullptr;
+  u64 RA = 0;
+  u64 size = 0;
+};
+
+// Translates [EA, EA + size) into RAM spans for the current thread, without raising exceptions.
+// Returns false if any page isn't mapped, isn't backed by RAM or is watched.
+static bool hleTranslateRange(sPPEState *ppeState, u64 EA, u64 size, bool memWrite, bool instrFetch,
+  std::vector<sHLESpan> &spans) {
+  sPPUThread &thread = ppeState->ppuThread[curThreadId];
+  // A failed translation leaves an exception pending, we restore all of it
+  const u16 exceptReg = thread.exceptReg;
+  const DAR_t DAR = thread.SPR.DAR;
+  const DSISR_t DSISR = thread.SPR.DSISR;
+  const uMSR MSR = thread.SPR.MSR;
+  const bool oldInstrFetch = thread.instrFetch;
+
+  thread.instrFetch = instrFetch;
+  spans.clear();
+  bool translated = true;
+  u64 offset = 0;
+  while (offset < size) {
+    const u64 pageEA = EA + offset;
+    const u64 chunkSize = std::min<u64>(size - offset, 0x1000 - (pageEA & 0xFFF));
+    u64 RA = pageEA;
+    u8 *hostPtr = nullptr;
+    if (!PPCInterpreter::MMUTranslateAddress(&RA, ppeState, memWrite, ePPUThread_None, &hostPtr) || !hostPtr) {
+      translated = false;
+      break;
+    }
+    spans.push_back({ hostPtr, RA, chunkSize });
+    offset += chunkSize;
+  }
+  thread.instrFetch = oldInstrFetch;
+
+  if (!translated) {
+    thread.exceptReg = exceptReg;
+    thread.SPR.DAR = DAR;
+    thread.SPR.DSISR = DSISR;
+    thread.SPR.MSR = MSR;
+  }
+  return translated;
+}
+
+// Copies between two span lists of the same total size.
+static void hleCopySpans(const std::vector<sHLESpan> &dst, const std::vector<sHLESpan> &src) {
+  u64 dstIdx = 0, srcIdx = 0, dstOffset = 0, srcOffset = 0;
+  while (dstIdx != dst.size() && srcIdx != src.size()) {
+    const u64 chunkSize = std::min(dst[dstIdx].size - dstOffset, src[srcIdx].size - srcOffset);
+    memmove(dst[dstIdx].hostPtr + dstOffset, src[srcIdx].hostPtr + srcOffset, chunkSize);
+    dstOffset += chunkSize;
+    srcOffset += chunkSize;
+    if (dstOffset == dst[dstIdx].size) { dstIdx++; dstOffset = 0; }
+    if (srcOffset == src[srcIdx].size) { srcIdx++; srcOffset = 0; }
+  }
+}
+
+// Gathers a span list into a host buffer.
+static void hleGatherSpans(const std::vector<sHLESpan> &spans, u8 *out) {
+  for (const auto &span : spans) {
+    memcpy(out, span.hostPtr, span.size);
+    out += span.size;
+  }
+}
+
+// Scatters a host buffer into a span list.
+static void hleScatterSpans(const std::vector<sHLESpan> &spans, const u8 *in) {
+  for (const auto &span : spans) {
+    memcpy(span.hostPtr, in, span.size);
+    in += span.size;
+  }
+}
+
+// Reads guest code words, converting from big endian. RA is set to the real address of the first word, if given.
+static bool hleReadCode(sPPEState *ppeState, u64 EA, u32 count, std::vector<u32> &words, u64 *RA = nullptr) {
+  thread_local std::vector<sHLESpan> spans{};
+  if (!hleTranslateRange(ppeState, EA, count * sizeof(u32), false, true, spans))
+    return false;
+  if (RA)
+    *RA = spans.front().RA;
+  const u64 base = words.size();
+  words.resize(base + count);
+  hleGatherSpans(spans, reinterpret_cast<u8*>(words.data() + base));
+  Base::ByteSwap::SwapBE(words.data() + base, count);
+  return true;
+}
+
+XenonHLE::~XenonHLE() {
+  LogStats();
+  if (dirtyTracker && dirtyConsumer != -1)
+    dirtyTracker->UnregisterConsumer(dirtyConsumer);
+}
+
+bool XenonHLE::LoadSignatures(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    LOG_WARNING(Xenon, "HLE: Unable to open the signature list '{}'", path);
+    return false;
+  }
+  std::lock_guard lock(hookMutex);
+  signatures.clear();
+  maxSignatureLength = 0;
+  std::string line;
+  u32 lineNum = 0;
+  while (std::getline(file, line)) {
+    lineNum++;
+    std::istringstream stream(line);
+    std::string routine;
+    if (!(stream >> routine) || routine.front() == '#')
+      continue;
+    sHLESignature signature = {};
+    switch (Base::JoaatStringHash(routine)) {
+    case "memcpy"_j: signature.routine = hleMemCpy; break;
+    case "memmove"_j: signature.routine = hleMemMove; break;
+    case "memset"_j: signature.routine = hleMemSet; break;
+    default:
+      LOG_WARNING(Xenon, "HLE: Unknown routine '{}' on line {}", routine, lineNum);
+      continue;
+    }
+    stream >> signature.name;
+    bool valid = !signature.name.empty();
+    std::string word;
+    while (valid && stream >> word) {
+      if (word.size() != 8) {
+        valid = false;
+        break;
+      }
+      u32 value = 0, mask = 0;
+      for (const char c : word) {
+        value <<= 4;
+        mask <<= 4;
+        if (c == '?')
+          continue;
+        if (!std::isxdigit(static_cast<u8>(c))) {
+          valid = false;
+          break;
+        }
+        value |= static_cast<u32>(std::isdigit(static_cast<u8>(c)) ? c - '0' : std::tolower(c) - 'a' + 10);
+        mask |= 0xF;
+      }
+      signature.words.push_back(value);
+      signature.masks.push_back(mask);
+    }
+    // Short signatures match way too much code
+    if (!valid || signature.words.size() < 4) {
+      LOG_WARNING(Xenon, "HLE: Invalid signature on line {}", lineNum);
+      continue;
+    }
+    maxSignatureLength = std::max<u32>(maxSignatureLength, static_cast<u32>(signature.words.size()));
+    signatures.push_back(std::move(signature));
+  }
+  LOG_INFO(Xenon, "HLE: Loaded {} signatures from '{}'", signatures.size(), path);
+  return true;
+}
+
+void XenonHLE::Reset() {
+  std::lock_guard lock(hookMutex);
+  for (auto &word : scannedPages) {
+    word.store(0, std::memory_order_relaxed);
+  }
+  for (auto &word : armedPages) {
+    word.store(0, std::memory_order_relaxed);
+  }
+  scannedRAMPages.clear();
+  for (u32 i = 0; i != hleMaxHooks; ++i) {
+    hooks[i].address.store(0, std::memory_order_release);
+  }
+  for (auto &verification : verifications) {
+    verification.pending = false;
+  }
+}
+
+void XenonHLE::ScanPage(sPPEState *ppeState, u64 EA) {
+  MICROPROFILE_SCOPEI("[Xe::HLE]", "ScanPage", MP_AUTO);
+  const u64 pageEA = EA & ~0xFFFULL;
+  std::lock_guard lock(hookMutex);
+  if (IsPageScanned(pageEA))
+    return;
+
+  SetPageScanned(pageEA, true);
+
+  std::vector<u32> code{};
+  code.reserve(1024 + maxSignatureLength);
+  // Code that isn't in RAM (SROM) is never HLE'd
+  u64 RA = 0;
+  if (!hleReadCode(ppeState, pageEA, 1024, code, &RA))
+    return;
+
+  // Watch the page for writes, code loaded there later must be scanned too. The soft-dirty backend is only harvested
+  // while the guest is stopped, there the hooks still check they match before every call.
+  if (!dirtyTracker) {
+    dirtyTracker = &PPCInterpreter::xenonContext->GetRAM()->GetDirtyTracker();
+    if (dirtyTracker->GetMode() == eDirtyTrackingMode::Software)
+      dirtyConsumer = dirtyTracker->RegisterConsumer("HLE");
+  }
+  if (dirtyConsumer != -1) {
+    std::vector<u64> &pages = scannedRAMPages[(RA - RAM_START_ADDR) & ~(DIRTY_PAGE_SIZE - 1)];
+    if (std::find(pages.begin(), pages.end(), pageEA) == pages.end())
+      pages.push_back(pageEA);
+  }
+  // Signatures starting near the end of the page continue on the next one, if it's mapped
+  if (maxSignatureLength > 1)
+    hleReadCode(ppeState, pageEA + 0x1000, maxSignatureLength - 1, code);
+
+  for (u32 wordIdx = 0; wordIdx != 1024; ++wordIdx) {
+    for (u32 signatureIdx = 0; signatureIdx != signatures.size(); ++signatureIdx) {
+      const sHLESignature &signature = signatures[signatureIdx];
+      if (wordIdx + signature.words.size() > code.size())
+        continue;
+      bool matched = true;
+      for (u32 i = 0; i != signature.words.size() && matched; ++i) {
+        matched = (code[wordIdx + i] & signature.masks[i]) == signature.words[i];
+      }
+      if (!matched)
+        continue;
+      const u64 address = pageEA + wordIdx * 4;
+      LOG_INFO(Xenon, "HLE: Found '{}' at {:#x}", signature.name, address);
+      AddHook(address, signatureIdx);
+      break;
+    }
+  }
+}
+
+bool XenonHLE::MatchesAt(sPPEState *ppeState, u64 EA, const sHLESignature &signature) {
+  thread_local std::vector<u32> code{};
+  code.clear();
+  if (!hleReadCode(ppeState, EA, static_cast<u32>(signature.words.size()), code))
+    return false;
+  for (u32 i = 0; i != signature.words.size(); ++i) {
+    if ((code[i] & signature.masks[i]) != signature.words[i])
+      return false;
+  }
+  return true;
+}
+
+bool XenonHLE::Invoke(sPPEState *ppeState, u64 EA) {
+  sHLEHook *hook = FindHook(EA);
+  if (!hook)
+    return false;
+  const u32 signatureIdx = hook->signatureIdx;
+  const sHLESignature &signature = signatures[signatureIdx];
+
+  // The code may have been replaced since the page was scanned
+  if (!MatchesAt(ppeState, EA, signature)) {
+    LOG_DEBUG(Xenon, "HLE: '{}' at {:#x} no longer matches, removing it", signature.name, EA);
+    RemoveHook(hook);
+    return false;
+  }
+
+  sPPUThread &thread = ppeState->ppuThread[curThreadId];
+  const bool SF = thread.SPR.MSR.SF;
+  const u64 dst = thread.GPR[3];
+  const u64 src = thread.GPR[4];
+  const u64 size = SF ? thread.GPR[5] : static_cast<u32>(thread.GPR[5]);
+  if (size > hleMaxSize)
+    return false;
+
+  thread_local std::vector<sHLESpan> dstSpans{};
+  thread_local std::vector<sHLESpan> srcSpans{};
+  thread_local std::vector<u8> bounce{};
+  if (!hleTranslateRange(ppeState, dst, size, true, false, dstSpans))
+    return false;
+  if (signature.routine != hleMemSet && !hleTranslateRange(ppeState, src, size, false, false, srcSpans))
+    return false;
+
+  // Let the guest run it and compare once it returns
+  if (Config::debug.hleVerify) {
+    sHLEVerification &verification = verifications[ppeState->ppuID * 2 + curThreadId];
+    verification.signatureIdx = signatureIdx;
+    verification.hookAddress = EA;
+    verification.returnAddress = thread.SPR.LR & ~3ULL;
+    verification.stackPointer = thread.GPR[1];
+    verification.dst = dst;
+    verification.expected.resize(size);
+    if (signature.routine == hleMemSet)
+      memset(verification.expected.data(), static_cast<u8>(src), size);
+    else
+      hleGatherSpans(srcSpans, verification.expected.data());
+    verification.pending = true;
+    hook->calls.fetch_add(1, std::memory_order_relaxed);
+    hook->bytes.fetch_add(size, std::memory_order_relaxed);
+    return false;
+  }
+
+  Xe::XCPU::XenonContext *cpuContext = PPCInterpreter::xenonContext;
+  for (const auto &span : dstSpans) {
+    cpuContext->xenonRes.CheckRange(span.RA, span.size);
+  }
+  switch (signature.routine) {
+  case hleMemSet:
+    for (const auto &span : dstSpans) {
+      memset(span.hostPtr, static_cast<u8>(src), span.size);
+    }
+    break;
+  case hleMemCpy:
+  case hleMemMove:
+    // Overlapping ranges go through a bounce buffer, so the result is the same as memmove on every span layout
+    if (dst < src + size && src < dst + size) {
+      bounce.resize(size);
+      hleGatherSpans(srcSpans, bounce.data());
+      hleScatterSpans(dstSpans, bounce.data());
+    } else {
+      hleCopySpans(dstSpans, srcSpans);
+    }
+    break;
+  }
+  for (const auto &span : dstSpans) {
+    cpuContext->GetRAM()->MarkDirtyHost(span.hostPtr, span.size);
+  }
+  hook->calls.fetch_add(1, std::memory_order_relaxed);
+  hook->bytes.fetch_add(size, std::memory_order_relaxed);
+
+  // Return to the caller, r3 already holds dst
+  thread.CIA = EA;
+  thread.NIA = thread.SPR.LR & ~3ULL;
+  return true;
+}
+
+void XenonHLE::CheckVerification(sPPEState *ppeState) {
+  sHLEVerification &verification = verifications[ppeState->ppuID * 2 + curThreadId];
+  if (!verification.pending)
+    return;
+  sPPUThread &thread = ppeState->ppuThread[curThreadId];
+  if (thread.NIA != verification.returnAddress || thread.GPR[1] != verification.stackPointer)
+    return;
+  verification.pending = false;
+
+  const std::string &name = signatures[verification.signatureIdx].name;
+  thread_local std::vector<sHLESpan> spans{};
+  thread_local std::vector<u8> result{};
+  if (!hleTranslateRange(ppeState, verification.dst, verification.expected.size(), false, false, spans)) {
+    LOG_WARNING(Xenon, "HLE: Unable to verify '{}' at {:#x}, destination is no longer mapped", name,
+      verification.hookAddress);
+    return;
+  }
+  result.resize(verification.expected.size());
+  hleGatherSpans(spans, result.data());
+  const auto mismatch = std::mismatch(result.begin(), result.end(), verification.expected.begin());
+  if (mismatch.first != result.end()) {
+    const u64 offset = static_cast<u64>(mismatch.first - result.begin());
+    LOG_ERROR(Xenon, "HLE: '{}' at {:#x} mismatch at dst+{:#x} (size {:#x}): guest {:#04x}, native {:#04x}", name,
+      verification.hookAddress, offset, result.size(), *mismatch.first, *mismatch.second);
+  }
+}
+
+void XenonHLE::LogStats() {
+  for (u32 i = 0; i != hleMaxHooks; ++i) {
+    const sHLEHook &hook = hooks[i];
+    const u64 address = hook.address.load(std::memory_order_acquire);
+    if (address == 0 || address == hleTombstone || hook.calls.load(std::memory_order_relaxed) == 0)
+      continue;
+    LOG_INFO(Xenon, "HLE: '{}' at {:#x}: {} calls, {:#x} bytes", signatures[hook.signatureIdx].name, address,
+      hook.calls.load(std::memory_order_relaxed), hook.bytes.load(std::memory_order_relaxed));
+  }
+}
+
+XenonHLE::sHLEHook *XenonHLE::FindHook(u64 EA) const {
+  u32 idx = static_cast<u32>(((EA >> 2) * 0x9E3779B97F4A7C15ULL) >> (64 - std::countr_zero(hleMaxHooks)));
+  for (u32 probe = 0; probe != hleMaxHooks; ++probe, idx = (idx + 1) & (hleMaxHooks - 1)) {
+    sHLEHook &hook = hooks[idx];
+    const u64 address = hook.address.load(std::memory_order_acquire);
+    if (address == EA)
+      return &hook;
+    if (address == 0)
+      return nullptr;
+  }
+  return nullptr;
+}
+
+void XenonHLE::AddHook(u64 EA, u32 signatureIdx) {
+  if (FindHook(EA))
+    return;
+  u32 idx = static_cast<u32>(((EA >> 2) * 0x9E3779B97F4A7C15ULL) >> (64 - std::countr_zero(hleMaxHooks)));
+  for (u32 probe = 0; probe != hleMaxHooks; ++probe, idx = (idx + 1) & (hleMaxHooks - 1)) {
+    sHLEHook &hook = hooks[idx];
+    const u64 address = hook.address.load(std::memory_order_relaxed);
+    if (address != 0 && address != hleTombstone)
+      continue;
+    hook.signatureIdx = signatureIdx;
+    hook.calls.store(0, std::memory_order_relaxed);
+    hook.bytes.store(0, std::memory_order_relaxed);
+    hook.address.store(EA, std::memory_order_release);
+    const u64 page = (EA >> 12) & (hlePageCount - 1);
+    armedPages[page >> 6].fetch_or(1ULL << (page & 63), std::memory_order_relaxed);
+    return;
+  }
+  LOG_WARNING(Xenon, "HLE: Hook table is full, ignoring '{}' at {:#x}", signatures[signatureIdx].name, EA);
+}
+
+void XenonHLE::RemoveHook(sHLEHook *hook) {
+  std::lock_guard lock(hookMutex);
+  const u64 address = hook->address.load(std::memory_order_relaxed);
+  if (address == 0 || address == hleTombstone)
+    return;
+  hook->address.store(hleTombstone, std::memory_order_release);
+  // Scan it again next time it runs, there may be something else there now
+  SetPageScanned(address, false);
+}
+
+void XenonHLE::SetPageScanned(u64 EA, bool scanned) {
+  std::atomic<u64> &entry = scannedPages[(EA >> 17) & (hlePageCount / 32 - 1)];
+  const u64 region = EA & ~0xFFFFFFFFULL;
+  const u64 bit = 1ULL << ((EA >> 12) & 31);
+  u64 value = entry.load(std::memory_order_relaxed);
+  if ((value & ~0xFFFFFFFFULL) != region) {
+    if (!scanned)
+      return;
+    // Held another region's pages, they'll be scanned again
+    value = region;
+  }
+  entry.store(scanned ? value | bit : value & ~bit, std::memory_order_relaxed);
+}
+
+void XenonHLE::CheckWrittenPages() {
+  // Another thread is already at it, or scanning
+  std::unique_lock lock(hookMutex, std::try_to_lock);
+  if (!lock.owns_lock() || dirtyConsumer == -1)
+    return;
+  for (const u64 offset : dirtyTracker->CollectDirtyPages(dirtyConsumer)) {
+    const auto it = scannedRAMPages.find(offset);
+    if (it == scannedRAMPages.end())
+      continue;
+    for (const u64 pageEA : it->second)
+      SetPageScanned(pageEA, false);
+    scannedRAMPages.erase(it);
+  }
+}
+
+}
@@ -0,0 +1,137 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Base/Types.h"
+
+struct sPPEState;
+class RAMDirtyTracker;
+
+namespace Xe::XCPU::HLE {
+  // Guest routines we can run natively.
+  enum eHLERoutine : u8 {
+    hleMemCpy,  // memcpy(r3 = dst, r4 = src, r5 = size), returns dst
+    hleMemMove, // memmove(r3 = dst, r4 = src, r5 = size), returns dst
+    hleMemSet   // memset(r3 = dst, r4 = value, r5 = size), returns dst
+  };
+
+  // A routine signature: the first instructions of the routine, with a mask of the bits that must match.
+  struct sHLESignature {
+    std::string name{};
+    eHLERoutine routine = hleMemCpy;
+    std::vector<u32> words{};
+    std::vector<u32> masks{};
+  };
+
+  // High level emulation of guest memory routines.
+  // Code pages are scanned for known routine signatures the first time they're executed. Calls to matched routines
+  // are done natively on the translated RAM spans, then return straight to the caller. If any page of the operation
+  // isn't mapped, isn't backed by RAM or is watched, the guest routine is interpreted instead, so faults and
+  // watchpoints behave as usual.
+  //
+  // Signatures are loaded from a text file, one per line:
+  //   <memcpy|memmove|memset> <name> <instruction words in hex, '?' digits are wildcards>
+  // Lines starting with '#' are ignored. e.g:
+  //   memset XeMemSet 2B850000 4D820020 ???????? 7C0802A6
+  class XenonHLE {
+  public:
+    ~XenonHLE();
+
+    // Loads the signature list. Returns false if the file couldn't be read.
+    bool LoadSignatures(const std::string &path);
+    // Drops every hook and scanned page (reset).
+    void Reset();
+
+    // Returns true if there's anything to scan for.
+    bool Enabled() const {
+      return !signatures.empty();
+    }
+    // Returns true if the page containing EA was already scanned.
+    bool IsPageScanned(u64 EA) const {
+      const u64 entry = scannedPages[(EA >> 17) & (hlePageCount / 32 - 1)].load(std::memory_order_relaxed);
+      return (entry >> 32) == (EA >> 32) && (entry & (1ULL << ((EA >> 12) & 31)));
+    }
+    // Returns true if the page containing EA has any hooks (or shares its bit with one that has).
+    bool IsPageArmed(u64 EA) const {
+      const u64 page = (EA >> 12) & (hlePageCount - 1);
+      return armedPages[page >> 6].load(std::memory_order_relaxed) & (1ULL << (page & 63));
+    }
+    // Returns true if there's a hook at EA.
+    bool IsHookAt(u64 EA) const {
+      return IsPageArmed(EA) && FindHook(EA) != nullptr;
+    }
+
+    // Scans the page containing EA for signatures, using the current thread's instruction translation.
+    void ScanPage(sPPEState *ppeState, u64 EA);
+    // Runs the routine hooked at EA natively. Returns true if it was done, NIA is then the caller's return address.
+    bool Invoke(sPPEState *ppeState, u64 EA);
+    // Drops the scanned pages whose RAM was written since the last call, so new code there gets scanned.
+    void CheckWrittenPages();
+    // Checks a pending verification for the current thread, once the interpreted routine returned.
+    void CheckVerification(sPPEState *ppeState);
+    // Logs the per-hook call and byte counters.
+    void LogStats();
+
+  private:
+    struct sHLEHook {
+      // Hooked address, 0 = free slot, hleTombstone = removed
+      std::atomic<u64> address = 0;
+      u32 signatureIdx = 0;
+      std::atomic<u64> calls = 0;
+      std::atomic<u64> bytes = 0;
+    };
+
+    // A result to check against interpretation.
+    struct sHLEVerification {
+      bool pending = false;
+      u32 signatureIdx = 0;
+      u64 hookAddress = 0;
+      u64 returnAddress = 0;
+      u64 stackPointer = 0;
+      u64 dst = 0;
+      std::vector<u8> expected{};
+    };
+
+    sHLEHook *FindHook(u64 EA) const;
+    void AddHook(u64 EA, u32 signatureIdx);
+    void RemoveHook(sHLEHook *hook);
+    // Returns true if the signature matches the guest code at EA.
+    bool MatchesAt(sPPEState *ppeState, u64 EA, const sHLESignature &signature);
+    // Sets or clears the scanned bit of the page containing EA. Must hold hookMutex.
+    void SetPageScanned(u64 EA, bool scanned);
+
+    // Pages per 4 GiB of effective address space.
+    static constexpr u64 hlePageCount = 1ULL << 20;
+    // Hook table size, must be a power of 2.
+    static constexpr u32 hleMaxHooks = 1024;
+    static constexpr u64 hleTombstone = 1;
+
+    std::vector<sHLESignature> signatures{};
+    // Longest signature, in instructions
+    u32 maxSignatureLength = 0;
+    // [EA >> 32][32 page bits] per entry, so pages that alias in the low 32 bits aren't mistaken for each other. An
+    // entry only holds one 4 GiB region at a time, the other region's pages just get scanned again.
+    std::array<std::atomic<u64>, hlePageCount / 32> scannedPages{};
+    // Aliases above 32 bits, which only costs a hook lookup, hooks hold the full address
+    std::array<std::atomic<u64>, hlePageCount / 64> armedPages{};
+    // Scanned pages by RAM page offset, to find the ones that were written
+    std::unordered_map<u64, std::vector<u64>> scannedRAMPages{};
+    RAMDirtyTracker *dirtyTracker = nullptr;
+    s32 dirtyConsumer = -1;
+    // Open addressing table, lookups are lock-free
+    std::unique_ptr<sHLEHook[]> hooks = std::make_unique<sHLEHook[]>(hleMaxHooks);
+    std::mutex hookMutex{};
+    // Pending verifications, one per hardware thread
+    std::array<sHLEVerification, 6> verifications{};
+  };
+}
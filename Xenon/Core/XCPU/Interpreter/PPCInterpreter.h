@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cstring>
+
+#include "Base/Config.h"
+
 #include "PPC_Instruction.h"
 
 #include "Core/XCPU/PPU/PPCInternal.h"
@@ -24,7 +28,7 @@ extern Xe::XCPU::XenonContext *xenonContext;
 //
 //  Helper macros for instructions
 //
-#define curThreadId   ppeState->currentThread
+#define curThreadId   executingThread
 #define curThread     ppeState->ppuThread[curThreadId]
 #define _previnstr    curThread.PI
 #define _instr        curThread.CI
@@ -147,12 +151,15 @@ u32 CRCompS(sPPEState *ppeState, u64 num1, u64 num2);
 void ppcExecuteSingleInstruction(sPPEState *ppeState);
 
 void ppcInterpreterTrap(sPPEState* ppeState, u32 trapNumber);
+// Thread priority change (or rX,rX,rX nops, mtspr TSRL)
+void ppcSetThreadPriority(sPPEState *ppeState, u8 priority);
 
 //
 // MMU
 //
 
-bool MMUTranslateAddress(u64 *EA, sPPEState *ppeState, bool memWrite, ePPUThreadID thr = ePPUThread_None);
+bool MMUTranslateAddress(u64 *EA, sPPEState *ppeState, bool memWrite, ePPUThreadID thr = ePPUThread_None,
+                         u8 **hostPtr = nullptr);
 u8 mmuGetPageSize(sPPEState *ppeState, bool L, u8 LP);
 void mmuAddTlbEntry(sPPEState *ppeState);
 bool mmuSearchTlbEntry(sPPEState *ppeState, u64 *RPN, u64 VA, u8 p, bool L, bool LP);
@@ -168,6 +175,12 @@ void MMURead(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppeState,
 void MMUWrite(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppeState,
               const u8* data, u64 EA, u64 byteCount, ePPUThreadID thr = ePPUThread_None);
 
+// Range R/W Routines, translate once per page and access RAM directly. MMIO pages fall back to MMURead/MMUWrite.
+// Return false if a translation failed.
+bool MMUReadRange(sPPEState *ppeState, u64 EA, u8 *outData, u64 size, ePPUThreadID thr = ePPUThread_None);
+bool MMUWriteRange(sPPEState *ppeState, u64 EA, const u8 *data, u64 size, ePPUThreadID thr = ePPUThread_None);
+bool MMUZeroRange(sPPEState *ppeState, u64 EA, u64 size, ePPUThreadID thr = ePPUThread_None);
+
 void MMUMemCpyFromHost(sPPEState *ppeState, u64 EA, const void *source, u64 size, ePPUThreadID thr = ePPUThread_None);
 
 void MMUMemCpy(sPPEState *ppeState, u64 EA, u32 source, u64 size, ePPUThreadID thr = ePPUThread_None);
@@ -176,15 +189,92 @@ void MMUMemSet(sPPEState *ppeState, u64 EA, s32 data, u64 size, ePPUThreadID thr
 
 u8 *MMUGetPointerFromRAM(u64 EA);
 
+//
+// Templated fast paths
+//
+// The common case (data access translated by the D-ERAT, RAM backed and naturally aligned) is fully inlined into
+// the callers. Anything else (MMIO, SoC, instruction fetches, ERAT misses, watched pages) goes through the
+// out-of-line MMURead/MMUWrite routines.
+
+// Generation the ERATs of a PPE must be synced to. Changes with the global one (tlbie, watchpoints) and with
+// the PPE's own one (tlbiel from its other thread).
+inline u32 mmuGetERATGeneration(sPPEState *ppeState) {
+  return xenonContext->eratGeneration.load(std::memory_order_acquire) +
+    ppeState->eratGeneration.load(std::memory_order_acquire);
+}
+
+// Returns the host pointer for a naturally aligned, RAM backed data access, or nullptr if the slow path is needed.
+template <typename T>
+inline u8 *mmuGetFastHostPtr(sPPEState *ppeState, u64 EA, ePPUThreadID thr, u64 *RA) {
+  sPPUThread &thread = ppeState->ppuThread[thr != ePPUThread_None ? thr : curThreadId];
+  if (thread.instrFetch || (EA & (sizeof(T) - 1)) || !xenonContext) [[unlikely]]
+    return nullptr;
+  const uMSR msr = thread.SPR.MSR;
+  if (!msr.SF)
+    EA = static_cast<u32>(EA);
+  thread.dERAT.Sync(mmuGetERATGeneration(ppeState));
+  u8 *hostPage = nullptr;
+  const u8 eratContext = Xe::XCPU::MMU::XenonERAT::BuildContext(msr.SF, msr.IR, msr.DR, msr.PR, msr.HV);
+  if (!thread.dERAT.Lookup(EA, eratContext, RA, &hostPage) || !hostPage) [[unlikely]]
+    return nullptr;
+  *RA |= (EA & 0xFFF);
+  return hostPage + (EA & 0xFFF);
+}
+
+// Reads sizeof(T) bytes of memory, converting from big endian.
+template <typename T>
+inline T MMUReadT(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None) {
+  T data = 0;
+  u64 RA = 0;
+  u8 *hostPtr = mmuGetFastHostPtr<T>(ppeState, EA, thr, &RA);
+  if (hostPtr) [[likely]]
+    memcpy(&data, hostPtr, sizeof(T));
+  else
+    MMURead(xenonContext, ppeState, EA, sizeof(T), reinterpret_cast<u8*>(&data), thr);
+  return byteswap_be<T>(data);
+}
+
+// Writes sizeof(T) bytes of memory, converting to big endian.
+template <typename T>
+inline void MMUWriteT(sPPEState *ppeState, u64 EA, T data, ePPUThreadID thr = ePPUThread_None) {
+  const T dataBS = byteswap_be<T>(data);
+  u64 RA = 0;
+  u8 *hostPtr = mmuGetFastHostPtr<T>(ppeState, EA, thr, &RA);
+  if (hostPtr) [[likely]] {
+    // Check if it's reserved
+    xenonContext->xenonRes.Check(RA, sizeof(T) <= 4);
+    memcpy(hostPtr, &dataBS, sizeof(T));
+    xenonContext->GetRAM()->MarkDirtyHost(hostPtr, sizeof(T));
+    return;
+  }
+  MMUWrite(xenonContext, ppeState, reinterpret_cast<const u8*>(&dataBS), EA, sizeof(T), thr);
+}
+
 // Helper Read Routines.
-u8 MMURead8(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None);
-u16 MMURead16(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None);
-u32 MMURead32(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None);
-u64 MMURead64(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None);
+inline u8 MMURead8(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None) {
+  return MMUReadT<u8>(ppeState, EA, thr);
+}
+inline u16 MMURead16(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None) {
+  return MMUReadT<u16>(ppeState, EA, thr);
+}
+inline u32 MMURead32(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None) {
+  return MMUReadT<u32>(ppeState, EA, thr);
+}
+inline u64 MMURead64(sPPEState *ppeState, u64 EA, ePPUThreadID thr = ePPUThread_None) {
+  return MMUReadT<u64>(ppeState, EA, thr);
+}
 // Helper Write Routines.
-void MMUWrite8(sPPEState *ppeState, u64 EA, u8 data, ePPUThreadID thr = ePPUThread_None);
-void MMUWrite16(sPPEState *ppeState, u64 EA, u16 data, ePPUThreadID thr = ePPUThread_None);
-void MMUWrite32(sPPEState *ppeState, u64 EA, u32 data, ePPUThreadID thr = ePPUThread_None);
-void MMUWrite64(sPPEState *ppeState, u64 EA, u64 data, ePPUThreadID thr = ePPUThread_None);
+inline void MMUWrite8(sPPEState *ppeState, u64 EA, u8 data, ePPUThreadID thr = ePPUThread_None) {
+  MMUWriteT<u8>(ppeState, EA, data, thr);
+}
+inline void MMUWrite16(sPPEState *ppeState, u64 EA, u16 data, ePPUThreadID thr = ePPUThread_None) {
+  MMUWriteT<u16>(ppeState, EA, data, thr);
+}
+inline void MMUWrite32(sPPEState *ppeState, u64 EA, u32 data, ePPUThreadID thr = ePPUThread_None) {
+  MMUWriteT<u32>(ppeState, EA, data, thr);
+}
+inline void MMUWrite64(sPPEState *ppeState, u64 EA, u64 data, ePPUThreadID thr = ePPUThread_None) {
+  MMUWriteT<u64>(ppeState, EA, data, thr);
+}
 
 } // namespace PPCInterpreter
@@ -1140,6 +1140,22 @@ void PPCInterpreter::PPCInterpreter_orx(sPPEState *ppeState) {
     rA <- (rS) | (rB)
   */
 
+  // or rX,rX,rX are nops that set the thread priority
+  if (_instr.rs == _instr.ra && _instr.rs == _instr.rb && !_instr.rc) {
+    switch (_instr.rs) {
+    case 1:
+    case 31:
+      ppcSetThreadPriority(ppeState, ePPUThreadPriority_Low);
+      return;
+    case 2:
+      ppcSetThreadPriority(ppeState, ePPUThreadPriority_Medium);
+      return;
+    case 3:
+      ppcSetThreadPriority(ppeState, ePPUThreadPriority_High);
+      return;
+    }
+  }
+
   GPRi(ra) = GPRi(rs) | GPRi(rb);
 
   // _rc
@@ -2,9 +2,11 @@
 /* Copyright 2025 Xenon Emulator Project. All rights reserved. */
 /***************************************************************/
 
+#include <atomic>
 #include <bit>
 
 #include "Base/Assert.h"
+#include "Base/ByteSwap.h"
 #include "PPCInterpreter.h"
 
 using namespace Base;
@@ -15,6 +17,75 @@ using namespace Base;
 // Utilities
 //
 
+// Loads an aligned 16 byte vector. A single range access, as it never crosses a page.
+static inline Vector128 vxuLoadVector(sPPEState *ppeState, u64 EA) {
+  Vector128 vector{};
+  PPCInterpreter::MMUReadRange(ppeState, EA, vector.bytes.data(), sizeof(vector));
+  Base::ByteSwap::SwapLane32(vector.bytes.data());
+  return vector;
+}
+
+// Load and Reserve. Reserves the real address and keeps the raw memory contents seen, which the conditional store
+// uses for its host CAS. Returns false if the translation failed.
+template <typename T>
+static inline bool ppcLoadAndReserve(sPPEState *ppeState, u64 EA, T *outData) {
+  sPPUThread &thread = ppeState->ppuThread[curThreadId];
+  EA &= ~static_cast<u64>(sizeof(T) - 1);
+  u64 RA = EA;
+  u8 *hostPtr = nullptr;
+  if (!PPCInterpreter::MMUTranslateAddress(&RA, ppeState, false, ePPUThread_None, &hostPtr))
+    return false;
+
+  PPCInterpreter::xenonContext->xenonRes.Reserve(thread.ppuRes.get(), RA);
+
+  T data = 0;
+  if (hostPtr)
+    data = std::atomic_ref<T>(*reinterpret_cast<T*>(hostPtr)).load(std::memory_order_acquire);
+  else
+    PPCInterpreter::MMURead(PPCInterpreter::xenonContext, ppeState, EA, sizeof(T), reinterpret_cast<u8*>(&data));
+  thread.ppuRes->reservedData = data;
+  *outData = byteswap_be<T>(data);
+  return true;
+}
+
+// Store Conditional. Returns true if the store was performed.
+// RAM backed stores are done with a host CAS against the contents seen by the Load and Reserve, so a store from
+// another thread that raced with us makes it fail, as it would on hardware.
+template <typename T>
+static inline bool ppcStoreConditional(sPPEState *ppeState, u64 EA, T data) {
+  sPPUThread &thread = ppeState->ppuThread[curThreadId];
+  EA &= ~static_cast<u64>(sizeof(T) - 1);
+  u64 RA = EA;
+  u8 *hostPtr = nullptr;
+  if (!PPCInterpreter::MMUTranslateAddress(&RA, ppeState, true, ePPUThread_None, &hostPtr))
+    return false;
+
+  Xe::XCPU::XenonContext *cpuContext = PPCInterpreter::xenonContext;
+  // Always drops our reservation
+  if (!cpuContext->xenonRes.Release(thread.ppuRes.get(), RA))
+    return false;
+
+  const T dataBS = byteswap_be<T>(data);
+  if (hostPtr) {
+    T expected = static_cast<T>(thread.ppuRes->reservedData);
+    if (!std::atomic_ref<T>(*reinterpret_cast<T*>(hostPtr)).compare_exchange_strong(expected, dataBS,
+        std::memory_order_acq_rel))
+      return false;
+    // Break other threads' reservations on it
+    cpuContext->xenonRes.Check(RA, sizeof(T) == sizeof(u32));
+    cpuContext->GetRAM()->MarkDirtyHost(hostPtr, sizeof(T));
+    return true;
+  }
+  PPCInterpreter::MMUWrite(cpuContext, ppeState, reinterpret_cast<const u8*>(&dataBS), EA, sizeof(T));
+  return true;
+}
+
+// Stores an aligned 16 byte vector. A single range access, as it never crosses a page.
+static inline void vxuStoreVector(sPPEState *ppeState, u64 EA, Vector128 vector) {
+  Base::ByteSwap::SwapLane32(vector.bytes.data());
+  PPCInterpreter::MMUWriteRange(ppeState, EA, vector.bytes.data(), sizeof(vector));
+}
+
 // Single-precision load floating-point instructions convert single-precision data to double-precision format
 // prior to loading the operands into the target FPR.
 // For double-precision floating-point load instructions, no conversion is required as the data from memory is 
@@ -135,8 +206,7 @@ void PPCInterpreter::PPCInterpreter_dcbz(sPPEState *ppeState) {
   EA = EA & ~(128 - 1); // Cache line size
 
   // Temporarily disable caching
-  for (u8 n = 0; n < 128; n += sizeof(u64))
-    MMUWrite64(ppeState, EA + n, 0);
+  MMUZeroRange(ppeState, EA, 128);
   return;
 
   // As far as I can tell, XCPU does all the crypto, scrambling of
@@ -315,26 +385,18 @@ void PPCInterpreter::PPCInterpreter_stswi(sPPEState *ppeState) {
     n <- n - 1
   */
 
-  u64 EA = _instr.ra ? GPRi(ra) : 0;
-  u64 N = _instr.rb ? _instr.rb : 32;
+  const u64 EA = _instr.ra ? GPRi(ra) : 0;
+  const u64 N = _instr.rb ? _instr.rb : 32;
   u8 reg = _instr.rd;
 
-  while (N > 0) {
-    if (N > 3) {
-      MMUWrite32(ppeState, EA, static_cast<u32>(GPR(reg)));
-      EA += 4;
-      N -= 4;
-    } else {
-      u32 buf = static_cast<u32>(GPR(reg));
-      while (N > 0) {
-        N = N - 1;
-        MMUWrite8(ppeState, EA, (0xFF000000 & buf) >> 24);
-        buf <<= 8;
-        EA++;
-      }
-    }
+  // Gather the bytes from the registers and store them with a single range access
+  u8 buffer[32] = {};
+  for (u64 i = 0; i < N; i += 4) {
+    const u32 word = byteswap_be<u32>(static_cast<u32>(GPR(reg)));
+    memcpy(&buffer[i], &word, sizeof(word));
     reg = (reg + 1) % 32;
   }
+  MMUWriteRange(ppeState, EA, buffer, N);
 }
 
 //
@@ -384,7 +446,6 @@ void PPCInterpreter::PPCInterpreter_stwcx(sPPEState *ppeState) {
     CR0 <- 0b00 || 0b0 || XER[SO]
   */
   const u64 EA = _instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb);
-  u64 RA = EA & ~3;
   u32 CR = 0;
 
   // TODO: If address is not aligned by 4, then we must issue a trap.
@@ -392,25 +453,13 @@ void PPCInterpreter::PPCInterpreter_stwcx(sPPEState *ppeState) {
   if (curThread.SPR.XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
-  // Translate address
-  MMUTranslateAddress(&RA, ppeState, true);
+  const bool stored = ppcStoreConditional<u32>(ppeState, EA, static_cast<u32>(GPRi(rs)));
 
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-  if (curThread.ppuRes->valid) {
-    xenonContext->xenonRes.LockGuard([&] {
-      if (curThread.ppuRes->valid) {
-        if (curThread.ppuRes->reservedAddr == RA) {
-          MMUWrite32(ppeState, EA, static_cast<u32>(GPRi(rs)));
-          BSET(CR, 4, CR_BIT_EQ);
-        } else {
-          xenonContext->xenonRes.Decrement();
-          curThread.ppuRes->valid = false;
-        }
-      }
-    });
-  }
+  if (stored)
+    BSET(CR, 4, CR_BIT_EQ);
 
   ppcUpdateCR(ppeState, 0, CR);
 }
@@ -494,32 +543,20 @@ void PPCInterpreter::PPCInterpreter_stdcx(sPPEState *ppeState) {
     CR0 <- 0b00 || 0b0 || XER[SO]
   */
   const u64 EA = _instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb);
-  u64 RA = EA & ~7;
   u32 CR = 0;
 
   if (curThread.SPR.XER.SO)
     BSET(CR, 4, CR_BIT_SO);
 
-  // TODO: If the address is not aligned by 4, then we must issue a trap.
+  // TODO: If the address is not aligned by 8, then we must issue a trap.
 
-  MMUTranslateAddress(&RA, ppeState, true);
+  const bool stored = ppcStoreConditional<u64>(ppeState, EA, GPRi(rd));
 
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-  if (curThread.ppuRes->valid) {
-    xenonContext->xenonRes.LockGuard([&] {
-      if (curThread.ppuRes->valid) {
-        if (curThread.ppuRes->reservedAddr == RA) {
-          MMUWrite64(ppeState, EA, GPRi(rd));
-          BSET(CR, 4, CR_BIT_EQ);
-        } else {
-          xenonContext->xenonRes.Decrement();
-          curThread.ppuRes->valid = false;
-        }
-      }
-    });
-  }
+  if (stored)
+    BSET(CR, 4, CR_BIT_EQ);
 
   ppcUpdateCR(ppeState, 0, CR);
 }
@@ -742,10 +779,7 @@ void PPCInterpreter::PPCInterpreter_stvx(sPPEState *ppeState) {
 
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  MMUWrite32(ppeState, EA, VRi(vs).dword[0]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 1), VRi(vs).dword[1]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 2), VRi(vs).dword[2]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 3), VRi(vs).dword[3]);
+  vxuStoreVector(ppeState, EA, VRi(vs));
 }
 
 // Store Vector Indexed 128
@@ -754,10 +788,7 @@ void PPCInterpreter::PPCInterpreter_stvx128(sPPEState *ppeState) {
 
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  MMUWrite32(ppeState, EA, VR(VMX128_1_VD128).dword[0]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 1), VR(VMX128_1_VD128).dword[1]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 2), VR(VMX128_1_VD128).dword[2]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 3), VR(VMX128_1_VD128).dword[3]);
+  vxuStoreVector(ppeState, EA, VR(VMX128_1_VD128));
 }
 
 // Store Vector Element Word Indexed (x'7C00 018E')
@@ -805,15 +836,10 @@ void PPCInterpreter::PPCInterpreter_stvrx(sPPEState *ppeState) {
 
   // Need to byteswap the bytes prior to the operation because of endianness.
   Vector128 vec = VRi(vs);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   auto bytes = vec.bytes;
-  for (u32 i = 0; i < eb; ++i) {
-    MMUWrite8(ppeState, EA + i, bytes[(16 - eb) + i]);
-  }
+  MMUWriteRange(ppeState, EA, bytes.data() + (16 - eb), eb);
 }
 
 // Store Vector Right Indexed 128
@@ -831,15 +857,10 @@ void PPCInterpreter::PPCInterpreter_stvrx128(sPPEState *ppeState) {
 
   // Need to byteswap the bytes prior to the operation because of endianness.
   Vector128 vec = VR(VMX128_1_VD128);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   auto bytes = vec.bytes;
-  for (u32 i = 0; i < eb; ++i) {
-    MMUWrite8(ppeState, EA + i, bytes[(16 - eb) + i]);
-  }
+  MMUWriteRange(ppeState, EA, bytes.data() + (16 - eb), eb);
 }
 
 // Store Vector Left Indexed
@@ -851,15 +872,10 @@ void PPCInterpreter::PPCInterpreter_stvlx(sPPEState *ppeState) {
 
   // Need to byteswap the bytes prior to the operation because of endianness.
   Vector128 vec = VRi(vs);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   auto bytes = vec.bytes;
-  for (int i = 0; i < 16 - eb; ++i) {
-    MMUWrite8(ppeState, EA + i, bytes[i]);
-  }
+  MMUWriteRange(ppeState, EA, bytes.data(), 16 - eb);
 }
 
 // Store Vector Left Indexed 128
@@ -870,15 +886,10 @@ void PPCInterpreter::PPCInterpreter_stvlx128(sPPEState *ppeState) {
   const u8 eb = EA & 0xF;
 
   Vector128 vec = VR(VMX128_1_VD128);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   auto bytes = vec.bytes;
-  for (int i = 0; i < 16 - eb; ++i) {
-    MMUWrite8(ppeState, EA + i, bytes[i]);
-  }
+  MMUWriteRange(ppeState, EA, bytes.data(), 16 - eb);
 }
 
 // Store Vector Left Indexed LRU 128
@@ -889,15 +900,10 @@ void PPCInterpreter::PPCInterpreter_stvlxl128(sPPEState *ppeState) {
   const u8 eb = EA & 0xF;
 
   Vector128 vec = VR(VMX128_1_VD128);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   auto bytes = vec.bytes;
-  for (int i = 0; i < 16 - eb; ++i) {
-    MMUWrite8(ppeState, EA + i, bytes[i]);
-  }
+  MMUWriteRange(ppeState, EA, bytes.data(), 16 - eb);
 }
 
 // Store Vector Indexed LRU (x'7C00 03CE')
@@ -915,10 +921,7 @@ void PPCInterpreter::PPCInterpreter_stvxl(sPPEState *ppeState) {
 
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  MMUWrite32(ppeState, EA, VRi(vs).dword[0]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 1), VRi(vs).dword[1]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 2), VRi(vs).dword[2]);
-  MMUWrite32(ppeState, EA + (sizeof(u32) * 3), VRi(vs).dword[3]);
+  vxuStoreVector(ppeState, EA, VRi(vs));
 }
 
 //
@@ -1191,26 +1194,18 @@ void PPCInterpreter::PPCInterpreter_lswi(sPPEState *ppeState) {
     EA <- EA + 1
     n <- n - 1
   */
-  u64 EA = _instr.ra ? GPRi(ra) : 0;
-  u64 N = _instr.rb ? _instr.rb : 32;
+  const u64 EA = _instr.ra ? GPRi(ra) : 0;
+  const u64 N = _instr.rb ? _instr.rb : 32;
   u8 reg = _instr.rd;
 
-  while (N > 0) {
-    if (N > 3) {
-      GPR(reg) = MMURead32(ppeState, EA);
-      EA += 4;
-      N -= 4;
-    } else {
-      u32 buf = 0;
-      u32 i = 3;
-      while (N > 0) {
-        N = N - 1;
-        buf |= MMURead8(ppeState, EA) << (i * 8);
-        EA++;
-        i--;
-      }
-      GPR(reg) = buf;
-    }
+  // Load all the bytes with a single range access, then scatter them to the registers
+  u8 buffer[32] = {};
+  if (!MMUReadRange(ppeState, EA, buffer, N))
+    return;
+  for (u64 i = 0; i < N; i += 4) {
+    u32 word = 0;
+    memcpy(&word, &buffer[i], sizeof(word));
+    GPR(reg) = byteswap_be<u32>(word);
     reg = (reg + 1) % 32;
   }
 }
@@ -1247,25 +1242,17 @@ void PPCInterpreter::PPCInterpreter_lwarx(sPPEState *ppeState) {
   rD <- (32)0 || MEM(EA,4)
   */
   const u64 EA = _instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb);
-  u64 RA = EA & ~3;
 
   // TODO: If address is not aligned by 4, then we must issue a trap.
 
-  MMUTranslateAddress(&RA, ppeState, false);
-
-  if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
+  u32 data = 0;
+  if (!ppcLoadAndReserve<u32>(ppeState, EA, &data))
     return;
 
-  curThread.ppuRes->valid = true;
-  curThread.ppuRes->reservedAddr = RA;
-  xenonContext->xenonRes.Increment();
-
-  u32 data = MMURead32(ppeState, EA);
-
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-    GPRi(rd) = data;
+  GPRi(rd) = data;
 }
 
 // Load Word Algebraic Indexed (x'7C00 02AA')
@@ -1434,19 +1421,11 @@ void PPCInterpreter::PPCInterpreter_ldarx(sPPEState *ppeState) {
 
   // TODO: If the address is not aligned by 8 then we must issue a trap.
   const u64 EA = _instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb);
-  u64 RA = EA & ~7;
-
-  MMUTranslateAddress(&RA, ppeState, false);
 
-  if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
+  u64 data = 0;
+  if (!ppcLoadAndReserve<u64>(ppeState, EA, &data))
     return;
 
-  curThread.ppuRes->reservedAddr = RA;
-  curThread.ppuRes->valid = true;
-  xenonContext->xenonRes.Increment();
-
-  const u64 data = MMURead64(ppeState, EA);
-
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
@@ -1695,10 +1674,7 @@ void PPCInterpreter::PPCInterpreter_lvebx(sPPEState *ppeState) {
 
   Vector128 vector = {};
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvebx [EA = {:#x}, eb = {:#x} data = {:#x}]", (u32)EA, eb, data);
@@ -1728,10 +1704,7 @@ void PPCInterpreter::PPCInterpreter_lvehx(sPPEState *ppeState) {
 
   Vector128 vector = {};
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvehx [EA = {:#x}, eb = {:#x} data = {:#x}]", (u32)EA, eb, data);
@@ -1762,10 +1735,7 @@ void PPCInterpreter::PPCInterpreter_lvewx(sPPEState *ppeState) {
 
   Vector128 vector = {};
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvewx [EA = {:#x}, eb = {:#x} data = {:#x}]", (u32)EA, eb, data);
@@ -1785,10 +1755,7 @@ void PPCInterpreter::PPCInterpreter_lvewx128(sPPEState *ppeState) {
 
   Vector128 vector = {};
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvewx128 [EA = {:#x}, eb = {:#x} data = {:#x}]", (u32)EA, eb, data);
@@ -1816,10 +1783,7 @@ void PPCInterpreter::PPCInterpreter_lvx(sPPEState *ppeState) {
   Vector128 vector{};
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = _instr.vd;
@@ -1842,10 +1806,7 @@ void PPCInterpreter::PPCInterpreter_lvx128(sPPEState *ppeState) {
   Vector128 vector {};
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = VMX128_1_VD128;
@@ -1866,10 +1827,7 @@ void PPCInterpreter::PPCInterpreter_lvxl128(sPPEState *ppeState) {
   Vector128 vector{};
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = VMX128_1_VD128;
@@ -1899,10 +1857,7 @@ void PPCInterpreter::PPCInterpreter_lvxl(sPPEState *ppeState) {
   Vector128 vector{};
   const u64 EA = (_instr.ra ? GPRi(ra) + GPRi(rb) : GPRi(rb)) & ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = _instr.vd;
@@ -1934,10 +1889,7 @@ void PPCInterpreter::PPCInterpreter_lvlx(sPPEState *ppeState) {
   const u8 eb = EA & 0xF;
   EA &= ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvlx [EA {:#x}] Temp VR = [{:#x}, {:#x}, {:#x}, {:#x}]",
@@ -1947,10 +1899,7 @@ void PPCInterpreter::PPCInterpreter_lvlx(sPPEState *ppeState) {
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-  vector.dword[0] = byteswap_be<u32>(vector.dword[0]);
-  vector.dword[1] = byteswap_be<u32>(vector.dword[1]);
-  vector.dword[2] = byteswap_be<u32>(vector.dword[2]);
-  vector.dword[3] = byteswap_be<u32>(vector.dword[3]);
+  Base::ByteSwap::SwapLane32(vector.bytes.data());
 
   u8 i = 0;
   for (i = 0; i < 16 - eb; ++i)
@@ -1959,10 +1908,7 @@ void PPCInterpreter::PPCInterpreter_lvlx(sPPEState *ppeState) {
   while (i < 16)
     VRi(vd).bytes[i++] = 0;
 
-  VRi(vd).dword[0] = byteswap_be<u32>(VRi(vd).dword[0]);
-  VRi(vd).dword[1] = byteswap_be<u32>(VRi(vd).dword[1]);
-  VRi(vd).dword[2] = byteswap_be<u32>(VRi(vd).dword[2]);
-  VRi(vd).dword[3] = byteswap_be<u32>(VRi(vd).dword[3]);
+  Base::ByteSwap::SwapLane32(VRi(vd).bytes.data());
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = _instr.vd;
@@ -1981,10 +1927,7 @@ void PPCInterpreter::PPCInterpreter_lvlx128(sPPEState *ppeState) {
   const u8 eb = EA & 0xF;
   EA &= ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvlx128 [EA {:#x}] Temp VR = [{:#x}, {:#x}, {:#x}, {:#x}]",
@@ -1994,10 +1937,7 @@ void PPCInterpreter::PPCInterpreter_lvlx128(sPPEState *ppeState) {
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-  vector.dword[0] = byteswap_be<u32>(vector.dword[0]);
-  vector.dword[1] = byteswap_be<u32>(vector.dword[1]);
-  vector.dword[2] = byteswap_be<u32>(vector.dword[2]);
-  vector.dword[3] = byteswap_be<u32>(vector.dword[3]);
+  Base::ByteSwap::SwapLane32(vector.bytes.data());
 
   u8 i = 0;
   for (i = 0; i < 16 - eb; ++i)
@@ -2006,10 +1946,7 @@ void PPCInterpreter::PPCInterpreter_lvlx128(sPPEState *ppeState) {
   while (i < 16)
     VR(VMX128_1_VD128).bytes[i++] = 0;
 
-  VR(VMX128_1_VD128).dword[0] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[0]);
-  VR(VMX128_1_VD128).dword[1] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[1]);
-  VR(VMX128_1_VD128).dword[2] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[2]);
-  VR(VMX128_1_VD128).dword[3] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[3]);
+  Base::ByteSwap::SwapLane32(VR(VMX128_1_VD128).bytes.data());
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = VMX128_1_VD128;
@@ -2037,10 +1974,7 @@ void PPCInterpreter::PPCInterpreter_lvrx(sPPEState *ppeState) {
   const u8 eb = EA & 0xF;
   EA &= ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvrx [EA {:#x}] Temp VR = [{:#x}, {:#x}, {:#x}, {:#x}]",
@@ -2050,10 +1984,7 @@ void PPCInterpreter::PPCInterpreter_lvrx(sPPEState *ppeState) {
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-  vector.dword[0] = byteswap_be<u32>(vector.dword[0]);
-  vector.dword[1] = byteswap_be<u32>(vector.dword[1]);
-  vector.dword[2] = byteswap_be<u32>(vector.dword[2]);
-  vector.dword[3] = byteswap_be<u32>(vector.dword[3]);
+  Base::ByteSwap::SwapLane32(vector.bytes.data());
 
   u8 i = 0;
 
@@ -2067,10 +1998,7 @@ void PPCInterpreter::PPCInterpreter_lvrx(sPPEState *ppeState) {
     ++i;
   }
 
-  VRi(vd).dword[0] = byteswap_be<u32>(VRi(vd).dword[0]);
-  VRi(vd).dword[1] = byteswap_be<u32>(VRi(vd).dword[1]);
-  VRi(vd).dword[2] = byteswap_be<u32>(VRi(vd).dword[2]);
-  VRi(vd).dword[3] = byteswap_be<u32>(VRi(vd).dword[3]);
+  Base::ByteSwap::SwapLane32(VRi(vd).bytes.data());
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = _instr.vd;
@@ -2089,10 +2017,7 @@ void PPCInterpreter::PPCInterpreter_lvrx128(sPPEState *ppeState) {
   const u8 eb = EA & 0xF;
   EA &= ~0xF;
 
-  vector.dword[0] = MMURead32(ppeState, EA);
-  vector.dword[1] = MMURead32(ppeState, EA + (sizeof(u32) * 1));
-  vector.dword[2] = MMURead32(ppeState, EA + (sizeof(u32) * 2));
-  vector.dword[3] = MMURead32(ppeState, EA + (sizeof(u32) * 3));
+  vector = vxuLoadVector(ppeState, EA);
 
 #ifdef VXU_LOAD_DEBUG
   LOG_DEBUG(Xenon, "lvrx128 [EA {:#x}] Temp VR = [{:#x}, {:#x}, {:#x}, {:#x}]",
@@ -2102,10 +2027,7 @@ void PPCInterpreter::PPCInterpreter_lvrx128(sPPEState *ppeState) {
   if (_ex & ppuDataSegmentEx || _ex & ppuDataStorageEx)
     return;
 
-  vector.dword[0] = byteswap_be<u32>(vector.dword[0]);
-  vector.dword[1] = byteswap_be<u32>(vector.dword[1]);
-  vector.dword[2] = byteswap_be<u32>(vector.dword[2]);
-  vector.dword[3] = byteswap_be<u32>(vector.dword[3]);
+  Base::ByteSwap::SwapLane32(vector.bytes.data());
 
   u8 i = 0;
 
@@ -2119,10 +2041,7 @@ void PPCInterpreter::PPCInterpreter_lvrx128(sPPEState *ppeState) {
     ++i;
   }
 
-  VR(VMX128_1_VD128).dword[0] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[0]);
-  VR(VMX128_1_VD128).dword[1] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[1]);
-  VR(VMX128_1_VD128).dword[2] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[2]);
-  VR(VMX128_1_VD128).dword[3] = byteswap_be<u32>(VR(VMX128_1_VD128).dword[3]);
+  Base::ByteSwap::SwapLane32(VR(VMX128_1_VD128).bytes.data());
 
 #ifdef VXU_LOAD_DEBUG
   u8 vrd = VMX128_1_VD128;
@@ -161,8 +161,8 @@ void PPCInterpreter::PPCInterpreter_slbia(sPPEState *ppeState) {
     slbEntry.V = 0;
   }
   // Invalidate both ERAT's
-  curThread.iERAT.invalidateAll();
-  curThread.dERAT.invalidateAll();
+  curThread.iERAT.InvalidateAll();
+  curThread.dERAT.InvalidateAll();
 }
 
 // TLB Invalidate Entry Local
@@ -172,6 +172,8 @@ void PPCInterpreter::PPCInterpreter_tlbiel(sPPEState *ppeState) {
   const bool LP = (GPRi(rb) & 0x1000) >> 12;
   const bool invalSelector = (GPRi(rb) & 0x800) >> 11;
   const u8 p = mmuGetPageSize(ppeState, _instr.l10, LP);
+  // Both threads of the core update the TLB.
+  std::lock_guard<std::mutex> tlbLock(ppeState->sharedStateMutex);
 
   if (invalSelector) {
     // Index to one of the 256 rows of the tlb. Possible entire tlb
@@ -196,9 +198,11 @@ void PPCInterpreter::PPCInterpreter_tlbiel(sPPEState *ppeState) {
     ppeState->TLB.tlbSet3[rb_44_51].pte1 = 0;
 
     // Should only invalidate entries for a specific set of addresses.
-    // Invalidate both ERAT's *** BUG *** !!!
-    curThread.iERAT.invalidateAll();
-    curThread.dERAT.invalidateAll();
+    // The TLB is shared by both threads of the core, the other thread flushes its ERAT's once it sees the new
+    // generation. It may be running on another host thread.
+    curThread.iERAT.InvalidateAll();
+    curThread.dERAT.InvalidateAll();
+    ppeState->eratGeneration.fetch_add(1, std::memory_order_release);
 
     // Invalidate JIT blocks conservatively (full set invalidation).
     if (XeMain::GetCPU()) {
@@ -276,9 +280,11 @@ void PPCInterpreter::PPCInterpreter_tlbiel(sPPEState *ppeState) {
       }
     }
     // Should only invalidate entries for a specific set of addresses.
-    // Invalidate both ERAT's *** BUG *** !!!
-    curThread.iERAT.invalidateAll();
-    curThread.dERAT.invalidateAll();
+    // The TLB is shared by both threads of the core, the other thread flushes its ERAT's once it sees the new
+    // generation. It may be running on another host thread.
+    curThread.iERAT.InvalidateAll();
+    curThread.dERAT.InvalidateAll();
+    ppeState->eratGeneration.fetch_add(1, std::memory_order_release);
 
     // Invalidate JIT blocks that map to the page/rango afectado por RB/p
     if (XeMain::GetCPU()) {
@@ -326,10 +332,10 @@ void PPCInterpreter::PPCInterpreter_tlbie(sPPEState *ppeState) {
   if (Config::log.advanced)
     LOG_TRACE(Xenon, "tlbie, EA:0x{:X} | PageSize:{} | Full:0x{:X},{} | LP:{}", EA, p, fullPageSize, fullPageSize, LP ? "true" : "false");
 #endif
-  for (u64 i{}; i != fullPageSize; ++i) {
-    curThread.iERAT.invalidateElement(EA+i);
-    curThread.dERAT.invalidateElement(EA+i);
-  }
+  // tlbie is broadcast to every processor. Bumping the generation is the only invalidation, every thread (this one
+  // included) flushes its ERAT's once it sees it, as every lookup syncs with it first.
+  if (xenonContext)
+    xenonContext->eratGeneration.fetch_add(1, std::memory_order_release);
 
   // Invalidate JIT blocks that map to the page/rango afectado por RB/p
   if (XeMain::GetCPU()) {
@@ -462,6 +468,8 @@ void PPCInterpreter::mmuAddTlbEntry(sPPEState *ppeState) {
   LOG_TRACE(Xenon_MMU, "[TLB]: Adding entry: TLB Set: {:#d}, TLB Index: {:#x}, VPN: {:#x}, PTE VPN: {:#x}, PTE RPN: {:#x}",
     TS, TI, VPN, tlbVpn, tlbRpn);
 
+  // Both threads of the core update the TLB.
+  std::lock_guard<std::mutex> tlbLock(ppeState->sharedStateMutex);
   // TLB set to choose from
   // There are 4 sets of 256 entries each:
   switch (TS) {
@@ -528,6 +536,8 @@ bool PPCInterpreter::mmuSearchTlbEntry(sPPEState *ppeState, u64 *RPN, u64 VA, u8
     break;
   }
 
+  // The other thread of the core may be updating the TLB.
+  std::lock_guard<std::mutex> tlbLock(ppeState->sharedStateMutex);
   //
   // Compare each valid entry at specified index in the TLB with the VA.
   //
@@ -614,7 +624,7 @@ void PPCInterpreter::mmuReadString(sPPEState *ppeState, u64 stringAddress,
     maxLength = strLength + 1;
 
   stringBufferAddress = MMURead32(ppeState, stringAddress + 4);
-  MMURead(xenonContext, ppeState, stringBufferAddress, maxLength, reinterpret_cast<u8*>(string));
+  MMUReadRange(ppeState, stringBufferAddress, reinterpret_cast<u8*>(string), maxLength);
   string[maxLength - 1] = 0;
 }
 
@@ -687,8 +697,38 @@ u64 PPCInterpreter::mmuContructEndAddressFromSecEngAddr(u64 inputAddress,
 }
 
 // Main address translation mechanism used on the XCPU.
+// Halts the CPU and opens the debugger after a watchpoint was hit.
+static void mmuWatchpointHit() {
+  if (XeMain::GetCPU()) {
+    XeMain::GetCPU()->Halt(); // Halt the CPU
+    Config::imgui.debugWindow = true; // Open the debugger after halting
+  }
+}
+
+// Returns the host pointer for a translated page if it is backed by RAM, nullptr otherwise.
+// Pages that return nullptr must go through the SoC/RootBus path.
+static u8 *mmuGetRAMHostPage(u64 EA, u64 RA) {
+  Xe::XCPU::XenonContext *cpuContext = PPCInterpreter::xenonContext;
+  if (!cpuContext || !cpuContext->GetRAM())
+    return nullptr;
+  // The xboxkrnl accesses the IIC through 0x7FFFxxxx, see MMURead/MMUWrite.
+  if (((EA & 0x000000007FFF0000ULL) >> 16) == 0x7FFF)
+    return nullptr;
+  bool socAccess = false;
+  const u64 physAddr = PPCInterpreter::mmuContructEndAddressFromSecEngAddr(RA & ~0xFFFULL, &socAccess);
+  if (socAccess)
+    return nullptr;
+  // Watched pages must take the slow path
+  if (cpuContext->watchpoints.IsPageWatched(physAddr))
+    return nullptr;
+  RAM *ram = cpuContext->GetRAM();
+  if (physAddr < ram->GetStartAddress() || physAddr + 0x1000 > ram->GetStartAddress() + ram->GetSize())
+    return nullptr;
+  return ram->GetPointerToAddress(static_cast<u32>(physAddr));
+}
+
 bool PPCInterpreter::MMUTranslateAddress(u64 *EA, sPPEState *ppeState,
-                                         bool memWrite, ePPUThreadID thr) {
+                                         bool memWrite, ePPUThreadID thr, u8 **hostPtr) {
   // Every time the CPU does a load or store, it goes trough the MMU.
   // The MMU decides based on MSR, and some other regs if address translation
   // for Instr/Data is in Real Mode (EA = RA) or in Virtual Mode (Page
@@ -741,30 +781,25 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, sPPEState *ppeState,
   // pages can occupy several ERAT entries.All EA - to - RA mappings are kept in the ERAT including
   // both real - mode and virtual - mode addresses(that is, addresses accessed with MSR[IR] equal to
   // 0 or 1).
-  // TODO:
   // The ERATs identify each translation entry with some combination of the MSR[SF, IR, DR,
   // PR, and HV] bits, depending on whether the entry is in the I - ERAT or D - ERAT.This allows the
   // ERATs to distinguish between translations that are valid for the various modes of operation.
   // See IBM_CBE_Handbook_v1.1 Page 82.
+  Xe::XCPU::MMU::XenonERAT &erat = thread.instrFetch ? thread.iERAT : thread.dERAT;
+  const u8 eratContext = Xe::XCPU::MMU::XenonERAT::BuildContext(_msr.SF, _msr.IR, _msr.DR, _msr.PR, _msr.HV);
+
+  // Pick up invalidations done by other threads
+  if (xenonContext)
+    erat.Sync(mmuGetERATGeneration(ppeState));
 
   // Search ERAT's
-  if (thread.instrFetch) {
-    // iERAT
-    RA = thread.iERAT.getElement((*EA & ~0xFFF));
-    if (RA != -1) {
-      RA |= (*EA & 0xFFF);
-      *EA = RA;
-      return true;
-    }
-  }
-  else {
-    // dERAT
-    RA = thread.dERAT.getElement((*EA & ~0xFFF));
-    if (RA != -1) {
-      RA |= (*EA & 0xFFF);
-      *EA = RA;
-      return true;
-    }
+  u8 *hostPage = nullptr;
+  if (erat.Lookup(*EA, eratContext, &RA, &hostPage)) {
+    if (hostPtr)
+      *hostPtr = hostPage ? hostPage + (*EA & 0xFFF) : nullptr;
+    RA |= (*EA & 0xFFF);
+    *EA = RA;
+    return true;
   }
 
   // Holds whether the cpu thread issuing the fetch is running in Real or
@@ -1113,15 +1148,11 @@ bool PPCInterpreter::MMUTranslateAddress(u64 *EA, sPPEState *ppeState,
     QSET(RA, 0, 21, 0);
   }
 
-  // Save in ERAT's
-  if (thread.instrFetch) {
-    // iERAT
-    thread.iERAT.putElement((*EA & ~0xFFF), (RA & ~0xFFF));
-  }
-  else {
-    // dERAT
-    thread.dERAT.putElement((*EA & ~0xFFF), (RA & ~0xFFF));
-  }
+  // Save in ERAT's, along with the host pointer for RAM backed pages
+  hostPage = mmuGetRAMHostPage(*EA, RA);
+  erat.Insert(*EA, RA, eratContext, hostPage);
+  if (hostPtr)
+    *hostPtr = hostPage ? hostPage + (RA & 0xFFF) : nullptr;
 
   *EA = RA;
   return true;
@@ -1133,10 +1164,18 @@ void PPCInterpreter::MMURead(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppeS
   MICROPROFILE_SCOPEI("[Xe::PPCInterpreter]", "MMURead", MP_AUTO);
   sPPUThread &thread = ppeState->ppuThread[thr != ePPUThread_None ? thr : curThreadId];
   const u64 oldEA = EA;
-  if (!MMUTranslateAddress(&EA, ppeState, false, thr)) {
+  u8 *hostPtr = nullptr;
+  if (!MMUTranslateAddress(&EA, ppeState, false, thr, &hostPtr)) {
     memset(outData, 0, byteCount);
     return;
   }
+
+  // RAM backed page, read straight from host memory
+  if (hostPtr && (EA & 0xFFF) + byteCount <= 0x1000) {
+    memcpy(outData, hostPtr, byteCount);
+    return;
+  }
+
   bool socRead = false;
 
   EA = mmuContructEndAddressFromSecEngAddr(EA, &socRead);
@@ -1146,11 +1185,10 @@ void PPCInterpreter::MMURead(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppeS
   if (((oldEA & 0x000000007FFF0000ULL) >> 16) == 0x7FFF)
     socRead = true;
 
-  // Debugger halt
-  if (EA && EA == Config::debug.haltOnReadAddress && XeMain::GetCPU()) {
-    XeMain::GetCPU()->Halt(); // Halt the CPU
-    Config::imgui.debugWindow = true; // Open the debugger after halting
-  }
+  // Watchpoints
+  if (cpuContext->watchpoints.Any() &&
+      cpuContext->watchpoints.Check(EA, byteCount, thread.instrFetch ? Xe::XCPU::MMU::watchExec : Xe::XCPU::MMU::watchRead))
+    mmuWatchpointHit();
 
   // TODO: Investigate why FSB_CONFIG_RX_STATE needs these values to work
   switch (thread.CIA) {
@@ -1162,32 +1200,9 @@ void PPCInterpreter::MMURead(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppeS
   } break;
   }
 
-  // Handle SoC reads
-  if (socRead) {
-    // Check if the read is from the SROM
-    if (EA >= XE_SROM_ADDR && EA < XE_SROM_ADDR + XE_SROM_SIZE) {
-      const u32 sromAddr = static_cast<u32>(EA - XE_SROM_ADDR);
-      memcpy(outData, &cpuContext->SROM[sromAddr], byteCount);
-      return;
-    }
-    // Check if the read is from SRAM
-    else if (EA >= XE_SRAM_ADDR && EA < XE_SRAM_ADDR + XE_SRAM_SIZE) {
-      const u32 sramAddr = static_cast<u32>(EA - XE_SRAM_ADDR);
-      memcpy(outData, &cpuContext->SRAM[sramAddr], byteCount);
-      return;
-    }
-    // Integrated Interrupt Controller in real mode, used when the HV wants to
-    // start a CPUs IC
-    else if (EA >= XE_SOCINTS_BLOCK_START && EA <= XE_SOCINTS_BLOCK_START + XE_SOCINTS_BLOCK_SIZE) {
-      // Pass it onto our context INT struct.
-      cpuContext->HandleSOCRead(EA, outData, byteCount);
-      return;
-    }
-    // Try to handle the SoC read, may belong to one of the CPU SoC blocks.
-    else if (cpuContext->HandleSOCRead(EA, outData, byteCount)) {
-      return;
-    }
-  }
+  // Handle SoC reads, SROM/SRAM and the CPU SoC blocks are resolved through the SoC page map.
+  if (socRead && cpuContext->HandleSOCRead(EA, outData, byteCount))
+    return;
 
   // External read
   if (!xenonContext->GetRootBus()->Read(EA, outData, byteCount, socRead) && socRead) {
@@ -1201,13 +1216,21 @@ void PPCInterpreter::MMUWrite(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppe
                               const u8 *data, u64 EA, u64 byteCount, ePPUThreadID thr) {
   MICROPROFILE_SCOPEI("[Xe::PPCInterpreter]", "MMUWrite", MP_AUTO);
   const u64 oldEA = EA;
+  u8 *hostPtr = nullptr;
 
-  if (!MMUTranslateAddress(&EA, ppeState, true, thr))
+  if (!MMUTranslateAddress(&EA, ppeState, true, thr, &hostPtr))
     return;
 
   // Check if it's reserved
   cpuContext->xenonRes.Check(EA, (byteCount <= 4 ? true : false));
 
+  // RAM backed page, write straight to host memory
+  if (hostPtr && (EA & 0xFFF) + byteCount <= 0x1000) {
+    memcpy(hostPtr, data, byteCount);
+    cpuContext->GetRAM()->MarkDirtyHost(hostPtr, byteCount);
+    return;
+  }
+
   bool socWrite = false;
 
   EA = mmuContructEndAddressFromSecEngAddr(EA, &socWrite);
@@ -1217,45 +1240,24 @@ void PPCInterpreter::MMUWrite(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppe
   if (((oldEA & 0x000000007FFFF0000ULL) >> 16) == 0x7FFF)
     socWrite = true;
 
-  // Debugger halt
-  if (EA && EA == Config::debug.haltOnWriteAddress && XeMain::GetCPU()) {
-    XeMain::GetCPU()->Halt(); // Halt the CPU
-    Config::imgui.debugWindow = true; // Open the debugger after halting
-  }
+  // Watchpoints
+  if (cpuContext->watchpoints.Any() && cpuContext->watchpoints.Check(EA, byteCount, Xe::XCPU::MMU::watchWrite))
+    mmuWatchpointHit();
 
-  if (socWrite) {
 #ifdef DEBUG_BUILD
-    if (EA == 0x61010ULL) {
-      u64 postCode = *reinterpret_cast<const u64 *>(data);
-      std::string poseCodeStr = Xe::XCPU::POSTBUS::GET_POST(postCode);
-      PPU *PPU = XeMain::GetCPU()->GetPPU(ppeState->ppuID);
-      if (PPU->traceFile) {
-        fprintf(PPU->traceFile, "POST,0x%llx,%s\n", postCode, poseCodeStr.c_str());
-      }
-    }
-#endif
-    // Check if writing to SROM region.
-    if (EA >= XE_SROM_ADDR && EA < XE_SROM_ADDR + XE_SROM_SIZE) {
-      LOG_ERROR(Xenon_MMU, "Tried to write to XCPU SROM!");
-      return;
-    }
-    // Check if writing to internal SRAM.
-    else if (EA >= XE_SRAM_ADDR && EA < XE_SRAM_ADDR + XE_SRAM_SIZE) {
-      u32 sramAddr = static_cast<u32>(EA - XE_SRAM_ADDR);
-      memcpy(&cpuContext->SRAM[sramAddr], data, byteCount);
-      return;
-    }
-    // Integrated Interrupt Controller in real mode, used when the HV wants to
-    // start a CPUs IC.
-    else if (EA >= XE_SOCINTS_BLOCK_START && EA <= XE_SOCINTS_BLOCK_START + XE_SOCINTS_BLOCK_SIZE) {
-      cpuContext->HandleSOCWrite(EA, data, byteCount);
-      return;
-    }
-    // Try to handle the SoC write, may belong to one of the CPU SoC blocks.
-    else if (cpuContext->HandleSOCWrite(EA, data, byteCount)) {
-      return;
+  if (socWrite && EA == 0x61010ULL) {
+    u64 postCode = *reinterpret_cast<const u64 *>(data);
+    std::string poseCodeStr = Xe::XCPU::POSTBUS::GET_POST(postCode);
+    PPU *PPU = XeMain::GetCPU()->GetPPU(ppeState->ppuID);
+    if (PPU->traceFile) {
+      fprintf(PPU->traceFile, "POST,0x%llx,%s\n", postCode, poseCodeStr.c_str());
     }
   }
+#endif
+
+  // Handle SoC writes, SROM/SRAM and the CPU SoC blocks are resolved through the SoC page map.
+  if (socWrite && cpuContext->HandleSOCWrite(EA, data, byteCount))
+    return;
 
   // External write
   if (!xenonContext->GetRootBus()->Write(EA, data, byteCount, socWrite) && socWrite) {
@@ -1266,24 +1268,115 @@ void PPCInterpreter::MMUWrite(Xe::XCPU::XenonContext *cpuContext, sPPEState *ppe
   }
 }
 
+// Walks [EA, EA + size) one page at a time, translating every page only once.
+// pageFunc(offset, pageEA, hostPtr, chunkSize) is called for every page, hostPtr is nullptr when the page isn't
+// backed by RAM (or is watched), in which case the caller must use the MMIO path.
+// Returns false if a translation failed, the exception is left pending on the thread.
+template <typename T>
+static bool mmuWalkRange(sPPEState *ppeState, u64 EA, u64 size, bool memWrite, ePPUThreadID thr, T &&pageFunc) {
+  u64 offset = 0;
+  while (offset < size) {
+    const u64 pageEA = EA + offset;
+    const u64 chunkSize = std::min<u64>(size - offset, 0x1000 - (pageEA & 0xFFF));
+    u64 RA = pageEA;
+    u8 *hostPtr = nullptr;
+    if (!PPCInterpreter::MMUTranslateAddress(&RA, ppeState, memWrite, thr, &hostPtr))
+      return false;
+    if (hostPtr && memWrite)
+      PPCInterpreter::xenonContext->xenonRes.CheckRange(RA, chunkSize);
+    pageFunc(offset, pageEA, hostPtr, chunkSize);
+    offset += chunkSize;
+  }
+  return true;
+}
+
+// Reads a range of memory, translating once per page
+bool PPCInterpreter::MMUReadRange(sPPEState *ppeState, u64 EA, u8 *outData, u64 size, ePPUThreadID thr) {
+  MICROPROFILE_SCOPEI("[Xe::PPCInterpreter]", "MMUReadRange", MP_AUTO);
+  return mmuWalkRange(ppeState, EA, size, false, thr,
+    [&](u64 offset, u64 pageEA, u8 *hostPtr, u64 chunkSize) {
+      if (hostPtr)
+        memcpy(outData + offset, hostPtr, chunkSize);
+      else
+        MMURead(xenonContext, ppeState, pageEA, chunkSize, outData + offset, thr);
+    });
+}
+
+// Writes a range of memory, translating once per page
+bool PPCInterpreter::MMUWriteRange(sPPEState *ppeState, u64 EA, const u8 *data, u64 size, ePPUThreadID thr) {
+  MICROPROFILE_SCOPEI("[Xe::PPCInterpreter]", "MMUWriteRange", MP_AUTO);
+  return mmuWalkRange(ppeState, EA, size, true, thr,
+    [&](u64 offset, u64 pageEA, u8 *hostPtr, u64 chunkSize) {
+      if (hostPtr) {
+        memcpy(hostPtr, data + offset, chunkSize);
+        xenonContext->GetRAM()->MarkDirtyHost(hostPtr, chunkSize);
+      } else
+        MMUWrite(xenonContext, ppeState, data + offset, pageEA, chunkSize, thr);
+    });
+}
+
+// Zeroes a range of memory, translating once per page
+bool PPCInterpreter::MMUZeroRange(sPPEState *ppeState, u64 EA, u64 size, ePPUThreadID thr) {
+  MICROPROFILE_SCOPEI("[Xe::PPCInterpreter]", "MMUZeroRange", MP_AUTO);
+  return mmuWalkRange(ppeState, EA, size, true, thr,
+    [&](u64 offset, u64 pageEA, u8 *hostPtr, u64 chunkSize) {
+      if (hostPtr) {
+        memset(hostPtr, 0, chunkSize);
+        xenonContext->GetRAM()->MarkDirtyHost(hostPtr, chunkSize);
+      } else
+        MMUMemSet(ppeState, pageEA, 0, chunkSize, thr);
+    });
+}
+
 void PPCInterpreter::MMUMemCpyFromHost(sPPEState *ppeState,
                                        u64 EA, const void *source, u64 size, ePPUThreadID thr) {
-  MMUWrite(xenonContext, ppeState, reinterpret_cast<const u8*>(source), EA, size);
+  MMUWriteRange(ppeState, EA, reinterpret_cast<const u8*>(source), size, thr);
 }
 
 void PPCInterpreter::MMUMemCpy(sPPEState *ppeState,
                                u64 EA, u32 source, u64 size, ePPUThreadID thr) {
-  std::unique_ptr<u8[]> data = std::make_unique<STRIP_UNIQUE_ARR(data)>(size);
-  MMURead(xenonContext, ppeState, source, size, data.get(), thr);
-  MMUWrite(xenonContext, ppeState, data.get(), EA, size, thr);
-  data.reset();
+  MICROPROFILE_SCOPEI("[Xe::PPCInterpreter]", "MMUMemCpy", MP_AUTO);
+  // Copy in chunks that never cross a page on either side, so both translate once per chunk
+  u8 bounce[0x1000];
+  // Like memmove, when the destination overlaps the end of the source we go from the end, so no chunk reads bytes
+  // an earlier one already wrote
+  const bool backward = EA > source && EA < source + size;
+  u64 copied = 0;
+  while (copied < size) {
+    u64 offset = 0, chunkSize = 0;
+    if (backward) {
+      const u64 end = size - copied;
+      chunkSize = std::min<u64>({ end, ((source + end - 1) & 0xFFF) + 1, ((EA + end - 1) & 0xFFF) + 1 });
+      offset = end - chunkSize;
+    } else {
+      offset = copied;
+      chunkSize = std::min<u64>({ size - offset, 0x1000 - ((source + offset) & 0xFFF), 0x1000 - ((EA + offset) & 0xFFF) });
+    }
+    const u64 srcEA = source + offset;
+    const u64 dstEA = EA + offset;
+    u64 srcRA = srcEA, dstRA = dstEA;
+    u8 *srcPtr = nullptr, *dstPtr = nullptr;
+    if (!MMUTranslateAddress(&srcRA, ppeState, false, thr, &srcPtr) ||
+        !MMUTranslateAddress(&dstRA, ppeState, true, thr, &dstPtr))
+      return;
+    if (srcPtr && dstPtr) {
+      xenonContext->xenonRes.CheckRange(dstRA, chunkSize);
+      memmove(dstPtr, srcPtr, chunkSize);
+      xenonContext->GetRAM()->MarkDirtyHost(dstPtr, chunkSize);
+    } else {
+      MMURead(xenonContext, ppeState, srcEA, chunkSize, bounce, thr);
+      MMUWrite(xenonContext, ppeState, bounce, dstEA, chunkSize, thr);
+    }
+    copied += chunkSize;
+  }
 }
 
 void PPCInterpreter::MMUMemSet(sPPEState *ppeState,
                                u64 EA, s32 data, u64 size, ePPUThreadID thr) {
   const u64 oldEA = EA;
+  u8 *hostPtr = nullptr;
 
-  if (MMUTranslateAddress(&EA, ppeState, true, thr) == false)
+  if (MMUTranslateAddress(&EA, ppeState, true, thr, &hostPtr) == false)
     return;
 
   if (!xenonContext)
@@ -1292,6 +1385,13 @@ void PPCInterpreter::MMUMemSet(sPPEState *ppeState,
   // Check if it's reserved
   xenonContext->xenonRes.Check(EA, (size <= 4 ? true : false));
 
+  // RAM backed page, set host memory directly
+  if (hostPtr && (EA & 0xFFF) + size <= 0x1000) {
+    memset(hostPtr, data, size);
+    xenonContext->GetRAM()->MarkDirtyHost(hostPtr, size);
+    return;
+  }
+
   bool socWrite = false;
 
   EA = mmuContructEndAddressFromSecEngAddr(EA, &socWrite);
@@ -1299,6 +1399,11 @@ void PPCInterpreter::MMUMemSet(sPPEState *ppeState,
   // so we use that address here to validate its an soc write
   if (((oldEA & 0x000000007FFFF0000ULL) >> 16) == 0x7FFF)
     socWrite = true;
+
+  // Watchpoints
+  if (xenonContext->watchpoints.Any() && xenonContext->watchpoints.Check(EA, size, Xe::XCPU::MMU::watchWrite))
+    mmuWatchpointHit();
+
   if (socWrite) {
     switch (EA) {
     default: {
@@ -1330,47 +1435,3 @@ void PPCInterpreter::MMUMemSet(sPPEState *ppeState,
 u8* PPCInterpreter::MMUGetPointerFromRAM(u64 EA) {
   return xenonContext->GetRAM()->GetPointerToAddress(EA);
 }
-
-// Reads 1 byte of memory
-u8 PPCInterpreter::MMURead8(sPPEState *ppeState, u64 EA, ePPUThreadID thr) {
-  u8 data = 0;
-  MMURead(xenonContext, ppeState, EA, sizeof(data), reinterpret_cast<u8*>(&data), thr);
-  return data;
-}
-// Reads 2 bytes of memory
-u16 PPCInterpreter::MMURead16(sPPEState *ppeState, u64 EA, ePPUThreadID thr) {
-  u16 data = 0;
-  MMURead(xenonContext, ppeState, EA, sizeof(data), reinterpret_cast<u8*>(&data), thr);
-  return byteswap_be<u16>(data);
-}
-// Reads 4 bytes of memory
-u32 PPCInterpreter::MMURead32(sPPEState *ppeState, u64 EA, ePPUThreadID thr) {
-  u32 data = 0;
-  MMURead(xenonContext, ppeState, EA, sizeof(data), reinterpret_cast<u8*>(&data), thr);
-  return byteswap_be<u32>(data);
-}
-// Reads 8 bytes of memory
-u64 PPCInterpreter::MMURead64(sPPEState *ppeState, u64 EA, ePPUThreadID thr) {
-  u64 data = 0;
-  MMURead(xenonContext, ppeState, EA, sizeof(data), reinterpret_cast<u8*>(&data), thr);
-  return byteswap_be<u64>(data);
-}
-// Writes 1 byte to memory
-void PPCInterpreter::MMUWrite8(sPPEState *ppeState, u64 EA, u8 data, ePPUThreadID thr) {
-  MMUWrite(xenonContext, ppeState, reinterpret_cast<const u8*>(&data), EA, sizeof(data), thr);
-}
-// Writes 2 bytes to memory
-void PPCInterpreter::MMUWrite16(sPPEState *ppeState, u64 EA, u16 data, ePPUThreadID thr) {
-  const u16 dataBS = byteswap_be<u16>(data);
-  MMUWrite(xenonContext, ppeState, reinterpret_cast<const u8*>(&dataBS), EA, sizeof(data), thr);
-}
-// Writes 4 bytes to memory
-void PPCInterpreter::MMUWrite32(sPPEState *ppeState, u64 EA, u32 data, ePPUThreadID thr) {
-  const u32 dataBS = byteswap_be<u32>(data);
-  MMUWrite(xenonContext, ppeState, reinterpret_cast<const u8*>(&dataBS), EA, sizeof(data), thr);
-}
-// Writes 8 bytes to memory
-void PPCInterpreter::MMUWrite64(sPPEState *ppeState, u64 EA, u64 data, ePPUThreadID thr) {
-  const u64 dataBS = byteswap_be<u64>(data);
-  MMUWrite(xenonContext, ppeState, reinterpret_cast<const u8*>(&dataBS), EA, sizeof(data), thr);
-}
@@ -2,6 +2,7 @@
 /* Copyright 2025 Xenon Emulator Project. All rights reserved. */
 /***************************************************************/
 
+#include <atomic>
 #include <unordered_map>
 
 #include "Base/Logging/Log.h"
@@ -158,7 +159,7 @@ void PPCInterpreter::PPCInterpreter_sc(sPPEState *ppeState) {
   curThread.exHVSysCall = _instr.lev & 1;
 #ifdef SYSCALL_DEBUG
   if (curThread.GPR[0] != 0) { // Don't want to ouput every time that HvxGetVersions is called.
-    LOG_DEBUG(Xenon, "{}(Thread{:#d}): Issuing Syscall {}", ppeState->ppuName, (u8)ppeState->currentThread,
+    LOG_DEBUG(Xenon, "{}(Thread{:#d}): Issuing Syscall {}", ppeState->ppuName, (u8)curThreadId,
       getSyscallNameFromIndex17489(curThread.GPR[0]));
   }
 #endif // SYSCALL_DEBUG
@@ -211,10 +212,9 @@ void PPCInterpreter::PPCInterpreter_slbie(sPPEState *ppeState) {
     }
   }
 
-  // Should only invalidate entries for a specific set of addresses.
-  // Invalidate both ERAT's *** BUG *** !!!
-  curThread.iERAT.invalidateAll();
-  curThread.dERAT.invalidateAll();
+  // A segment spans 256MB, which is far bigger than what the ERAT's can hold, so invalidate both of them.
+  curThread.iERAT.InvalidateAll();
+  curThread.dERAT.InvalidateAll();
 }
 
 // Return From Interrupt Doubleword
@@ -302,6 +302,29 @@ void PPCInterpreter::PPCInterpreter_tdi(sPPEState *ppeState) {
   }
 }
 
+// Sets the priority of the current thread. Problem state changes need TSCR[UCP], high priority needs the
+// hypervisor or TSCR[PSCTP].
+// Dropping to low priority is how guest code spin-waits, so whether or not the change is allowed the thread
+// ends its slice, see PPU::PPUSpinBackoff.
+void PPCInterpreter::ppcSetThreadPriority(sPPEState *ppeState, u8 priority) {
+  if (priority == ePPUThreadPriority_Disabled || priority > ePPUThreadPriority_High)
+    return;
+  const uMSR msr = curThread.SPR.MSR;
+  bool allowed = true;
+  if (!msr.HV) {
+    if (msr.PR)
+      allowed = ppeState->SPR.TSCR.UCP && priority != ePPUThreadPriority_High;
+    else
+      allowed = priority != ePPUThreadPriority_High || ppeState->SPR.TSCR.PSCTP;
+  }
+  if (allowed)
+    curThread.SPR.TSRL.TP = priority;
+  if (priority == ePPUThreadPriority_Low)
+    curThread.yieldRequested = Config::xcpu.smtHints;
+  else
+    curThread.spinSlices = 0;
+}
+
 // Move From Special Purpose Register
 void PPCInterpreter::PPCInterpreter_mfspr(sPPEState *ppeState) {
   u32 spr = _instr.spr;
@@ -324,7 +347,7 @@ void PPCInterpreter::PPCInterpreter_mfspr(sPPEState *ppeState) {
     GPRi(rs) = curThread.SPR.DAR;
     break;
   case eXenonSPR::DEC:
-    GPRi(rs) = curThread.SPR.DEC;
+    GPRi(rs) = std::atomic_ref<DEC_t>(curThread.SPR.DEC).load(std::memory_order_relaxed);
     break;
   case eXenonSPR::HDEC:
     GPRi(rs) = ppeState->SPR.HDEC;
@@ -342,7 +365,7 @@ void PPCInterpreter::PPCInterpreter_mfspr(sPPEState *ppeState) {
     GPRi(rs) = curThread.SPR.CFAR;
     break;
   case eXenonSPR::CTRLRD:
-    GPRi(rs) = ppeState->SPR.CTRL.hexValue;
+    GPRi(rs) = ppeState->LoadCTRL().hexValue;
     break;
   case eXenonSPR::VRSAVE:
     GPRi(rs) = curThread.SPR.VRSAVE;
@@ -387,6 +410,12 @@ void PPCInterpreter::PPCInterpreter_mfspr(sPPEState *ppeState) {
   case eXenonSPR::TSCR:
     GPRi(rs) = ppeState->SPR.TSCR.hexValue;
     break;
+  case eXenonSPR::TSRL:
+    GPRi(rs) = curThread.SPR.TSRL.hexValue;
+    break;
+  case eXenonSPR::TSRR:
+    GPRi(rs) = ppeState->ppuThread[curThreadId == ePPUThread_Zero ? ePPUThread_One : ePPUThread_Zero].SPR.TSRL.hexValue;
+    break;
   case eXenonSPR::TTR:
     GPRi(rs) = ppeState->SPR.TTR.hexValue;
     break;
@@ -441,7 +470,8 @@ void PPCInterpreter::PPCInterpreter_mtspr(sPPEState *ppeState) {
     curThread.SPR.DAR = GPRi(rd);
     break;
   case eXenonSPR::DEC:
-    curThread.SPR.DEC = static_cast<u32>(GPRi(rd));
+    // The timebase updater may be decrementing it from another host thread.
+    std::atomic_ref<DEC_t>(curThread.SPR.DEC).store(static_cast<DEC_t>(GPRi(rd)), std::memory_order_relaxed);
     break;
   case eXenonSPR::SDR1:
     ppeState->SPR.SDR1.hexValue = GPRi(rd);
@@ -458,7 +488,9 @@ void PPCInterpreter::PPCInterpreter_mtspr(sPPEState *ppeState) {
   case eXenonSPR::CTRLWR: {
     uCTRL newCTRL;
     newCTRL.hexValue = static_cast<u32>(GPRi(rd));
-    if (ppeState->currentThread == ePPUThread_Zero) {
+    // Both threads of the core update CTRL.
+    std::lock_guard<std::mutex> ctrlLock(ppeState->sharedStateMutex);
+    if (curThreadId == ePPUThread_Zero) {
       // Thread Zero
       if (ppeState->SPR.CTRL.TE1) {
         // TE1 is set, do not modify it.
@@ -474,12 +506,17 @@ void PPCInterpreter::PPCInterpreter_mtspr(sPPEState *ppeState) {
 
     // TODO: Check this, reversing and docs suggests this is the correct behavior.
     // If a thread is being enabled, we must generate a reset interrupt on said thread.
-    if (ppeState->SPR.CTRL.TE0 == 0 && newCTRL.TE0) { ppeState->ppuThread[0].exceptReg |= ppuSystemResetEx; }
-    if (ppeState->SPR.CTRL.TE1 == 0 && newCTRL.TE1) { ppeState->ppuThread[1].exceptReg |= ppuSystemResetEx; }
+    if (ppeState->SPR.CTRL.TE0 == 0 && newCTRL.TE0) { ppeState->ppuThread[0].PostExceptions(ppuSystemResetEx); }
+    if (ppeState->SPR.CTRL.TE1 == 0 && newCTRL.TE1) { ppeState->ppuThread[1].PostExceptions(ppuSystemResetEx); }
 
-    LOG_TRACE(Xenon, "{} (Thread{:#d}): Setting ctrl to {:#x}", ppeState->ppuName, (u8)ppeState->currentThread, newCTRL.hexValue);
+    LOG_TRACE(Xenon, "{} (Thread{:#d}): Setting ctrl to {:#x}", ppeState->ppuName, (u8)curThreadId, newCTRL.hexValue);
 
-    ppeState->SPR.CTRL = newCTRL;
+    ppeState->StoreCTRL(newCTRL);
+    // With parallel SMT the other thread has a host thread of its own, parked while it's disabled.
+    if (ppeState->parallelSMT) {
+      const ePPUThreadID otherThread = curThreadId == ePPUThread_Zero ? ePPUThread_One : ePPUThread_Zero;
+      xenonContext->iic.wakeThread(static_cast<u8>(ppeState->ppuThread[otherThread].SPR.PIR));
+    }
     break;
   }
   case eXenonSPR::VRSAVE:
@@ -527,6 +564,12 @@ void PPCInterpreter::PPCInterpreter_mtspr(sPPEState *ppeState) {
   case eXenonSPR::TSCR:
     ppeState->SPR.TSCR.hexValue = static_cast<u32>(GPRi(rd));
     break;
+  case eXenonSPR::TSRL: {
+    // Only the priority is writable
+    uTSR newTSR;
+    newTSR.hexValue = GPRi(rd);
+    ppcSetThreadPriority(ppeState, static_cast<u8>(newTSR.TP));
+  } break;
   case eXenonSPR::TTR:
     ppeState->SPR.TTR.hexValue = GPRi(rd);
     break;
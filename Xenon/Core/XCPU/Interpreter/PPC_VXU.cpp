@@ -4,6 +4,7 @@
 
 #include <cmath>
 
+#include "Base/ByteSwap.h"
 #include "PPCInterpreter.h"
 
 // Data Stream Touch for Store
@@ -896,10 +897,8 @@ void PPCInterpreter::PPCInterpreter_vperm(sPPEState *ppeState) {
     vector.bytes[idx] = vpermHelper(reIndex[bytes[reIndex[idx]]], VRi(va), VRi(rb));
   }
 
-  VRi(vd).dword[0] = byteswap_be<u32>(vector.dword[0]);
-  VRi(vd).dword[1] = byteswap_be<u32>(vector.dword[1]);
-  VRi(vd).dword[2] = byteswap_be<u32>(vector.dword[2]);
-  VRi(vd).dword[3] = byteswap_be<u32>(vector.dword[3]);
+  VRi(vd) = vector;
+  Base::ByteSwap::SwapLane32(VRi(vd).bytes.data());
 }
 
 // Vector128 Permute
@@ -919,10 +918,8 @@ void PPCInterpreter::PPCInterpreter_vperm128(sPPEState *ppeState) {
     vector.bytes[idx] = vpermHelper(reIndex[bytes[reIndex[idx]]], VR(VMX128_2_VA128), VR(VMX128_2_VB128));
   }
 
-  VR(VMX128_2_VD128).dword[0] = byteswap_be<u32>(vector.dword[0]);
-  VR(VMX128_2_VD128).dword[1] = byteswap_be<u32>(vector.dword[1]);
-  VR(VMX128_2_VD128).dword[2] = byteswap_be<u32>(vector.dword[2]);
-  VR(VMX128_2_VD128).dword[3] = byteswap_be<u32>(vector.dword[3]);
+  VR(VMX128_2_VD128) = vector;
+  Base::ByteSwap::SwapLane32(VR(VMX128_2_VD128).bytes.data());
 }
 
 // Vector128 Permutate Word Immediate
@@ -1140,19 +1137,13 @@ void PPCInterpreter::PPCInterpreter_vslo(sPPEState* ppeState) {
 
   // Need to byteswap becuase of byte endianness.
   Base::Vector128 vec = VRi(va);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   for (u8 idx = 0; idx < 16; ++idx) {
     VRi(vd).bytes[idx] = (idx + shift < 16) ? vec.bytes[idx + shift] : 0;
   }
 
-  VRi(vd).dword[0] = byteswap_be<u32>(VRi(vd).dword[0]);
-  VRi(vd).dword[1] = byteswap_be<u32>(VRi(vd).dword[1]);
-  VRi(vd).dword[2] = byteswap_be<u32>(VRi(vd).dword[2]);
-  VRi(vd).dword[3] = byteswap_be<u32>(VRi(vd).dword[3]);
+  Base::ByteSwap::SwapLane32(VRi(vd).bytes.data());
 }
 
 // Vector Multiply Add Floating Point (x'1000 002E')
@@ -1354,24 +1345,15 @@ void PPCInterpreter::PPCInterpreter_vsldoi(sPPEState *ppeState) {
 
   // NOTE: Checked against Xenia's tests.
 
-  vra.dword[0] = byteswap_be<u32>(vra.dword[0]);
-  vra.dword[1] = byteswap_be<u32>(vra.dword[1]);
-  vra.dword[2] = byteswap_be<u32>(vra.dword[2]);
-  vra.dword[3] = byteswap_be<u32>(vra.dword[3]);
+  Base::ByteSwap::SwapLane32(vra.bytes.data());
 
-  vrb.dword[0] = byteswap_be<u32>(vrb.dword[0]);
-  vrb.dword[1] = byteswap_be<u32>(vrb.dword[1]);
-  vrb.dword[2] = byteswap_be<u32>(vrb.dword[2]);
-  vrb.dword[3] = byteswap_be<u32>(vrb.dword[3]);
+  Base::ByteSwap::SwapLane32(vrb.bytes.data());
 
   for (u8 idx = 0; idx < 16; idx++) {
     VRi(vd).bytes[idx] = vsldoiHelper(sh + idx, vra, vrb);
   }
 
-  VRi(vd).dword[0] = byteswap_be<u32>(VRi(vd).dword[0]);
-  VRi(vd).dword[1] = byteswap_be<u32>(VRi(vd).dword[1]);
-  VRi(vd).dword[2] = byteswap_be<u32>(VRi(vd).dword[2]);
-  VRi(vd).dword[3] = byteswap_be<u32>(VRi(vd).dword[3]);
+  Base::ByteSwap::SwapLane32(VRi(vd).bytes.data());
 #endif
 }
 
@@ -1410,24 +1392,15 @@ void PPCInterpreter::PPCInterpreter_vsldoi128(sPPEState *ppeState) {
 
   // NOTE: Checked against Xenia's tests.
 
-  vra.dword[0] = byteswap_be<u32>(vra.dword[0]);
-  vra.dword[1] = byteswap_be<u32>(vra.dword[1]);
-  vra.dword[2] = byteswap_be<u32>(vra.dword[2]);
-  vra.dword[3] = byteswap_be<u32>(vra.dword[3]);
+  Base::ByteSwap::SwapLane32(vra.bytes.data());
 
-  vrb.dword[0] = byteswap_be<u32>(vrb.dword[0]);
-  vrb.dword[1] = byteswap_be<u32>(vrb.dword[1]);
-  vrb.dword[2] = byteswap_be<u32>(vrb.dword[2]);
-  vrb.dword[3] = byteswap_be<u32>(vrb.dword[3]);
+  Base::ByteSwap::SwapLane32(vrb.bytes.data());
 
   for (u8 idx = 0; idx < 16; idx++) {
     VR(VMX128_5_VD128).bytes[idx] = vsldoiHelper(sh + idx, vra, vrb);
   }
 
-  VR(VMX128_5_VD128).dword[0] = byteswap_be<u32>(VR(VMX128_5_VD128).dword[0]);
-  VR(VMX128_5_VD128).dword[1] = byteswap_be<u32>(VR(VMX128_5_VD128).dword[1]);
-  VR(VMX128_5_VD128).dword[2] = byteswap_be<u32>(VR(VMX128_5_VD128).dword[2]);
-  VR(VMX128_5_VD128).dword[3] = byteswap_be<u32>(VR(VMX128_5_VD128).dword[3]);
+  Base::ByteSwap::SwapLane32(VR(VMX128_5_VD128).bytes.data());
 #endif
 }
 
@@ -1437,10 +1410,7 @@ void PPCInterpreter::PPCInterpreter_vspltb(sPPEState *ppeState) {
 
   // Need to byteswap becuase of byte endianness.
   Base::Vector128 vec = VRi(vb);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   const u8 uimm = _instr.vuimm;
 
@@ -1453,10 +1423,7 @@ void PPCInterpreter::PPCInterpreter_vspltb(sPPEState *ppeState) {
 void PPCInterpreter::PPCInterpreter_vsplth(sPPEState* ppeState) {
   // Need to byteswap becuase of byte endianness.
   Base::Vector128 vec = VRi(vb);
-  vec.dword[0] = byteswap_be<u32>(vec.dword[0]);
-  vec.dword[1] = byteswap_be<u32>(vec.dword[1]);
-  vec.dword[2] = byteswap_be<u32>(vec.dword[2]);
-  vec.dword[3] = byteswap_be<u32>(vec.dword[3]);
+  Base::ByteSwap::SwapLane32(vec.bytes.data());
 
   const u8 uimm = _instr.vuimm;
 
@@ -1464,10 +1431,7 @@ void PPCInterpreter::PPCInterpreter_vsplth(sPPEState* ppeState) {
     VRi(vd).word[idx] = vec.word[uimm];
   }
 
-  VRi(vd).dword[0] = byteswap_be<u32>(VRi(vd).dword[0]);
-  VRi(vd).dword[1] = byteswap_be<u32>(VRi(vd).dword[1]);
-  VRi(vd).dword[2] = byteswap_be<u32>(VRi(vd).dword[2]);
-  VRi(vd).dword[3] = byteswap_be<u32>(VRi(vd).dword[3]);
+  Base::ByteSwap::SwapLane32(VRi(vd).bytes.data());
 }
 
 // Vector Splat Immediate Signed Halfword (x'1000 034C')
@@ -20,6 +20,10 @@
 void callHalt() {
   return XeMain::GetCPU()->Halt();
 }
+void callBreakpoint(PPU *ppu) {
+  if (ppu->PPUCheckBreakpoint())
+    callHalt();
+}
 
 // Constructor
 PPU_JIT::PPU_JIT(PPU *ppu) :
@@ -140,6 +144,21 @@ void PPU_JIT::InvalidateAllBlocks() {
   blockPageList.clear();
 }
 
+void PPU_JIT::InvalidateTranslatedBlocks() {
+  std::vector<u64> blocksToInvalidate;
+  {
+    std::lock_guard<std::mutex> lock(jitCacheMutex);
+    for (auto &[blockAddr, block] : jitBlocksCache) {
+      if (!block->realMode)
+        blocksToInvalidate.push_back(blockAddr);
+    }
+    for (u64 blockAddr : blocksToInvalidate)
+      jitBlocksCache.erase(blockAddr);
+  }
+  for (u64 blockAddr : blocksToInvalidate)
+    UnregisterBlock(blockAddr);
+}
+
 // Gets current sPPUThread and uses ppeState to get the current Thread pointer.
 void PPU_JIT::SetupContext(JITBlockBuilder *b) {
 #if defined(ARCH_X86) || defined(ARCH_X86_64)
@@ -152,33 +171,27 @@ void PPU_JIT::SetupContext(JITBlockBuilder *b) {
 }
 
 // JIT Instruction Prologue
-// * Checks for HALT at current address and calls it if it's enabled and address is a match
+// * If the instruction has a breakpoint, emits a stub that checks it (when halting is enabled)
 // * Updates instruction pointers (PIA,CIA,NIA) and instruction data
-void PPU_JIT::InstrPrologue(JITBlockBuilder *b, u32 instrData) {
+void PPU_JIT::InstrPrologue(JITBlockBuilder *b, u32 instrData, bool breakpoint) {
 #if defined(ARCH_X86) || defined(ARCH_X86_64)
   x86::Gp temp = newGP64();
-  Label continueLabel = COMP->newLabel();
 
-  // enableHalt
-  COMP->test(b->haltBool, b->haltBool);
-  COMP->je(continueLabel);
+  // Breakpoint stub, only present on instructions with a breakpoint
+  if (breakpoint) {
+    Label continueLabel = COMP->newLabel();
 
-  // ppuHaltOn != NULL
-  COMP->mov(temp, b->ppu->scalar(&PPU::ppuHaltOn));
-  COMP->test(temp, temp);
-  COMP->je(continueLabel);
+    // enableHalt
+    COMP->test(b->haltBool, b->haltBool);
+    COMP->je(continueLabel);
 
-  // ppuHaltOn == curThread.NIA - !guestHalt
-  COMP->cmp(temp, b->threadCtx->scalar(&sPPUThread::NIA));
-  COMP->jne(continueLabel);
-  COMP->cmp(b->ppu->scalar(&PPU::guestHalt).Ptr<u8>(), 0);
-  COMP->jne(continueLabel);
+    // Check the breakpoint conditions and call HALT if they match
+    InvokeNode *out = nullptr;
+    COMP->invoke(&out, imm((void*)callBreakpoint), FuncSignature::build<void, PPU *>());
+    out->setArg(0, b->ppu->Base());
 
-  // Call HALT
-  InvokeNode *out = nullptr;
-  COMP->invoke(&out, imm((void*)callHalt), FuncSignature::build<void>());
-
-  COMP->bind(continueLabel);
+    COMP->bind(continueLabel);
+  }
 
   // Update PIA, CIA, NIA and CI.
   // PIA = CIA:
@@ -245,10 +258,15 @@ std::shared_ptr<JITBlock> PPU_JIT::BuildJITBlock(u64 blockStartAddress, u64 maxB
   //
 
   u64 instrCount = 0;
+  const bool hleActive = Config::highlyExperimental.hleMemRoutines && ppu->xenonContext->hle.Enabled();
 
   while (XeRunning && !XePaused) {
     auto &thread = curThread;
 
+    // HLE'd routines must be entered from ExecuteJITInstrs, end the block before falling through into one
+    if (instrCount != 0 && hleActive && ppu->xenonContext->hle.IsHookAt(thread.NIA))
+      break;
+
     // Update previous instruction address
     thread.PIA = thread.CIA;
     // Update current instruction address
@@ -300,7 +318,7 @@ std::shared_ptr<JITBlock> PPU_JIT::BuildJITBlock(u64 blockStartAddress, u64 maxB
 
 
     // Setup our instruction prologue.
-    InstrPrologue(jitBuilder.get(), opcode);
+    InstrPrologue(jitBuilder.get(), opcode, ppu->xenonContext->breakpoints.IsBreakpointAt(thread.CIA));
 
     // Check for ocurred Instruction access exceptions.
     if (opcode == 0xFFFFFFFF || opcode == 0xCDCDCDCD || opcode == 0x00000000) {
@@ -424,6 +442,7 @@ std::shared_ptr<JITBlock> PPU_JIT::BuildJITBlock(u64 blockStartAddress, u64 maxB
   for (auto &instr : instrsTemp) {
     block->hash += instr;
   }
+  block->realMode = !curThread.SPR.MSR.DR || !curThread.SPR.MSR.IR;
 
   // Insert block into the block cache.
   {
@@ -446,8 +465,21 @@ u64 PPU_JIT::ExecuteJITBlock(u64 blockStartAddress, bool enableHalt) {
 }
 
 // Execute a given number of instructions using JIT.
-void PPU_JIT::ExecuteJITInstrs(u64 numInstrs, bool active, bool enableHalt, bool singleBlock) {
-  u32 instrsExecuted = 0;
+u64 PPU_JIT::ExecuteJITInstrs(u64 numInstrs, bool active, bool enableHalt, bool singleBlock) {
+  u64 instrsExecuted = 0;
+
+  Xe::XCPU::HLE::XenonHLE &hle = ppu->xenonContext->hle;
+  const bool hleActive = Config::highlyExperimental.hleMemRoutines && hle.Enabled();
+  const bool hleVerify = hleActive && Config::debug.hleVerify;
+  if (hleActive)
+    hle.CheckWrittenPages();
+
+  // Breakpoints changed, rebuild the blocks so stubs get added/removed
+  const u32 bpGeneration = ppu->xenonContext->breakpoints.GetGeneration();
+  if (bpGeneration != breakpointGeneration) {
+    breakpointGeneration = bpGeneration;
+    InvalidateAllBlocks();
+  }
   while (instrsExecuted < numInstrs && active && (XeRunning && !XePaused)) {
     auto &thread = curThread;
 
@@ -469,6 +501,18 @@ void PPU_JIT::ExecuteJITInstrs(u64 numInstrs, bool active, bool enableHalt, bool
     // Skip to next block if needed.
     if (skipBlock) { instrsExecuted++; thread.NIA += 4; }
 
+    // Run HLE'd routines natively, they return straight to the caller
+    if (hleActive) {
+      if (hleVerify)
+        hle.CheckVerification(ppeState);
+      if (!hle.IsPageScanned(thread.NIA))
+        hle.ScanPage(ppeState, thread.NIA);
+      if (hle.IsPageArmed(thread.NIA) && hle.Invoke(ppeState, thread.NIA)) {
+        instrsExecuted++;
+        continue;
+      }
+    }
+
     // Get next block start address.
     u64 blockStartAddress = thread.NIA;
     // Attempt to find such block in the block cache.
@@ -525,8 +569,10 @@ void PPU_JIT::ExecuteJITInstrs(u64 numInstrs, bool active, bool enableHalt, bool
       instrsExecuted += ExecuteJITBlock(blockStartAddress, enableHalt);
 
       // If the thread was suspended due to CTRL being written, we must end execution on said thread.
-      if (ppeState->currentThread == 0 && ppeState->SPR.CTRL.TE0 != true) { break; }
-      if (ppeState->currentThread == 1 && ppeState->SPR.CTRL.TE1 != true) { break; }
+      const uCTRL CTRL = ppeState->LoadCTRL();
+      if (ppeState->currentThread == 0 && CTRL.TE0 != true) { break; }
+      if (ppeState->currentThread == 1 && CTRL.TE1 != true) { break; }
     }
   }
+  return instrsExecuted;
 }
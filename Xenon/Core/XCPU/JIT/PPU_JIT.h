@@ -218,6 +218,8 @@ public:
   asmjit::JitRuntime *runtime = nullptr;
   // Hash of all opcodes
   u64 hash = 0;
+  // Built with translation off. These get checked against memory before running in real mode
+  bool realMode = false;
 };
 
 class PPU_JIT {
@@ -225,16 +227,19 @@ public:
   PPU_JIT(PPU *ppu);
   ~PPU_JIT();
 
-  void ExecuteJITInstrs(u64 numInstrs, bool active, bool enableHalt = true, bool singleBlock = false);
+  // Runs up to numInstrs instructions, returns how many were executed.
+  u64 ExecuteJITInstrs(u64 numInstrs, bool active, bool enableHalt = true, bool singleBlock = false);
   u64 ExecuteJITBlock(u64 blockStartAddress, bool enableHalt); // returns step count
   std::shared_ptr<JITBlock> BuildJITBlock(u64 blockStartAddress, u64 maxBlockSize);
   void SetupContext(JITBlockBuilder *b);
-  void InstrPrologue(JITBlockBuilder *b, u32 instrData);
+  void InstrPrologue(JITBlockBuilder *b, u32 instrData, bool breakpoint);
 
   // Page based indexing and iinvalidation methods.
   void InvalidateBlocksForRange(u64 startAddr, u64 endAddr);
   void InvalidateBlockAt(u64 blockAddr);
   void InvalidateAllBlocks();
+  // Drops the blocks built with translation on, on a soft reset. Real mode ones are checked before they run.
+  void InvalidateTranslatedBlocks();
 
 private:
   PPU *ppu = nullptr; // "Linked" PPU
@@ -249,6 +254,8 @@ private:
   std::unordered_map<u64, std::vector<u64>> blockPageList = {};
   // Mutex for thread safety.
   std::mutex jitCacheMutex;
+  // Last seen breakpoint generation, blocks are dropped when it changes.
+  u32 breakpointGeneration = 0;
   // Internal helpers for page based indexing.
   void RegisterBlockPages(u64 blockStart, u64 blockSize);
   void UnregisterBlock(u64 blockStart);
@@ -0,0 +1,121 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <array>
+
+#include "Base/Types.h"
+
+namespace Xe::XCPU::MMU {
+  // ERAT entry context bits.
+  // The ERATs identify each translation entry with some combination of the MSR[SF, IR, DR, PR, and HV] bits,
+  // this allows the ERATs to distinguish between translations that are valid for the various modes of operation.
+  // See IBM_CBE_Handbook_v1.1 Page 82.
+  enum eERATContext : u8 {
+    eratCtxSF = 1 << 0,
+    eratCtxIR = 1 << 1,
+    eratCtxDR = 1 << 2,
+    eratCtxPR = 1 << 3,
+    eratCtxHV = 1 << 4
+  };
+
+  // Effective to Real Address Translation cache.
+  // The hardware ERATs are 64 entry, 2 way. We use a larger direct-mapped table indexed by the EA page number, as
+  // a miss only costs us a walk through the SLB/TLB. Every entry holds the translation for an aligned 4KB area of
+  // memory, large pages occupy several entries.
+  // The table is only ever touched by the owning PPU thread, so no locking is done. Invalidations coming from
+  // other threads (tlbie) are done by bumping a shared generation counter, which the owner checks on lookup.
+  class XenonERAT {
+  public:
+    // Number of entries, must be a power of 2.
+    static constexpr u32 eratNumEntries = 512;
+
+    struct sERATEntry {
+      // Effective page address (EA & ~0xFFF).
+      u64 EA = 0;
+      // Real page address (RA & ~0xFFF).
+      u64 RA = 0;
+      // Host pointer to the start of the page when it's backed by RAM, nullptr for MMIO.
+      u8 *hostPage = nullptr;
+      // Epoch this entry was inserted in, entries from older epochs are stale.
+      u32 epoch = 0;
+      // MSR context the translation is valid for. See eERATContext.
+      u8 context = 0;
+    };
+
+    // Builds the ERAT context tag from the current MSR bits.
+    static constexpr u8 BuildContext(bool SF, bool IR, bool DR, bool PR, bool HV) {
+      return (SF ? eratCtxSF : 0) | (IR ? eratCtxIR : 0) | (DR ? eratCtxDR : 0) |
+             (PR ? eratCtxPR : 0) | (HV ? eratCtxHV : 0);
+    }
+
+    // Synchronizes with the shared invalidation generation counter, flushing everything if it changed.
+    void Sync(u32 globalGeneration) {
+      if (globalGeneration != seenGeneration) {
+        seenGeneration = globalGeneration;
+        InvalidateAll();
+      }
+    }
+
+    // Searches for a translation of the page containing EA. Returns true, the real page address and the host page
+    // pointer (if any) on a hit.
+    bool Lookup(u64 EA, u8 context, u64 *RA, u8 **hostPage = nullptr) const {
+      const sERATEntry &entry = entries[GetIndex(EA)];
+      if (entry.epoch == epoch && entry.context == context && entry.EA == (EA & ~0xFFFULL)) {
+        *RA = entry.RA;
+        if (hostPage)
+          *hostPage = entry.hostPage;
+        return true;
+      }
+      return false;
+    }
+
+    // Stores a translation, replacing whatever was in the same slot.
+    void Insert(u64 EA, u64 RA, u8 context, u8 *hostPage = nullptr) {
+      sERATEntry &entry = entries[GetIndex(EA)];
+      entry.EA = EA & ~0xFFFULL;
+      entry.RA = RA & ~0xFFFULL;
+      entry.hostPage = hostPage;
+      entry.epoch = epoch;
+      entry.context = context;
+    }
+
+    // Invalidates every entry that translates an EA inside [EA, EA + size).
+    void InvalidateRange(u64 EA, u64 size) {
+      const u64 start = EA & ~0xFFFULL;
+      const u64 end = EA + size;
+      // Large ranges cover the entire table anyways
+      if ((size >> 12) >= eratNumEntries) {
+        InvalidateAll();
+        return;
+      }
+      for (u64 page = start; page < end; page += 0x1000) {
+        sERATEntry &entry = entries[GetIndex(page)];
+        if (entry.EA == page)
+          entry.epoch = epoch - 1;
+      }
+    }
+
+    // Invalidates all entries. This only advances the epoch, unless it wraps around.
+    void InvalidateAll() {
+      if (++epoch == 0) {
+        entries.fill({});
+        epoch = 1;
+      }
+    }
+
+  private:
+    static constexpr u32 GetIndex(u64 EA) {
+      return static_cast<u32>(EA >> 12) & (eratNumEntries - 1);
+    }
+
+    // Current epoch, starts at 1 so zero-initialized entries are never valid.
+    u32 epoch = 1;
+    // Last seen value of the shared generation counter.
+    u32 seenGeneration = 0;
+    // Translation entries.
+    std::array<sERATEntry, eratNumEntries> entries{};
+  };
+}
@@ -0,0 +1,86 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#include <algorithm>
+
+#include "Base/Global.h"
+
+#include "XenonWatchpoints.h"
+
+namespace Xe::XCPU::MMU {
+
+u32 XenonWatchpoints::Add(u64 address, u64 size, u8 type) {
+  std::lock_guard lock(watchLock);
+  sWatchpoint watchpoint = {};
+  watchpoint.id = nextId++;
+  watchpoint.start = address;
+  watchpoint.end = address + (size ? size : 1);
+  watchpoint.type = type;
+  watchpoints.push_back(watchpoint);
+  LOG_INFO(Xenon_MMU, "Watchpoint {} added: [{:#x}, {:#x}) {}{}{}", watchpoint.id, watchpoint.start, watchpoint.end,
+    (type & watchRead) ? "R" : "", (type & watchWrite) ? "W" : "", (type & watchExec) ? "X" : "");
+  Rebuild();
+  return watchpoint.id;
+}
+
+bool XenonWatchpoints::Remove(u32 id) {
+  std::lock_guard lock(watchLock);
+  const auto it = std::find_if(watchpoints.begin(), watchpoints.end(),
+    [id](const sWatchpoint &watchpoint) { return watchpoint.id == id; });
+  if (it == watchpoints.end())
+    return false;
+  watchpoints.erase(it);
+  Rebuild();
+  return true;
+}
+
+void XenonWatchpoints::Clear() {
+  std::lock_guard lock(watchLock);
+  watchpoints.clear();
+  Rebuild();
+}
+
+std::vector<sWatchpoint> XenonWatchpoints::GetWatchpoints() {
+  std::lock_guard lock(watchLock);
+  return watchpoints;
+}
+
+bool XenonWatchpoints::Check(u64 RA, u64 size, u8 type) {
+  if (!Any())
+    return false;
+  // Range accesses can span many pages, a watchpoint may be on any of them
+  const u64 lastPage = (RA + size - 1) >> 12;
+  bool watched = false;
+  for (u64 page = RA >> 12; page <= lastPage && !watched; ++page)
+    watched = IsPageWatched(page << 12);
+  if (!watched)
+    return false;
+  std::lock_guard lock(watchLock);
+  for (const auto &watchpoint : watchpoints) {
+    if ((watchpoint.type & type) && RA < watchpoint.end && RA + size > watchpoint.start) {
+      LOG_INFO(Xenon_MMU, "Watchpoint {} hit: {} of {:#x} bytes at {:#x}", watchpoint.id,
+        type == watchWrite ? "write" : type == watchExec ? "exec" : "read", size, RA);
+      return true;
+    }
+  }
+  return false;
+}
+
+void XenonWatchpoints::Rebuild() {
+  for (auto &word : pageBitmap) {
+    word.store(0, std::memory_order_relaxed);
+  }
+  for (const auto &watchpoint : watchpoints) {
+    for (u64 page = watchpoint.start >> 12; page <= (watchpoint.end - 1) >> 12; ++page) {
+      const u64 index = page & (watchPageCount - 1);
+      pageBitmap[index >> 6].fetch_or(1ULL << (index & 63), std::memory_order_relaxed);
+    }
+  }
+  activeCount.store(static_cast<u32>(watchpoints.size()), std::memory_order_release);
+  // Drop cached host pointers, watched pages must go through the slow path
+  if (eratGeneration)
+    eratGeneration->fetch_add(1, std::memory_order_release);
+}
+
+}
@@ -0,0 +1,79 @@
+/***************************************************************/
+/* Copyright 2025 Xenon Emulator Project. All rights reserved. */
+/***************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include "Base/Types.h"
+
+namespace Xe::XCPU::MMU {
+  // Watchpoint access types.
+  enum eWatchType : u8 {
+    watchRead = 1 << 0,
+    watchWrite = 1 << 1,
+    watchExec = 1 << 2
+  };
+
+  struct sWatchpoint {
+    // Watchpoint ID, used for removal.
+    u32 id = 0;
+    // Watched real address range [start, end).
+    u64 start = 0;
+    u64 end = 0;
+    // Access types that trigger it. See eWatchType.
+    u8 type = 0;
+  };
+
+  // Data/Exec watchpoints.
+  // Watched pages are tracked in a bitmap, the MMU never caches host pointers for them in the ERATs. That way RAM
+  // accesses to watched pages miss the fast paths and reach the slow MMURead/MMUWrite routines, which are the only
+  // ones checking the watchpoint list. When no watchpoints are set, nothing is ever checked.
+  class XenonWatchpoints {
+  public:
+    // eratGeneration is bumped on every change, so that the PPU threads drop their cached host pointers.
+    XenonWatchpoints(std::atomic<u32> *eratGenerationPtr) : eratGeneration(eratGenerationPtr) {}
+
+    // Adds a watchpoint on the real address range [address, address + size). Returns its ID.
+    u32 Add(u64 address, u64 size, u8 type);
+    // Removes a watchpoint. Returns false if it didn't exist.
+    bool Remove(u32 id);
+    // Removes every watchpoint.
+    void Clear();
+    // Returns a copy of the current watchpoints.
+    std::vector<sWatchpoint> GetWatchpoints();
+
+    // Returns true if any watchpoint is set.
+    bool Any() const {
+      return activeCount.load(std::memory_order_acquire) != 0;
+    }
+    // Returns true if the page containing the given real address is watched.
+    bool IsPageWatched(u64 RA) const {
+      if (!Any())
+        return false;
+      const u64 page = (RA >> 12) & (watchPageCount - 1);
+      return pageBitmap[page >> 6].load(std::memory_order_relaxed) & (1ULL << (page & 63));
+    }
+    // Checks an access against the watchpoints. Returns true (and logs it) if it hit one.
+    bool Check(u64 RA, u64 size, u8 type);
+
+  private:
+    // Rebuilds the page bitmap from the current list and flushes the ERATs. Must hold watchLock.
+    void Rebuild();
+
+    // Number of tracked pages (32-bit real address space). Higher addresses wrap around, which at worst sends some
+    // accesses to the slow path.
+    static constexpr u64 watchPageCount = 1ULL << 20;
+
+    std::atomic<u32> *eratGeneration = nullptr;
+    std::atomic<u32> activeCount = 0;
+    std::array<std::atomic<u64>, watchPageCount / 64> pageBitmap{};
+    std::vector<sWatchpoint> watchpoints{};
+    std::mutex watchLock{};
+    u32 nextId = 1;
+  };
+}
@@ -11,11 +11,20 @@
 #include "Core/XeMain.h"
 #include "Base/Config.h"
 #include "Base/Thread.h"
+#include "Base/Topology.h"
 #include "Base/Logging/Log.h"
 #include "Core/XCPU/Interpreter/PPCInterpreter.h"
 #include "Core/XCPU/ElfABI.h"
 #include "Core/XCPU/JIT/PPU_JIT.h"
 
+// Longest a sleeping PPU blocks without rechecking its state, wakeups are signalled so this only bounds a missed one
+#define PPU_MAX_SLEEP 100ms
+// Spin-wait backoff. Slices a thread has to keep yielding before we yield the host thread, and then park it
+#define PPU_SPIN_YIELD_SLICES 16
+#define PPU_SPIN_PARK_SLICES 256
+// Longest a spinning thread is parked, whatever it waits on may be released by a write we don't see
+#define PPU_SPIN_PARK 50us
+
 PPU::PPU(Xe::XCPU::XenonContext *inXenonContext, u64 resetVector, u32 PIR) :
   resetVector(resetVector)
 {
@@ -77,23 +86,33 @@ PPU::PPU(Xe::XCPU::XenonContext *inXenonContext, u64 resetVector, u32 PIR) :
   // Asign global Xenon context
   xenonContext = inXenonContext;
 
+  if (Xe::XCPU::XenonScheduler *scheduler = xenonContext->scheduler) {
+    // Start counting guest time from now
+    lastTimeBase = scheduler->GetTimeBase();
+    // Register now rather than when our thread starts, so the turn order doesn't depend on host timing
+    scheduler->AddCPU(ppeState->ppuID);
+  }
+
   xenonMMU = std::make_unique<STRIP_UNIQUE(xenonMMU)>(xenonContext);
 
-  // If we have a specific halt address, set it here
-  ppuHaltOn = Config::debug.haltOnAddress;
+  // Parallel SMT. The JIT bakes the executing thread into its blocks, and turns are per PPU in deterministic mode
+  if (Config::xcpu.parallelSMT) {
+    if (currentExecMode != eExecutorMode::Interpreter)
+      LOG_WARNING(Xenon, "{}: Parallel SMT needs the interpreter, interleaving threads", ppeState->ppuName);
+    else if (xenonContext->scheduler && xenonContext->scheduler->IsDeterministic())
+      LOG_WARNING(Xenon, "{}: Parallel SMT is unavailable in deterministic mode, interleaving threads", ppeState->ppuName);
+    else
+      ppeState->parallelSMT = true;
+  }
 
   for (u8 thrdID = 0; thrdID < 2; thrdID++) {
     sPPUThread &thread = ppeState->ppuThread[static_cast<ePPUThreadID>(thrdID)];
     thread.ppuRes = std::make_unique<STRIP_UNIQUE(sPPUThread::ppuRes)>();
-    memset(thread.ppuRes.get(), 0, sizeof(PPU_RES));
     xenonContext->xenonRes.Register(thread.ppuRes.get());
 
     // Set the decrementer as per docs. See CBE Public Registers pdf in Docs
     thread.SPR.DEC = 0x7FFFFFFF;
-
-    // Resize ERATs
-    thread.iERAT.resizeCache(512);
-    thread.dERAT.resizeCache(512);
+    thread.SPR.TSRL.TP = ePPUThreadPriority_Medium;
   }
 
   // Set PVR and PIR
@@ -128,9 +147,15 @@ PPU::~PPU() {
   // Signal we're quitting
   ppuThreadState.store(eThreadState::Quiting);
   ppuThreadActive = false;
-  // Kill the thread
+  PPUWake();
+  // Release our thread if it's waiting for its turn
+  if (ppeState && xenonContext->scheduler)
+    xenonContext->scheduler->RemoveCPU(ppeState->ppuID);
+  // Kill the threads
   if (ppuThread.joinable())
     ppuThread.join();
+  if (ppuSecondaryThread.joinable())
+    ppuSecondaryThread.join();
   ppuJIT.reset();
   ppeState.reset();
 }
@@ -169,14 +194,24 @@ void PPU::StartExecution(bool setHRMOR) {
 
   // If we're PPU0,thread0 then enable THRD 0 and set Reset Vector.
   if (ppeState->ppuID == 0 && setHRMOR) {
-    ppeState->SPR.CTRL.TE0 = 1; // Enable Thread 0
+    {
+      std::lock_guard<std::mutex> ctrlLock(ppeState->sharedStateMutex);
+      uCTRL CTRL = ppeState->SPR.CTRL;
+      CTRL.TE0 = 1; // Enable Thread 0
+      ppeState->StoreCTRL(CTRL);
+    }
     ppeState->SPR.HRMOR.hexValue = 0x20000000000ULL;
     ppeState->ppuThread[ePPUThread_Zero].NIA = resetVector;
     // Also simulate 1BL if we're told to.
     if (Config::xcpu.simulate1BL) { Simulate1Bl(); }
   }
 
+  // What a soft reset goes back to
+  powerOnState.Capture(*this);
+
   ppuThread = std::thread(&PPU::ThreadLoop, this);
+  if (ppeState->parallelSMT)
+    ppuSecondaryThread = std::thread(&PPU::SecondaryThreadLoop, this);
 }
 
 void PPU::Reset() {
@@ -186,12 +221,28 @@ void PPU::Reset() {
 
   // Tell the thread to reset it
   ppuThreadResetting = true;
+  PPUWake();
+}
+
+void PPU::SoftReset() {
+  Base::StateReader reader = powerOnState.Reader();
+  LoadRegisters(reader);
+  // Guest time carries on from here, like for a new PPU
+  if (xenonContext->scheduler)
+    lastTimeBase = xenonContext->scheduler->GetTimeBase();
+  guestHalt = false;
+  ppuStepAmount = 0;
+  ppuSecondaryStepAmount = 0;
+  // Boot code runs in real mode, where cached blocks are checked against memory first. Unchanged 1BL and bootloader
+  // code doesn't have to be compiled again
+  if (ppuJIT)
+    ppuJIT->InvalidateTranslatedBlocks();
 }
 
 void PPU::Halt(u64 haltOn, bool requestedByGuest, s8 ppuId, ePPUThreadID threadId) {
   if (haltOn && !guestHalt) {
     LOG_DEBUG(Xenon, "Halting PPU{} on address 0x{:X}", ppeState->ppuID, haltOn);
-    ppuHaltOn = haltOn;
+    xenonContext->breakpoints.Add(haltOn, ppeState->ppuID, -1, {}, 0, true);
   }
   guestHalt = requestedByGuest;
 #ifndef NO_GFX
@@ -202,6 +253,7 @@ void PPU::Halt(u64 haltOn, bool requestedByGuest, s8 ppuId, ePPUThreadID threadI
   if (ppuThreadPreviousState == eThreadState::None) // If we were told to ignore it, then do so
     ppuThreadPreviousState.store(ppuThreadState.load());
   ppuThreadState.store(eThreadState::Halted);
+  PPUWake();
 }
 void PPU::Continue() {
   if (ppuThreadState.load() == eThreadState::Running)
@@ -211,6 +263,7 @@ void PPU::Continue() {
   ppuThreadState.store(ppuThreadPreviousState.load());
   ppuThreadPreviousState.store(eThreadState::None);
   guestHalt = false;
+  PPUWake();
 }
 void PPU::ContinueFromException() {
   if (ppuThreadState.load() == eThreadState::Running)
@@ -218,13 +271,14 @@ void PPU::ContinueFromException() {
   if (ppuThreadPreviousState == eThreadState::Running)
     LOG_DEBUG(Xenon, "Jumping to exception handler");
   if (guestHalt) {
-    sPPUThread &thread = ppeState->ppuThread[curThreadId];
-    thread.exceptReg |= ppuProgramEx;
+    sPPUThread &thread = ppeState->ppuThread[ppeState->currentThread];
     thread.progExceptionType = ppuProgExTypeTRAP;
+    thread.PostExceptions(ppuProgramEx);
   }
   ppuThreadState.store(ppuThreadPreviousState.load());
   ppuThreadPreviousState.store(eThreadState::None);
   guestHalt = false;
+  PPUWake();
 }
 void PPU::Step(int amount) {
   if (ppuThreadState.load() == eThreadState::Running)
@@ -232,24 +286,61 @@ void PPU::Step(int amount) {
   if (ppuThreadPreviousState == eThreadState::Running)
     LOG_DEBUG(Xenon, "Continuing PPU{} for {} Instructions", ppeState->ppuID, amount);
   ppuStepAmount = amount;
+  if (ppeState->parallelSMT)
+    ppuSecondaryStepAmount = amount;
+  PPUWake();
+}
+
+void PPU::Suspend() {
+  suspendRequested.store(true);
+  // Sleeping threads have to notice
+  PPUWake();
+  std::unique_lock lock(suspendMutex);
+  suspendCondition.wait(lock, [this] { return activeSlices.load() == 0; });
+}
+void PPU::Resume() {
+  {
+    std::lock_guard lock(suspendMutex);
+    suspendRequested.store(false);
+  }
+  suspendCondition.notify_all();
+  PPUWake();
 }
 
 // PPU Entry Point.
-void PPU::PPURunInstructions(u64 numInstrs, bool enableHalt) {
+u64 PPU::PPURunInstructions(u64 numInstrs, bool enableHalt) {
   // Start Profile
   MICROPROFILE_SCOPEI("[Xe::PPU]", "PPURunInstructions", MP_AUTO);
+  Xe::XCPU::HLE::XenonHLE &hle = xenonContext->hle;
+  const bool hleActive = Config::highlyExperimental.hleMemRoutines && hle.Enabled();
+  const bool hleVerify = hleActive && Config::debug.hleVerify;
+  u64 instrsExecuted = 0;
+  if (hleActive)
+    hle.CheckWrittenPages();
+  curThread.yieldRequested = false;
   for (size_t instrCount = 0; instrCount < numInstrs && ppuThreadActive; ++instrCount) {
     // Halt if needed before executing the next instruction
-    if (enableHalt && ppuHaltOn == curThread.NIA) {
+    // Only pages with breakpoints on them are checked
+    if (enableHalt && xenonContext->breakpoints.IsPageArmed(curThread.NIA) && PPUCheckBreakpoint()) {
       Halt();
     }
 
+    // Run HLE'd routines natively, they return straight to the caller
+    bool hleHandled = false;
+    if (hleActive) {
+      if (hleVerify)
+        hle.CheckVerification(ppeState.get());
+      if (!hle.IsPageScanned(curThread.NIA))
+        hle.ScanPage(ppeState.get(), curThread.NIA);
+      hleHandled = hle.IsPageArmed(curThread.NIA) && hle.Invoke(ppeState.get(), curThread.NIA);
+    }
+
     // Read next instruction
     bool readNextInstr = false;
     // Profile read next instruction
     {
       MICROPROFILE_SCOPEI("[Xe::PPU]", "ReadNextInstruction", MP_AUTO);
-      readNextInstr = PPUReadNextInstruction();
+      readNextInstr = !hleHandled && PPUReadNextInstruction();
     }
     if (readNextInstr) {
 #ifdef DEBUG_BUILD
@@ -271,15 +362,22 @@ void PPU::PPURunInstructions(u64 numInstrs, bool enableHalt) {
 
     // Handle pending exceptions
     PPUCheckExceptions();
+    instrsExecuted++;
 
     // If the thread was suspended due to CTRL being written, we must end execution on said thread.
-    if (ppeState->currentThread == 0 && ppeState->SPR.CTRL.TE0 != true) { break; }
-    if (ppeState->currentThread == 1 && ppeState->SPR.CTRL.TE1 != true) { break; }
+    const uCTRL CTRL = ppeState->LoadCTRL();
+    if (curThreadId == 0 && CTRL.TE0 != true) { break; }
+    if (curThreadId == 1 && CTRL.TE1 != true) { break; }
+
+    // The thread is spin-waiting, give the core to its sibling.
+    if (curThread.yieldRequested) { break; }
 
     // Break after exec and if it's halted
     if ((enableHalt && ppuThreadState == eThreadState::Halted) || ppuThreadState == eThreadState::Resetting)
       break;
   }
+  curThread.spinSlices = curThread.yieldRequested ? curThread.spinSlices + 1 : 0;
+  return instrsExecuted;
 }
 
 // PPU Thread state machine, handles all execution and codeflow
@@ -297,27 +395,38 @@ void PPU::ThreadStateMachine() {
   case eThreadState::Running: {
     // Check our threads to see if any are running
     u8 state = GetCurrentRunningThreads();
-    if (currentExecMode == eExecutorMode::Interpreter) {
+    if (ppeState->parallelSMT) {
+      // Thread 1 runs on its own host thread, see SecondaryThreadLoop.
+      if (!ppuThreadResetting && (state & ePPUThreadBit_Zero)) {
+        PPUSelectThread(ePPUThread_Zero);
+        sliceInstrs += PPURunInstructions(PPUGetSliceLength(curThread), xenonContext->breakpoints.Any());
+        PPUSpinBackoff(ePPUThreadBit_Zero);
+      } else if (!ppuThreadResetting && (state & ePPUThreadBit_One)) {
+        // Only thread 1 is enabled, wait until thread 0 is, or the core goes to sleep.
+        xenonContext->iic.sleepThread(static_cast<u8>(ppeState->ppuThread[ePPUThread_Zero].SPR.PIR), false, PPU_MAX_SLEEP);
+      }
+    } else if (currentExecMode == eExecutorMode::Interpreter) {
       if (!ppuThreadResetting && (state & ePPUThreadBit_Zero)) {
-        // Thread 0 is running, process instructions until we reach TTR timeout.
-        curThreadId = ePPUThread_Zero;
-        PPURunInstructions(ppeState->SPR.TTR.hexValue, ppuHaltOn != 0);
+        // Thread 0 is running, process instructions until we reach its slice length.
+        PPUSelectThread(ePPUThread_Zero);
+        sliceInstrs += PPURunInstructions(PPUGetSliceLength(curThread), xenonContext->breakpoints.Any());
       }
       if (!ppuThreadResetting && (state & ePPUThreadBit_One)) {
-        // Thread 1 is running, process instructions until we reach TTR timeout.
-        curThreadId = ePPUThread_One;
-        PPURunInstructions(ppeState->SPR.TTR.hexValue, ppuHaltOn != 0);
+        // Thread 1 is running, process instructions until we reach its slice length.
+        PPUSelectThread(ePPUThread_One);
+        sliceInstrs += PPURunInstructions(PPUGetSliceLength(curThread), xenonContext->breakpoints.Any());
       }
+      PPUSpinBackoff(state);
     } else {
       if (!ppuThreadResetting && (state & ePPUThreadBit_Zero)) {
         // Thread 1 is running, process instructions until we reach TTR timeout.
-        curThreadId = ePPUThread_Zero;
-        ppuJIT->ExecuteJITInstrs(ppeState->SPR.TTR.hexValue, ppuThreadActive, ppuHaltOn != 0);
+        PPUSelectThread(ePPUThread_Zero);
+        sliceInstrs += ppuJIT->ExecuteJITInstrs(ppeState->SPR.TTR.hexValue, ppuThreadActive, xenonContext->breakpoints.Any());
       }
       if (!ppuThreadResetting && (state & ePPUThreadBit_One)) {
         // Thread 1 is running, process instructions until we reach TTR timeout.
-        curThreadId = ePPUThread_One;
-        ppuJIT->ExecuteJITInstrs(ppeState->SPR.TTR.hexValue, ppuThreadActive, ppuHaltOn != 0);
+        PPUSelectThread(ePPUThread_One);
+        sliceInstrs += ppuJIT->ExecuteJITInstrs(ppeState->SPR.TTR.hexValue, ppuThreadActive, xenonContext->breakpoints.Any());
       }
     }
   } break;
@@ -326,41 +435,48 @@ void PPU::ThreadStateMachine() {
     ppuThreadActive = ppuThreadState.load() != eThreadState::None;
     // Handle stepping
     u8 state = GetCurrentRunningThreads();
-    if (currentExecMode == eExecutorMode::Interpreter) {
+    if (ppeState->parallelSMT) {
+      // Thread 1 steps on its own host thread.
+      if (state & ePPUThreadBit_Zero) {
+        PPUSelectThread(ePPUThread_Zero);
+        if (const u64 stepAmount = ppuStepAmount.exchange(0))
+          sliceInstrs += PPURunInstructions(stepAmount, false);
+      }
+    } else if (currentExecMode == eExecutorMode::Interpreter) {
       if (state & ePPUThreadBit_Zero) {
-        curThreadId = ePPUThread_Zero;
+        PPUSelectThread(ePPUThread_Zero);
         if (ppuStepAmount > 0) {
-          PPURunInstructions(ppuStepAmount, false);
+          sliceInstrs += PPURunInstructions(ppuStepAmount, false);
           ppuStepAmount = 0; // Ensure step mode doesn't continue indefinitely
         }
       }
       if (state & ePPUThreadBit_One) {
-        curThreadId = ePPUThread_One;
+        PPUSelectThread(ePPUThread_One);
         if (ppuStepAmount > 0) {
-          PPURunInstructions(ppuStepAmount, false);
+          sliceInstrs += PPURunInstructions(ppuStepAmount, false);
           ppuStepAmount = 0; // Ensure step mode doesn't continue indefinitely
         }
       }
     } else {
       if (state & ePPUThreadBit_Zero) {
-        curThreadId = ePPUThread_Zero;
+        PPUSelectThread(ePPUThread_Zero);
         if (ppuStepAmount > 0) {
-          ppuJIT->ExecuteJITInstrs(ppuStepAmount, ppuThreadActive, false);
+          sliceInstrs += ppuJIT->ExecuteJITInstrs(ppuStepAmount, ppuThreadActive, false);
           ppuStepAmount = 0; // Ensure step mode doesn't continue indefinitely
         }
       }
       if (state & ePPUThreadBit_One) {
-        curThreadId = ePPUThread_One;
+        PPUSelectThread(ePPUThread_One);
         if (ppuStepAmount > 0) {
-          ppuJIT->ExecuteJITInstrs(ppuStepAmount, ppuThreadActive, false);
+          sliceInstrs += ppuJIT->ExecuteJITInstrs(ppuStepAmount, ppuThreadActive, false);
           ppuStepAmount = 0; // Ensure step mode doesn't continue indefinitely
         }
       }
     }
   } break;
   case eThreadState::Sleeping: {
-    // Waiting for an event, do nothing
-    std::this_thread::sleep_for(1ns); // Don't burn the CPU
+    // Both threads are disabled, block until something can wake us up
+    PPUSleep();
   } break;
   case eThreadState::Unused: {
     ppuThreadState.store(eThreadState::None);
@@ -382,24 +498,168 @@ void PPU::ThreadStateMachine() {
 }
 void PPU::ThreadLoop() {
   // Set thread name
-  if (ppeState.get())
+  if (ppeState.get()) {
     Base::SetCurrentThreadName("[Xe] " + ppeState->ppuName);
+    // Both SMT threads run here, so we get a host core with its siblings
+    Base::Topology::ApplyPlacement(static_cast<Base::Topology::eThreadRole>(
+      static_cast<u8>(Base::Topology::eThreadRole::PPU0) + ppeState->ppuID));
+  }
+  Xe::XCPU::XenonScheduler *scheduler = ppeState ? xenonContext->scheduler : nullptr;
+  const bool deterministic = scheduler && scheduler->IsDeterministic();
   while (ppuThreadActive) {
     // Start Profile
     MICROPROFILE_SCOPEI("[Xe::PPU]", "ThreadLoop", MP_AUTO);
+    // In deterministic mode PPUs run one slice at a time
+    if (deterministic && !scheduler->WaitForTurn(ppeState->ppuID))
+      break;
+    PPUEnterSlice();
+    sliceInstrs = 0;
+
     // Run state machine
     ThreadStateMachine();
 
     // If our thread is not active while running, abort early.
     // We are likely destroying the handle
-    if (!ppuThreadActive)
+    if (!ppuThreadActive) {
+      PPULeaveSlice();
       break;
+    }
 
-    if (PPUCheckInterrupts())
-      continue;
+    // End of a slice, account for it and catch up on guest time
+    if (scheduler && !deterministic)
+      scheduler->RetireInstructions(sliceInstrs);
+    PPUSyncTimeBase();
+
+    PPUCheckInterrupts();
+    PPULeaveSlice();
+
+    if (deterministic) {
+      const bool sleeping = ppuThreadState.load() == eThreadState::Sleeping;
+      scheduler->EndTurn(ppeState->ppuID, sliceInstrs, sleeping, sleeping ? PPUGetWakeTick() : UINT64_MAX);
+    }
   }
+  // Don't hold up the others
+  if (scheduler)
+    scheduler->RemoveCPU(ppeState->ppuID);
   // Thread is done executing, just tell it to exit
   ppuThreadActive = false;
+  PPUWake();
+}
+
+// Runs thread 1 when both threads run in parallel, thread 0 runs in ThreadLoop. Follows the state set by
+// ThreadStateMachine, and parks while it can't run.
+void PPU::SecondaryThreadLoop() {
+  Base::SetCurrentThreadName("[Xe] " + ppeState->ppuName + " T1");
+  Base::Topology::ApplyPlacement(static_cast<Base::Topology::eThreadRole>(
+    static_cast<u8>(Base::Topology::eThreadRole::PPU0) + ppeState->ppuID));
+  Xe::XCPU::XenonScheduler *scheduler = xenonContext->scheduler;
+  const u8 PIR = static_cast<u8>(ppeState->ppuThread[ePPUThread_One].SPR.PIR);
+  while (ppuThreadActive) {
+    // Start Profile
+    MICROPROFILE_SCOPEI("[Xe::PPU]", "SecondaryThreadLoop", MP_AUTO);
+    PPUEnterSlice();
+    const eThreadState state = ppuThreadState.load();
+    if (state == eThreadState::None) {
+      PPULeaveSlice();
+      break;
+    }
+    const bool enabled = ppeState->LoadCTRL().TE1;
+    u64 instrs = 0;
+    if (enabled && !ppuThreadResetting && (state == eThreadState::Running || state == eThreadState::Executing)) {
+      PPUSelectThread(ePPUThread_One);
+      instrs = PPURunInstructions(PPUGetSliceLength(curThread), xenonContext->breakpoints.Any());
+    } else if (enabled && state == eThreadState::Halted && ppuSecondaryStepAmount.load()) {
+      PPUSelectThread(ePPUThread_One);
+      instrs = PPURunInstructions(ppuSecondaryStepAmount.exchange(0), false);
+    } else {
+      // Disabled, halted or the core is asleep. CTRL writes, state changes and steps wake us up
+      xenonContext->iic.sleepThread(PIR, false, PPU_MAX_SLEEP);
+      PPULeaveSlice();
+      continue;
+    }
+
+    // End of a slice, account for it and catch up on guest time
+    if (scheduler)
+      scheduler->RetireInstructions(instrs);
+    PPUSyncTimeBase();
+    PPUSpinBackoff(ePPUThreadBit_One);
+
+    // We disabled ourselves, thread 0 may have to put the core to sleep
+    if (!ppeState->LoadCTRL().TE1)
+      xenonContext->iic.wakeThread(static_cast<u8>(ppeState->ppuThread[ePPUThread_Zero].SPR.PIR));
+    PPULeaveSlice();
+  }
+}
+
+// Save state
+void PPU::SaveState(Base::StateWriter &writer) {
+  for (const sPPUThread &thread : ppeState->ppuThread) {
+    writer.Write(thread.PIA);
+    writer.Write(thread.CIA);
+    writer.Write(thread.NIA);
+    writer.Write(thread.CI);
+    writer.Write(thread.instrFetch);
+    writer.Write(thread.GPR);
+    writer.Write(thread.FPR);
+    writer.Write(thread.SPR);
+    writer.Write(thread.VR);
+    writer.Write(thread.CR);
+    writer.Write(thread.FPSCR);
+    writer.Write(thread.VSCR);
+    writer.Write(thread.SLB);
+    writer.Write(thread.exceptReg);
+    writer.Write<u16>(thread.pendingExceptReg.load());
+    writer.Write(thread.progExceptionType);
+    writer.Write(thread.exHVSysCall);
+    writer.Write(thread.yieldRequested);
+    writer.Write(thread.spinSlices);
+  }
+  writer.Write(ppeState->currentThread);
+  writer.Write(ppeState->SPR);
+  writer.Write(ppeState->TLB);
+  writer.Write(ppuThreadState.load());
+  writer.Write(ppuThreadPreviousState.load());
+  writer.Write<u64>(lastTimeBase.load());
+}
+
+void PPU::LoadState(Base::StateReader &reader) {
+  LoadRegisters(reader);
+  if (ppuJIT)
+    ppuJIT->InvalidateAllBlocks();
+}
+
+void PPU::LoadRegisters(Base::StateReader &reader) {
+  for (sPPUThread &thread : ppeState->ppuThread) {
+    reader.Read(thread.PIA);
+    reader.Read(thread.CIA);
+    reader.Read(thread.NIA);
+    reader.Read(thread.CI);
+    reader.Read(thread.instrFetch);
+    reader.Read(thread.GPR);
+    reader.Read(thread.FPR);
+    reader.Read(thread.SPR);
+    reader.Read(thread.VR);
+    reader.Read(thread.CR);
+    reader.Read(thread.FPSCR);
+    reader.Read(thread.VSCR);
+    reader.Read(thread.SLB);
+    reader.Read(thread.exceptReg);
+    thread.pendingExceptReg.store(reader.Read<u16>());
+    reader.Read(thread.progExceptionType);
+    reader.Read(thread.exHVSysCall);
+    reader.Read(thread.yieldRequested);
+    reader.Read(thread.spinSlices);
+    // Nothing we cached is valid anymore
+    xenonContext->xenonRes.Release(thread.ppuRes.get(), 0);
+    thread.iERAT.InvalidateAll();
+    thread.dERAT.InvalidateAll();
+  }
+  reader.Read(ppeState->currentThread);
+  reader.Read(ppeState->SPR);
+  reader.Read(ppeState->TLB);
+  ppuThreadState.store(reader.Read<eThreadState>());
+  ppuThreadPreviousState.store(reader.Read<eThreadState>());
+  lastTimeBase.store(reader.Read<u64>());
 }
 
 // Returns a pointer to the specified thread.
@@ -476,7 +736,12 @@ void bswap_elf(T &value) {
 #define READ(header, entry) elf32 ? header entry : header##64 entry
 u64 PPU::loadElfImage(u8* data, u64 size) {
   // Setup HRMOR for elf binaries
-  ppeState->SPR.CTRL.hexValue = 0x800000; // CTRL[TE0] = 1;
+  {
+    std::lock_guard<std::mutex> ctrlLock(ppeState->sharedStateMutex);
+    uCTRL CTRL;
+    CTRL.hexValue = 0x800000; // CTRL[TE0] = 1;
+    ppeState->StoreCTRL(CTRL);
+  }
   ppeState->SPR.HRMOR.hexValue = 0x0000000000000000;
 
   // Loaded ELF Header type (elf32/elf64)
@@ -604,6 +869,67 @@ u64 PPU::loadElfImage(u8* data, u64 size) {
   return curThread.NIA;
 }
 
+// Checks the breakpoints on the next instruction of the current thread.
+bool PPU::PPUCheckBreakpoint() {
+  // Already halted by the guest, the debugger is waiting on it
+  if (guestHalt)
+    return false;
+  return xenonContext->breakpoints.Check(ppeState.get(), curThread.NIA);
+}
+
+// Returns how many instructions a thread runs before switching to its sibling. The TTR, shortened for low
+// priority threads and lengthened for high priority ones, so the sibling gets more or less of the core.
+u64 PPU::PPUGetSliceLength(const sPPUThread &thread) {
+  const u64 TTR = ppeState->SPR.TTR.hexValue;
+  if (!Config::xcpu.smtHints)
+    return TTR;
+  switch (thread.SPR.TSRL.TP) {
+  case ePPUThreadPriority_Low:
+    return std::max<u64>(TTR / 4, 1);
+  case ePPUThreadPriority_High:
+    return TTR * 2;
+  default:
+    return TTR;
+  }
+}
+
+// Backs off when every thread we just ran has been spin-waiting for a while. Whatever they wait on is up to
+// another PPU or a device, so first let the host run something else, then park until an interrupt, a wakeup
+// or a short timeout. Guest time doesn't depend on host timing in deterministic mode, no need to back off.
+void PPU::PPUSpinBackoff(u8 threads) {
+  if (!Config::xcpu.smtHints || !threads)
+    return;
+  Xe::XCPU::XenonScheduler *scheduler = xenonContext->scheduler;
+  if (scheduler && scheduler->IsDeterministic())
+    return;
+  u32 spinSlices = UINT32_MAX;
+  ePPUThreadID parkThread = ePPUThread_None;
+  for (u8 thrdNum = 0; thrdNum < 2; thrdNum++) {
+    if (!(threads & (thrdNum == 0 ? ePPUThreadBit_Zero : ePPUThreadBit_One)))
+      continue;
+    spinSlices = std::min(spinSlices, ppeState->ppuThread[static_cast<ePPUThreadID>(thrdNum)].spinSlices);
+    if (parkThread == ePPUThread_None)
+      parkThread = static_cast<ePPUThreadID>(thrdNum);
+  }
+  if (spinSlices < PPU_SPIN_YIELD_SLICES)
+    return;
+  if (spinSlices < PPU_SPIN_PARK_SLICES) {
+    std::this_thread::yield();
+    return;
+  }
+  const sPPUThread &thread = ppeState->ppuThread[parkThread];
+  xenonContext->iic.sleepThread(static_cast<u8>(thread.SPR.PIR), thread.SPR.MSR.EE, PPU_SPIN_PARK);
+}
+
+// Selects the thread executed by the calling host thread, and takes in the exceptions posted to it while it
+// wasn't running.
+void PPU::PPUSelectThread(ePPUThreadID thrdID) {
+  executingThread = thrdID;
+  // The JIT and the debugger read it from here
+  ppeState->currentThread = thrdID;
+  ppeState->ppuThread[thrdID].MergePendingExceptions();
+}
+
 // Reads the next instruction from memory and advances the NIP accordingly.
 bool PPU::PPUReadNextInstruction() {
   ePPUThreadID thrId = curThreadId;
@@ -633,7 +959,34 @@ bool PPU::PPUReadNextInstruction() {
 // Checks for CPU bringup interrupts
 bool PPU::PPUCheckInterrupts() {
   // Check if we are allowed to enable thread zero if the thread is sleeping...
-  bool WEXT = (ppeState->SPR.TSCR.hexValue & 0x100000) >> 20;
+  bool WEXT = (ppeState->SPR.TSCR.hexValue & TSCR_WEXT) >> 20;
+
+  // Check for decrementer wakeups, these resume the thread whose decrementer expired
+  if (ppuThreadActive && !ppuThreadResetting && ppuThreadState.load() == eThreadState::Sleeping) {
+    for (u8 thrdNum = 0; thrdNum < 2; thrdNum++) {
+      const u32 WDEC = thrdNum == 0 ? TSCR_WDEC0 : TSCR_WDEC1;
+      sPPUThread &thread = ppeState->ppuThread[static_cast<ePPUThreadID>(thrdNum)];
+      if (!(ppeState->SPR.TSCR.hexValue & WDEC) || !(thread.GetAllExceptions() & ppuDecrementerEx))
+        continue;
+      LOG_DEBUG(Xenon, "{} (Thread{}) woken up by its decrementer", ppeState->ppuName, thrdNum);
+      // Enable the thread and issue a system reset exception.
+      {
+        std::lock_guard<std::mutex> ctrlLock(ppeState->sharedStateMutex);
+        uCTRL CTRL = ppeState->SPR.CTRL;
+        if (thrdNum == 0)
+          CTRL.TE0 = 1;
+        else
+          CTRL.TE1 = 1;
+        ppeState->StoreCTRL(CTRL);
+      }
+      thread.SPR.SRR1 = 0x180000; // Set SRR1[42:44] = 011
+      thread.PostExceptions(ppuSystemResetEx);
+      ppuThreadState.store(eThreadState::Running);
+      // Thread 1 may be parked on its own host thread
+      PPUWake();
+      return false;
+    }
+  }
 
   // Check for external interrupts that enable execution
   if (ppuThreadActive && !ppuThreadResetting && (ppuThreadState.load() == eThreadState::Halted 
@@ -648,8 +1001,13 @@ bool PPU::PPUCheckInterrupts() {
     ppuThreadState.store(eThreadState::Running);
     
     // Enable thread 0 execution and issue a system reset exception.
-    ppeState->SPR.CTRL.TE0 = 1;
-    ppeState->ppuThread[ePPUThread_Zero].exceptReg |= ppuSystemResetEx;
+    {
+      std::lock_guard<std::mutex> ctrlLock(ppeState->sharedStateMutex);
+      uCTRL CTRL = ppeState->SPR.CTRL;
+      CTRL.TE0 = 1;
+      ppeState->StoreCTRL(CTRL);
+    }
+    ppeState->ppuThread[ePPUThread_Zero].PostExceptions(ppuSystemResetEx);
 
     sPPUThread &thread = curThread;
 
@@ -823,33 +1181,142 @@ void PPU::UpdateTimeBase(u64 tbTicks) {
   // are enabled to update
   if (ppeState->SPR.HID6.tb_enable) {
     // The Decrementer and the Time Base are driven by the same time frequency.
-    u32 newDec = 0;
-    u32 dec = 0;
-    // Update the Time Base.
-    ppeState->SPR.TB.hexValue += tbTicks;
-    // Get the decrementer value.
-    dec = curThread.SPR.DEC;
-    newDec = dec - tbTicks;
-    // Update the new decrementer value.
-    curThread.SPR.DEC = newDec;
-    // Check if Previous decrementer measurement is smaller than current and a
-    // decrementer exception is not pending.
-    if (newDec > dec && !(_ex & ppuDecrementerEx)) {
-      // The decrementer must issue an interrupt.
-      _ex |= ppuDecrementerEx;
+    // Update the Time Base. With parallel SMT either of our host threads may be doing this, while the other
+    // thread reads it or writes its decrementer.
+    std::atomic_ref<u64>(ppeState->SPR.TB.hexValue).fetch_add(tbTicks, std::memory_order_relaxed);
+    // Both threads decrementers run off it.
+    for (auto &thread : ppeState->ppuThread) {
+      // Update the decrementer value, getting the previous one.
+      const u32 dec = static_cast<u32>(std::atomic_ref<DEC_t>(thread.SPR.DEC).fetch_sub(
+        static_cast<DEC_t>(tbTicks), std::memory_order_relaxed));
+      const u32 newDec = dec - static_cast<u32>(tbTicks);
+      // Check if we went past zero (either wrapped, or more ticks elapsed than were left).
+      if (newDec > dec || tbTicks > dec) {
+        // The decrementer must issue an interrupt. The thread may be running on another host thread.
+        thread.PostExceptions(ppuDecrementerEx);
+      }
     }
   }
 }
 
+// Services the event scheduler and applies the guest time that elapsed since our last slice.
+void PPU::PPUSyncTimeBase() {
+  Xe::XCPU::XenonScheduler *scheduler = xenonContext->scheduler;
+  if (!scheduler || !ppeState)
+    return;
+  scheduler->Service();
+  const u64 timeBase = scheduler->GetTimeBase();
+  // With parallel SMT both our host threads sync, whoever gets here first applies the elapsed time
+  u64 prevTimeBase = lastTimeBase.load(std::memory_order_relaxed);
+  do {
+    if (timeBase <= prevTimeBase)
+      return;
+  } while (!lastTimeBase.compare_exchange_weak(prevTimeBase, timeBase, std::memory_order_acq_rel));
+  const u64 tbTicks = timeBase - prevTimeBase;
+  // The TB counter only runs while enabled in the SoC
+  if (tbTicks && xenonContext->timeBaseActive)
+    UpdateTimeBase(tbTicks);
+}
+
+// Returns the timebase tick at which a sleeping PPU has to wake up on its own, a decrementer expiring with its
+// TSCR[WDEC0/1] set. UINT64_MAX if none.
+u64 PPU::PPUGetWakeTick() {
+  Xe::XCPU::XenonScheduler *scheduler = xenonContext->scheduler;
+  // Decrementers only run with the timebase
+  if (!scheduler || !xenonContext->timeBaseActive || !ppeState->SPR.HID6.tb_enable)
+    return UINT64_MAX;
+  const u32 TSCR = ppeState->SPR.TSCR.hexValue;
+  u64 wakeTicks = UINT64_MAX;
+  for (u8 thrdNum = 0; thrdNum < 2; thrdNum++) {
+    const u32 WDEC = thrdNum == 0 ? TSCR_WDEC0 : TSCR_WDEC1;
+    const u32 dec = static_cast<u32>(std::atomic_ref<DEC_t>(
+      ppeState->ppuThread[static_cast<ePPUThreadID>(thrdNum)].SPR.DEC).load(std::memory_order_relaxed));
+    // Already negative, it won't expire again any time soon
+    if ((TSCR & WDEC) && !(dec & 0x80000000))
+      wakeTicks = std::min<u64>(wakeTicks, dec + 1);
+  }
+  return wakeTicks == UINT64_MAX ? UINT64_MAX : lastTimeBase + wakeTicks;
+}
+
+// Blocks a sleeping PPU until it can be woken up: an external interrupt (TSCR[WEXT]), a decrementer expiring
+// (TSCR[WDEC0/1]), a state change from the host, or the next scheduled event, which we may have to service.
+void PPU::PPUSleep() {
+  Xe::XCPU::XenonScheduler *scheduler = xenonContext->scheduler;
+  // Deterministic mode, the others can't run while we hold our turn. Just give it up, guest time moves on
+  // to the next wakeup once everyone is asleep
+  if (scheduler && scheduler->IsDeterministic())
+    return;
+
+  const bool WEXT = ppeState->SPR.TSCR.hexValue & TSCR_WEXT;
+  const u64 wakeTick = PPUGetWakeTick();
+  // Our decrementer is already due
+  if (wakeTick <= lastTimeBase)
+    return;
+
+  if (scheduler && scheduler->GetTimeBaseMode() == Xe::XCPU::eTimeBaseMode::Instructions) {
+    // Guest time only moves as the others run, there's no host deadline. We get woken up once it reaches our
+    // decrementer, or skips ahead to the next wakeup when we're the last one to fall asleep
+    scheduler->IdleCPU(ppeState->ppuID, wakeTick);
+    xenonContext->iic.sleepThread(static_cast<u8>(curThread.SPR.PIR), WEXT, PPU_MAX_SLEEP);
+    scheduler->ResumeCPU(ppeState->ppuID);
+    return;
+  }
+
+  u64 sleepTicks = Xe::XCPU::XenonScheduler::ToTicks(PPU_MAX_SLEEP);
+  if (wakeTick != UINT64_MAX)
+    sleepTicks = std::min(sleepTicks, wakeTick - lastTimeBase);
+  if (scheduler) {
+    const u64 timeBase = scheduler->GetTimeBase();
+    const u64 nextEventTick = scheduler->GetNextEventTick();
+    sleepTicks = nextEventTick > timeBase ? std::min(sleepTicks, nextEventTick - timeBase) : 0;
+  }
+
+  if (sleepTicks == 0)
+    return;
+  xenonContext->iic.sleepThread(static_cast<u8>(curThread.SPR.PIR), WEXT,
+    std::chrono::nanoseconds(sleepTicks * Xe::XCPU::XenonScheduler::timeBasePeriodNs));
+}
+
+// Wakes up our thread if it's sleeping, so it notices a state change.
+void PPU::PPUWake() {
+  if (!ppeState)
+    return;
+  for (auto &thread : ppeState->ppuThread) {
+    xenonContext->iic.wakeThread(static_cast<u8>(thread.SPR.PIR));
+  }
+}
+
+// Counts us in a slice, or parks us first while suspended.
+void PPU::PPUEnterSlice() {
+  activeSlices.fetch_add(1);
+  while (suspendRequested.load()) {
+    PPULeaveSlice();
+    {
+      std::unique_lock lock(suspendMutex);
+      suspendCondition.wait(lock, [this] { return !suspendRequested.load(); });
+    }
+    activeSlices.fetch_add(1);
+  }
+}
+
+// Counts us out of a slice, letting Suspend know once every host thread is out.
+void PPU::PPULeaveSlice() {
+  if (activeSlices.fetch_sub(1) == 1 && suspendRequested.load()) {
+    std::lock_guard lock(suspendMutex);
+    suspendCondition.notify_all();
+  }
+}
+
 // Returns current executing thread by reading CTRL register
 u8 PPU::GetCurrentRunningThreads() {
   if (!ppeState)
     return ePPUThreadBit_None;
 
   // Extract bits 22-23 in one step and directly map them to thread states
-  u8 ctrlTE = (ppeState->SPR.CTRL.hexValue >> 22) & 0b11;
+  const uCTRL CTRL = ppeState->LoadCTRL();
+  u8 ctrlTE = (CTRL.hexValue >> 22) & 0b11;
   // If the thread state was changed to shut down both threads, set the thread state to sleeping.
-  if (!(ppeState->SPR.CTRL.TE0 || ppeState->SPR.CTRL.TE1)) {
+  if (!(CTRL.TE0 || CTRL.TE1)) {
     ppuThreadState.store(eThreadState::Sleeping);
   }
 
@@ -4,7 +4,9 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 #include "PowerPC.h"
 #include "Core/XCPU/Context/XenonContext.h"
@@ -49,6 +51,9 @@ public:
 
   // Reset the PPU state
   void Reset();
+  // Puts every register back to its state when execution started, in place. Keeps our threads and the JIT blocks
+  // built in real mode. Only while suspended.
+  void SoftReset();
 
   // Debug tools
   void Halt(u64 haltOn = 0, bool requestedByGuest = false, s8 ppuId = 0, ePPUThreadID threadId = ePPUThread_None);
@@ -56,17 +61,29 @@ public:
   void ContinueFromException();
   void Step(int amount = 1);
 
+  // Parks our host threads at their next slice boundary and waits until they're all parked, so our state can be
+  // read or replaced. Unlike Halt, nothing (interrupts, wakeups) brings us back before Resume.
+  void Suspend();
+  void Resume();
+
+  // Save state, every register of both threads. Only while suspended.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
+
   // Thread state machine
   void ThreadStateMachine();
 
   // Thread function
   void ThreadLoop();
 
+  // Thread function for thread one when both threads run in parallel
+  void SecondaryThreadLoop();
+
   // Returns a pointer to a thread
   sPPUThread *GetPPUThread(u8 thrdID);
 
-  // Runs a specified number of instructions
-  void PPURunInstructions(u64 numInstrs, bool enableHalt = true);
+  // Runs a specified number of instructions, returns how many were executed
+  u64 PPURunInstructions(u64 numInstrs, bool enableHalt = true);
 
   // Checks if the thread is active
   bool ThreadActive() {
@@ -92,7 +109,7 @@ public:
   // Get ppuJIT
   PPU_JIT *GetPPUJIT() { return ppuJIT.get(); }
 
-  // Updates the current PPU's time base and decrementer based on
+  // Updates the current PPU's time base and both threads decrementers based on
   // the amount of tb ticks given.
   void UpdateTimeBase(u64 tbTicks);
 
@@ -107,6 +124,9 @@ private:
   // Thread handle
   std::thread ppuThread;
 
+  // Thread one's handle, with parallel SMT
+  std::thread ppuSecondaryThread;
+
   // PPU running?
   std::atomic<eThreadState> ppuThreadState = eThreadState::None;
 
@@ -119,18 +139,29 @@ private:
   // PPU thread state before halting
   std::atomic<eThreadState> ppuThreadPreviousState = eThreadState::None;
 
-  // If this is set to a non-zero value, it will halt on that address then clear it
-  u64 ppuHaltOn = 0;
-
   // If this is set, then the guest requested us to halt. Opens another option in the debugger
   bool guestHalt = false;
 
   // Amount of instructions to step
-  u64 ppuStepAmount = 0;
+  std::atomic<u64> ppuStepAmount = 0;
+
+  // Amount of instructions to step on thread one, with parallel SMT
+  std::atomic<u64> ppuSecondaryStepAmount = 0;
+
+  // Scheduler timebase at our last slice boundary, either host thread's with parallel SMT
+  std::atomic<u64> lastTimeBase = 0;
+
+  // Instructions retired in the current slice, both threads
+  u64 sliceInstrs = 0;
 
   // Execution threads inside this PPU.
   std::unique_ptr<sPPEState> ppeState;
 
+  // Registers as StartExecution left them, see SoftReset
+  Base::StateSnapshot powerOnState = {};
+  // Reads the registers saved by SaveState.
+  void LoadRegisters(Base::StateReader &reader);
+
   // Main CPU Context.
   Xe::XCPU::XenonContext *xenonContext = nullptr;
 
@@ -140,6 +171,12 @@ private:
   // Initial reset vector
   u32 resetVector = 0;
 
+  // Suspension, see Suspend. Host threads count themselves in activeSlices while they run a slice
+  std::atomic<bool> suspendRequested = false;
+  std::atomic<u32> activeSlices = 0;
+  std::mutex suspendMutex;
+  std::condition_variable suspendCondition;
+
   //
   // Exceptions
   //
@@ -164,6 +201,8 @@ private:
   friend class PPU_JIT;
   // Function call epilogue.
   friend bool InstrEpilogue(PPU *ppu, sPPEState *ppeState);
+  // Breakpoint stub.
+  friend void callBreakpoint(PPU *ppu);
 
   //
   // Helpers
@@ -172,12 +211,31 @@ private:
   // Returns the number of instructions per second the current
   // host computer can process.
   u32 GetIPS();
+  // Slice boundaries, a suspended PPU parks in PPUEnterSlice until resumed
+  void PPUEnterSlice();
+  void PPULeaveSlice();
+  // Checks the breakpoints on the next instruction. Returns true if we must halt.
+  bool PPUCheckBreakpoint();
+  // Instructions a thread runs before switching to its sibling, TTR scaled by its priority
+  u64 PPUGetSliceLength(const sPPUThread &thread);
+  // Gives the host core away when the threads we just ran keep spin-waiting
+  void PPUSpinBackoff(u8 threads);
+  // Selects the thread the calling host thread executes and takes in its posted exceptions
+  void PPUSelectThread(ePPUThreadID thrdID);
   // Read next intruction from memory
   bool PPUReadNextInstruction();
   // Checks for pending exceptions
   bool PPUCheckInterrupts();
   // Checks for pending exceptions
   bool PPUCheckExceptions();
+  // Services the scheduler and applies the elapsed guest time to our timebase. Done at slice boundaries.
+  void PPUSyncTimeBase();
+  // Timebase tick at which a sleeping PPU has to wake up on its own (decrementer), UINT64_MAX if none.
+  u64 PPUGetWakeTick();
+  // Blocks while both threads are disabled, until something can wake us up.
+  void PPUSleep();
+  // Wakes up a sleeping PPU.
+  void PPUWake();
   // Gets the current running threads.
   u8 GetCurrentRunningThreads();
   // Simulates the behavior of the 1BL inside the Xenon Secure ROM.
@@ -4,14 +4,16 @@
 
 #pragma once
 
+#include <atomic>
 #include <bit>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include "Base/Bitfield.h"
-#include "Base/LRUCache.h"
 #include "Base/Vector128.h"
 #include "Core/XCPU/Context/Reservations/XenonReservations.h"
+#include "Core/XCPU/MMU/XenonERAT.h"
 
 
 // PowerPC Opcode definitions
@@ -615,6 +617,19 @@ union uTSCR {
 #endif
 };
 
+// Thread priorities, TSRL[TP]
+enum ePPUThreadPriority : u8 {
+  ePPUThreadPriority_Disabled = 0,
+  ePPUThreadPriority_Low,
+  ePPUThreadPriority_Medium,
+  ePPUThreadPriority_High
+};
+
+// TSCR wakeup enable bits, for a PPU with both threads disabled
+#define TSCR_WEXT 0x100000   // External interrupt wakeup enable
+#define TSCR_WDEC1 0x200000  // Decrementer wakeup enable for thread 1
+#define TSCR_WDEC0 0x400000  // Decrementer wakeup enable for thread 0
+
 // Thread Switch Timeout Register (TTR)
 union uTTR {
   u64 hexValue;
@@ -1293,17 +1308,38 @@ struct sPPUThread {
   sSLBEntry SLB[64]{};
 
   // ERAT's (MMU)
-  LRUCache iERAT{}; // Instruction effective to real address cache.
-  LRUCache dERAT{}; // Data effective to real address cache.
+  Xe::XCPU::MMU::XenonERAT iERAT{}; // Instruction effective to real address cache.
+  Xe::XCPU::MMU::XenonERAT dERAT{}; // Data effective to real address cache.
 
   // Exception Register
   u16 exceptReg = 0;
+  // Exceptions raised from other host threads (decrementer, thread enable), moved into exceptReg by the host thread
+  // executing us at slice boundaries. See MergePendingExceptions.
+  std::atomic<u16> pendingExceptReg = 0;
   // Program Exception Type
   u16 progExceptionType = 0;
   // SystemCall Type (Hypervisor syscall)
   bool exHVSysCall = false;
+  // The thread lowered its priority to wait on something (spin-wait loops), ends its slice.
+  bool yieldRequested = false;
+  // Consecutive slices the thread ended by yielding, how long it has been spinning.
+  u32 spinSlices = 0;
   // PPU reservations for PPC atomic load/store operations.
   std::unique_ptr<PPU_RES> ppuRes{};
+
+  // Raises exceptions on this thread from a host thread that may not be the one executing it.
+  void PostExceptions(u16 exceptions) {
+    pendingExceptReg.fetch_or(exceptions, std::memory_order_release);
+  }
+  // Moves the posted exceptions into exceptReg. Only the host thread executing us may call this.
+  void MergePendingExceptions() {
+    if (pendingExceptReg.load(std::memory_order_relaxed))
+      exceptReg |= pendingExceptReg.exchange(0, std::memory_order_acquire);
+  }
+  // Exceptions raised, merged or not.
+  u16 GetAllExceptions() const {
+    return exceptReg | pendingExceptReg.load(std::memory_order_acquire);
+  }
 };
 
 // The structure of the Xenon CPU differs from that on the CELL/BE in that instead of having one PPE and 8 SPE's
@@ -1324,6 +1360,10 @@ enum ePPUThreadID : u8 {
   ePPUThread_One,
   ePPUThread_None
 };
+// Thread executed by the calling host thread. With parallel SMT both threads of a PPE run at once, each on a host
+// thread of its own, so this can't live in sPPEState.
+inline constinit thread_local ePPUThreadID executingThread = ePPUThread_Zero;
+
 enum ePPUThreadBit : u8 {
   ePPUThreadBit_None = 0,
   ePPUThreadBit_Zero,
@@ -1338,10 +1378,28 @@ struct sPPEState {
       ppuThread[i].ppuRes.reset();
     }
   }
+  // Reads CTRL, the other thread may be writing it.
+  uCTRL LoadCTRL() {
+    uCTRL ctrl;
+    ctrl.hexValue = std::atomic_ref<u32>(SPR.CTRL.hexValue).load(std::memory_order_acquire);
+    return ctrl;
+  }
+  // Writes CTRL. Must hold sharedStateMutex, writers read-modify-write it.
+  void StoreCTRL(uCTRL ctrl) {
+    std::atomic_ref<u32>(SPR.CTRL.hexValue).store(ctrl.hexValue, std::memory_order_release);
+  }
   // Power Processing Unit Threads
   sPPUThread ppuThread[2] = {};
-  // Current executing thread ID.
+  // Last thread selected for execution. Kept for the JIT and the debugger, executing code uses executingThread.
   ePPUThreadID currentThread = ePPUThread_Zero;
+  // Both threads run at once on host threads of their own, see PPU::SecondaryThreadLoop.
+  bool parallelSMT = false;
+  // Guards the TLB and CTRL, which both threads update with read-modify-write sequences. CTRL goes through
+  // LoadCTRL/StoreCTRL, as its thread enable bits are also polled without it.
+  std::mutex sharedStateMutex;
+  // Bumped by tlbiel, both thread's ERATs flush themselves once they see it change. Same as the global generation,
+  // but local to the core.
+  std::atomic<u32> eratGeneration = 0;
   // Shared Special Purpose Registers.
   sPPUGlobalSPRs SPR{};
   // Translation Lookaside Buffer
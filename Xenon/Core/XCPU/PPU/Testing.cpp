@@ -12,7 +12,7 @@
 #include "Core/XCPU/Interpreter/PPCInterpreter.h"
 
 #define BLR_OPCODE 0x4e800020
-#define curThreadId   ppeState->currentThread
+#define curThreadId   executingThread
 #define curThread     ppeState->ppuThread[curThreadId]
 
 const u32 START_ADDRESS = 0x10000000;
@@ -285,7 +285,7 @@ public:
     if (currentTestMode == ePPUTestingMode::Interpreter) {
       bool testRunning = true;
       while (testRunning) {
-        sPPUThread& thread = ppeState->ppuThread[ppeState->currentThread];
+        sPPUThread& thread = ppeState->ppuThread[curThreadId];
         // Update previous instruction address
         thread.PIA = thread.CIA;
         // Update current instruction address
@@ -293,7 +293,7 @@ public:
         // Increase next instruction address
         thread.NIA += 4;
         // Fetch the instruction from memory
-        thread.CI.opcode = PPCInterpreter::MMURead32(ppeState, thread.CIA, ppeState->currentThread);
+        thread.CI.opcode = PPCInterpreter::MMURead32(ppeState, thread.CIA, curThreadId);
         if (thread.CI.opcode == 0xFFFFFFFF || thread.CI.opcode == 0xCDCDCDCD) {
           LOG_CRITICAL(Xenon, "[Testing]: Invalid opcode found.");
           return false;
@@ -324,7 +324,7 @@ public:
   }
 
   bool SetupTestState(TestCase &testCase) {
-    sPPUThread &thread = ppeState->ppuThread[ppeState->currentThread];
+    sPPUThread &thread = ppeState->ppuThread[curThreadId];
     // Clear registers involved in tests.
     for (auto &reg : thread.GPR) { reg = 0; }
     for (auto &reg : thread.FPR) { reg.setValue(0.0); }
@@ -352,6 +352,7 @@ public:
         auto bytesStr = it.second.substr(spacePos + 1);
         u32 address = std::strtoul(addressStr.c_str(), nullptr, 16);
         auto p = PPCInterpreter::MMUGetPointerFromRAM(address);
+        const u8 *start = p;
         const char *c = bytesStr.c_str();
         while (*c) {
           while (*c == ' ') ++c;
@@ -364,6 +365,7 @@ public:
           *p = static_cast<u8>(b);
           ++p;
         }
+        PPCInterpreter::xenonContext->GetRAM()->MarkDirtyHost(start, p - start);
       }
     }
     return true;
@@ -522,7 +524,7 @@ bool PPU::RunInstructionTests(sPPEState *ppeState, PPU_JIT* ppuJITPtr, ePPUTesti
   LOG_INFO(Xenon, "[Testing]: Failed: {}", failedTestsCount);
 
   // Reset the state:
-  sPPUThread &thread = ppeState->ppuThread[ppeState->currentThread];
+  sPPUThread &thread = ppeState->ppuThread[curThreadId];
   // Clear registers involved in tests.
   for (auto& reg : thread.GPR) { reg = 0; }
   for (auto& reg : thread.FPR) { reg.setValue(0.0); }
@@ -7,43 +7,26 @@
 #include "Core/XCPU/XenonCPU.h"
 #include "Interpreter/PPCInterpreter.h"
 
-#ifdef _WIN32
-#include <Windows.h>
-
-// Returns the CPU Frequency using Windows QueryPerformanceFrequency/QueryPerformanceCounter routines.
-double calibrateCPUFrequency() {
-  LARGE_INTEGER freq;
-  QueryPerformanceFrequency(&freq);
-
-  LARGE_INTEGER t0, t1;
-  u64 c0, c1;
-
-  QueryPerformanceCounter(&t0);
-  c0 = __rdtsc();
-
-  // Wait ~100 ms
-  Sleep(100); 
-
-  QueryPerformanceCounter(&t1);
-  c1 = __rdtsc();
-
-  double elapsedSec = double(t1.QuadPart - t0.QuadPart) / double(freq.QuadPart);
-  double cycles = double(c1 - c0);
-
-  return cycles / elapsedSec; // Frequency in Hz
-}
-
-#endif // _WIN32
-
 namespace Xe::XCPU {
 
-  XenonCPU::XenonCPU(RootBus *inBus, const std::string blPath, const std::string fusesPath, RAM *ramPtr) {
+  XenonCPU::XenonCPU(RootBus *inBus, const std::string blPath, const std::string fusesPath, RAM *ramPtr,
+    XenonScheduler *schedulerPtr) {
     // Initilize Xenon Context
-    xenonContext = std::make_unique<STRIP_UNIQUE(xenonContext)>(inBus, ramPtr);
+    xenonContext = std::make_unique<STRIP_UNIQUE(xenonContext)>(inBus, ramPtr, schedulerPtr);
+
+    // Sleeping PPUs wait for the next scheduled event at most, wake them up if an earlier one shows up
+    schedulerPtr->SetWakeupCallback([this] {
+      for (u8 threadID = 0; threadID < 6; threadID++)
+        xenonContext->iic.wakeThread(threadID);
+    });
 
     // Set SROM to 0.
     memset(xenonContext->SROM.get(), 0, XE_SROM_SIZE);
 
+    // Load the HLE routine signatures
+    if (Config::highlyExperimental.hleMemRoutines)
+      xenonContext->hle.LoadSignatures(Config::filepaths.hleSignatures);
+
     // Populate FuseSet
     {
       std::ifstream file(fusesPath);
@@ -76,12 +59,6 @@ namespace Xe::XCPU {
         xenonContext->socSecOTPBlock->EepromHash1[0] = fusesets[10].second;
         xenonContext->socSecOTPBlock->EepromHash2[0] = fusesets[11].second;
       }
-
-      // Start timebase timer thread.
-      if (!timeBaseThreadActive.load()) {
-        timeBaseThreadActive.store(true);
-        timeBaseThread = std::thread(&XenonCPU::timeBaseThreadLoop, this);
-      }
     }
 
     // Load 1BL binary if needed.
@@ -122,11 +99,13 @@ namespace Xe::XCPU {
     // Setup SOC blocks.
     xenonContext->socPRVBlock.get()->PowerOnResetStatus.AsBITS.SecureMode = 1; // CB Checks this.
     xenonContext->socPRVBlock.get()->PowerManagementControl.AsULONGLONG = 0x382C00000000B001ULL; // Power Management Control.
+
+    // What a soft reset goes back to
+    xenonContext->CapturePowerOnState();
   }
 
   XenonCPU::~XenonCPU() {
-    // First kill timer thread.
-    timeBaseThreadActive.store(false);
+    xenonContext->scheduler->SetWakeupCallback({});
 
     LOG_INFO(Xenon, "Shutting PPU cores down...");
     ppu0.reset();
@@ -143,6 +122,7 @@ namespace Xe::XCPU {
       ppu1.reset();
       ppu2.reset();
     }
+    elfLoaded = false;
     // Create PPU elements
     ppu0 = std::make_unique<STRIP_UNIQUE(ppu0)>(xenonContext.get(), resetVector, 0); // Threads 0-1
     ppu1 = std::make_unique<STRIP_UNIQUE(ppu1)>(xenonContext.get(), resetVector, 2); // Threads 2-3
@@ -155,6 +135,7 @@ namespace Xe::XCPU {
   }
 
   void XenonCPU::LoadElf(const std::string path) {
+    elfLoaded = true;
     ppu0.reset();
     ppu1.reset();
     ppu2.reset();
@@ -190,6 +171,8 @@ namespace Xe::XCPU {
   }
 
   void XenonCPU::Reset() {
+    // Code will be loaded again
+    xenonContext->hle.Reset();
     if (ppu0.get())
       ppu0->Reset();
     std::this_thread::sleep_for(200ms);
@@ -201,6 +184,18 @@ namespace Xe::XCPU {
     std::this_thread::sleep_for(200ms);
   }
 
+  bool XenonCPU::SoftReset() {
+    if (!ppu0.get() || elfLoaded || !xenonContext->Reset())
+      return false;
+    // Code will be loaded again
+    xenonContext->hle.Reset();
+    for (PPU *ppu : { ppu0.get(), ppu1.get(), ppu2.get() }) {
+      if (ppu)
+        ppu->SoftReset();
+    }
+    return true;
+  }
+
   void XenonCPU::Halt(u64 haltOn, bool requestedByGuest, u8 ppuId, ePPUThreadID threadId) {
     if (ppu0.get())
       ppu0->Halt(haltOn, requestedByGuest, ppuId, threadId);
@@ -276,60 +271,41 @@ namespace Xe::XCPU {
     return nullptr;
   }
 
-  // TimeBase thread for increasing global timer counter.
-  void XenonCPU::timeBaseThreadLoop() {
-    Base::SetCurrentThreadName("[Xe] CPU Timer Thread");
-
-#ifdef _WIN32
-    // Get our CPU frequency.
-    double cpuFrequencyInHz = calibrateCPUFrequency();
-    // Target time in Ns we need to wait.
-    const double targetNs = 2500.0;
-    // Convert that to CPU cycles.
-    unsigned long long targetCPUCycles = static_cast<unsigned long long>((targetNs * 1e-9) * cpuFrequencyInHz);
-    unsigned long long startCycle = __rdtsc();
-    unsigned long long nextCycle = startCycle + targetCPUCycles;
-
-    while (timeBaseThreadActive.load()) {
-      // Wait x cycles.
-      while (__rdtsc() < nextCycle) {}
-
-      // We're waiting for approx 2500 Ns, which represent 125 XenonCPU cycles.
-      if (xenonContext->timeBaseActive) {
-        ppu0->UpdateTimeBase(125);
-        ppu1->UpdateTimeBase(125);
-        ppu2->UpdateTimeBase(125);
-      }
-      // Update our start cycle.
-      startCycle = __rdtsc();
-      // Add our target cycles amount.
-      nextCycle = startCycle + targetCPUCycles;
+  void XenonCPU::Suspend() {
+    for (PPU *ppu : { ppu0.get(), ppu1.get(), ppu2.get() }) {
+      if (ppu)
+        ppu->Suspend();
     }
-#else
-    using clock = std::chrono::high_resolution_clock;
-    auto last = clock::now();
-    auto now = clock::now();
-
-    while (timeBaseThreadActive.load()) {
-      // Sleep a little to avoid burning CPU. We compute elapsed and convert to ticks.
-      // The lower we sleep, the more accurate the timebase will be, but it will also be more CPU intensive.
-      last = now;
-      std::this_thread::sleep_for(std::chrono::microseconds(100));
-      now = clock::now();
-      auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - last).count();
-      if (elapsed <= 0) continue;
-      // Xbox 360 timebase = 50 MHz -> period = 20 ns per tick
-      // ticks = elapsed_ns / 20
-      u64 ticks = static_cast<u64>(elapsed) / 20ULL;
-      if (ticks == 0) continue;
-      // Accumulate globally
-      if (xenonContext->timeBaseActive) {
-        ppu0->UpdateTimeBase(ticks);
-        ppu1->UpdateTimeBase(ticks);
-        ppu2->UpdateTimeBase(ticks);
+  }
+
+  void XenonCPU::Resume() {
+    for (PPU *ppu : { ppu0.get(), ppu1.get(), ppu2.get() }) {
+      if (ppu)
+        ppu->Resume();
+    }
+  }
+
+  void XenonCPU::SaveState(Base::StateWriter &writer) {
+    xenonContext->SaveState(writer);
+    for (PPU *ppu : { ppu0.get(), ppu1.get(), ppu2.get() }) {
+      writer.Write<bool>(ppu != nullptr);
+      if (ppu)
+        ppu->SaveState(writer);
+    }
+  }
+
+  void XenonCPU::LoadState(Base::StateReader &reader) {
+    xenonContext->LoadState(reader);
+    for (PPU *ppu : { ppu0.get(), ppu1.get(), ppu2.get() }) {
+      const bool present = reader.Read<bool>();
+      if (present != (ppu != nullptr)) {
+        LOG_ERROR(Xenon, "Save state PPU layout doesn't match the running one.");
+        reader.Fail();
+        return;
       }
+      if (ppu)
+        ppu->LoadState(reader);
     }
-#endif // _WIN32
   }
 
 } // Xe::XCPU
\ No newline at end of file
@@ -23,13 +23,18 @@ namespace Xe::XCPU {
   // - 768 bits of IBM's eFuse technology.
   class XenonCPU {
   public:
-    XenonCPU(RootBus *inBus, const std::string blPath, const std::string fusesPath, RAM *ramPtr);
+    XenonCPU(RootBus *inBus, const std::string blPath, const std::string fusesPath, RAM *ramPtr,
+      XenonScheduler *schedulerPtr);
     ~XenonCPU();
 
     // Starts the CPU at the given reset vector. (Usually address 0x100).
     void Start(u64 resetVector = 0x100);
     // Resets the CPU to POR state and efectively restarts execution.
     void Reset();
+    // Puts the context and every PPU back to their state when execution started, in place, so it starts over from
+    // the reset vector. Only while suspended, with RAM and the devices reset too. Returns false if it can't be done
+    // in place (ELF loader, nothing started yet), the CPU has to be recreated then.
+    bool SoftReset();
     // Halts one or more cores.
     void Halt(u64 haltOn = 0, bool requestedByGuest = false, u8 ppuId = 0, ePPUThreadID threadId = ePPUThread_Zero);
     // Continues execution on all enabled cores after a Halt was issued.
@@ -46,26 +51,30 @@ namespace Xe::XCPU {
     bool IsHaltedByGuest();
     // Returns the IIC pointer from our context.  
     XenonIIC *GetIICPointer() { return &xenonContext->iic; }
+    // Returns the execution breakpoints.
+    XenonBreakpoints &GetBreakpoints() { return xenonContext->breakpoints; }
+    // Returns the HLE routine hooks.
+    HLE::XenonHLE &GetHLE() { return xenonContext->hle; }
     // Returns a pointer to a given PPU.
     PPU *GetPPU(u8 ppuID);
+    // Parks every PPU at its next slice boundary, and lets them go again. See PPU::Suspend.
+    void Suspend();
+    void Resume();
+    // Save state, the context and all PPUs. Only while suspended.
+    void SaveState(Base::StateWriter &writer);
+    void LoadState(Base::StateReader &reader);
 
   private:
     // Global Xenon CPU Content (shared between PPUs)
     std::unique_ptr<XenonContext> xenonContext;
 
-    // TimeBase frequency timer
-    std::chrono::high_resolution_clock::time_point timeBaseUpdate{};
-
-    // High resolution timer thread for accumulating timebase ticks.
-    std::thread timeBaseThread{};
-    std::atomic<bool> timeBaseThreadActive{ false };
-    // Timer thread loop function.
-    void timeBaseThreadLoop();
-
     // Power Processing Units, the effective execution units inside the Xbox 360 CPU.
     std::unique_ptr<PPU> ppu0{};
     std::unique_ptr<PPU> ppu1{};
     std::unique_ptr<PPU> ppu2{};
+
+    // Running an ELF, it's gone once RAM is reset
+    bool elfLoaded = false;
   };
 
 } // Xe::XCPU
\ No newline at end of file
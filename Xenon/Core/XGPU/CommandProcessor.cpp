@@ -15,13 +15,17 @@
 * documenting this complex system.
 */
 
+#include <algorithm>
+
 #include "CommandProcessor.h"
 #include "ShaderConstants.h"
 #include "Microcode/ASTBlock.h"
 #include "Microcode/ASTNodeWriter.h"
 
+#include "Base/ByteSwap.h"
 #include "Base/CRCHash.h"
 #include "Base/Thread.h"
+#include "Base/Topology.h"
 
 #include "Render/Abstractions/Renderer.h"
 
@@ -96,6 +100,7 @@ void CommandProcessor::CPUpdateRBBase(u32 address) {
   if (!address)
     return;
 
+  cpRingBufferBaseAddress = address;
   cpRingBufferBasePtr = ram->GetPointerToAddress(address);
   LOG_DEBUG(Xenos, "CP: Updating RingBuffer Base Address: 0x{:X}", address);
   
@@ -115,8 +120,70 @@ void CommandProcessor::CPUpdateRBWritePointer(u32 offset) {
   cpWritePtrIndex = offset;
 }
 
+bool CommandProcessor::CPWaitIdle(std::chrono::milliseconds timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (cpWorkerThreadRunning && cpRingBufferBasePtr != nullptr && cpReadPtrIndex != cpWritePtrIndex) {
+    if (std::chrono::steady_clock::now() >= deadline)
+      return false;
+    std::this_thread::sleep_for(100us);
+  }
+  return true;
+}
+
+void CommandProcessor::SaveState(Base::StateWriter &writer) {
+  const auto writeMap = [&writer](const std::unordered_map<u32, u32> &map) {
+    // Sorted, so the same state always saves the same
+    std::vector<std::pair<u32, u32>> entries(map.begin(), map.end());
+    std::sort(entries.begin(), entries.end());
+    writer.WriteVector(entries);
+  };
+  writer.Write(cpPFPuCodeAddress);
+  writer.Write(cpMEuCodeWriteAddress);
+  writer.Write(cpMEuCodeReadAddress);
+  writer.Write(cpMEuCodeSize);
+  writeMap(cpMEuCodeData);
+  writer.Write(cpPFPuCodeSize);
+  writeMap(cpPFPuCodeData);
+  writer.WriteVector(cpME_PM4_ME_INIT_Data);
+  writer.Write(cpRingBufferBaseAddress);
+  writer.Write<u64>(cpRingBufferSize.load());
+  writer.Write<u32>(cpReadPtrIndex.load());
+  writer.Write<u32>(cpWritePtrIndex.load());
+  writer.Write(binSelect);
+  writer.Write(binMask);
+}
+
+void CommandProcessor::LoadState(Base::StateReader &reader) {
+  const auto readMap = [&reader](std::unordered_map<u32, u32> &map) {
+    std::vector<std::pair<u32, u32>> entries = {};
+    reader.ReadVector(entries);
+    map.clear();
+    map.insert(entries.begin(), entries.end());
+  };
+  reader.Read(cpPFPuCodeAddress);
+  reader.Read(cpMEuCodeWriteAddress);
+  reader.Read(cpMEuCodeReadAddress);
+  reader.Read(cpMEuCodeSize);
+  readMap(cpMEuCodeData);
+  reader.Read(cpPFPuCodeSize);
+  readMap(cpPFPuCodeData);
+  reader.ReadVector(cpME_PM4_ME_INIT_Data);
+  reader.Read(cpRingBufferBaseAddress);
+  cpRingBufferSize = static_cast<size_t>(reader.Read<u64>());
+  const u32 readIndex = reader.Read<u32>();
+  const u32 writeIndex = reader.Read<u32>();
+  reader.Read(binSelect);
+  reader.Read(binMask);
+  // Indexes first, the worker must not see the new buffer with the old ones
+  cpRingBufferBasePtr = nullptr;
+  cpReadPtrIndex = readIndex;
+  cpWritePtrIndex = writeIndex;
+  cpRingBufferBasePtr = cpRingBufferBaseAddress ? ram->GetPointerToAddress(cpRingBufferBaseAddress) : nullptr;
+}
+
 void CommandProcessor::cpWorkerThreadLoop() {
   Base::SetCurrentThreadName("[Xe] Command Processor");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::GPU);
   while (cpWorkerThreadRunning) {
     u32 writePtrIndex = cpWritePtrIndex.load();
     while (cpWorkerThreadRunning && (cpRingBufferBasePtr == nullptr || cpReadPtrIndex == writePtrIndex)) {
@@ -516,6 +583,7 @@ bool CommandProcessor::ExecutePacketType3_COND_WRITE(RingBuffer *ringBuffer, u32
       u8 *addrPtr = ram->GetPointerToAddress(static_cast<u32>(writeReg) & ~0x3);
       writeData = xeEndianSwap(writeData, endianness);
       memcpy(addrPtr, &writeData, sizeof(writeData));
+      ram->MarkDirtyHost(addrPtr, sizeof(writeData));
     } else { // Register
       state->WriteRegister(writeReg, writeData);
     }
@@ -531,10 +599,8 @@ bool CommandProcessor::ExecutePacketType3_INVALIDATE_STATE(RingBuffer *ringBuffe
 
 bool CommandProcessor::ExecutePacketType3_ME_INIT(RingBuffer *ringBuffer, u32 packetData, u32 dataCount) {
   // Initializes Command Processor's ME.
-  cpME_PM4_ME_INIT_Data.clear();
-  for (size_t i = 0; i < dataCount; i++) {
-    cpME_PM4_ME_INIT_Data.push_back(ringBuffer->ReadAndSwap<u32>());
-  }
+  cpME_PM4_ME_INIT_Data.resize(dataCount);
+  ringBuffer->ReadAndSwap(cpME_PM4_ME_INIT_Data.data(), dataCount);
   return true;
 }
 
@@ -653,10 +719,7 @@ bool CommandProcessor::ExecutePacketType3_IM_LOAD(RingBuffer *ringBuffer, u32 pa
   std::vector<u32> data{};
   u32 dwordCount = size / 4;
   data.resize(dwordCount);
-  memcpy(data.data(), addrPtr, size);
-  for (u32 &value : data) { 
-    value = byteswap_be(value);
-  }
+  Base::ByteSwap::CopySwapBE(data.data(), reinterpret_cast<const u32*>(addrPtr), dwordCount);
   
   fs::path shaderPath{ Base::FS::GetUserPath(Base::FS::PathType::ShaderDir) / "cache" };
   std::string typeString = shaderType == Xe::eShaderType::Pixel ? "pixel" : "vertex";
@@ -704,10 +767,7 @@ bool CommandProcessor::ExecutePacketType3_IM_LOAD_IMMEDIATE(RingBuffer *ringBuff
   
   std::vector<u32> data{};
   data.resize(sizeDwords);
-  ringBuffer->Read(data.data(), data.size());
-  for (u32 &value : data) {
-    value = byteswap_be(value);
-  }
+  ringBuffer->ReadAndSwap(data.data(), data.size());
 
   fs::path shaderPath{ Base::FS::GetUserPath(Base::FS::PathType::ShaderDir) / "cache" };
   std::string typeString = shaderType == Xe::eShaderType::Pixel ? "pixel" : "vertex";
@@ -766,9 +826,10 @@ bool CommandProcessor::ExecutePacketType3_SET_CONSTANT(RingBuffer *ringBuffer, u
   }
 
   // Write constants
-  for (u32 n = 0; n < dataCount - 1; n++, index++) {
-    const u32 data = ringBuffer->ReadAndSwap<u32>();
-    state->WriteRegister(static_cast<XeRegister>(index), data);
+  constantData.resize(dataCount - 1);
+  ringBuffer->ReadAndSwap(constantData.data(), constantData.size());
+  for (const u32 data : constantData) {
+    state->WriteRegister(static_cast<XeRegister>(index++), data);
   }
 
   return true;
@@ -802,9 +863,10 @@ bool CommandProcessor::ExecutePacketType3_SET_CONSTANT2(RingBuffer *ringBuffer,
   u32 index = offsetType & 0xFFFF;
 
   // Write constants
-  for (u32 n = 0; n < dataCount - 1; n++, index++) {
-    const u32 data = ringBuffer->ReadAndSwap<u32>();
-    state->WriteRegister(static_cast<XeRegister>(index), data);
+  constantData.resize(dataCount - 1);
+  ringBuffer->ReadAndSwap(constantData.data(), constantData.size());
+  for (const u32 data : constantData) {
+    state->WriteRegister(static_cast<XeRegister>(index++), data);
   }
 
   return true;
@@ -816,9 +878,10 @@ bool CommandProcessor::ExecutePacketType3_SET_SHADER_CONSTANTS(RingBuffer *ringB
   u32 index = offsetType & 0xFFFF;
 
   // Write constants
-  for (u32 n = 0; n < dataCount - 1; n++, index++) {
-    const u32 data = ringBuffer->ReadAndSwap<u32>();
-    state->WriteRegister(static_cast<XeRegister>(index), data);
+  constantData.resize(dataCount - 1);
+  ringBuffer->ReadAndSwap(constantData.data(), constantData.size());
+  for (const u32 data : constantData) {
+    state->WriteRegister(static_cast<XeRegister>(index++), data);
   }
   return true;
 }
@@ -851,6 +914,7 @@ bool CommandProcessor::ExecutePacketType3_EVENT_WRITE_SHD(RingBuffer *ringBuffer
 
   u8 *addrPtr = ram->GetPointerToAddress(address);
   memcpy(addrPtr, &writeValue, sizeof(writeValue));
+  ram->MarkDirtyHost(addrPtr, sizeof(writeValue));
 
   return true;
 }
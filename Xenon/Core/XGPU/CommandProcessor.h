@@ -104,6 +104,13 @@ public:
 
   void CPSetSQProgramCntl(u32 value);
 
+  // Waits until everything submitted so far has been processed, for at most timeout. Returns false on timeout.
+  bool CPWaitIdle(std::chrono::milliseconds timeout);
+
+  // Save state. Only while idle, see CPWaitIdle.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
+
 private:
   // PCI Bridge pointer. Used for interrupts
   PCIBridge *parentBus{};
@@ -145,6 +152,8 @@ private:
   std::unordered_map<u32, u32> cpPFPuCodeData;
   // CP ME for PM4_ME_INIT data
   std::vector<u32> cpME_PM4_ME_INIT_Data;
+  // Scratch buffer for SET_CONSTANT* packets, swapped in bulk
+  std::vector<u32> constantData;
 
   // Basically, the driver sets the CP write base to an address in memory where
   // the RingBuffer is located, and after it stores a Read Pointer to the location
@@ -154,6 +163,8 @@ private:
   // Since we don't have to deal with buffers, and simply read/write to memory, 
   // we can directly use pointers to real memory like hardware does.
 
+  // CP RingBuffer Base Address, as set by the guest.
+  u32 cpRingBufferBaseAddress = 0;
   // CP RingBuffer Base Address in memory.
   std::atomic<u8*> cpRingBufferBasePtr = nullptr;
   
@@ -161,7 +172,7 @@ private:
   std::atomic<size_t> cpRingBufferSize = 0;
 
   // Read/Write indexes.
-  u32 cpReadPtrIndex = 0;
+  std::atomic<u32> cpReadPtrIndex = 0;
   std::atomic<u32> cpWritePtrIndex = 0;
 
   // Execute primary buffer from CP_RB_BASE.
@@ -125,3 +125,41 @@ u32 Xe::XGPU::EDRAM::ReadCRC_AZ1_BC() {
   if (edramState.get()->az1BCRegIndex >= 6) { edramState.get()->az1BCRegIndex = 0; }
   return byteswap_be<u32>(data);
 }
+
+void Xe::XGPU::EDRAM::SaveState(Base::StateWriter &writer) {
+  const EDRAMState &state = *edramState;
+  writer.Write(state.edramBusy);
+  writer.Write(state.readRegisterIndex);
+  writer.Write(state.writeRegisterIndex);
+  writer.Write(state.readData);
+  writer.WriteVector(state.edramRegs);
+  writer.Write(state.az0BCRegIndex);
+  writer.Write(state.az1BCRegIndex);
+  writer.Write(state.reg41Index);
+  writer.Write(state.reg1041Index);
+  writer.WriteVector(state.az0Data);
+  writer.WriteVector(state.az1Data);
+  writer.WriteVector(state.reg41Data);
+  writer.WriteVector(state.reg1041Data);
+}
+
+void Xe::XGPU::EDRAM::LoadState(Base::StateReader &reader) {
+  EDRAMState &state = *edramState;
+  reader.Read(state.edramBusy);
+  reader.Read(state.readRegisterIndex);
+  reader.Read(state.writeRegisterIndex);
+  reader.Read(state.readData);
+  reader.ReadVector(state.edramRegs);
+  if (state.edramRegs.size() != MAX_EDRAM_REGS) {
+    reader.Fail();
+    state.edramRegs.resize(MAX_EDRAM_REGS);
+  }
+  reader.Read(state.az0BCRegIndex);
+  reader.Read(state.az1BCRegIndex);
+  reader.Read(state.reg41Index);
+  reader.Read(state.reg1041Index);
+  reader.ReadVector(state.az0Data);
+  reader.ReadVector(state.az1Data);
+  reader.ReadVector(state.reg41Data);
+  reader.ReadVector(state.reg1041Data);
+}
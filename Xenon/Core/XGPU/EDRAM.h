@@ -6,6 +6,7 @@
 
 #include <stdlib.h>
 
+#include "Base/StateStream.h"
 #include "Base/Types.h"
 #include "Base/Logging/Log.h"
 
@@ -83,6 +84,9 @@ public:
 
   // Returns true if the edram is currently busy with work.
   bool isEdramBusy() { return edramState.get()->edramBusy; };
+  // Save state.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
 private:
   std::unique_ptr<EDRAMState> edramState = {};
 };
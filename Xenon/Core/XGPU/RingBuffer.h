@@ -2,6 +2,7 @@
 /* Copyright 2025 Xenon Emulator Project. All rights reserved. */
 /***************************************************************/
 
+#include "Base/ByteSwap.h"
 #include "Base/Logging/Log.h"
 #include <mutex>
 
@@ -84,6 +85,15 @@ namespace Xe::XGPU {
       return imm;
     }
 
+    // Performs a read of count values at current buffer position and byteswaps them all at once.
+    template <typename T>
+    size_t ReadAndSwap(T *buffer, size_t count) {
+      std::lock_guard lock(mutex);
+      const size_t read = Read(reinterpret_cast<u8*>(buffer), count * sizeof(T));
+      Base::ByteSwap::SwapBE<T>(buffer, read / sizeof(T));
+      return read / sizeof(T);
+    }
+
     size_t Write(const u8 *buffer, size_t count);
     template <typename T>
     size_t Write(const T *buffer, size_t count) {
@@ -17,9 +17,16 @@
 #define XE_DEBUG
 #endif
 
-Xe::Xenos::XGPU::XGPU(Render::Renderer *renderer, RAM *ram, PCIBridge *pciBridge) :
+// VSYNC period.
+// Should be a 60Hz (16.6ms) timer, for testing purposes and because we're currently too slow we're setting up to 1s.
+// This actually controls the frequency in wich the kernel does Back -> Front buffer VdSwap commands, so by changing
+// this we effectively can control the refresh rate of the emulated console (as long as the system runs fast enough).
+#define XE_VSYNC_PERIOD 1s
+
+Xe::Xenos::XGPU::XGPU(Render::Renderer *renderer, RAM *ram, PCIBridge *pciBridge,
+  Xe::XCPU::XenonScheduler *schedulerPtr) :
   render(renderer),
-  ramPtr(ram), parentBus(pciBridge) {
+  ramPtr(ram), parentBus(pciBridge), scheduler(schedulerPtr) {
   edram = std::make_unique<STRIP_UNIQUE(edram)>();
 
   xenosState = std::make_unique<STRIP_UNIQUE(xenosState)>(ramPtr, edram.get(), nullptr);
@@ -111,16 +118,16 @@ Xe::Xenos::XGPU::XGPU(Render::Renderer *renderer, RAM *ram, PCIBridge *pciBridge
   commandProcessor = std::make_unique<STRIP_UNIQUE(commandProcessor)>(ramPtr, xenosState.get(), render, parentBus);
   xenosState->commandProcessor = commandProcessor.get(); // CP expects xenosState, xenosState expects CP, this fixes it.
 
-  xeVSyncWorkerThread = std::thread(&XGPU::xeVSyncWorkerThreadLoop, this);
+  // Start VSYNC
+  vsyncEvent = scheduler->RegisterEvent("Xenos VSYNC", [this](u64 dueTick, u64 currentTick) {
+    xeVSyncEvent(dueTick, currentTick);
+  });
+  scheduler->ScheduleEvent(vsyncEvent, Xe::XCPU::XenonScheduler::ToTicks(XE_VSYNC_PERIOD));
 }
 
 Xe::Xenos::XGPU::~XGPU() {
-  // Kill VSync Thread
-  xeVsyncWorkerThreadRunning = false;
-  // Wait for things to finish
-  if (xeVSyncWorkerThread.joinable()) {
-    xeVSyncWorkerThread.join();
-  }
+  // Stop VSYNC, waits for a running callback
+  scheduler->UnregisterEvent(vsyncEvent);
   // Reset other handles
   commandProcessor.reset();
   xenosState.reset();
@@ -241,6 +248,18 @@ bool Xe::Xenos::XGPU::IsAddressMappedInBAR(u32 address) {
   return false;
 }
 
+u32 Xe::Xenos::XGPU::GetBAR(u8 index) {
+  switch (index) {
+  case 0: return xgpuConfigSpace.configSpaceHeader.BAR0;
+  case 1: return xgpuConfigSpace.configSpaceHeader.BAR1;
+  case 2: return xgpuConfigSpace.configSpaceHeader.BAR2;
+  case 3: return xgpuConfigSpace.configSpaceHeader.BAR3;
+  case 4: return xgpuConfigSpace.configSpaceHeader.BAR4;
+  case 5: return xgpuConfigSpace.configSpaceHeader.BAR5;
+  }
+  return 0;
+}
+
 void Xe::Xenos::XGPU::DumpFB(const std::filesystem::path &path, s32 pitch) {
   std::ofstream f(path, std::ios::out | std::ios::binary | std::ios::trunc);
   if (!f) {
@@ -252,33 +271,36 @@ void Xe::Xenos::XGPU::DumpFB(const std::filesystem::path &path, s32 pitch) {
   f.close();
 }
 
-void Xe::Xenos::XGPU::xeVSyncWorkerThreadLoop() {
-  LOG_INFO(Xenos, "Entering VSYNC Worker thread.");
-
-  // VSync timer start
-  std::chrono::steady_clock::time_point timerStart =
-    std::chrono::steady_clock::now();
-
-  while (xeVsyncWorkerThreadRunning) {
-    // Ensure we haven't shutdown elsewhere
-    xeVsyncWorkerThreadRunning = XeRunning;
-    if (!xeVsyncWorkerThreadRunning)
-      break;
-    // Measure elapsed time since last check.
-    std::chrono::steady_clock::time_point timerNow =
-      std::chrono::steady_clock::now();
-    // Should be a 60Hz (16.6ms) timer, for testing purposes and because we're currently too slow we're setting up to 1s.
-    // This actually controls the frequency in wich the kernel does Back -> Front buffer VdSwap commands, so by changing 
-    // this we effectively can control the refresh rate of the emulated console (as long as the system runs fast enough). 
-    if (timerNow >= timerStart + 1s && (xenosState.get()->d1modeIntMask & 0x40000011)) {
-      // Set  VBLANK Pending
-      xenosState.get()->vblankVlineStatus |= 0x11000100; // Hardware dump shows this (byteswapped) value at interrupt time.
-      xenosState.get()->d1modeIntMask &= ~0x40000011;
-      parentBus->RouteInterrupt(PRIO_GRAPHICS, 4); // Debugging on hardware shows #2 is the correct CPU ID.
-
-      // Update internal timer.
-      timerStart = std::chrono::steady_clock::now();
-    }
+bool Xe::Xenos::XGPU::WaitIdle(std::chrono::milliseconds timeout) {
+  return commandProcessor->CPWaitIdle(timeout);
+}
+
+void Xe::Xenos::XGPU::SaveState(Base::StateWriter &writer) {
+  std::lock_guard lck(mutex);
+  writer.Write(xgpuConfigSpace);
+  writer.Write(pciDevSizes);
+  xenosState->SaveState(writer);
+  edram->SaveState(writer);
+  commandProcessor->SaveState(writer);
+}
+
+void Xe::Xenos::XGPU::LoadState(Base::StateReader &reader) {
+  std::lock_guard lck(mutex);
+  reader.Read(xgpuConfigSpace);
+  reader.Read(pciDevSizes);
+  xenosState->LoadState(reader);
+  edram->LoadState(reader);
+  commandProcessor->LoadState(reader);
+}
+
+void Xe::Xenos::XGPU::xeVSyncEvent(u64 dueTick, u64 currentTick) {
+  if (xenosState.get()->d1modeIntMask & 0x40000011) {
+    // Set  VBLANK Pending
+    xenosState.get()->vblankVlineStatus |= 0x11000100; // Hardware dump shows this (byteswapped) value at interrupt time.
+    xenosState.get()->d1modeIntMask &= ~0x40000011;
+    parentBus->RouteInterrupt(PRIO_GRAPHICS, 4); // Debugging on hardware shows #2 is the correct CPU ID.
   }
-  LOG_INFO(Xenos, "Exiting VSYNC Worker thread.");
-}
\ No newline at end of file
+  // Keep a steady cadence, but don't try to catch up on frames missed while nothing ran
+  const u64 period = Xe::XCPU::XenonScheduler::ToTicks(XE_VSYNC_PERIOD);
+  scheduler->ScheduleEventAt(vsyncEvent, std::max(dueTick + period, currentTick + 1));
+}
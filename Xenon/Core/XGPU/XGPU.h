@@ -17,6 +17,7 @@
 #include "Core/XGPU/XenosRegisters.h"
 #include "Core/XGPU/CommandProcessor.h"
 #include "Core/PCI/PCIe.h"
+#include "Core/XCPU/Context/Scheduler/XenonScheduler.h"
 
 /*
  *	XGPU.h Basic Xenos implementation.
@@ -31,7 +32,7 @@ namespace Xenos {
 
 class XGPU {
 public:
-  XGPU(Render::Renderer *renderer, RAM *ram, PCIBridge *pciBridge);
+  XGPU(Render::Renderer *renderer, RAM *ram, PCIBridge *pciBridge, Xe::XCPU::XenonScheduler *schedulerPtr);
   ~XGPU();
 
   // Memory Read/Write methods.
@@ -44,9 +45,23 @@ public:
 
   bool IsAddressMappedInBAR(u32 address);
 
+  // Returns the base address of the given BAR
+  u32 GetBAR(u8 index);
+
   // Dump framebuffer from RAM
   void DumpFB(const std::filesystem::path &path, s32 pitch);
 
+  // Waits for the command processor to go through everything submitted so far. Returns false on timeout.
+  bool WaitIdle(std::chrono::milliseconds timeout);
+
+  // Save state, config space, registers, EDRAM and the command processor. Only while idle.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
+
+  // Power-on state. Reset puts it back in place, only while idle. Whatever the renderer built stays around.
+  void CapturePowerOnState() { powerOnState.Capture(*this); }
+  void Reset() { powerOnState.Restore(*this); }
+
   u32 GetSurface() {
     return xenosState->fbSurfaceAddress;
   }
@@ -84,16 +99,19 @@ private:
   // Command Processor
   std::unique_ptr<Xe::XGPU::CommandProcessor> commandProcessor = {};
 
-  // Vertical Sync Worker thread
-  std::thread xeVSyncWorkerThread;
+  // Event scheduler, drives VSYNC
+  Xe::XCPU::XenonScheduler *scheduler = nullptr;
 
-  // VSYNC Worker thread running
-  volatile bool xeVsyncWorkerThreadRunning = true;
+  // Vertical Sync event
+  Xe::XCPU::SchedulerEventID vsyncEvent = Xe::XCPU::schedulerInvalidEvent;
 
-  // Vertical Sync Worker Thread Loop
+  // Vertical Sync event callback
   // Should fire an interrupt to a given CPU every time a vertical sync event happens.
   // Normally this is the spped of the display's refresh rate.
-  void xeVSyncWorkerThreadLoop();
+  void xeVSyncEvent(u64 dueTick, u64 currentTick);
+
+  // State at power-on, see Reset
+  Base::StateSnapshot powerOnState = {};
 };
 } // namespace Xenos
 } // namespace Xe
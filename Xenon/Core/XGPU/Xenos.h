@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "Base/ByteSwap.h"
 #include "Base/Types.h"
 
 // Contains Xenos related enums and structures.
@@ -227,4 +228,33 @@ inline float xeEndianSwap(float value, eEndian endianness) {
   v.f = value;
   v.i = xeEndianSwap(v.i, endianness);
   return v.f;
-}
\ No newline at end of file
+}
+
+// Bulk variants of xeEndianSwap, copies count values from src to dst swapping them as they go.
+inline void xeEndianCopySwap(u16 *dst, const u16 *src, size_t count, eEndian endianness) {
+  switch (endianness) {
+  case eEndian::xe8in16:
+    Base::ByteSwap::CopySwap16(dst, src, count);
+    break;
+  default:
+    std::memcpy(dst, src, count * sizeof(u16));
+    break;
+  }
+}
+
+inline void xeEndianCopySwap(u32 *dst, const u32 *src, size_t count, eEndian endianness) {
+  switch (endianness) {
+  case eEndian::xe8in16:
+    Base::ByteSwap::CopySwap16(dst, src, count * 2);
+    break;
+  case eEndian::xe8in32:
+    Base::ByteSwap::CopySwapBE<u32>(dst, src, count);
+    break;
+  case eEndian::xe16in32:
+    Base::ByteSwap::CopySwap16In32(dst, src, count);
+    break;
+  default:
+    std::memcpy(dst, src, count * sizeof(u32));
+    break;
+  }
+}
@@ -28,6 +28,112 @@ Xe::XGPU::XenosState::~XenosState() {
   Regs.reset();
 }
 
+template <typename Visitor>
+void Xe::XGPU::XenosState::VisitState(Visitor &&visit) {
+  visit(fbSurfaceAddress);
+  visit(framebufferDisable);
+  visit(configControl);
+  visit(scratchMask);
+  visit(scratchAddr);
+  visit(scratch);
+  visit(waitUntil);
+  visit(rbbmControl);
+  visit(rbbmDebug);
+  visit(rbbmStatus);
+  visit(rbbmSoftReset);
+  visit(surfaceInfo);
+  visit(colorInfo);
+  visit(depthInfo);
+  visit(color1Info);
+  visit(color2Info);
+  visit(color3Info);
+  visit(blendRed);
+  visit(blendGreen);
+  visit(blendBlue);
+  visit(blendAlpha);
+  visit(stencilReferenceMask);
+  visit(depthControl);
+  visit(blendControl0);
+  visit(tileControl);
+  visit(modeControl);
+  visit(blendControl1);
+  visit(blendControl2);
+  visit(blendControl3);
+  visit(copyControl);
+  visit(copyDestBase);
+  visit(copyDestPitch);
+  visit(copyDestInfo);
+  visit(depthClear);
+  visit(clearColor);
+  visit(clearColorLo);
+  visit(copyFunction);
+  visit(copyReference);
+  visit(copyMask);
+  visit(maxVertexIndex);
+  visit(minVertexIndex);
+  visit(indexOffset);
+  visit(multiPrimitiveIndexBufferResetIndex);
+  visit(currentBinIdMin);
+  visit(vgtDrawInitiator);
+  visit(vgtDMABase);
+  visit(vgtDMASize);
+  visit(viewportControl);
+  visit(windowOffset);
+  visit(windowScissorTl);
+  visit(windowScissorBr);
+  visit(viewportXOffset);
+  visit(viewportYOffset);
+  visit(viewportZOffset);
+  visit(viewportXScale);
+  visit(viewportYScale);
+  visit(viewportZScale);
+  visit(programCntl);
+  visit(crtcControl);
+  visit(modeViewportSize);
+  visit(vCounter);
+  visit(vblankStatus);
+  visit(vblankVlineStatus);
+  visit(d1modeIntMask);
+  visit(mhStatus);
+  visit(coherencySizeHost);
+  visit(coherencyBaseHost);
+  visit(coherencyStatusHost);
+  visit(edramTiming);
+  visit(edramInfo);
+  visit(dcLutAutofill);
+  visit(xdvoEnable);
+  visit(xdvoBitDepthControl);
+  visit(xdvoClockInv);
+  visit(xdvoControl);
+  visit(xdvoCrcEnable);
+  visit(xdvoCrcControl);
+  visit(xdvoCrcMaskSignalRGB);
+  visit(xdvoCrcMaskSignalControl);
+  visit(xdvoCrcSignalRGB);
+  visit(xdvoCrcSignalControl);
+  visit(xdvoStrengthControl);
+  visit(xdvoDataStrengthControl);
+  visit(xdvoForceOutputControl);
+  visit(xdvoRegisterIndex);
+  visit(xdvoRegisterData);
+  visit(floatConsts);
+  visit(boolConsts);
+}
+
+void Xe::XGPU::XenosState::SaveState(Base::StateWriter &writer) {
+  std::lock_guard lck(mutex);
+  VisitState([&writer](const auto &field) { writer.Write(field); });
+  writer.WriteCompressed(Regs.get(), 0xFFFFF);
+  writer.Write(RegMask);
+}
+
+void Xe::XGPU::XenosState::LoadState(Base::StateReader &reader) {
+  std::lock_guard lck(mutex);
+  VisitState([&reader](auto &field) { reader.Read(field); });
+  reader.ReadCompressed(Regs.get(), 0xFFFFF);
+  reader.Read(RegMask);
+}
+
 u32 Xe::XGPU::XenosState::ReadRawRegister(u32 addr, u32 size) {
   // Set a lock
   std::lock_guard lck(mutex);
@@ -467,6 +573,7 @@ void Xe::XGPU::XenosState::WriteRawRegister(u32 addr, u32 value) {
 #endif
       u8 *memPtr = ramPtr->GetPointerToAddress(memAddr);
       memcpy(memPtr, &scratch[scratchRegIndex], sizeof(scratch[scratchRegIndex]));
+      ramPtr->MarkDirty(memAddr, sizeof(scratch[scratchRegIndex]));
     }
   } break;
   case XeRegister::MH_STATUS:
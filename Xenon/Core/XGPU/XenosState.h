@@ -80,6 +80,10 @@ public:
     return RegMask[firstIndex / BitCount];
   }
 
+  // Save state. The internal resolution is host configuration and isn't part of it.
+  void SaveState(Base::StateWriter &writer);
+  void LoadState(Base::StateReader &reader);
+
   // Mutex
   std::recursive_mutex mutex{};
 
@@ -222,6 +226,10 @@ public:
   static constexpr u32 BitCount = sizeof(u64) * 8;
   static constexpr u32 BlockCount = (NumRegs + BitCount - 1) / BitCount;
   u64 RegMask[BlockCount] = {};
+private:
+  // Calls visit on every saved field, in save order.
+  template <typename Visitor>
+  void VisitState(Visitor &&visit);
 };
 
 } // namespace Xe::XGPU
@@ -4,6 +4,8 @@
 
 #include "XeMain.h"
 
+#include "Base/ByteSwap.h"
+#include "Base/Topology.h"
 #include "Render/Backends/Vulkan/VulkanRenderer.h"
 
 void XeMain::Create() {
@@ -11,62 +13,93 @@ void XeMain::Create() {
   Base::Log::Initialize();
   Base::Log::Start();
   LOG_INFO(System, "Starting Xenon.");
+  Base::ByteSwap::Initialize();
   rootDirectory = Base::FS::GetUserPath(Base::FS::PathType::RootDir);
   LoadConfig();
   Base::Log::Filter logFilter{ Config::log.currentLevel };
   Base::Log::SetGlobalFilter(logFilter);
+  // Decide where our threads go before any of them starts
+  Base::Topology::Initialize();
+
+  // Devices are brought up in parallel, each one as soon as what it needs is there
+  Base::TaskGraph startup("Startup");
+  const auto schedulerTask = startup.Add("Scheduler", [] {
+    // Create the event scheduler, everything timed runs off it
+    scheduler = std::make_unique<STRIP_UNIQUE(scheduler)>();
+  });
+  const auto ramTask = startup.Add("RAM", [] {
+    ram = std::make_shared<STRIP_UNIQUE(ram)>("RAM", RAM_START_ADDR, Config::xcpu.ramSize, false);
+  });
 #ifndef NO_GFX
-  switch (Base::JoaatStringHash(Config::rendering.backend)) {
-  case "OpenGL"_jLower:
-    renderer = std::make_unique<Render::OGLRenderer>();
-    break;
-  case "Vulkan"_jLower:
-    renderer = std::make_unique<Render::VulkanRenderer>();
-    break;
-  case "Dummy"_jLower:
-    renderer = std::make_unique<Render::DummyRenderer>();
-    break;
-  default:
-    LOG_ERROR(Render, "Invalid renderer backend: {}", Config::rendering.backend);
-    break;
-  }
+  // The window must be created on the main thread
+  const auto rendererTask = startup.Add("Renderer", [] {
+    switch (Base::JoaatStringHash(Config::rendering.backend)) {
+    case "OpenGL"_jLower:
+      renderer = std::make_unique<Render::OGLRenderer>();
+      break;
+    case "Vulkan"_jLower:
+      renderer = std::make_unique<Render::VulkanRenderer>();
+      break;
+    case "Dummy"_jLower:
+      renderer = std::make_unique<Render::DummyRenderer>();
+      break;
+    default:
+      LOG_ERROR(Render, "Invalid renderer backend: {}", Config::rendering.backend);
+      break;
+    }
+    // Handles and shaders are created on the render thread, we don't wait for them
+    if (renderer)
+      renderer->Start(ram.get());
+  }, { ramTask }, true);
 #endif
-
-  // Create RAM
-  ram = std::make_shared<STRIP_UNIQUE(ram)>("RAM", RAM_START_ADDR, Config::xcpu.ramSize, false);
-
-  // Create bridges
-  CreateBridges();
-
-  // Start renderer
+  const auto ioPoolTask = startup.Add("I/O Pool", [] {
+    // Create the device I/O pool, storage devices submit their transfers to it
+    ioPool = std::make_unique<STRIP_UNIQUE(ioPool)>(ram.get(), Config::threading.ioWorkers);
+  }, { ramTask });
+  const auto bridgesTask = startup.Add("Bridges", [] {
+    CreateBridges();
+  }, { ramTask });
+  const auto devicesTask = CreatePCIDevices(startup, { schedulerTask, ramTask, ioPoolTask, bridgesTask });
+  const auto rootBusTask = startup.Add("Root Bus", [] {
+    CreateRootBus();
+  }, { devicesTask });
+  const auto cpuTask = startup.Add("CPU", [] {
+    xenonCPU = std::make_unique<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::filepaths.oneBl, Config::filepaths.fuses, ram.get(),
+      scheduler.get());
+    pciBridge->RegisterIIC(xenonCPU->GetIICPointer());
+  }, { rootBusTask });
+  // Xenos goes after the devices, so scheduler events are always registered in the same order
+  const auto xgpuTask = startup.Add("XGPU", [] {
+    xenos = std::make_unique<STRIP_UNIQUE(xenos)>(
 #ifndef NO_GFX
-  if (renderer)
-    renderer->Start(ram.get());
+      renderer.get(),
+#else
+      nullptr,
 #endif
-
-  // With a async backend, we want it to catch up first, so just wait a bit.
-  std::this_thread::sleep_for(100ms);
-
-  // Create PCI devices
-  CreatePCIDevices(ram.get());
-
-  // Create rootbus
-  CreateRootBus();
-
-  // Create CPU
-  xenonCPU = std::make_unique<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::filepaths.oneBl, Config::filepaths.fuses, ram.get());
-  pciBridge->RegisterIIC(xenonCPU->GetIICPointer());
-
-  // Create XGPU
-  xenos = std::make_unique<STRIP_UNIQUE(xenos)>(
+      ram.get(), pciBridge.get(), scheduler.get()
+    );
+    hostBridge->RegisterXGPU(xenos);
+    // XGPU BARs are decoded by the Host Bridge, so they must be in the page table too
+    rootBus->RebuildPageTable();
+  }, {
 #ifndef NO_GFX
-    renderer.get(),
-#else
-    nullptr,
+    rendererTask,
 #endif
-    ram.get(), pciBridge.get()
-  );
-  hostBridge->RegisterXGPU(xenos);
+    rootBusTask });
+  startup.Add("Save States", [] {
+    // Create the save state manager
+    saveStates = std::make_unique<STRIP_UNIQUE(saveStates)>();
+    // Fast boot fingerprints the NAND, so it goes before anything can write to it
+    if (Config::fastBoot.enable)
+      fastBoot = std::make_unique<STRIP_UNIQUE(fastBoot)>(saveStates.get());
+  }, { cpuTask, xgpuTask });
+  startup.Add("Power-On State", [] {
+    // What reboots put the devices back to, see SoftReboot
+    hostBridge->CapturePowerOnState();
+    pciBridge->CapturePowerOnState();
+    xenos->CapturePowerOnState();
+  }, { cpuTask, xgpuTask });
+  startup.Run();
 }
 
 void XeMain::Shutdown() {
@@ -84,6 +117,10 @@ void XeMain::Shutdown() {
   // Save config
   SaveConfig();
 
+  // Drop fast boot and the save state manager while the CPU and RAM are still around
+  fastBoot.reset();
+  saveStates.reset();
+
   // Shutdown the XCPU
   xenonCPU.reset();
   CPUStarted = false;
@@ -91,6 +128,12 @@ void XeMain::Shutdown() {
   // Shutdown the PCI bridges
   pciBridge.reset();
 
+  // Devices using the I/O pool wait for their requests as they go, then the pool itself, all before RAM
+  sfcx.reset();
+  odd.reset();
+  hdd.reset();
+  ioPool.reset();
+
   // Shutdown the rootbus
   rootBus.reset();
   nand.reset();
@@ -151,8 +194,14 @@ void XeMain::ShutdownCPU() {
   if (!CPUStarted) {
     return;
   }
+  // Fast boot only captures on the first boot
+  if (fastBoot)
+    fastBoot->Stop();
   // Set the CPU to 'Resetting' mode before killing the handle
   xenonCPU->Reset();
+  // Nothing saved so far can be built upon anymore
+  if (saveStates)
+    saveStates->Invalidate();
   if (ram) {
     // Reset RAM
     ram->Reset();
@@ -164,18 +213,72 @@ void XeMain::ShutdownCPU() {
   }
   // Reset the CPU
   xenonCPU.reset();
-  xenonCPU = std::make_unique<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::filepaths.oneBl, Config::filepaths.fuses, ram.get());
+  xenonCPU = std::make_unique<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::filepaths.oneBl, Config::filepaths.fuses, ram.get(),
+    scheduler.get());
   // Ensure the IIC pointer in the PCI bridge is correct
   pciBridge->RegisterIIC(xenonCPU->GetIICPointer());
   // Set the CPU as inactive
   CPUStarted = false;
 }
 
+// Puts the devices back to their power-on state, scheduler must be paused
+static void ResetDevices() {
+  // Let whatever is in flight land first. A busy command processor would race with the reset, so Xenos is left alone
+  const bool xenosIdle = XeMain::xenos && XeMain::xenos->WaitIdle(1000ms);
+  if (XeMain::xenos && !xenosIdle)
+    LOG_WARNING(System, "Reboot: Xenos didn't go idle, it keeps its current state.");
+  if (XeMain::ioPool)
+    XeMain::ioPool->WaitIdle();
+  // Anything still queued was meant for the devices we're about to reset
+  XeMain::scheduler->DropAsyncEvents();
+  XeMain::hostBridge->Reset();
+  XeMain::pciBridge->Reset();
+  if (xenosIdle)
+    XeMain::xenos->Reset();
+  // BARs go back to unassigned
+  XeMain::rootBus->RebuildPageTable();
+}
+
+bool XeMain::SoftReboot(u32 type) {
+  if (!CPUStarted)
+    return false;
+  const auto start = std::chrono::steady_clock::now();
+  // Fast boot only captures on the first boot
+  if (fastBoot)
+    fastBoot->Stop();
+  xenonCPU->Suspend();
+  scheduler->Pause();
+  if (!xenonCPU->SoftReset()) {
+    scheduler->Resume();
+    xenonCPU->Resume();
+    return false;
+  }
+  ResetDevices();
+  // RAM keeps its allocation, the pages are just discarded
+  ram->Reset();
+  smcCore->SetPowerOnReason(static_cast<Xe::PCIDev::SMC_PWR_REASON>(type));
+  // Nothing saved so far can be built upon anymore
+  if (saveStates)
+    saveStates->Invalidate();
+  scheduler->Resume();
+  xenonCPU->Resume();
+  LOG_INFO(System, "Reboot: Reset in place in {:.2f} ms.",
+    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+  return true;
+}
+
 void XeMain::Reboot(u32 type) {
+  // Reset everything in place if we can
+  if (SoftReboot(type))
+    return;
   // Check if the CPU is active
   if (CPUStarted) {
     // Shutdown the CPU
     ShutdownCPU();
+    // The devices go back to power-on too, like on a soft reboot
+    scheduler->Pause();
+    ResetDevices();
+    scheduler->Resume();
   }
   // Set poweron type
   smcCore->SetPowerOnReason(static_cast<Xe::PCIDev::SMC_PWR_REASON>(type));
@@ -187,9 +290,14 @@ void XeMain::ReloadFiles() {
   if (!GetCPU())
     return;
   GetCPU()->Halt();
+  // The NAND image changes, states saved so far can't be built upon
+  if (saveStates)
+    saveStates->Invalidate();
   // Reset the SFCX
-  sfcx = std::make_shared<STRIP_UNIQUE(sfcx)>("SFCX", SFCX_DEV_SIZE, Config::filepaths.nand, pciBridge.get(), ram.get());
+  sfcx = std::make_shared<STRIP_UNIQUE(sfcx)>("SFCX", SFCX_DEV_SIZE, Config::filepaths.nand, pciBridge.get(), ram.get(),
+    scheduler.get(), ioPool.get());
   sfcx->Start();
+  sfcx->CapturePowerOnState();
   pciBridge->ResetPCIDevice(sfcx);
   // Reset the NAND
   nand = std::make_shared<STRIP_UNIQUE(nand)>("NAND", sfcx.get());
@@ -197,7 +305,8 @@ void XeMain::ReloadFiles() {
   if (!CPUStarted) {
     // Reset the CPU again to reload 1bl and fuses
     xenonCPU.reset();
-    xenonCPU = std::make_unique<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::filepaths.oneBl, Config::filepaths.fuses, ram.get());
+    xenonCPU = std::make_unique<STRIP_UNIQUE(xenonCPU)>(rootBus.get(), Config::filepaths.oneBl, Config::filepaths.fuses, ram.get(),
+      scheduler.get());
     // Ensure the IIC pointer in the PCI bridge is correct
     pciBridge->RegisterIIC(xenonCPU->GetIICPointer());
   }
@@ -230,43 +339,54 @@ void XeMain::CreateRootBus() {
   rootBus->AddDevice(ram);
 }
 
-void XeMain::CreatePCIDevices(RAM *ram) {
-  LOG_INFO(Xenon, "Creating PCI Devices...");
-  ohci0 = std::make_shared<STRIP_UNIQUE(ohci0)>("OHCI0", OHCI_DEV_SIZE);
-  ohci1 = std::make_shared<STRIP_UNIQUE(ohci1)>("OHCI1", OHCI_DEV_SIZE);
-  pciBridge->AddPCIDevice(ohci0);
-  pciBridge->AddPCIDevice(ohci1);
-
-  ehci0 = std::make_shared<STRIP_UNIQUE(ehci0)>("EHCI0", EHCI_DEV_SIZE);
-  ehci1 = std::make_shared<STRIP_UNIQUE(ehci1)>("EHCI1", EHCI_DEV_SIZE);
-  pciBridge->AddPCIDevice(ehci0);
-  pciBridge->AddPCIDevice(ehci1);
-
-  audioController = std::make_shared<STRIP_UNIQUE(audioController)>("AUDIOCTRLR", AUDIO_CTRLR_DEV_SIZE);
-  pciBridge->AddPCIDevice(audioController);
-
-  ethernet = std::make_shared<STRIP_UNIQUE(ethernet)>("ETHERNET", ETHERNET_DEV_SIZE, pciBridge.get(), ram);
-  pciBridge->AddPCIDevice(ethernet);
-
-  sfcx = std::make_shared<STRIP_UNIQUE(sfcx)>("SFCX", SFCX_DEV_SIZE, Config::filepaths.nand, pciBridge.get(), ram);
-  if (sfcx->hasInitialised) {
-    pciBridge->AddPCIDevice(sfcx);
-    nand = std::make_shared<STRIP_UNIQUE(nand)>("NAND", sfcx.get());
-  }
-
-  xma = std::make_shared<STRIP_UNIQUE(xma)>("XMA", XMA_DEV_SIZE);
-  pciBridge->AddPCIDevice(xma);
-
-  odd = std::make_shared<STRIP_UNIQUE(odd)>("CDROM", ODD_DEV_SIZE, pciBridge.get(), ram);
-  pciBridge->AddPCIDevice(odd);
-
-  hdd = std::make_shared<STRIP_UNIQUE(hdd)>("HDD", HDD_DEV_SIZE, pciBridge.get(), ram);
-  pciBridge->AddPCIDevice(hdd);
-
-  smcCore = std::make_shared<STRIP_UNIQUE(smcCore)>("SMC", SMC_DEV_SIZE, pciBridge.get());
-  pciBridge->AddPCIDevice(smcCore);
-
-  sfcx->Start();
+Base::TaskGraph::TaskId XeMain::CreatePCIDevices(Base::TaskGraph &startup,
+  const std::vector<Base::TaskGraph::TaskId> &dependencies) {
+  // Devices are created in parallel, then added to the bridge in a fixed order
+  const auto usbTask = startup.Add("USB", [] {
+    ohci0 = std::make_shared<STRIP_UNIQUE(ohci0)>("OHCI0", OHCI_DEV_SIZE);
+    ohci1 = std::make_shared<STRIP_UNIQUE(ohci1)>("OHCI1", OHCI_DEV_SIZE);
+    ehci0 = std::make_shared<STRIP_UNIQUE(ehci0)>("EHCI0", EHCI_DEV_SIZE);
+    ehci1 = std::make_shared<STRIP_UNIQUE(ehci1)>("EHCI1", EHCI_DEV_SIZE);
+  }, dependencies);
+  const auto miscTask = startup.Add("Audio, Ethernet, XMA", [] {
+    audioController = std::make_shared<STRIP_UNIQUE(audioController)>("AUDIOCTRLR", AUDIO_CTRLR_DEV_SIZE);
+    ethernet = std::make_shared<STRIP_UNIQUE(ethernet)>("ETHERNET", ETHERNET_DEV_SIZE, pciBridge.get(), ram.get());
+    xma = std::make_shared<STRIP_UNIQUE(xma)>("XMA", XMA_DEV_SIZE);
+  }, dependencies);
+  const auto sfcxTask = startup.Add("SFCX", [] {
+    sfcx = std::make_shared<STRIP_UNIQUE(sfcx)>("SFCX", SFCX_DEV_SIZE, Config::filepaths.nand, pciBridge.get(), ram.get(),
+      scheduler.get(), ioPool.get());
+    if (sfcx->hasInitialised)
+      nand = std::make_shared<STRIP_UNIQUE(nand)>("NAND", sfcx.get());
+  }, dependencies);
+  const auto oddTask = startup.Add("ODD", [] {
+    odd = std::make_shared<STRIP_UNIQUE(odd)>("CDROM", ODD_DEV_SIZE, pciBridge.get(), ram.get(), scheduler.get(),
+      ioPool.get());
+  }, dependencies);
+  const auto hddTask = startup.Add("HDD", [] {
+    hdd = std::make_shared<STRIP_UNIQUE(hdd)>("HDD", HDD_DEV_SIZE, pciBridge.get(), ram.get(), scheduler.get(),
+      ioPool.get());
+  }, dependencies);
+  const auto smcTask = startup.Add("SMC", [] {
+    smcCore = std::make_shared<STRIP_UNIQUE(smcCore)>("SMC", SMC_DEV_SIZE, pciBridge.get(), scheduler.get());
+  }, dependencies);
+
+  return startup.Add("PCI Devices", [] {
+    LOG_INFO(Xenon, "Creating PCI Devices...");
+    pciBridge->AddPCIDevice(ohci0);
+    pciBridge->AddPCIDevice(ohci1);
+    pciBridge->AddPCIDevice(ehci0);
+    pciBridge->AddPCIDevice(ehci1);
+    pciBridge->AddPCIDevice(audioController);
+    pciBridge->AddPCIDevice(ethernet);
+    if (sfcx->hasInitialised)
+      pciBridge->AddPCIDevice(sfcx);
+    pciBridge->AddPCIDevice(xma);
+    pciBridge->AddPCIDevice(odd);
+    pciBridge->AddPCIDevice(hdd);
+    pciBridge->AddPCIDevice(smcCore);
+    sfcx->Start();
+  }, { usbTask, miscTask, sfcxTask, oddTask, hddTask, smcTask });
 }
 
 Xe::XCPU::XenonCPU *XeMain::GetCPU() {
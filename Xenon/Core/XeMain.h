@@ -8,6 +8,7 @@
 #include "Base/Logging/Log.h"
 #include "Base/Config.h"
 #include "Base/PathUtil.h"
+#include "Base/TaskGraph.h"
 
 #include "Core/PCI/Bridge/HostBridge.h"
 #include "Core/PCI/Bridge/PCIBridge.h"
@@ -25,6 +26,8 @@
 #include "Core/PCI/Devices/SMC/SMC.h"
 #include "Core/PCI/Devices/XMA/XMA.h"
 #include "Core/RootBus/RootBus.h"
+#include "Core/SaveState/FastBoot.h"
+#include "Core/SaveState/SaveState.h"
 #include "Core/XCPU/XenonCPU.h"
 #include "Core/XGPU/XGPU.h"
 
@@ -41,6 +44,9 @@ extern void StartCPU();
 
 extern void ShutdownCPU();
 
+// Resets the CPU and devices to their power-on state in place, keeping allocations and caches.
+// Returns false if the machine has to be rebuilt instead.
+extern bool SoftReboot(u32 type);
 extern void Reboot(u32 type);
 
 extern void ReloadFiles();
@@ -49,7 +55,9 @@ extern void SaveConfig();
 extern void LoadConfig();
 
 extern void CreateBridges();
-extern void CreatePCIDevices(RAM *ram);
+// Adds the device tasks to the startup graph, returns the one that finishes them.
+extern Base::TaskGraph::TaskId CreatePCIDevices(Base::TaskGraph &startup,
+  const std::vector<Base::TaskGraph::TaskId> &dependencies);
 extern void CreateRootBus();
 
 extern Xe::XCPU::XenonCPU *GetCPU();
@@ -59,6 +67,10 @@ extern Xe::XCPU::XenonCPU *GetCPU();
 inline std::filesystem::path rootDirectory = {};
 
 // Main Emulator objects
+// Event scheduler. Declared first so it outlives every device that registers events on it
+inline std::unique_ptr<Xe::XCPU::XenonScheduler> scheduler{};
+// Device I/O pool. Declared before the devices for the same reason
+inline std::unique_ptr<Xe::PCIDev::IOPool> ioPool{};
 inline std::shared_ptr<RootBus> rootBus{}; // RootBus Object
 inline std::shared_ptr<HostBridge> hostBridge{}; // HostBridge Object
 inline std::shared_ptr<PCIBridge> pciBridge{}; // PCIBridge Object
@@ -102,6 +114,11 @@ inline std::unique_ptr<Xe::XCPU::XenonCPU> xenonCPU{};
 //  Xenos GPU
 inline std::shared_ptr<Xe::Xenos::XGPU> xenos{};
 
+// Save states
+inline std::unique_ptr<Xe::SaveState::SaveStateManager> saveStates{};
+// Fast boot, only when enabled
+inline std::unique_ptr<Xe::SaveState::FastBoot> fastBoot{};
+
 } // namespace XeMain
 
 // Global shutdown handler
@@ -9,10 +9,14 @@
 #include "Base/Thread.h"
 
 PARAM(help, "Prints this message", false);
+PARAM(loadstate, "Loads a save state once the console is started");
+PARAM(savestatetest, "Runs for the given amount of seconds, checks a full and an incremental save state round trip, then exits");
 
 #define AUTO_FLIP 1
 s32 main(s32 argc, char *argv[]) {
   MicroProfileOnThreadCreate("Main");
+  // Time to first instruction is measured from here
+  const auto launchTime = std::chrono::steady_clock::now();
   // Init params
   Base::Param::Init(argc, argv);
   // Handle help param
@@ -36,10 +40,28 @@ s32 main(s32 argc, char *argv[]) {
   }
   // Create all handles
   XeMain::Create();
-  // Give errors a second to catch up, incase of the async backend
-  std::this_thread::sleep_for(200ms);
   // Start execution of the emulator
   XeMain::StartCPU();
+  // Load the requested save state, or resume from the fast boot checkpoint
+  if (PARAM_loadstate.Present())
+    XeMain::saveStates->Load(PARAM_loadstate.Get());
+  else if (XeMain::fastBoot)
+    XeMain::fastBoot->Start();
+  if (XeMain::CPUStarted) {
+    LOG_INFO(System, "Startup: Guest running {:.2f} ms after launch.",
+      std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - launchTime).count());
+  }
+  // Headless save state check, the exit code tells whether both round trips matched
+  s32 exitCode = 0;
+  if (PARAM_savestatetest.Present()) {
+    std::this_thread::sleep_for(std::chrono::seconds(PARAM_savestatetest.Get<s32>()));
+    const fs::path statePath = XeMain::rootDirectory / "savestatetest.xst";
+    bool passed = XeMain::saveStates->VerifyRoundTrip(statePath, false);
+    std::this_thread::sleep_for(1s);
+    passed = XeMain::saveStates->VerifyRoundTrip(fs::path(statePath).replace_extension(".inc.xst"), true) && passed;
+    exitCode = passed ? 0 : 1;
+    XeRunning = false;
+  }
   // Inf wait until told otherwise
   while (XeRunning) {
 #if MICROPROFILE_ENABLED && !AUTO_FLIP
@@ -58,5 +80,5 @@ s32 main(s32 argc, char *argv[]) {
   if (Base::RemoveHangup() != 0) {
     printf("Failed to remove signal handler. (this is more of a warning, than an issue)\n");
   }
-  return 0;
+  return exitCode;
 }
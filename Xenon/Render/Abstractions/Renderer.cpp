@@ -8,6 +8,7 @@
 #include "Base/Config.h"
 #include "Base/Version.h"
 #include "Base/Thread.h"
+#include "Base/Topology.h"
 
 #include "Core/XGPU/XGPU.h"
 #include "Core/XGPU/ShaderConstants.h"
@@ -285,15 +286,11 @@ bool Renderer::IssueCopy(Xe::XGPU::XenosState *state) {
         continue;
       }
 
+      // Swap the vertex data to host order as we copy it out
       const u64 wordCount = fetchData.Size;
-      std::vector<u32> rawWords(wordCount);
-      memcpy(rawWords.data(), data, wordCount * sizeof(u32));
-
       std::vector<u8> uploadBytes(wordCount * 4);
-      for (u64 i = 0; i != wordCount; ++i) {
-        u32 w = rawWords[i];
-        ::memcpy(&uploadBytes[i * 4], &w, 4);
-      }
+      xeEndianCopySwap(reinterpret_cast<u32*>(uploadBytes.data()), reinterpret_cast<const u32*>(data), wordCount,
+        static_cast<eEndian>(fetchData.Endian));
 
       Render::BufferLoadJob fetchBufferJob = {
         "VertexFetch",
@@ -396,15 +393,12 @@ void Renderer::TryLinkShaderPair(u32 vsHash, u32 psHash) {
               continue;
             }
 
+            // Swap the vertex data to host order as we copy it out
             const size_t wordCount = fetchSize / 4;
-            std::vector<u32> rawWords(wordCount);
-
-            memcpy(rawWords.data(), data, wordCount * sizeof(u32));
             std::vector<f32> dataVec;
             dataVec.resize(wordCount);
-            for (u64 i = 0; i != wordCount; ++i) {
-              dataVec[i] = std::bit_cast<f32, u32>(rawWords[i]);
-            }
+            xeEndianCopySwap(reinterpret_cast<u32*>(dataVec.data()), reinterpret_cast<const u32*>(data), wordCount,
+              static_cast<eEndian>(fetchData.Vertex[0].Endian));
 
             u64 bufferKey = (static_cast<u64>(fetchAddress) << 32) | fetchSize;
 
@@ -447,6 +441,7 @@ void Renderer::TryLinkShaderPair(u32 vsHash, u32 psHash) {
 void Renderer::Thread() {
   // Set thread name
   Base::SetCurrentThreadName("[Xe] Render");
+  Base::Topology::ApplyPlacement(Base::Topology::eThreadRole::GPU);
 
   // Setup SDL handles (thread-specific)
   BackendSDLInit();
@@ -241,9 +241,19 @@ void OGLRenderer::DrawIndexed(Xe::XGPU::XeShader shader, Xe::XGPU::XeDrawParams
   // Bind the VBO
   if (auto buffer = createdBuffers.find("VertexFetch"_jLower); buffer != createdBuffers.end())
     buffer->second->Bind();
-  // Bind and upload index buffer (TODO: Fix this)
+  // Swap the index buffer to host order, then bind and upload it
+  const u32 indexSize = indexBufferInfo.indexFormat == eIndexFormat::xeInt16 ? sizeof(u16) : sizeof(u32);
+  indexData.resize(static_cast<u64>(indexBufferInfo.count) * indexSize);
+  if (indexBufferInfo.elements) {
+    if (indexSize == sizeof(u16))
+      xeEndianCopySwap(reinterpret_cast<u16*>(indexData.data()), reinterpret_cast<const u16*>(indexBufferInfo.elements),
+        indexBufferInfo.count, indexBufferInfo.endianness);
+    else
+      xeEndianCopySwap(reinterpret_cast<u32*>(indexData.data()), reinterpret_cast<const u32*>(indexBufferInfo.elements),
+        indexBufferInfo.count, indexBufferInfo.endianness);
+  }
   glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBufferInfo.count, indexBufferInfo.elements, GL_STATIC_DRAW);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexData.size(), indexData.data(), GL_STATIC_DRAW);
   // Bind textures
   for (u32 i = 0; i != shader.textures.size(); ++i) {
     glActiveTexture(GL_TEXTURE0 + i);
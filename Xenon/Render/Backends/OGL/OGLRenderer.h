@@ -54,6 +54,8 @@ private:
   u32 VAO;
   u32 dummyVAO;
   u32 EBO;
+  // Host order copy of the current index buffer
+  std::vector<u8> indexData{};
   // SDL Context
   SDL_GLContext context;
   // Checks if ES
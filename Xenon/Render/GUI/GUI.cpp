@@ -614,9 +614,11 @@ void PPUThreadRegisters(Render::GUI *gui, sPPEState *state, ePPUThreadID thr) {
     if (gui->BeginNode("PPU:Reserve")) {
       PPU_RES *ppuRes = ppuRegisters.ppuRes.get();
       U8HexPtr(gui, ppuRes, ppuID);
-      BoolPtr(gui, ppuRes, valid);
-      // volatile? nah! (Required with std::format on macOS)
-      HexBase(gui, "reservedAddr", static_cast<u64>(ppuRes->reservedAddr));
+      // A single word holds both, see XenonReservations
+      const u64 reservation = ppuRes->reservation.load(std::memory_order_relaxed);
+      CopyCustom(gui, valid, "{}", (reservation & XE_RES_VALID_BIT) ? "true" : "false");
+      HexBase(gui, "reservedAddr", reservation & ~XE_RES_VALID_BIT);
+      HexBase(gui, "reservedData", ppuRes->reservedData);
       gui->EndNode();
     }
     Hex(gui, ppuRegisters, CIA);